@@ -26,9 +26,12 @@
 #include <ql/math/solvers1d/brent.hpp>
 #include <ql/math/solvers1d/newtonsafe.hpp>
 #include <ql/cashflows/couponpricer.hpp>
+#include <ql/cashflows/iborcoupon.hpp>
+#include <ql/indexes/swapindex.hpp>
 #include <ql/patterns/visitor.hpp>
 #include <ql/quotes/simplequote.hpp>
 #include <ql/termstructures/yield/zerospreadedtermstructure.hpp>
+#include <ql/utilities/dataformatters.hpp>
 
 using std::shared_ptr;
 using std::dynamic_pointer_cast;
@@ -467,6 +470,115 @@ namespace QuantLib {
         return totalNPV/discountCurve.discount(npvDate);
     }
 
+    namespace {
+
+        // whether the rate of the coupon is still to be forecast,
+        // following the logic of IborCoupon::indexFixing
+        bool isForecast(const FloatingRateCoupon& coupon) {
+            Date today = Settings::instance().evaluationDate();
+            Date fixingDate = coupon.fixingDate();
+            if (fixingDate > today)
+                return true;
+            if (fixingDate < today ||
+                Settings::instance().enforcesTodaysHistoricFixings())
+                return false;
+            try {
+                return coupon.index()->pastFixing(fixingDate) == Null<Real>();
+            } catch (Error&) {
+                return true;
+            }
+        }
+
+        bool forecastsOn(const FloatingRateCoupon& coupon,
+                         const YieldTermStructure& curve) {
+            shared_ptr<IborIndex> ibor =
+                dynamic_pointer_cast<IborIndex>(coupon.index());
+            if (ibor)
+                return ibor->forwardingTermStructure().currentLink().get()
+                    == &curve;
+            shared_ptr<SwapIndex> swap =
+                dynamic_pointer_cast<SwapIndex>(coupon.index());
+            if (swap)
+                return swap->forwardingTermStructure().currentLink().get()
+                    == &curve
+                    || swap->discountingTermStructure().currentLink().get()
+                    == &curve;
+            return false;
+        }
+
+    }
+
+    Real CashFlows::npv(const Leg& leg,
+                        const YieldTermStructure& discountCurve,
+                        bool includeSettlementDateFlows,
+                        Date settlementDate,
+                        Date npvDate,
+                        Real npvAdjoint,
+                        std::map<Date, Real>& discountAdjoints) {
+
+        if (leg.empty())
+            return 0.0;
+
+        if (settlementDate == Date())
+            settlementDate = Settings::instance().evaluationDate();
+
+        if (npvDate == Date())
+            npvDate = settlementDate;
+
+        // forward sweep
+        DiscountFactor npvDiscount = discountCurve.discount(npvDate);
+        Real totalNPV = 0.0;
+        for (Size i=0; i<leg.size(); ++i) {
+            if (!leg[i]->hasOccurred(settlementDate,
+                                     includeSettlementDateFlows) &&
+                !leg[i]->tradingExCoupon(settlementDate))
+                totalNPV += leg[i]->amount() *
+                            discountCurve.discount(leg[i]->date());
+        }
+
+        // reverse sweep; totalNPV/npvDiscount is the result
+        Real totalAdjoint = npvAdjoint/npvDiscount;
+        discountAdjoints[npvDate] -=
+            npvAdjoint*totalNPV/(npvDiscount*npvDiscount);
+        for (Size i=0; i<leg.size(); ++i) {
+            if (leg[i]->hasOccurred(settlementDate,
+                                    includeSettlementDateFlows) ||
+                leg[i]->tradingExCoupon(settlementDate))
+                continue;
+            Date paymentDate = leg[i]->date();
+            discountAdjoints[paymentDate] += totalAdjoint*leg[i]->amount();
+
+            shared_ptr<FloatingRateCoupon> floating =
+                dynamic_pointer_cast<FloatingRateCoupon>(leg[i]);
+            if (!floating || !forecastsOn(*floating, discountCurve) ||
+                !isForecast(*floating))
+                continue;
+            shared_ptr<IborCoupon> coupon =
+                dynamic_pointer_cast<IborCoupon>(floating);
+            QL_REQUIRE(coupon && !coupon->isInArrears(),
+                       "adjoint not available for the " << io::ordinal(i+1)
+                       << " cash flow, whose rate is forecast on the "
+                       "discount curve");
+
+            // amount = N tau (gearing F + spread), with the forward rate
+            // F = (D(start)/D(end) - 1)/t forecast as IborCoupon does
+            const std::shared_ptr<IborIndex>& index = coupon->iborIndex();
+            Date start = index->valueDate(coupon->fixingDate());
+            Date end = coupon->fixingEndDate();
+            Time t = index->dayCounter().yearFraction(start, end);
+            DiscountFactor startDiscount = discountCurve.discount(start);
+            DiscountFactor endDiscount = discountCurve.discount(end);
+            Real forwardAdjoint = totalAdjoint *
+                discountCurve.discount(paymentDate) * coupon->nominal() *
+                coupon->accrualPeriod() * coupon->gearing();
+            discountAdjoints[start] += forwardAdjoint/(t*endDiscount);
+            discountAdjoints[end] -=
+                forwardAdjoint*startDiscount/(t*endDiscount*endDiscount);
+        }
+
+        return totalNPV/npvDiscount;
+    }
+
     Real CashFlows::bps(const Leg& leg,
                         const YieldTermStructure& discountCurve,
                         bool includeSettlementDateFlows,
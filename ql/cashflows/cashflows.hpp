@@ -32,6 +32,7 @@
 #include <ql/interestrate.hpp>
 #include <memory>
 #include <algorithm>
+#include <map>
 
 namespace QuantLib {
 
@@ -172,6 +173,29 @@ namespace QuantLib {
                         bool includeSettlementDateFlows,
                         Date settlementDate = Date(),
                         Date npvDate = Date());
+        //! NPV of the cash flows and its adjoints.
+        /*! Returns the NPV as the overload above does and, by
+            reverse-mode differentiation of its calculation, adds to
+            discountAdjoints[d] the derivative of the NPV with respect
+            to the discount factor at each date d used, times the
+            given npvAdjoint.
+
+            The amounts of IborCoupon instances not fixed yet whose
+            index forecasts on the given term structure depend on its
+            discount factors at the start and end of their fixing
+            periods and are differentiated accordingly; they must
+            not be in arrears and their pricer must be linear in the
+            fixing, as BlackIborCouponPricer is.  An error is raised
+            for other floating-rate coupons forecasting on the term
+            structure; the remaining amounts are taken as fixed.
+        */
+        static Real npv(const Leg& leg,
+                        const YieldTermStructure& discountCurve,
+                        bool includeSettlementDateFlows,
+                        Date settlementDate,
+                        Date npvDate,
+                        Real npvAdjoint,
+                        std::map<Date, Real>& discountAdjoints);
         //! Basis-point sensitivity of the cash flows.
         /*! The result is the change in NPV due to a uniform
             1-basis-point change in the rate paid by the cash
@@ -0,0 +1,72 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ Copyright (C) 2004, 2011 Ferdinando Ametrano
+ Copyright (C) 2004, 2005 StatPro Italia srl
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#ifndef quantlib_config_hpp
+#define quantlib_config_hpp
+
+#ifndef QL_ERROR_FUNCTIONS
+/* #undef QL_ERROR_FUNCTIONS */
+#endif
+
+#ifndef QL_ERROR_LINES
+/* #undef QL_ERROR_LINES */
+#endif
+
+#ifndef QL_ENABLE_TRACING
+/* #undef QL_ENABLE_TRACING */
+#endif
+
+#ifndef QL_NEGATIVE_RATES
+#define QL_NEGATIVE_RATES
+#endif
+
+#ifndef QL_EXTRA_SAFETY_CHECKS
+/* #undef QL_EXTRA_SAFETY_CHECKS */
+#endif
+
+#ifndef QL_USE_INDEXED_COUPON
+/* #undef QL_USE_INDEXED_COUPON */
+#endif
+
+#ifndef QL_ENABLE_SESSIONS
+/* #undef QL_ENABLE_SESSIONS */
+#endif
+
+#ifndef QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN
+/* #undef QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN */
+#endif
+
+#ifndef QL_HIGH_RESOLUTION_DATE
+/* #undef QL_HIGH_RESOLUTION_DATE */
+#endif
+
+#ifndef QL_ENABLE_SINGLETON_THREAD_SAFE_INIT
+/* #undef QL_ENABLE_SINGLETON_THREAD_SAFE_INIT */
+#endif
+
+#ifndef QL_USE_MKL
+/* #undef QL_USE_MKL */
+#endif
+
+#ifndef MULTIPRECISION_NON_CENTRAL_CHI_SQUARED_QUADRATURE
+/* #undef MULTIPRECISION_NON_CENTRAL_CHI_SQUARED_QUADRATURE */
+#endif
+
+#endif
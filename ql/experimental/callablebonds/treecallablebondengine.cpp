@@ -61,15 +61,8 @@ namespace QuantLib {
         DiscretizedCallableFixedRateBond callableBond(arguments_,
                                                       referenceDate,
                                                       dayCounter);
-        std::shared_ptr<Lattice> lattice;
-
-        if (lattice_) {
-            lattice = lattice_;
-        } else {
-            std::vector<Time> times = callableBond.mandatoryTimes();
-            TimeGrid timeGrid(times.begin(), times.end(), timeSteps_);
-            lattice = model_->tree(timeGrid);
-        }
+        std::shared_ptr<Lattice> lattice =
+            this->lattice(callableBond.mandatoryTimes());
 
         Time redemptionTime =
             dayCounter.yearFraction(referenceDate,
@@ -80,11 +80,8 @@ namespace QuantLib {
             expectedDistribution(const Date& date) const {
             // precal date conditional magnitudes:
             std::vector<Real> notionals = basket_->remainingNotionals(date);
-            std::vector<Probability> invProbs = 
-                basket_->remainingProbabilities(date);
-            for(Size iName=0; iName<invProbs.size(); iName++)
-                invProbs[iName] = 
-                    copula_->inverseCumulativeY(invProbs[iName], iName);
+            std::vector<Real> invProbs = copula_->inverseCumulativeY(
+                basket_->remainingProbabilities(date));
 
             return copula_->integratedExpectedValue(
 			  [this, date, notionals, invProbs] (const std::vector<Real>& v) ->std::vector<Real> {return lossProbability(date, notionals, invProbs, v);}
@@ -173,11 +170,9 @@ namespace QuantLib {
             std::accumulate(lgdsLeft.begin(), lgdsLeft.end(), Real(0.)) /
                 bsktSize;
 
-        std::vector<Probability> condDefProb(bsktSize, 0.);
-        for(Size j=0; j<bsktSize; j++)//transform
-            condDefProb[j] = 
-                copula_->conditionalDefaultProbabilityInvP(uncondDefProbInv[j],
-                    j, mktFactors);
+        std::vector<Probability> condDefProb;
+        copula_->conditionalDefaultProbabilitiesInvP(uncondDefProbInv,
+            mktFactors, condDefProb);
         // of full portfolio:
         Real avgProb = avgLgd <= QL_EPSILON ? 0. : // only if all are 0
                 std::inner_product(condDefProb.begin(), 
@@ -314,12 +309,9 @@ namespace QuantLib {
     Real BinomialLossModel<LLM>::expectedTrancheLoss(const Date& d) const {
         std::vector<Real> lossVals  = lossPoints(d);
         std::vector<Real> notionals = basket_->remainingNotionals(d);
-        std::vector<Probability> invProbs = 
-            basket_->remainingProbabilities(d);
-        for(Size iName=0; iName<invProbs.size(); iName++)
-            invProbs[iName] = 
-                copula_->inverseCumulativeY(invProbs[iName], iName);
-            
+        std::vector<Real> invProbs = copula_->inverseCumulativeY(
+            basket_->remainingProbabilities(d));
+
         return copula_->integratedExpectedValue(
 		    [this, &d, &lossVals, &notionals, &invProbs](const std::vector<Real>& v) {return this->condTrancheLoss(d, lossVals, notionals, invProbs, v);}
             );
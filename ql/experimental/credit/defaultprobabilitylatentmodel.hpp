@@ -136,6 +136,8 @@ namespace QuantLib {
 
     protected:
         void update() {
+            thresholdProbs_.clear();
+            thresholds_.clear();
             if (basket_) basket_->notifyObservers();
             LatentModel<copulaPolicy>::update();
         }
@@ -170,6 +172,77 @@ namespace QuantLib {
             return res;
         }
 
+        /*! Batch version of the method above: returns in probs the
+        conditional default probabilities of the first invCumYProbs.size()
+        names at the given values of the factors. All the names go through
+        the copula cumulative in a single call, which the Gaussian copula
+        vectorizes.
+        */
+        void conditionalDefaultProbabilitiesInvP(
+                const std::vector<Real> &invCumYProbs,
+                const std::vector<Real> &m,
+                std::vector<Probability> &probs) const {
+            const Size n = invCumYProbs.size();
+            probs.resize(n);
+            for (Size i = 0; i < n; ++i)
+                probs[i] = (invCumYProbs[i] -
+                            std::inner_product(factorWeights_[i].begin(),
+                                               factorWeights_[i].end(),
+                                               m.begin(), 0.)) /
+                           idiosyncFctrs_[i];
+            if (n != 0)
+                cumulativeZ(&probs[0], &probs[0], n);
+        }
+
+        /*! Node-major batch version: returns in probs the conditional
+        default probabilities of the first invCumYProbs.size() names at
+        each of the given values of the factors, so that probs[k*n+i] is
+        the one of name i at node k. All of them go through the copula
+        cumulative in a single call.
+        */
+        void conditionalDefaultProbabilitiesInvP(
+                const std::vector<Real> &invCumYProbs,
+                const std::vector<std::vector<Real> > &nodes,
+                std::vector<Probability> &probs) const {
+            const Size n = invCumYProbs.size();
+            probs.resize(n * nodes.size());
+            for (Size k = 0; k < nodes.size(); ++k) {
+                Real *nodeProbs = &probs[k * n];
+                for (Size i = 0; i < n; ++i)
+                    nodeProbs[i] = (invCumYProbs[i] -
+                                    std::inner_product(
+                                        factorWeights_[i].begin(),
+                                        factorWeights_[i].end(),
+                                        nodes[k].begin(), 0.)) /
+                                   idiosyncFctrs_[i];
+            }
+            if (!probs.empty())
+                cumulativeZ(&probs[0], &probs[0], probs.size());
+        }
+
+        /*! Returns the inverse cumulatives of the given unconditional
+        default probabilities of the first probs.size() names, i.e. their
+        default thresholds on the latent variables. As in
+        conditionalDefaultProbability, probabilities below 1e-10 are taken
+        as null. The last result is cached, so that integrations repeated
+        at the same date (for instance, by a root-finder on the loss
+        distribution) do not invert the probabilities again.
+
+        \warning Because of the cache, this method must not be called
+                 concurrently on the same model.
+        */
+        std::vector<Real> inverseCumulativeY(
+                const std::vector<Probability> &probs) const {
+            if (probs != thresholdProbs_) {
+                thresholds_.resize(probs.size());
+                for (Size i = 0; i < probs.size(); ++i)
+                    thresholds_[i] = probs[i] < 1.e-10 ?
+                        QL_MIN_REAL : inverseCumulativeY(probs[i], i);
+                thresholdProbs_ = probs;
+            }
+            return thresholds_;
+        }
+
     protected:
         /*! Returns the probability of default of a given name conditional on
         the realization of a given set of values of the model independent
@@ -209,6 +282,24 @@ namespace QuantLib {
         // \todo: check the issuer has not defaulted.
         Real conditionalProbAtLeastNEvents(Size n, const Date &date,
                                            const std::vector<Real> &mktFactors) const;
+        /*! Same as above, given the default thresholds of the names as
+            returned by inverseCumulativeY.
+        */
+        Real conditionalProbAtLeastNEventsInvP(Size n,
+                                               const std::vector<Real> &invCumYProbs,
+                                               const std::vector<Real> &mktFactors) const;
+        //! Unconditional default probabilities of the basket names.
+        std::vector<Probability> defaultProbabilities(const Date &date) const {
+            QL_REQUIRE(basket_, "No portfolio basket set.");
+            const std::shared_ptr<Pool> &pool = basket_->pool();
+            std::vector<Probability> probs;
+            probs.reserve(basket_->size());
+            for (Size i = 0; i < basket_->size(); i++)
+                probs.emplace_back(pool->get(pool->names()[i]).
+                        defaultProbability(basket_->defaultKeys()[i])->
+                        defaultProbability(date));
+            return probs;
+        }
 
         //! access to integration:
         const std::shared_ptr<LMIntegration> &
@@ -245,12 +336,19 @@ namespace QuantLib {
         defaults in the basket portfolio at a given time.
         */
         Probability probAtLeastNEvents(Size n, const Date &date) const {
+            const std::vector<Real> invProbs =
+                inverseCumulativeY(defaultProbabilities(date));
             return integratedExpectedValue(
-                    [this, &date, n](const std::vector<Real> &v) {
-                        return this->conditionalProbAtLeastNEvents(n, date, v);
+                    [this, &invProbs, n](const std::vector<Real> &v) {
+                        return this->conditionalProbAtLeastNEventsInvP(
+                            n, invProbs, v);
                     });
 
         }
+    private:
+        // cached default thresholds
+        mutable std::vector<Probability> thresholdProbs_;
+        mutable std::vector<Real> thresholds_;
     };
 
 
@@ -293,6 +391,17 @@ namespace QuantLib {
         if (n == 0)
 	    return 1;
 
+        return conditionalProbAtLeastNEventsInvP(n,
+            inverseCumulativeY(defaultProbabilities(date)), mktFactors);
+    }
+
+    template<class CP>
+    Real DefaultLatentModel<CP>::conditionalProbAtLeastNEventsInvP(Size n,
+                                                                   const std::vector<Real> &invCumYProbs,
+                                                                   const std::vector<Real> &mktFactors) const {
+        if (n == 0)
+	    return 1;
+
         QL_REQUIRE(basket_, "No portfolio basket set.");
 
         /* TODO-HAO:
@@ -300,15 +409,11 @@ namespace QuantLib {
         */
         // first position with as many defaults as desired:
         Size poolSize = basket_->size();//move to 'livesize'
-        const std::shared_ptr<Pool> &pool = basket_->pool();
 
         // Precalc conditional probabilities
         std::vector<Probability> pDefCond;
-        for (Size i = 0; i < poolSize; i++)
-            pDefCond.emplace_back(conditionalDefaultProbability(
-                    pool->get(pool->names()[i]).
-                            defaultProbability(basket_->defaultKeys()[i])->
-                            defaultProbability(date), i, mktFactors));
+        conditionalDefaultProbabilitiesInvP(invCumYProbs, mktFactors,
+                                            pDefCond);
 
         Probability probNEventsOrMore = 0.;
 
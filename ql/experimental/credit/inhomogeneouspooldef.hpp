@@ -139,9 +139,8 @@ namespace QuantLib {
             std::back_inserter(lgd), [](Real x){return 1.0 - x;});
         std::transform(lgd.begin(), lgd.end(), notionals_.begin(), 
             lgd.begin(), std::multiplies<Real>());
-        std::vector<Real> prob = basket_->remainingProbabilities(d);
-        for(Size iName=0; iName<prob.size(); iName++)
-            prob[iName] = copula_->inverseCumulativeY(prob[iName], iName);
+        std::vector<Real> prob = copula_->inverseCumulativeY(
+            basket_->remainingProbabilities(d));
 
         // integrate locally (1 factor). 
         // use explicitly a 1D latent model object? 
@@ -149,20 +148,25 @@ namespace QuantLib {
         Distribution dist(nBuckets_, 0.0, 
             detachAmount_);
             //notional_);
-        std::vector<Real> mkft(1, min_ + delta_ /2.);
+        std::vector<std::vector<Real> > mkft(nSteps_,
+            std::vector<Real>(1, min_ + delta_ /2.));
+        for (Size i = 1; i < nSteps_; i++)
+            mkft[i][0] = mkft[i-1][0] + delta_;
+        // conditional probabilities of all names at all the steps at once
+        std::vector<Probability> allConditionalProbs;
+        copula_->conditionalDefaultProbabilitiesInvP(prob, mkft,
+            allConditionalProbs);
+        const Size nNames = prob.size();
         for (Size i = 0; i < nSteps_; i++) {
-            std::vector<Real> conditionalProbs;
-            for(Size iName=0; iName<notionals_.size(); iName++)
-                conditionalProbs.emplace_back(
-                copula_->conditionalDefaultProbabilityInvP(prob[iName], iName, 
-                    mkft));
+            std::vector<Real> conditionalProbs(
+                allConditionalProbs.begin() + i*nNames,
+                allConditionalProbs.begin() + (i+1)*nNames);
             Distribution d = bucktLDistBuff(lgd, conditionalProbs);
-            Real densitydm = delta_ * copula_->density(mkft);
+            Real densitydm = delta_ * copula_->density(mkft[i]);
             // also, instead of calling the static method it could be wrapped 
             // through an inlined call in the latent model
             for (Size j = 0; j < nBuckets_; j++)
                 dist.addDensity(j, d.density(j) * densitydm);
-            mkft[0] += delta_;
         }
         return dist;
     }
@@ -35,6 +35,7 @@
 #include <ql/experimental/math/tcopulapolicy.hpp>
 
 #include <ql/math/randomnumbers/mt19937uniformrng.hpp>
+#include <ql/utilities/parallelfor.hpp>
 
 /* Intended to replace
     ql\experimental\credit\randomdefaultmodel.Xpp
@@ -84,9 +85,11 @@ namespace QuantLib {
     positions that part of the problem will be starting to overtake the
     simulation costs.
 
-    \todo: someone with sound experience on cache misses look into this, the
-    statistics will be getting memory in and out of the cpu heavily and it
-    might be possible to get performance out of that.
+    The events of all simulations are stored contiguously, together with
+    the offsets at which the events of each simulation start. The portfolio
+    losses of all simulations at the last date queried are cached sorted,
+    so that further statistics on that date don't rescan the events.
+
     \todo: parallelize the statistics computation, things like Var/ESF splits
     are very expensive.
     \todo: consider another design, taking the statistics outside the models.
@@ -100,6 +103,7 @@ namespace QuantLib {
         // random generation is performed in this class only.
         typedef typename LatentModel<copulaPolicy>::template FactorSampler<USNG>
             copulaRNG_type;
+        typedef simEvent<derivedRandomLM<copulaPolicy, USNG> > simEvent_type;
     protected:
         RandomLM(Size numFactors,
             Size numLMVars,
@@ -110,7 +114,9 @@ namespace QuantLib {
           nSims_(nSims), copula_(copula) {}
 
         void update() {
-            simsBuffer_.clear();
+            simEvents_.clear();
+            simOffsets_.clear();
+            losses_.clear();
             // tell basket to notify instruments, etc, we are invalid
             if(!basket_.empty()) basket_->notifyObservers();
             LazyObject::update();
@@ -124,24 +130,87 @@ namespace QuantLib {
         }
 
         void performSimulations() const {
-            // Next sequence should determine the event and push it into buffer
-            for(Size i=nSims_; i; i--) {
-                const std::vector<Real>& sample =
-                    copulasRng_->nextSequence().value;
-                static_cast<const derivedRandomLM<copulaPolicy, USNG>* >(
-                    this)->nextSample(sample);
-            // alternatively make call an explicit local method...
+            const derivedRandomLM<copulaPolicy, USNG>* model =
+                static_cast<const derivedRandomLM<copulaPolicy, USNG>* >(this);
+            simEvents_.clear();
+            simOffsets_.assign(1, 0);
+            simOffsets_.reserve(nSims_+1);
+            losses_.clear();
+            if(threads_ == 0) {
+                // Next sequence should determine the event and push it
+                //   into buffer
+                for(Size i=nSims_; i; i--) {
+                    model->nextSample(copulasRng_->nextSequence().value,
+                        simEvents_);
+                    simOffsets_.push_back(simEvents_.size());
+                }
+                return;
+            }
+            /* Each shard of simulations draws its samples from its own
+            substream of the generator and buffers its events; the shards are
+            then appended in order, so that results do not depend on the
+            number of threads.
+            */
+            Size nShards = (nSims_ + simsPerShard_ - 1) / simsPerShard_;
+            std::vector<std::vector<simEvent_type> > shardEvents(nShards);
+            std::vector<std::vector<Size> > shardOffsets(nShards);
+            parallelFor(nShards, threads_, [&](Size iShard) {
+                Size first = iShard * simsPerShard_;
+                Size last = std::min(first + simsPerShard_, nSims_);
+                copulaRNG_type rng = copulasRng_->substream(first);
+                shardOffsets[iShard].reserve(last - first);
+                for(Size i=first; i<last; i++) {
+                    model->nextSample(rng.nextSequence().value,
+                        shardEvents[iShard]);
+                    shardOffsets[iShard].push_back(
+                        shardEvents[iShard].size());
+                }
+            });
+            for(Size iShard=0; iShard<nShards; iShard++) {
+                Size base = simEvents_.size();
+                simEvents_.insert(simEvents_.end(),
+                    shardEvents[iShard].begin(), shardEvents[iShard].end());
+                for(Size i=0; i<shardOffsets[iShard].size(); i++)
+                    simOffsets_.push_back(base + shardOffsets[iShard][i]);
+                std::vector<simEvent_type>().swap(shardEvents[iShard]);
             }
         }
 
+        //! Events of a given simulation, stored contiguously.
+        class SimEvents {
+          public:
+            SimEvents(const simEvent_type* begin, const simEvent_type* end)
+            : begin_(begin), end_(end) {}
+            Size size() const { return end_ - begin_; }
+            const simEvent_type& operator[](Size i) const {
+                return begin_[i];
+            }
+            const simEvent_type* begin() const { return begin_; }
+            const simEvent_type* end() const { return end_; }
+          private:
+            const simEvent_type *begin_, *end_;
+        };
+
         /* Method to access simulation results and avoiding a copy of
-        each thread results buffer. PerformCalculations should have been called.
-        Here in the monothread version this method is redundant/trivial but
-        serves to detach the statistics access to the way the simulations are
-        stored.
+        the results buffer. PerformCalculations should have been called.
+        It serves to detach the statistics access to the way the simulations
+        are stored.
         */
-        const std::vector<simEvent<derivedRandomLM<copulaPolicy, USNG> > >&
-            getSim(const Size iSim) const { return simsBuffer_[iSim]; }
+        SimEvents getSim(const Size iSim) const {
+            return SimEvents(simEvents_.data() + simOffsets_[iSim],
+                             simEvents_.data() + simOffsets_[iSim+1]);
+        }
+
+        /* Computes and caches the untranched portfolio loss of each
+        simulation at the given date, in days from today. PerformCalculations
+        should have been called.
+        */
+        void portfolioLosses(Date::serial_type val) const;
+        /* Sum of the tranched losses of the sorted simulations from the
+        given position on. The losses must have been computed by
+        portfolioLosses.
+        */
+        Real trancheLossSum(Size from) const;
 
         /* Allows statistics to be written generically for fixed and random
         recovery rates. */
@@ -207,16 +276,40 @@ namespace QuantLib {
         //@}
     public:
         virtual ~RandomLM() {}
+        /*! Spreads the simulations over the given number of threads
+        (0, the default, runs them serially). Simulations are grouped in
+        shards of the given size, each drawing from its own substream of the
+        generator; results depend on the shard size but not on the number of
+        threads and, for low-discrepancy generators, are the same as the
+        serial ones.
+
+        \warning the latent model, the default curves and the copula
+                 must be safe to read concurrently; the rejection-based
+                 samplers are not.
+        */
+        void setThreads(Size threads, Size simsPerShard = 1024) {
+            QL_REQUIRE(simsPerShard > 0, "null number of simulations per shard");
+            threads_ = threads;
+            simsPerShard_ = simsPerShard;
+            update();
+        }
     private:
         BigNatural seed_;
+        Size threads_ = 0, simsPerShard_ = 1024;
     protected:
         const Size numFactors_;
         const Size numLMVars_;
 
         const Size nSims_;
 
-        mutable std::vector<std::vector<simEvent<derivedRandomLM<copulaPolicy,
-            USNG > > > > simsBuffer_;
+        // events of all simulations; those of the i-th simulation lie
+        //   between the i-th and (i+1)-th offsets.
+        mutable std::vector<simEvent_type> simEvents_;
+        mutable std::vector<Size> simOffsets_;
+        // portfolio losses at the last date queried, in simulation order
+        //   and sorted; the latter with the running sums of their values.
+        mutable Date::serial_type lossesDate_ = 0;
+        mutable std::vector<Real> losses_, sortedLosses_, lossSums_;
 
         mutable copulaPolicy copula_;
         mutable std::shared_ptr<copulaRNG_type> copulasRng_;
@@ -245,8 +338,7 @@ namespace QuantLib {
         Real counts = 0.;
         for(Size iSim=0; iSim < nSims_; iSim++) {
             Size simCount = 0;
-            const std::vector<simEvent<D<C, URNG> > >& events =
-                getSim(iSim);
+            const SimEvents events = getSim(iSim);
             for(Size iEvt=0; iEvt < events.size(); iEvt++)
                 // duck type on the members:
                 if(val > events[iEvt].dayFromRef) simCount++;
@@ -273,7 +365,7 @@ namespace QuantLib {
 
         std::vector<Probability> hitsByDate(basketSize, 0.);
         for(Size iSim=0; iSim < nSims_; iSim++) {
-            const std::vector<simEvent<D<C, URNG> > >& events = getSim(iSim);
+            const SimEvents events = getSim(iSim);
             std::map<unsigned short, unsigned short> namesDefaulting;
             for(Size iEvt=0; iEvt < events.size(); iEvt++) {
                 // if event is within time horizon...
@@ -317,7 +409,7 @@ namespace QuantLib {
         Real expectedDefi = 0.;
         Real expectedDefj = 0.;
         for(Size iSim=0; iSim < nSims_; iSim++) {
-            const std::vector<simEvent<D<C, URNG> > >& events = getSim(iSim);
+            const SimEvents events = getSim(iSim);
             Real imatch = 0., jmatch = 0.;
             for(Size iEvt=0; iEvt < events.size(); iEvt++) {
                 if((val > events[iEvt].dayFromRef) &&
@@ -358,31 +450,104 @@ namespace QuantLib {
         Real attachAmount = basket_->attachmentAmount();
         Real detachAmount = basket_->detachmentAmount();
 
-        // Real trancheLoss= 0.;
-        GeneralStatistics lossStats;
-        for(Size iSim=0; iSim < nSims_; iSim++) {
-            const std::vector<simEvent<D<C, URNG> > >& events = getSim(iSim);
+        portfolioLosses(val);
+        /* The mean and the sum of squared deviations of the tranched losses
+        are accumulated per shard of simulations (Welford) and the shards
+        are merged in order (Chan et al.), so that the variance doesn't
+        suffer from the cancellation of a one-pass estimate and results
+        don't depend on the number of threads.
+        */
+        Size nShards = (nSims_ + simsPerShard_ - 1) / simsPerShard_;
+        std::vector<std::pair<Real, Real> > shardMoments(nShards);
+        parallelFor(nShards, threads_, [&](Size iShard) {
+            Size first = iShard * simsPerShard_;
+            Size last = std::min(first + simsPerShard_, nSims_);
+            Real mean = 0., m2 = 0.;
+            for(Size i=first; i<last; i++) {
+                Real loss = std::min(std::max(losses_[i] - attachAmount, 0.),
+                    detachAmount - attachAmount);
+                Real delta = loss - mean;
+                mean += delta / static_cast<Real>(i - first + 1);
+                m2 += delta * (loss - mean);
+            }
+            shardMoments[iShard] = std::make_pair(mean, m2);
+        });
+        Real mean = 0., m2 = 0., samples = 0.;
+        for(Size iShard=0; iShard<nShards; iShard++) {
+            Real shardSamples = static_cast<Real>(
+                std::min(simsPerShard_, nSims_ - iShard * simsPerShard_));
+            Real total = samples + shardSamples;
+            Real delta = shardMoments[iShard].first - mean;
+            mean += delta * shardSamples / total;
+            m2 += shardMoments[iShard].second +
+                delta * delta * samples * shardSamples / total;
+            samples = total;
+        }
+        // same estimates as a GeneralStatistics instance would give
+        Real variance = m2 / (samples - 1.);
+        return std::make_pair(mean, std::sqrt(variance / samples) *
+            InverseCumulativeNormal::standard_value(0.5*(1.+confidencePerc)));
+    }
+
+
+    template<template <class, class> class D, class C, class URNG>
+    void RandomLM<D, C, URNG>::portfolioLosses(Date::serial_type val) const
+    {
+        if(!losses_.empty() && lossesDate_ == val)
+            return;
+        Date today = Settings::instance().evaluationDate();
 
+        losses_.resize(nSims_);
+        for(Size iSim=0; iSim < nSims_; iSim++) {
+            const SimEvents events = getSim(iSim);
             Real portfSimLoss=0.;
             for(Size iEvt=0; iEvt < events.size(); iEvt++) {
                 // if event is within time horizon...
                 if(val > static_cast<Date::serial_type>(
-					   events[iEvt].dayFromRef)) {
+                       events[iEvt].dayFromRef)) {
                     Size iName = events[iEvt].nameIdx;
                     // ...and is contained in the basket.
+                    //if(basket_->pool()->has(copula_->pool()->names()[iName]))
                         portfSimLoss +=
                             basket_->exposure(basket_->names()[iName],
                                 Date(events[iEvt].dayFromRef +
                                     today.serialNumber())) *
                                         (1.-getEventRecovery(events[iEvt]));
-               }
+                }
             }
-            lossStats.add(// d  ates? current losses? realized defaults, not yet
-                std::min(std::max(portfSimLoss - attachAmount, 0.),
-                    detachAmount - attachAmount) );
+            losses_[iSim] = portfSimLoss;
         }
-        return std::make_pair(lossStats.mean(), lossStats.errorEstimate() *
-            InverseCumulativeNormal::standard_value(0.5*(1.+confidencePerc)));
+
+        sortedLosses_ = losses_;
+        std::sort(sortedLosses_.begin(), sortedLosses_.end());
+        lossSums_.resize(nSims_+1);
+        lossSums_[0] = 0.;
+        for(Size i=0; i < nSims_; i++)
+            lossSums_[i+1] = lossSums_[i] + sortedLosses_[i];
+        lossesDate_ = val;
+    }
+
+
+    template<template <class, class> class D, class C, class URNG>
+    Real RandomLM<D, C, URNG>::trancheLossSum(Size from) const
+    {
+        Real attachAmount = basket_->attachmentAmount();
+        Real detachAmount = basket_->detachmentAmount();
+        Real width = detachAmount - attachAmount;
+
+        // losses up to the attachment are zero, those in the tranche are
+        //   shifted and those over the detachment are capped.
+        Size iAttach = std::max<Size>(from, std::upper_bound(
+            sortedLosses_.begin(), sortedLosses_.end(), attachAmount)
+                - sortedLosses_.begin());
+        Size iDetach = std::max<Size>(iAttach, std::upper_bound(
+            sortedLosses_.begin(), sortedLosses_.end(), detachAmount)
+                - sortedLosses_.begin());
+        Real inTranche = static_cast<Real>(iDetach - iAttach);
+        Real capped = static_cast<Real>(nSims_ - iDetach);
+        Real sum = lossSums_[iDetach] - lossSums_[iAttach];
+
+        return sum - attachAmount * inTranche + width * capped;
     }
 
 
@@ -406,9 +571,6 @@ namespace QuantLib {
 
     template<template <class, class> class D, class C, class URNG>
     Histogram RandomLM<D, C, URNG>::computeHistogram(const Date& d) const {
-        std::vector<Real> data;
-        std::set<Real> keys;// attainable loss values
-        keys.insert(0.);
         Date today = Settings::instance().evaluationDate();
         Date::serial_type val = d.serialNumber() - today.serialNumber();
         // redundant test? should have been tested by the basket caller?
@@ -419,27 +581,11 @@ namespace QuantLib {
         Real attachAmount = basket_->attachmentAmount();
         Real detachAmount = basket_->detachmentAmount();
 
-        for(Size iSim=0; iSim < nSims_; iSim++) {
-            const std::vector<simEvent<D<C, URNG> > >& events = getSim(iSim);
-
-            Real portfSimLoss=0.;
-            for(Size iEvt=0; iEvt < events.size(); iEvt++) {
-                if(val > static_cast<Date::serial_type>(
-					 events[iEvt].dayFromRef)) {
-                    Size iName = events[iEvt].nameIdx;
-          // test needed (here and the others) to reuse simulations:
-          //          if(basket_->pool()->has(copula_->pool()->names()[iName]))
-                        portfSimLoss +=
-                            basket_->exposure(basket_->names()[iName],
-                                Date(events[iEvt].dayFromRef +
-                                    today.serialNumber())) *
-                                        (1.-getEventRecovery(events[iEvt]));
-                }
-            }
-            data.emplace_back(std::min(std::max(portfSimLoss - attachAmount, 0.),
-                detachAmount - attachAmount));
-            keys.insert(data.back());
-        }
+        portfolioLosses(val);
+        std::vector<Real> data(nSims_);
+        for(Size iSim=0; iSim < nSims_; iSim++)
+            data[iSim] = std::min(std::max(losses_[iSim] - attachAmount, 0.),
+                detachAmount - attachAmount);
         // avoid using as many points as in the simulation.
         Size nPts = std::min<Size>(data.size(), 150);// fix
         return Histogram(data.begin(), data.end(), nPts);
@@ -461,43 +607,20 @@ namespace QuantLib {
         Date::serial_type val = d.serialNumber() - today.serialNumber();
         if(val <= 0) return 0.;// plus basket realized losses
 
-        //GenericRiskStatistics<GeneralStatistics> statsX;
-        std::vector<Real> losses;
-        for(Size iSim=0; iSim < nSims_; iSim++) {
-            const std::vector<simEvent<D<C, URNG> > >& events = getSim(iSim);
-            Real portfSimLoss=0.;
-            for(Size iEvt=0; iEvt < events.size(); iEvt++) {
-                if(val > static_cast<Date::serial_type>(
-					  events[iEvt].dayFromRef)) {
-                    Size iName = events[iEvt].nameIdx;
-                    // ...and is contained in the basket.
-                    //if(basket_->pool()->has(copula_->pool()->names()[iName]))
-                        portfSimLoss +=
-                            basket_->exposure(basket_->names()[iName],
-                                Date(events[iEvt].dayFromRef +
-                                    today.serialNumber())) *
-                                        (1.-getEventRecovery(events[iEvt]));
-                }
-            }
-            portfSimLoss = std::min(std::max(portfSimLoss - attachAmount, 0.),
-                detachAmount - attachAmount);
-            losses.emplace_back(portfSimLoss);
-        }
-
-        std::sort(losses.begin(), losses.end());
+        // tranching preserves the order of the sorted losses
+        portfolioLosses(val);
         Real posit = std::ceil(percent * nSims_);
         posit = posit >= 0. ? posit : 0.;
         Size position = static_cast<Size>(posit);
-        Real perctlInf = losses[position];//q_{\alpha}
+        Real perctlInf = std::min(std::max(sortedLosses_[position] -
+            attachAmount, 0.), detachAmount - attachAmount);//q_{\alpha}
 
         // the prob of values strictly larger than the quantile value.
         Probability probOverQ =
-            static_cast<Real>(std::distance(losses.begin() + position,
-                losses.end())) / static_cast<Real>(nSims_);
+            static_cast<Real>(nSims_ - position) / static_cast<Real>(nSims_);
 
         return ( perctlInf * (1.-percent-probOverQ) +//<-correction term
-            std::accumulate(losses.begin() + position, losses.end(), 
-			    Real(0.))/nSims_
+            trancheLossSum(position)/nSims_
                 )/(1.-percent);
 
         /* Alternative ESF definition; find the first loss larger than the
@@ -553,33 +676,17 @@ namespace QuantLib {
         Real attachAmount = basket_->attachmentAmount();
         Real detachAmount = basket_->detachmentAmount();
 
-        std::vector<Real> rankLosses;
         Date today = Settings::instance().evaluationDate();
         Date::serial_type val = d.serialNumber() - today.serialNumber();
-        for(Size iSim=0; iSim < nSims_; iSim++) {
-            const std::vector<simEvent<D<C, URNG> > >& events = getSim(iSim);
-            Real portfSimLoss=0.;
-            for(Size iEvt=0; iEvt < events.size(); iEvt++) {
-                if(val > static_cast<Date::serial_type>(
-					 events[iEvt].dayFromRef)) {
-                    Size iName = events[iEvt].nameIdx;
-                 //   if(basket_->pool()->has(copula_->pool()->names()[iName]))
-                        portfSimLoss +=
-                            basket_->exposure(basket_->names()[iName],
-                                Date(events[iEvt].dayFromRef +
-                                    today.serialNumber())) *
-                                        (1.-getEventRecovery(events[iEvt]));
-                }
-            }
-            portfSimLoss = std::min(std::max(portfSimLoss - attachAmount, 0.),
+        // tranching preserves the order of the sorted losses
+        portfolioLosses(val);
+        auto rankLoss = [&](Size i) {
+            return std::min(std::max(sortedLosses_[i] - attachAmount, 0.),
                 detachAmount - attachAmount);
-            // update dataset for rank stat:
-            rankLosses.emplace_back(portfSimLoss);
-        }
+        };
 
-        std::sort(rankLosses.begin(), rankLosses.end());
         Size quantilePosition = static_cast<Size>(floor(nSims_*percentile));
-        Real quantileValue = rankLosses[quantilePosition];
+        Real quantileValue = rankLoss(quantilePosition);
 
         // compute confidence interval:
         const Probability confInterval = 0.95;// as an argument?
@@ -618,8 +725,8 @@ namespace QuantLib {
             s++;
             s = std::min(nSims_-1, s);
         }
-        lowerPercentile = rankLosses[r];
-        upperPercentile = rankLosses[s];
+        lowerPercentile = rankLoss(r);
+        upperPercentile = rankLoss(s);
 
         return std::tuple<Real, Real, Real>(quantileValue,
             lowerPercentile, upperPercentile);
@@ -660,33 +767,22 @@ namespace QuantLib {
         Date today = Settings::instance().evaluationDate();
         Date::serial_type val = date.serialNumber() - today.serialNumber();
 
+        portfolioLosses(val);
+        std::vector<simEvent_type> splitEventsBuffer;
         for(Size iSim=0; iSim < nSims_; iSim++) {
-            const std::vector<simEvent<D<C, URNG> > >& events = getSim(iSim);
-            Real portfSimLoss=0.;
-            //std::vector<Real> splitBuffer(numLiveNames_, 0.);
-            std::vector<simEvent<D<C, URNG> > > splitEventsBuffer;
-
-            for(Size iEvt=0; iEvt < events.size(); iEvt++) {
-                if(val > static_cast<Date::serial_type>(
-					 events[iEvt].dayFromRef)) {
-                    Size iName = events[iEvt].nameIdx;
-                // if(basket_->pool()->has(copula_->pool()->names()[iName])) {
-                        portfSimLoss +=
-                            basket_->exposure(basket_->names()[iName],
-                                Date(events[iEvt].dayFromRef +
-                                    today.serialNumber())) *
-                                        (1.-getEventRecovery(events[iEvt]));
-                        //and will sort later if buffer applies:
-                        splitEventsBuffer.emplace_back(events[iEvt]);
-                }
-            }
-            portfSimLoss = std::min(std::max(portfSimLoss - attachAmount, 0.),
-                detachAmount - attachAmount);
+            Real portfSimLoss = std::min(std::max(losses_[iSim] -
+                attachAmount, 0.), detachAmount - attachAmount);
 
             /* second pass; split is conditional to total losses within target
             losses/percentile:  */
             Real ptflCumulLoss = 0.;
             if(portfSimLoss > loss) {
+                const SimEvents events = getSim(iSim);
+                splitEventsBuffer.clear();
+                for(Size iEvt=0; iEvt < events.size(); iEvt++)
+                    if(val > static_cast<Date::serial_type>(
+                           events[iEvt].dayFromRef))
+                        splitEventsBuffer.emplace_back(events[iEvt]);
                 std::sort(splitEventsBuffer.begin(), splitEventsBuffer.end());
                 //NOW THIS:
                 split.assign(numLiveNames, 0.);
@@ -874,7 +970,9 @@ namespace QuantLib {
         */
         friend class RandomLM< ::QuantLib::RandomDefaultLM, copulaPolicy, USNG>;
     protected:
-        void nextSample(const std::vector<Real>& values) const;
+        // appends the events of the simulation to the given buffer
+        void nextSample(const std::vector<Real>& values,
+            std::vector<defaultSimEvent>& events) const;
         void initDates() const {
             /* Precalculate horizon time default probabilities (used to
               determine if the default took place and subsequently compute its
@@ -884,6 +982,7 @@ namespace QuantLib {
             Date maxHorizonDate = today  + Period(this->maxHorizon_, Days);
 
             const std::shared_ptr<Pool>& pool = this->basket_->pool();
+            horizonDefaultPs_.clear();
             for(Size iName=0; iName < this->basket_->size(); ++iName)//use'live'
                 horizonDefaultPs_.emplace_back(pool->get(pool->names()[iName]).
                     defaultProbability(this->basket_->defaultKeys()[iName])
@@ -933,11 +1032,10 @@ namespace QuantLib {
 
     template<class C, class URNG>
     void RandomDefaultLM<C, URNG>::nextSample(
-        const std::vector<Real>& values) const
+        const std::vector<Real>& values,
+        std::vector<defaultSimEvent>& events) const
     {
         const std::shared_ptr<Pool>& pool = this->basket_->pool();
-        // starts with no events
-        this->simsBuffer_.emplace_back(std::vector<defaultSimEvent> ());
 
         for(Size iName=0; iName<model_->size(); iName++) {
             Real latentVarSample =
@@ -965,8 +1063,7 @@ namespace QuantLib {
                                         std::log(1.-simDefaultProb)
                     /std::log(1.-data_.horizonDefaultPs_[iName])));
                    */
-                this->simsBuffer_.back().emplace_back(defaultSimEvent(iName,
-                    dateSTride));
+                events.emplace_back(defaultSimEvent(iName, dateSTride));
                //emplace_back
             }
         /* Used to remove sims with no events. Uses less memory, faster
@@ -102,7 +102,9 @@ namespace QuantLib {
         */
         friend class RandomLM< ::QuantLib::RandomLossLM, copulaPolicy, USNG>;
     protected:
-        void nextSample(const std::vector<Real>& values) const;
+        // appends the events of the simulation to the given buffer
+        void nextSample(const std::vector<Real>& values,
+            std::vector<defaultSimEvent>& events) const;
 
         // see note on randomdefaultlatentmodel
         void initDates() const {
@@ -110,10 +112,11 @@ namespace QuantLib {
               determine if the default took place and subsequently compute its 
               event time)
             */
-            Date today = Settings::instance().evaluationDate();
-            Date maxHorizonDate = today  + Period(this->maxHorizon_, Days);
+            today_ = Settings::instance().evaluationDate();
+            Date maxHorizonDate = today_  + Period(this->maxHorizon_, Days);
 
             const std::shared_ptr<Pool>& pool = this->basket_->pool();
+            horizonDefaultPs_.clear();
             for(Size iName=0; iName < this->basket_->size(); ++iName)//use'live'
                 horizonDefaultPs_.emplace_back(pool->get(pool->names()[iName]).
                     defaultProbability(this->basket_->defaultKeys()[iName])
@@ -147,6 +150,8 @@ namespace QuantLib {
         // Default probabilities for each name at the time of the maximun 
         //   horizon date. Cached for perf.
         mutable std::vector<Probability> horizonDefaultPs_;
+        // read once, simulations might run in other threads
+        mutable Date today_;
     };
 
 
@@ -155,10 +160,10 @@ namespace QuantLib {
 
     template<class C, class URNG>
     void RandomLossLM<C, URNG>::nextSample(
-        const std::vector<Real>& values) const 
+        const std::vector<Real>& values,
+        std::vector<defaultSimEvent>& events) const 
     {
         const std::shared_ptr<Pool>& pool = this->basket_->pool();
-        this->simsBuffer_.emplace_back(std::vector<defaultSimEvent> ());
 
         // half the model is defaults, the other half are RRs...
         for(Size iName=0; iName<copula_->size()/2; iName++) {
@@ -202,8 +207,7 @@ namespace QuantLib {
                 probability the date is moved to the TS date 
                 Unless the gap is ridiculous this has no practical effect for 
                 the RR value*/
-                Date today = Settings::instance().evaluationDate();
-                Date eventDate = today+Period(static_cast<Integer>(dateSTride), 
+                Date eventDate = today_+Period(static_cast<Integer>(dateSTride), 
                     Days);
                 if(eventDate<dfts->referenceDate()) 
                     eventDate = dfts->referenceDate();
@@ -212,7 +216,7 @@ namespace QuantLib {
                 Real recovery = 
                     copula_->conditionalRecovery(latentRRVarSample,
                         iName, eventDate);
-                this->simsBuffer_.back().emplace_back(
+                events.emplace_back(
                   defaultSimEvent(iName, dateSTride, recovery));
                 //emplace_back
             }
@@ -221,10 +225,6 @@ namespace QuantLib {
         default probability, otherwise is more expensive and sim access has 
         to be modified. However low probability is also an indicator that 
         variance reduction is needed. */
-        //if(simsBuffer.back().empty()) {
-        //    emptySims_++;// Size; intilzd to zero
-        //    simsBuffer.pop_back();
-        //}
         }
     }
 
@@ -76,6 +76,9 @@ namespace QuantLib {
         Real expectedConditionalLossInvP(const std::vector<Real>& pDefDate, 
             //const Date& date,
             const std::vector<Real>& mktFactor) const;
+        std::vector<Real> conditionalLossProbInvP(
+            const std::vector<Real>& invpDefDate,
+            const std::vector<Real>& mktFactor) const;
     protected:
         void resetModel();
     public:
@@ -163,12 +166,8 @@ namespace QuantLib {
             );
             */
 /**/
-        std::vector<Probability> uncDefProb =
-                basket_->remainingProbabilities(date);
-        std::vector<Real> invProb;
-        for (Size i = 0; i < uncDefProb.size(); ++i)
-            invProb.emplace_back(copula_->inverseCumulativeY(uncDefProb[i], i));
-        ///  invProb.emplace_back(CP::inverseCumulativeY(uncDefProb[i], i));//<-static call
+        std::vector<Real> invProb = copula_->inverseCumulativeY(
+            basket_->remainingProbabilities(date));
         return copula_->integratedExpectedValue(
                 [this, &invProb](const std::vector<Real> &x) { return expectedConditionalLossInvP(invProb, x); }
         );
@@ -179,10 +178,10 @@ namespace QuantLib {
     inline std::vector<Real> 
         RecursiveLossModel<CP>::lossProbability(const Date& date) const {
 
-        std::vector<Probability> uncDefProb = 
-            basket_->remainingProbabilities(date);
+        std::vector<Real> invProb = copula_->inverseCumulativeY(
+            basket_->remainingProbabilities(date));
         return copula_->integratedExpectedValue(
-            [this, &uncDefProb](const std::vector<Real>& x){return conditionalLossProb(uncDefProb, x);}
+            [this, &invProb](const std::vector<Real>& x){return conditionalLossProbInvP(invProb, x);}
             );
     }
 
@@ -361,13 +360,15 @@ namespace QuantLib {
         // eq. 10 p.68
         // attainable losses distribution, recursive algorithm
 
+        std::vector<Probability> pDefCond;
+        copula_->conditionalDefaultProbabilitiesInvP(invpDefDate, mktFactor,
+            pDefCond);
+
         std::map<Real, Probability> pIndepDistrib;
         // K=0
         pIndepDistrib.insert(std::make_pair(0., 1.));
         for(Size iName=0; iName<remainingBsktSize_; ++iName) {
-            Probability pDef =
-                copula_->conditionalDefaultProbabilityInvP(invpDefDate[iName], 
-                    iName, mktFactor);
+            Probability pDef = pDefCond[iName];
 
             // iterate on all possible losses in the distribution:
             std::map<Real, Probability> pDistTemp;
@@ -499,6 +500,23 @@ namespace QuantLib {
         return results;
     }
 
+    template<class CP>
+    std::vector<Real> RecursiveLossModel<CP>::conditionalLossProbInvP(
+        const std::vector<Real>& invpDefDate,
+        const std::vector<Real>& mktFactor) const
+    {
+        std::map<Real, Probability> pIndepDistrib =
+            conditionalLossDistribInvP(invpDefDate, mktFactor);
+
+        std::vector<Real> results;
+        std::map<Real, Probability>::iterator distIt = pIndepDistrib.begin();
+        while(distIt != pIndepDistrib.end()) {
+            results.emplace_back(distIt->second);
+            ++distIt;
+        }
+        return results;
+    }
+
 }
 
 #endif
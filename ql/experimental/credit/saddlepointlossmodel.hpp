@@ -385,11 +385,8 @@ namespace QuantLib {
     inline Real SaddlePointLossModel<CP>::CumulantGenerating(
         const Date& date, Real s) const 
     {
-        std::vector<Real> invUncondProbs = 
-            basket_->remainingProbabilities(date);
-        for(Size i=0; i<invUncondProbs.size(); i++)
-            invUncondProbs[i] = 
-            copula_->inverseCumulativeY(invUncondProbs[i], i);
+        std::vector<Real> invUncondProbs = copula_->inverseCumulativeY(
+            basket_->remainingProbabilities(date));
 
         return copula_->integratedExpectedValue(
                 [this, &invUncondProbs, &s](const std::vector<Real>& x){return CumulantGeneratingCond(invUncondProbs, s, x);}
@@ -400,11 +397,8 @@ namespace QuantLib {
     inline Real SaddlePointLossModel<CP>::CumGen1stDerivative(
         const Date& date, Real s) const 
     {
-        std::vector<Real> invUncondProbs = 
-            basket_->remainingProbabilities(date);
-        for(Size i=0; i<invUncondProbs.size(); i++)
-            invUncondProbs[i] = 
-            copula_->inverseCumulativeY(invUncondProbs[i], i);
+        std::vector<Real> invUncondProbs = copula_->inverseCumulativeY(
+            basket_->remainingProbabilities(date));
 
        return copula_->integratedExpectedValue(
                [this, &invUncondProbs, &s](const std::vector<Real>& x){return CumGen1stDerivativeCond(invUncondProbs, s, x);}
@@ -415,11 +409,8 @@ namespace QuantLib {
     inline Real SaddlePointLossModel<CP>::CumGen2ndDerivative(
         const Date& date, Real s) const 
     {
-        std::vector<Real> invUncondProbs = 
-            basket_->remainingProbabilities(date);
-        for(Size i=0; i<invUncondProbs.size(); i++)
-            invUncondProbs[i] = 
-            copula_->inverseCumulativeY(invUncondProbs[i], i);
+        std::vector<Real> invUncondProbs = copula_->inverseCumulativeY(
+            basket_->remainingProbabilities(date));
 
         return copula_->integratedExpectedValue(
                 [this, &invUncondProbs, &s](const std::vector<Real>& x){return CumGen2ndDerivativeCond(invUncondProbs, s, x);}
@@ -430,11 +421,8 @@ namespace QuantLib {
     inline Real SaddlePointLossModel<CP>::CumGen3rdDerivative(
         const Date& date, Real s) const 
     {
-        std::vector<Real> invUncondProbs = 
-            basket_->remainingProbabilities(date);
-        for(Size i=0; i<invUncondProbs.size(); i++)
-            invUncondProbs[i] = 
-            copula_->inverseCumulativeY(invUncondProbs[i], i);
+        std::vector<Real> invUncondProbs = copula_->inverseCumulativeY(
+            basket_->remainingProbabilities(date));
 
         return copula_->integratedExpectedValue(
                 [this, &invUncondProbs, &s](const std::vector<Real>& x){return CumGen3rdDerivativeCond(invUncondProbs, s, x);}
@@ -445,11 +433,8 @@ namespace QuantLib {
     inline Real SaddlePointLossModel<CP>::CumGen4thDerivative(
         const Date& date, Real s) const 
     {
-        std::vector<Real> invUncondProbs = 
-            basket_->remainingProbabilities(date);
-        for(Size i=0; i<invUncondProbs.size(); i++)
-            invUncondProbs[i] = 
-            copula_->inverseCumulativeY(invUncondProbs[i], i);
+        std::vector<Real> invUncondProbs = copula_->inverseCumulativeY(
+            basket_->remainingProbabilities(date));
 
         return copula_->integratedExpectedValue(
                 [this, &invUncondProbs, &s](const std::vector<Real>& x){return CumGen4thDerivativeCond(invUncondProbs, s, x);}
@@ -465,11 +450,8 @@ namespace QuantLib {
             // time dependent soon:
             basket_->detachmentAmount()) return 0.;
 
-        std::vector<Real> invUncondProbs = 
-            basket_->remainingProbabilities(d);
-        for(Size i=0; i<invUncondProbs.size(); i++)
-            invUncondProbs[i] = 
-            copula_->inverseCumulativeY(invUncondProbs[i], i);
+        std::vector<Real> invUncondProbs = copula_->inverseCumulativeY(
+            basket_->remainingProbabilities(d));
 
         return copula_->integratedExpectedValue(
                 [this, &invUncondProbs, &trancheLossFract](const std::vector<Real>& x){return probOverLossCond(invUncondProbs, trancheLossFract, x);}
@@ -480,11 +462,8 @@ namespace QuantLib {
     inline Probability SaddlePointLossModel<CP>::probOverPortfLoss(
         const Date& d, Real loss) const 
     {
-        std::vector<Probability> invUncondProbs = 
-            basket_->remainingProbabilities(d);
-        for(Size i=0; i<invUncondProbs.size(); i++)
-            invUncondProbs[i] = 
-            copula_->inverseCumulativeY(invUncondProbs[i], i);
+        std::vector<Real> invUncondProbs = copula_->inverseCumulativeY(
+            basket_->remainingProbabilities(d));
 
         return copula_->integratedExpectedValue(
                 [this, &invUncondProbs, &loss](const std::vector<Real>& x){return probOverLossPortfCond(invUncondProbs, loss, x);}
@@ -495,11 +474,8 @@ namespace QuantLib {
     inline Real SaddlePointLossModel<CP>::expectedTrancheLoss(
         const Date& d) const 
     {
-        std::vector<Real> invUncondProbs = 
-            basket_->remainingProbabilities(d);
-        for(Size i=0; i<invUncondProbs.size(); i++)
-            invUncondProbs[i] = 
-            copula_->inverseCumulativeY(invUncondProbs[i], i);
+        std::vector<Real> invUncondProbs = copula_->inverseCumulativeY(
+            basket_->remainingProbabilities(d));
 
         return copula_->integratedExpectedValue(
                 [this, &invUncondProbs](const std::vector<Real>& x){return conditionalExpectedTrancheLoss(invUncondProbs, x);}
@@ -510,11 +486,8 @@ namespace QuantLib {
     inline Probability SaddlePointLossModel<CP>::probDensity(
         const Date& d, Real loss) const 
     {
-        std::vector<Real> invUncondProbs = 
-            basket_->remainingProbabilities(d);
-        for(Size i=0; i<invUncondProbs.size(); i++)
-            invUncondProbs[i] = 
-            copula_->inverseCumulativeY(invUncondProbs[i], i);
+        std::vector<Real> invUncondProbs = copula_->inverseCumulativeY(
+            basket_->remainingProbabilities(d));
 
         return copula_->integratedExpectedValue(
                 [this, &invUncondProbs, &loss](const std::vector<Real>& x){return probDensityCond(invUncondProbs, loss, x);}
@@ -525,11 +498,8 @@ namespace QuantLib {
     inline std::vector<Real> 
     SaddlePointLossModel<CP>::splitVaRLevel(const Date& date, Real s) const 
     {
-        std::vector<Real> invUncondProbs = 
-            basket_->remainingProbabilities(date);
-        for(Size i=0; i<invUncondProbs.size(); i++)
-            invUncondProbs[i] = 
-            copula_->inverseCumulativeY(invUncondProbs[i], i);
+        std::vector<Real> invUncondProbs = copula_->inverseCumulativeY(
+            basket_->remainingProbabilities(date));
 
         return copula_->integratedExpectedValue(
             [this, &invUncondProbs, &s](const std::vector<Real>& x){return splitLossCond(invUncondProbs, s, x);});
@@ -559,10 +529,11 @@ namespace QuantLib {
         const Size nNames = remainingNotionals_.size();
         Real sum = 0.;
 
+        std::vector<Probability> pDefCond;
+        copula_->conditionalDefaultProbabilitiesInvP(invUncondProbs,
+            mktFactor, pDefCond);
         for(Size iName=0; iName < nNames; iName++) {
-            Probability pBuffer = 
-                copula_->conditionalDefaultProbabilityInvP(
-                    invUncondProbs[iName], iName, mktFactor);
+            Probability pBuffer = pDefCond[iName];
             sum += std::log(1. - pBuffer + 
                 pBuffer * std::exp(remainingNotionals_[iName] * 
                 (1.-copula_->conditionalRecoveryInvP(invUncondProbs[iName],
@@ -580,10 +551,11 @@ namespace QuantLib {
         const Size nNames = remainingNotionals_.size();
         Real sum = 0.;
 
+        std::vector<Probability> pDefCond;
+        copula_->conditionalDefaultProbabilitiesInvP(invUncondProbs,
+            mktFactor, pDefCond);
         for(Size iName=0; iName < nNames; iName++) {
-            Probability pBuffer = 
-                copula_->conditionalDefaultProbabilityInvP(
-                    invUncondProbs[iName], iName, mktFactor);
+            Probability pBuffer = pDefCond[iName];
             // loss in fractional units
             Real lossInDef = remainingNotionals_[iName] * 
                 (1.-copula_->conditionalRecoveryInvP(invUncondProbs[iName], 
@@ -603,10 +575,11 @@ namespace QuantLib {
         const Size nNames = remainingNotionals_.size();
         Real sum = 0.;
 
+        std::vector<Probability> pDefCond;
+        copula_->conditionalDefaultProbabilitiesInvP(invUncondProbs,
+            mktFactor, pDefCond);
         for(Size iName=0; iName < nNames; iName++) {
-            Probability pBuffer = 
-                copula_->conditionalDefaultProbabilityInvP(
-                    invUncondProbs[iName], iName, mktFactor);
+            Probability pBuffer = pDefCond[iName];
             // loss in fractional units
             Real lossInDef = remainingNotionals_[iName] * 
                 (1.-copula_->conditionalRecoveryInvP(invUncondProbs[iName], 
@@ -628,10 +601,11 @@ namespace QuantLib {
         const Size nNames = remainingNotionals_.size();
         Real sum = 0.;
 
+        std::vector<Probability> pDefCond;
+        copula_->conditionalDefaultProbabilitiesInvP(invUncondProbs,
+            mktFactor, pDefCond);
         for(Size iName=0; iName < nNames; iName++) {
-            Probability pBuffer = 
-                copula_->conditionalDefaultProbabilityInvP(
-                    invUncondProbs[iName], iName, mktFactor);
+            Probability pBuffer = pDefCond[iName];
             Real lossInDef = remainingNotionals_[iName] * 
                 (1.-copula_->conditionalRecoveryInvP(invUncondProbs[iName], 
                     iName, mktFactor)) / remainingNotional_;
@@ -659,10 +633,11 @@ namespace QuantLib {
         const Size nNames = remainingNotionals_.size();
         Real sum = 0.;
 
+        std::vector<Probability> pDefCond;
+        copula_->conditionalDefaultProbabilitiesInvP(invUncondProbs,
+            mktFactor, pDefCond);
         for(Size iName=0; iName < nNames; iName++) {
-            Probability pBuffer = 
-                copula_->conditionalDefaultProbabilityInvP(
-                    invUncondProbs[iName], iName, mktFactor);
+            Probability pBuffer = pDefCond[iName];
             Real lossInDef = remainingNotionals_[iName] * 
                 (1.-copula_->conditionalRecoveryInvP(invUncondProbs[iName], 
                     iName, mktFactor)) / remainingNotional_;
@@ -696,10 +671,11 @@ namespace QuantLib {
              deriv2 = 0.,
              deriv3 = 0.,
              deriv4 = 0.;
+        std::vector<Probability> pDefCond;
+        copula_->conditionalDefaultProbabilitiesInvP(invUncondProbs,
+            mktFactor, pDefCond);
         for(Size iName=0; iName < nNames; iName++) {
-            Probability pBuffer = 
-                copula_->conditionalDefaultProbabilityInvP(
-                    invUncondProbs[iName], iName, mktFactor);
+            Probability pBuffer = pDefCond[iName];
             Real lossInDef = remainingNotionals_[iName] * 
                 (1.-copula_->conditionalRecoveryInvP(invUncondProbs[iName], 
                     iName, mktFactor)) / remainingNotional_;
@@ -738,10 +714,11 @@ namespace QuantLib {
         Real deriv0 = 0.,
              //deriv1 = 0.,
              deriv2 = 0.;
+        std::vector<Probability> pDefCond;
+        copula_->conditionalDefaultProbabilitiesInvP(invUncondProbs,
+            mktFactor, pDefCond);
         for(Size iName=0; iName < nNames; iName++) {
-            Probability pBuffer = 
-                copula_->conditionalDefaultProbabilityInvP(
-                    invUncondProbs[iName], iName, mktFactor);
+            Probability pBuffer = pDefCond[iName];
             Real lossInDef = remainingNotionals_[iName] * 
                 (1.-copula_->conditionalRecoveryInvP(invUncondProbs[iName], 
                     iName, mktFactor)) / remainingNotional_;
@@ -1128,10 +1105,11 @@ namespace QuantLib {
         Real saddlePt = findSaddle(invUncondProbs, loss / remainingNotional_, 
             mktFactor);
 
-        for(Size iName=0; iName<nNames; iName++) {
-            Probability pBuffer = 
-                copula_->conditionalDefaultProbabilityInvP(
-                    invUncondProbs[iName], iName, mktFactor);
+        std::vector<Probability> pDefCond;
+        copula_->conditionalDefaultProbabilitiesInvP(invUncondProbs,
+            mktFactor, pDefCond);
+        for(Size iName=0; iName < nNames; iName++) {
+            Probability pBuffer = pDefCond[iName];
             Real lossInDef = remainingNotionals_[iName] * 
                 (1.-copula_->conditionalRecoveryInvP(invUncondProbs[iName], 
                     iName, mktFactor));
@@ -1152,9 +1130,11 @@ namespace QuantLib {
         const Size nNames = remainingNotionals_.size();
         Real eloss = 0.;
         /// USE STL.....-------------------
+        std::vector<Probability> pDefCond;
+        copula_->conditionalDefaultProbabilitiesInvP(invUncondProbs,
+            mktFactor, pDefCond);
         for(Size iName=0; iName < nNames; iName++) {
-            Probability pBuffer = copula_->conditionalDefaultProbabilityInvP(
-                invUncondProbs[iName], iName, mktFactor);
+            Probability pBuffer = pDefCond[iName];
             eloss += pBuffer * remainingNotionals_[iName] *
                 (1.-copula_->conditionalRecoveryInvP(invUncondProbs[iName], 
                     iName, mktFactor));
@@ -1170,9 +1150,11 @@ namespace QuantLib {
         const Size nNames = remainingNotionals_.size();
         Real eloss = 0.;
         /// USE STL.....-------------------
+        std::vector<Probability> pDefCond;
+        copula_->conditionalDefaultProbabilitiesInvP(invUncondProbs,
+            mktFactor, pDefCond);
         for(Size iName=0; iName < nNames; iName++) {
-            Probability pBuffer = copula_->conditionalDefaultProbabilityInvP(
-                invUncondProbs[iName], iName, mktFactor);
+            Probability pBuffer = pDefCond[iName];
             eloss += 
                 pBuffer * remainingNotionals_[iName] * 
                 (1.-copula_->conditionalRecoveryInvP(invUncondProbs[iName], 
@@ -1197,9 +1179,11 @@ namespace QuantLib {
                     iName, mktFactor))); 
         std::vector<Real> vola(nNames, 0.), mu(nNames, 0.);
         Real volaTot = 0., muTot = 0.;
+        std::vector<Probability> pDefCond;
+        copula_->conditionalDefaultProbabilitiesInvP(invUncondProbs,
+            mktFactor, pDefCond);
         for(Size iName=0; iName < nNames; iName++) {
-            Probability pBuffer = copula_->conditionalDefaultProbabilityInvP(
-                invUncondProbs[iName], iName, mktFactor);
+            Probability pBuffer = pDefCond[iName];
             mu[iName] = lgds[iName] * pBuffer / remainingNotionals_[iName];
             muTot += lgds[iName] * pBuffer;
             vola[iName] = lgds[iName] * lgds[iName] * pBuffer * (1.-pBuffer) 
@@ -1273,9 +1257,11 @@ namespace QuantLib {
         const Size nNames = remainingNotionals_.size();
 
         /// use stl algorthms
+        std::vector<Probability> pDefCond;
+        copula_->conditionalDefaultProbabilitiesInvP(invUncondProbs,
+            mktFactor, pDefCond);
         for(Size iName=0; iName < nNames; iName++) {
-            Probability pBuffer = copula_->conditionalDefaultProbabilityInvP(
-                invUncondProbs[iName], iName, mktFactor);
+            Probability pBuffer = pDefCond[iName];
             elCond += pBuffer * remainingNotionals_[iName] * 
                 (1.-copula_->conditionalRecoveryInvP(invUncondProbs[iName],
                     iName, mktFactor));
@@ -1334,11 +1320,8 @@ namespace QuantLib {
         //assumed the amount includes the realized loses
         if(lossPerc >= trancheAmount) return trancheAmount;
         //SHOULD CHECK NOW THE OPPOSITE LIMIT ("zero" losses)....
-        std::vector<Real> invUncondProbs = 
-            basket_->remainingProbabilities(d);
-        for(Size i=0; i<invUncondProbs.size(); i++)
-            invUncondProbs[i] = 
-                copula_->inverseCumulativeY(invUncondProbs[i], i);
+        std::vector<Real> invUncondProbs = copula_->inverseCumulativeY(
+            basket_->remainingProbabilities(d));
 
         // Integrate with the tranche or the portfolio according to the limits.
         return copula_->integratedExpectedValue(
@@ -79,6 +79,13 @@ namespace QuantLib {
         Probability cumulativeZ(Real z) const {
             return cumulative_(z);
         }
+        /*! Cumulative probabilities of the idiosyncratic factors at the n
+            points in z, written to p (which can be the same array); uses
+            the batch cumulative normal.
+        */
+        void cumulativeZ(const Real* z, Probability* p, Size n) const {
+            cumulative_(z, p, n);
+        }
         /*! Probability density of a given realization of values of the systemic
           factors (remember they are independent). In the normal case, since 
           they all follow the same law it is just a trivial product of the same 
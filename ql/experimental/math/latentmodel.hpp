@@ -32,6 +32,7 @@
 #include <ql/experimental/math/polarstudenttrng.hpp>
 #include <ql/handle.hpp>
 #include <ql/quote.hpp>
+#include <ql/utilities/parallelfor.hpp>
 #include <functional>
 #include <memory>
 #include <algorithm>
@@ -87,6 +88,18 @@ namespace QuantLib {
                         const std::vector<Real> &arg)> f) const {
             QL_FAIL("No vector integration provided");
         }
+        /* Versions evaluating the integrand on several threads; the
+        default falls back to the serial integration for integrators
+        that can not be split. */
+        virtual Real parallelIntegrate(std::function<Real(
+                const std::vector<Real> &arg)> f, Size) const {
+            return integrate(f);
+        }
+        virtual std::vector<Real> parallelIntegrateV(
+                std::function<std::vector<Real>(
+                        const std::vector<Real> &arg)> f, Size) const {
+            return integrateV(f);
+        }
 
         virtual ~LMIntegration() {}
     };
@@ -122,7 +135,9 @@ namespace QuantLib {
             public GaussianQuadMultidimIntegrator, public LMIntegration {
     public:
         IntegrationBase(Size dimension, Size order)
-                : GaussianQuadMultidimIntegrator(dimension, order) {}
+                : GaussianQuadMultidimIntegrator(dimension, order) {
+            nodes(nodes_, weights_);
+        }
 
         Real integrate(std::function<Real(
                 const std::vector<Real> &arg)> f) const {
@@ -136,7 +151,40 @@ namespace QuantLib {
             integrate<std::vector<Real>>(f);
         }
 
+        /* The grid is fixed, so the integrand is evaluated at all nodes
+        concurrently and the weighted values are then added up in node
+        order; the result does not depend on the number of threads. */
+        Real parallelIntegrate(std::function<Real(
+                const std::vector<Real> &arg)> f, Size threads) const {
+            std::vector<Real> values(nodes_.size());
+            parallelFor(nodes_.size(), threads, [&](Size k) {
+                values[k] = f(nodes_[k]);
+            });
+            Real result = 0.0;
+            for (Size k = 0; k < values.size(); k++)
+                result += weights_[k] * values[k];
+            return result;
+        }
+
+        std::vector<Real> parallelIntegrateV(
+                std::function<std::vector<Real>(
+                        const std::vector<Real> &arg)> f,
+                Size threads) const {
+            std::vector<std::vector<Real> > values(nodes_.size());
+            parallelFor(nodes_.size(), threads, [&](Size k) {
+                values[k] = f(nodes_[k]);
+            });
+            std::vector<Real> result(values.front().size(), 0.0);
+            for (Size k = 0; k < values.size(); k++)
+                for (Size i = 0; i < result.size(); i++)
+                    result[i] += weights_[k] * values[k][i];
+            return result;
+        }
+
         virtual ~IntegrationBase() {}
+    private:
+        std::vector<std::vector<Real> > nodes_;
+        std::vector<Real> weights_;
     };
 
     template<>
@@ -310,6 +358,11 @@ namespace QuantLib {
             return copula_.cumulativeZ(z);
         }
 
+        //! Cumulative distribution of Z for a batch of values.
+        void cumulativeZ(const Real* z, Probability* p, Size n) const {
+            copula_.cumulativeZ(z, p, n);
+        }
+
         //! Density function of M, the market/systemic factors.
         Probability density(const std::vector<Real> &m) const {
 #if defined(QL_EXTRA_SAFETY_CHECKS)
@@ -452,8 +505,18 @@ namespace QuantLib {
                 x_.value = copula_.allFactorCumulInverter(sample.value);
                 return x_;
             }
+            /*! Returns a sampler for the draws from the given offset on,
+            for use by a different thread; see USNG::substream.
+            */
+            FactorSampler substream(Size offset) const {
+                return FactorSampler(copula_, sequenceGen_.substream(offset));
+            }
 
         private:
+            FactorSampler(const copulaType &copula, const USNG &sequenceGen)
+                    : sequenceGen_(sequenceGen),
+                      x_(std::vector<Real>(copula.numFactors()), 1.0),
+                      copula_(copula) {}
             USNG sequenceGen_;// copy, we might be mutithreaded
             mutable sample_type x_;
             // no copies
@@ -599,6 +662,15 @@ namespace QuantLib {
         }
         //! \name Integration facility interface
         //@{
+        /*! Evaluates the integrands on the given number of threads (0, the
+        default, integrates serially) when the integration allows it.
+
+        \warning integrands are called concurrently and must be safe to
+                 call so.
+        */
+        void setIntegrationThreads(Size threads) {
+            integrationThreads_ = threads;
+        }
         /*! Integrates an arbitrary scalar function over the density domain(i.e.
          computes its expected value).
         */
@@ -606,11 +678,12 @@ namespace QuantLib {
                 std::function<Real(const std::vector<Real> &)> f) const {
             // function composition: composes the integrand with the density 
             //   through a product.
-            return
-                    integration()->integrate(
-                            [this, &f](const std::vector<Real> &v) {
-                                return (this->copula_.density(v) * f(v));
-                            });
+            auto g = [this, &f](const std::vector<Real> &v) {
+                return (this->copula_.density(v) * f(v));
+            };
+            if (integrationThreads_ > 0)
+                return integration()->parallelIntegrate(g, integrationThreads_);
+            return integration()->integrate(g);
         }
 
         /*! Integrates an arbitrary vector function over the density domain(i.e.
@@ -620,11 +693,14 @@ namespace QuantLib {
                 // const std::function<std::vector<Real>(
                 std::function<std::vector<Real>(
                         const std::vector<Real> &)> f) const {
-            return
-                    integration()->integrateV(//see note in LMIntegrators base class
-                            [this, &f](const std::vector<Real> &v) -> std::vector<Real> {
-                                return detail::multiplyV()(this->copula_.density(v), f(v));
-                            });
+            auto g = [this, &f](const std::vector<Real> &v) -> std::vector<Real> {
+                return detail::multiplyV()(this->copula_.density(v), f(v));
+            };
+            if (integrationThreads_ > 0)
+                return integration()->parallelIntegrateV(g,
+                                                         integrationThreads_);
+            //see note in LMIntegrators base class
+            return integration()->integrateV(g);
         }
 
     protected:
@@ -663,6 +739,7 @@ namespace QuantLib {
         mutable Size nVariables_;// matches idiosyncFctrs_.size() 
 
         mutable copulaType copula_;
+        Size integrationThreads_ = 0;
     };
 
 
@@ -786,6 +863,10 @@ namespace QuantLib {
             return boxMullRng_.nextSequence();
         }
 
+        FactorSampler substream(Size) const {
+            QL_FAIL("Box-Muller sampler can not be split in substreams");
+        }
+
     private:
         RandomSequenceGenerator<BoxMullerGaussianRng<URNG> > boxMullRng_;
     };
@@ -824,6 +905,10 @@ namespace QuantLib {
             return sequence_;
         }
 
+        FactorSampler substream(Size) const {
+            QL_FAIL("polar Student-T sampler can not be split in substreams");
+        }
+
     private:
         mutable sample_type sequence_;
         URNG urng_;
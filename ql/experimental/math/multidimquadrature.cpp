@@ -33,4 +33,28 @@ namespace QuantLib {
         spawnFcts<maxDimensions_>();
     }
 
+    void GaussianQuadMultidimIntegrator::nodes(
+        std::vector<std::vector<Real> >& x, std::vector<Real>& w) const {
+        const Array& x1 = integral_.x();
+        const Array& w1 = integral_.weights();
+        const Size order = x1.size();
+        Size size = 1;
+        for (Size d=0; d<dimension_; ++d)
+            size *= order;
+
+        x.assign(size, std::vector<Real>(dimension_));
+        w.assign(size, 1.0);
+        // the first dimension is the innermost integration; each one
+        // runs from the last abscissa to the first
+        for (Size k=0; k<size; ++k) {
+            Size index = k;
+            for (Size d=0; d<dimension_; ++d) {
+                Size i = order - 1 - index % order;
+                index /= order;
+                x[k][d] = x1[i];
+                w[k] *= w1[i];
+            }
+        }
+    }
+
 }
@@ -55,8 +55,8 @@ namespace QuantLib {
                 //first one, we do not know the size of the vector returned by f
                 Integer i = order()-1;
                 std::vector<Real> term = f(x_[i]);// potential copy! @#$%^!!!
-                std::for_each(term.begin(), term.end(),
-                              [this, i](Real r){return this->w_[i]* r;});
+                std::transform(term.begin(), term.end(), term.begin(),
+                               [this, i](Real r){return this->w_[i]* r;});
                 std::vector<Real> sum = term;
            
                 for (i--; i >= 0; --i) {
@@ -81,6 +81,14 @@ namespace QuantLib {
         //! Integration quadrature order.
         Size order() const {return integralV_.order();}
 
+        /*! Nodes of the tensor-product quadrature and their weights; the
+            integral of f is the sum of the weighted values of f at the
+            nodes, which are returned in the order the recursive
+            integration visits them.
+        */
+        void nodes(std::vector<std::vector<Real> >& x,
+                   std::vector<Real>& w) const;
+
         //! Integrates function f over \f$ R^{dim} \f$
         /* This function is just syntax since the only thing it does is calling 
         to integrate<RetType> which has to exist for the type returned by the 
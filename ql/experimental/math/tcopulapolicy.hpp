@@ -98,6 +98,13 @@ namespace QuantLib {
             return cdf(distributions_.back(), z /
                 varianceFactors_.back());
         }
+        /*! Cumulative probabilities of the idiosyncratic factors at the n
+            points in z, written to p (which can be the same array).
+        */
+        void cumulativeZ(const Real* z, Probability* p, Size n) const {
+            for(Size i=0; i<n; i++)
+                p[i] = cumulativeZ(z[i]);
+        }
         /*! Probability density of a given realization of values of the systemic
           factors (remember they are independent).
           Intended to be used in numerical integration of an arbitrary function 
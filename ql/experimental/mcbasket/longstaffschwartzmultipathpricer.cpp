@@ -20,6 +20,7 @@
 #include <ql/math/generallinearleastsquares.hpp>
 #include <ql/experimental/mcbasket/longstaffschwartzmultipathpricer.hpp>
 #include <ql/utilities/tracing.hpp>
+#include <numeric>
 #include <vector>
 
 namespace QuantLib {
@@ -51,7 +52,8 @@ namespace QuantLib {
       dF_        (discounts),
       v_         (LsmBasisSystem::multiPathBasisSystem(payoff->basisSystemDimension(),
                                                        polynomOrder,
-                                                       polynomType)) {
+                                                       polynomType)),
+      leanThreads_(0), rowsPerShard_(1024), calibrationPaths_(0) {
         QL_REQUIRE(   polynomType == LsmBasisSystem::Monomial
                    || polynomType == LsmBasisSystem::Laguerre
                    || polynomType == LsmBasisSystem::Hermite
@@ -89,9 +91,14 @@ namespace QuantLib {
         PathInfo path = transformPath(multiPath);
 
         if (calibrationPhase_) {
-            // store paths for the calibration
-            // only the relevant part
-            paths_.emplace_back(path);
+            if (leanThreads_ != 0) {
+                // store the regression data for the calibration
+                addCalibrationData(path);
+            } else {
+                // store paths for the calibration
+                // only the relevant part
+                paths_.emplace_back(path);
+            }
             // result doesn't matter
             return 0.0;
         }
@@ -158,6 +165,11 @@ namespace QuantLib {
     }
 
     void LongstaffSchwartzMultiPathPricer::calibrate() {
+        if (leanThreads_ != 0) {
+            calibrateLean();
+            return;
+        }
+
         const Size n = paths_.size(); // number of paths
         Array prices(n, 0.0), exercise(n, 0.0);
 
@@ -311,4 +323,150 @@ namespace QuantLib {
         // entering the calculation phase
         calibrationPhase_ = false;
     }
+
+    void LongstaffSchwartzMultiPathPricer::setLeanCalibration(
+                                                     Size threads,
+                                                     Size rowsPerShard) {
+        QL_REQUIRE(calibrationPhase_ && paths_.empty()
+                   && calibrationPaths_ == 0,
+                   "calibration paths already added");
+        QL_REQUIRE(rowsPerShard > 0, "null number of rows per shard");
+        leanThreads_ = threads;
+        rowsPerShard_ = rowsPerShard;
+        basisValues_.resize(v_.size());
+        calibrationData_.assign(timePositions_.size() - 1,
+                                LsmCalibrationData(v_.size()));
+    }
+
+    void LongstaffSchwartzMultiPathPricer::addCalibrationData(
+                                                const PathInfo& path) const {
+        const Size len = path.pathLength();
+        const Size basisDimension = payoff_->basisSystemDimension();
+        const Size j = calibrationPaths_++;
+
+        // this is the last event date
+        {
+            const Real payoff = path.payments[len - 1];
+            const Real exercise = path.exercises[len - 1];
+            const bool canExercise = !path.states[len - 1].empty();
+
+            // at the end the continuation value is 0.0
+            Real price = payoff;
+            if (canExercise && exercise > 0.0)
+                price += exercise;
+            finalValues_.push_back(price);
+        }
+
+        for (Size i = 0; i < len - 1; ++i) {
+            payments_.push_back(path.payments[i]);
+
+            // If states is empty, no exercise in this path
+            const Array & states = path.states[i];
+            if (!states.empty()) {
+                QL_REQUIRE(states.size() == basisDimension,
+                           "Invalid size of basis system");
+                for (Size l = 0; l < v_.size(); ++l)
+                    basisValues_[l] = v_[l](states);
+                calibrationData_[i].add(j, path.exercises[i], basisValues_);
+            }
+        }
+    }
+
+    void LongstaffSchwartzMultiPathPricer::calibrateLean() {
+        const Size n = calibrationPaths_; // number of paths
+        const Size len = timePositions_.size();
+        Array prices(finalValues_.begin(), finalValues_.end());
+        std::vector<Real>().swap(finalValues_);
+
+        lowerBounds_[len - 1] = *std::min_element(prices.begin(), prices.end());
+
+        for (Integer i = len - 2; i >= 0; --i) {
+            LsmCalibrationData& data = calibrationData_[i];
+
+            // prices are discounted up to time i
+            const Real discountRatio = dF_[i + 1] / dF_[i];
+            prices *= discountRatio;
+            lowerBounds_[i + 1] *= discountRatio;
+
+            // only paths whose exercise value exceeds the lower bound
+            // of the continuation value partecipate to the regression
+            coeff_[i] = data.regression(prices, lowerBounds_[i + 1],
+                                        leanThreads_, rowsPerShard_);
+            std::vector<Real> continuationValues;
+            if (!coeff_[i].empty()) {
+                continuationValues =
+                    data.continuationValues(coeff_[i], leanThreads_,
+                                            rowsPerShard_);
+            } else {
+                QL_TRACE("Not enough itm paths: default decision is NEVER");
+            }
+
+            // paths that can't be exercised contribute their
+            // continuation value to all sums
+            Real sumNoExercise =
+                std::accumulate(prices.begin(), prices.end(), Real(0.0));
+            Real sumOptimized = sumNoExercise;
+            Real sumAlwaysExercise = sumNoExercise;
+
+            std::vector<bool> lsExercise(data.size(), false);
+            for (Size k = 0; k < data.size(); ++k) {
+                const Real exercise = data.exercise(k);
+                const Real price = prices[data.path(k)];
+                sumAlwaysExercise += exercise - price;
+                if (!coeff_[i].empty() && exercise > lowerBounds_[i + 1]
+                    && continuationValues[k] < exercise) {
+                    lsExercise[k] = true;
+                    sumOptimized += exercise - price;
+                }
+            }
+
+            sumOptimized /= n;
+            sumNoExercise /= n;
+            sumAlwaysExercise /= n;
+
+            QL_TRACE(   "Time index: " << i 
+                     << ", LowerBound: " << lowerBounds_[i + 1] 
+                     << ", Optimum: " << sumOptimized 
+                     << ", Continuation: " << sumNoExercise 
+                     << ", Termination: " << sumAlwaysExercise);
+
+            if (  sumOptimized >= sumNoExercise 
+                && sumOptimized >= sumAlwaysExercise) {
+
+                QL_TRACE("Accepted LS decision");
+                for (Size k = 0; k < data.size(); ++k) {
+                    if (lsExercise[k])
+                        prices[data.path(k)] = data.exercise(k);
+                }
+            }
+            else if (sumAlwaysExercise > sumNoExercise) {
+                QL_TRACE("Overridden bad LS decision: ALWAYS");
+                for (Size k = 0; k < data.size(); ++k)
+                    prices[data.path(k)] = data.exercise(k);
+                // special value to indicate always exercise
+                coeff_[i] = Array(v_.size() + 1); 
+            }
+            else {
+                QL_TRACE("Overridden bad LS decision: NEVER");
+                // special value to indicate never exercise
+                coeff_[i] = Array(0); 
+            }
+
+            // then we add in any case the payment at time t
+            // which is made even if cancellation happens at t
+            for (Size j = 0; j < n; ++j)
+                prices[j] += payments_[j * (len - 1) + i];
+
+            lowerBounds_[i] = *std::min_element(prices.begin(), prices.end());
+
+            data.clear();
+        }
+
+        // remove calibration data
+        std::vector<Real>().swap(payments_);
+        calibrationPaths_ = 0;
+        // entering the calculation phase
+        calibrationPhase_ = false;
+    }
+
 }
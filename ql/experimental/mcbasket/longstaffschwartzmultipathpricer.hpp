@@ -26,6 +26,7 @@
 #include <ql/methods/montecarlo/pathpricer.hpp>
 #include <ql/methods/montecarlo/multipath.hpp>
 #include <ql/methods/montecarlo/lsmbasissystem.hpp>
+#include <ql/methods/montecarlo/lsmcalibrationdata.hpp>
 #include <ql/experimental/mcbasket/pathpayoff.hpp>
 
 namespace QuantLib {
@@ -56,6 +57,20 @@ namespace QuantLib {
         Real operator()(const MultiPath& multiPath) const;
         virtual void calibrate();
 
+        //! stores regression data rather than paths for the calibration
+        /*! When the number of threads is not null, the calibration
+            paths are not stored; instead, for each event date, only
+            the payments, the exercise values and the values of the
+            basis functions at the states are kept.  The regressions
+            are accumulated in shards of the given number of rows,
+            which are distributed across the given number of threads,
+            and solved by QR decomposition; the results don't depend
+            on the number of threads.
+
+            This must be called before the calibration paths are added.
+        */
+        void setLeanCalibration(Size threads, Size rowsPerShard = 1024);
+
       protected:
         struct PathInfo {
             PathInfo(Size numberOfTimes);
@@ -82,6 +97,15 @@ namespace QuantLib {
 
         mutable std::vector<PathInfo> paths_;
         const   std::vector<std::function<Real(const Array&)> > v_;
+
+      private:
+        void addCalibrationData(const PathInfo& path) const;
+        void calibrateLean();
+
+        Size leanThreads_, rowsPerShard_;
+        mutable Size calibrationPaths_;
+        mutable std::vector<Real> payments_, finalValues_, basisValues_;
+        mutable std::vector<LsmCalibrationData> calibrationData_;
     };
 
 }
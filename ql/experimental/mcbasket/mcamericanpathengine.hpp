@@ -77,12 +77,14 @@ namespace QuantLib {
         MakeMCAmericanPathEngine& withMaxSamples(Size samples);
         MakeMCAmericanPathEngine& withSeed(BigNatural seed);
         MakeMCAmericanPathEngine& withCalibrationSamples(Size samples);
+        MakeMCAmericanPathEngine& withLeanCalibration(Size threads = 1);
         // conversion to pricing engine
         operator std::shared_ptr<PricingEngine>() const;
       private:
         std::shared_ptr<StochasticProcessArray> process_;
         bool brownianBridge_, antithetic_, controlVariate_;
         Size steps_, stepsPerYear_, samples_, maxSamples_, calibrationSamples_;
+        Size leanCalibrationThreads_;
         Real tolerance_;
         BigNatural seed_;
     };
@@ -171,7 +173,7 @@ namespace QuantLib {
       controlVariate_(false),
       steps_(Null<Size>()), stepsPerYear_(Null<Size>()),
       samples_(Null<Size>()), maxSamples_(Null<Size>()),
-      calibrationSamples_(Null<Size>()),
+      calibrationSamples_(Null<Size>()), leanCalibrationThreads_(0),
       tolerance_(Null<Real>()), seed_(0) {}
 
     template <class RNG>
@@ -251,6 +253,13 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG>
+    inline MakeMCAmericanPathEngine<RNG>&
+    MakeMCAmericanPathEngine<RNG>::withLeanCalibration(Size threads) {
+        leanCalibrationThreads_ = threads;
+        return *this;
+    }
+
     template <class RNG>
     inline
     MakeMCAmericanPathEngine<RNG>::operator
@@ -259,18 +268,20 @@ namespace QuantLib {
                    "number of steps not given");
         QL_REQUIRE(steps_ == Null<Size>() || stepsPerYear_ == Null<Size>(),
                    "number of steps overspecified");
-        return std::shared_ptr<PricingEngine>(new
-            MCAmericanPathEngine<RNG>(process_,
-                                        steps_,
-                                        stepsPerYear_,
-                                        brownianBridge_,
-                                        antithetic_,
-                                        controlVariate_,
-                                        samples_,
-                                        tolerance_,
-                                        maxSamples_,
-                                        seed_,
-                                        calibrationSamples_));
+        std::shared_ptr<MCAmericanPathEngine<RNG> > engine(
+            new MCAmericanPathEngine<RNG>(process_,
+                                          steps_,
+                                          stepsPerYear_,
+                                          brownianBridge_,
+                                          antithetic_,
+                                          controlVariate_,
+                                          samples_,
+                                          tolerance_,
+                                          maxSamples_,
+                                          seed_,
+                                          calibrationSamples_));
+        engine->setLeanCalibration(leanCalibrationThreads_);
+        return engine;
     }
 
 }
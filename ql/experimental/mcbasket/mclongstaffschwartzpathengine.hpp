@@ -63,6 +63,13 @@ namespace QuantLib {
 
         void calculate() const;
 
+        //! calibrates on regression data rather than stored paths
+        /*! See LongstaffSchwartzMultiPathPricer::setLeanCalibration
+            for details.  A null number of threads (the default) selects
+            the calibration on stored paths.
+        */
+        void setLeanCalibration(Size threads, Size rowsPerShard = 1024);
+
       protected:
         virtual std::shared_ptr<LongstaffSchwartzMultiPathPricer>
                                                     lsmPathPricer() const = 0;
@@ -80,6 +87,7 @@ namespace QuantLib {
         const Size maxSamples_;
         const Size seed_;
         const Size nCalibrationSamples_;
+        Size leanThreads_, rowsPerShard_;
 
         mutable std::shared_ptr<LongstaffSchwartzMultiPathPricer> pathPricer_;
     };
@@ -109,7 +117,8 @@ namespace QuantLib {
       maxSamples_         (maxSamples),
       seed_               (seed),
       nCalibrationSamples_( (nCalibrationSamples == Null<Size>())
-                            ? 2048 : nCalibrationSamples) {
+                            ? 2048 : nCalibrationSamples),
+      leanThreads_(0), rowsPerShard_(1024) {
         QL_REQUIRE(timeSteps != Null<Size>() ||
                    timeStepsPerYear != Null<Size>(),
                    "no time steps provided");
@@ -142,7 +151,11 @@ namespace QuantLib {
     inline
     void MCLongstaffSchwartzPathEngine<GenericEngine,MC,RNG,S>::calculate() 
     const {
+        QL_REQUIRE(this->threads_ == 0,
+                   "multi-threaded simulation not supported");
         pathPricer_ = this->lsmPathPricer();
+        if (leanThreads_ != 0)
+            pathPricer_->setLeanCalibration(leanThreads_, rowsPerShard_);
         this->mcModel_ = std::shared_ptr<MonteCarloModel<MC,RNG,S> >(
                           new MonteCarloModel<MC,RNG,S>
                               (pathGenerator(), pathPricer_,
@@ -161,6 +174,16 @@ namespace QuantLib {
         }
     }
 
+    template <class GenericEngine, template <class> class MC,
+              class RNG, class S>
+    inline
+    void MCLongstaffSchwartzPathEngine<GenericEngine,MC,RNG,S>::
+    setLeanCalibration(Size threads, Size rowsPerShard) {
+        QL_REQUIRE(rowsPerShard > 0, "null number of rows per shard");
+        leanThreads_ = threads;
+        rowsPerShard_ = rowsPerShard;
+    }
+
     template <class GenericEngine, template <class> class MC,
               class RNG, class S>
     inline
@@ -0,0 +1,135 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file nodesensitivityanalysis.hpp
+    \brief bucket sensitivities to the quotes of a bootstrapped curve
+*/
+
+#ifndef quantlib_node_sensitivity_analysis_hpp
+#define quantlib_node_sensitivity_analysis_hpp
+
+#include <ql/termstructures/yield/piecewiseyieldcurve.hpp>
+#include <ql/math/matrixutilities/qrdecomposition.hpp>
+#include <ql/quotes/simplequote.hpp>
+#include <ql/instrument.hpp>
+#include <map>
+
+namespace QuantLib {
+
+    //! bucket PV01 sensitivity analysis for the quotes of a bootstrapped curve
+    /*! returns the first derivatives of the aggregated NPV with
+        respect to each of the given quotes, as bucketAnalysis does,
+        for a portfolio depending on them through the passed curve.
+
+        The instruments are not repriced.  Their engines must return
+        the derivatives \f$ \bar{d} \f$ of their NPV with respect to
+        the discount factors of the curve as the additional result
+        "discountAdjoints", as DiscountingSwapEngine and
+        DiscountingBondEngine do when required.  These are taken
+        back to the curve nodes as \f$ g = D^T \bar{d} \f$, where
+        \f$ D \f$ is returned by the discountJacobian() method of
+        the curve, and the sensitivities to the quotes are the
+        solution \f$ \lambda \f$ of \f$ J^T \lambda = g \f$, with
+        \f$ J \f$ the Jacobian of the implied quotes with respect
+        to the nodes returned by the jacobian() method.
+
+        Empty quantities vector is considered as unit vector.  Quotes
+        which are not used by the curve helpers have null sensitivity.
+
+        \pre The curve must provide its Jacobian, i.e., it must be
+             a PiecewiseYieldCurve using IterativeBootstrap or
+             GlobalBootstrap.
+
+        \warning The instruments must depend on the quotes only
+                 through the discount factors of the curve passed
+                 to their engines, which must be the given one.
+    */
+    template <class Curve>
+    std::vector<Real>
+    nodeBucketAnalysis(
+               const std::vector<Handle<SimpleQuote> >& quotes,
+               const std::shared_ptr<Curve>& curve,
+               const std::vector<std::shared_ptr<Instrument> >& instruments,
+               const std::vector<Real>& quantities) {
+
+        std::vector<Real> result(quotes.size(), 0.0);
+        if (instruments.empty() || quotes.empty())
+            return result;
+
+        QL_REQUIRE(quantities.empty() ||
+                   quantities.size() == instruments.size(),
+                   "quantities (" << quantities.size() << ") and "
+                   "instruments (" << instruments.size() << ") "
+                   "have different size");
+
+        // adjoints of the portfolio value...
+        std::map<Date, Real> discountAdjoints;
+        for (Size k=0; k<instruments.size(); ++k) {
+            Real quantity = quantities.empty() ? 1.0 : quantities[k];
+            std::map<Date, Real> adjoints;
+            try {
+                adjoints = instruments[k]->result<std::map<Date, Real> >(
+                                                          "discountAdjoints");
+            } catch (std::exception& e) {
+                QL_FAIL("discount adjoints not available for the "
+                        << io::ordinal(k+1) << " instrument: " << e.what());
+            }
+            for (const auto& a : adjoints)
+                discountAdjoints[a.first] += quantity*a.second;
+        }
+        if (discountAdjoints.empty())
+            return result;
+
+        // ...with respect to the curve nodes...
+        std::vector<Date> dates;
+        Array adjoints(discountAdjoints.size());
+        dates.reserve(discountAdjoints.size());
+        for (const auto& a : discountAdjoints) {
+            adjoints[dates.size()] = a.second;
+            dates.push_back(a.first);
+        }
+        Array g = adjoints * curve->discountJacobian(dates);
+
+        // ...and to the quotes of the alive helpers
+        const Matrix& jacobian = curve->jacobian();
+        Size n = jacobian.rows();
+        QL_REQUIRE(jacobian.columns() == n && g.size() == n,
+                   "Jacobian size (" << jacobian.rows() << "x"
+                   << jacobian.columns() << ") doesn't match the number "
+                   "of curve nodes (" << g.size() << ")");
+        Array lambda = qrSolve(transpose(jacobian), g);
+
+        typedef typename Curve::traits_type::helper helper;
+        const std::vector<std::shared_ptr<helper> >& helpers =
+                                                        curve->instruments();
+        Size firstAliveHelper = helpers.size() - n;
+        for (Size j=0; j<quotes.size(); ++j) {
+            const Quote* q = quotes[j].currentLink().get();
+            for (Size i=0; i<n; ++i) {
+                if (helpers[firstAliveHelper+i]->quote().currentLink().get()
+                    == q) {
+                    result[j] = lambda[i];
+                    break;
+                }
+            }
+        }
+        return result;
+    }
+
+}
+
+#endif
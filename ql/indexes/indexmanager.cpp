@@ -30,7 +30,14 @@ namespace QuantLib {
 
     const TimeSeries<Real>&
     IndexManager::getHistory(const string& name) const {
-        return data_[to_upper_copy(name)].value();
+        // a missing history is not added, so that histories can be
+        // read from several threads at the same time
+        history_map::const_iterator i = data_.find(to_upper_copy(name));
+        if (i == data_.end()) {
+            static const TimeSeries<Real> empty;
+            return empty;
+        }
+        return i->second.value();
     }
 
     void IndexManager::setHistory(const string& name,
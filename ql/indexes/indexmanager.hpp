@@ -40,7 +40,9 @@ namespace QuantLib {
       public:
         //! returns whether historical fixings were stored for the index
         bool hasHistory(const std::string& name) const;
-        //! returns the (possibly empty) history of the index fixings
+        /*! returns the (possibly empty) history of the index fixings;
+            if no history was stored, none is added.
+        */
         const TimeSeries<Real>& getHistory(const std::string& name) const;
         //! stores the historical fixings of the index
         void setHistory(const std::string& name, const TimeSeries<Real>&);
@@ -0,0 +1,225 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/instruments/portfoliovaluation.hpp>
+#include <ql/utilities/null.hpp>
+#include <ql/cashflows/floatingratecoupon.hpp>
+#include <ql/indexes/iborindex.hpp>
+#include <ql/instruments/bond.hpp>
+#include <ql/instruments/swap.hpp>
+#include <ql/utilities/parallelfor.hpp>
+#include <algorithm>
+#include <mutex>
+#include <unordered_map>
+
+namespace QuantLib {
+
+    namespace {
+
+        // same steps as Instrument::calculate, without storing
+        // anything in the instrument
+        Real value(const Instrument& instrument, PricingEngine& engine) {
+            if (instrument.isExpired())
+                return 0.0;
+            engine.reset();
+            instrument.setupArguments(engine.getArguments());
+            engine.getArguments()->validate();
+            engine.calculate();
+            const Instrument::results* results =
+                dynamic_cast<const Instrument::results*>(
+                                                    engine.getResults());
+            QL_ENSURE(results != nullptr,
+                      "no results returned from pricing engine");
+            QL_REQUIRE(results->value != Null<Real>(),
+                       "NPV not provided");
+            return results->value;
+        }
+
+        std::vector<const Leg*> legs(const Instrument& instrument) {
+            std::vector<const Leg*> result;
+            if (const Swap* swap = dynamic_cast<const Swap*>(&instrument)) {
+                for (Size j=0; j<swap->numberOfLegs(); ++j)
+                    result.push_back(&swap->leg(j));
+            } else if (const Bond* bond =
+                                   dynamic_cast<const Bond*>(&instrument)) {
+                result.push_back(&bond->cashflows());
+            }
+            return result;
+        }
+
+    }
+
+    PortfolioValuation::PortfolioValuation(Size threads,
+                                           Size instrumentsPerTask)
+    : threads_(threads), instrumentsPerTask_(instrumentsPerTask) {
+        QL_REQUIRE(instrumentsPerTask > 0,
+                   "the number of instruments per task must be positive");
+    }
+
+    void PortfolioValuation::addDependency(
+                               const std::shared_ptr<LazyObject>& object) {
+        QL_REQUIRE(object, "null dependency");
+        dependencies_.push_back(object);
+    }
+
+    void PortfolioValuation::add(
+                const std::vector<std::shared_ptr<Instrument> >& instruments,
+                const engine_factory& factory) {
+        for (Size i=0; i<instruments.size(); ++i)
+            QL_REQUIRE(instruments[i], "null instrument");
+        factories_.push_back(factory);
+        instruments_.insert(instruments_.end(),
+                            instruments.begin(), instruments.end());
+        groups_.resize(instruments_.size(), factories_.size()-1);
+    }
+
+    void PortfolioValuation::add(
+               const std::vector<std::shared_ptr<Instrument> >& instruments) {
+        add(instruments, engine_factory());
+    }
+
+    std::vector<Real> PortfolioValuation::NPV() const {
+        for (Size i=0; i<dependencies_.size(); ++i)
+            dependencies_[i]->calculateIfNeeded();
+
+        Size n = instruments_.size();
+        std::vector<Real> npv(n);
+
+        // Coupon pricers store the coupon being priced, so that
+        // instruments sharing a pricer can't be priced concurrently;
+        // the index curves used by the coupons are calculated here.
+        const Size shared = Null<Size>();
+        std::unordered_map<const FloatingRateCouponPricer*, Size> owners;
+        std::vector<std::vector<const FloatingRateCouponPricer*> >
+                                                               pricers(n);
+        for (Size i=0; i<n; ++i) {
+            if (!factories_[groups_[i]])
+                continue;
+            for (const Leg* leg : legs(*instruments_[i])) {
+                for (const auto& cashflow : *leg) {
+                    auto coupon =
+                        std::dynamic_pointer_cast<FloatingRateCoupon>(
+                                                                 cashflow);
+                    if (!coupon)
+                        continue;
+                    auto index = std::dynamic_pointer_cast<IborIndex>(
+                                                            coupon->index());
+                    if (index) {
+                        auto curve = std::dynamic_pointer_cast<LazyObject>(
+                            index->forwardingTermStructure().currentLink());
+                        if (curve)
+                            curve->calculateIfNeeded();
+                    }
+                    const FloatingRateCouponPricer* pricer =
+                        coupon->pricer().get();
+                    if (pricer == nullptr
+                        || std::find(pricers[i].begin(), pricers[i].end(),
+                                     pricer) != pricers[i].end())
+                        continue;
+                    pricers[i].push_back(pricer);
+                    auto owner = owners.emplace(pricer, i);
+                    if (!owner.second)
+                        owner.first->second = shared;
+                }
+            }
+        }
+        std::vector<bool> serial(n, false);
+        for (Size i=0; i<n; ++i) {
+            for (const FloatingRateCouponPricer* pricer : pricers[i])
+                if (owners[pricer] == shared)
+                    serial[i] = true;
+        }
+
+        // instruments without factory are priced on this thread;
+        // the first instrument of each of the other groups is also
+        // priced here so that the lazy objects it uses are calculated,
+        // and so are the instruments sharing coupon pricers
+        std::vector<Size> parallel, serialized,
+                          first(factories_.size(), Null<Size>());
+        parallel.reserve(n);
+        for (Size i=0; i<n; ++i) {
+            Size g = groups_[i];
+            if (!factories_[g])
+                npv[i] = instruments_[i]->NPV();
+            else if (first[g] == Null<Size>())
+                first[g] = i;
+            else if (serial[i])
+                serialized.push_back(i);
+            else
+                parallel.push_back(i);
+        }
+
+        Size tasks =
+            (parallel.size() + instrumentsPerTask_ - 1)/instrumentsPerTask_;
+        Size workers = std::max<Size>(std::min(threads_, tasks), 1);
+
+        // engines register with their observables when created, which
+        // is not thread-safe; they're all created upfront
+        std::vector<std::vector<std::shared_ptr<PricingEngine> > >
+            engines(workers,
+                    std::vector<std::shared_ptr<PricingEngine> >(
+                                                      factories_.size()));
+        for (Size g=0; g<factories_.size(); ++g) {
+            if (first[g] == Null<Size>())
+                continue;
+            for (Size w=0; w<workers; ++w) {
+                engines[w][g] = factories_[g]();
+                QL_REQUIRE(engines[w][g],
+                           "null pricing engine returned by factory");
+            }
+            npv[first[g]] = value(*instruments_[first[g]], *engines[0][g]);
+        }
+        for (Size k=0; k<serialized.size(); ++k) {
+            Size i = serialized[k];
+            npv[i] = value(*instruments_[i], *engines[0][groups_[i]]);
+        }
+
+        // each task borrows the engines of a free worker; at most
+        // as many tasks as workers run at the same time
+        std::vector<Size> freeWorkers;
+        for (Size w=0; w<workers; ++w)
+            freeWorkers.push_back(workers-1-w);
+        std::mutex mutex;
+
+        parallelFor(tasks, workers, [&](Size task) {
+            Size worker;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                worker = freeWorkers.back();
+                freeWorkers.pop_back();
+            }
+            try {
+                Size end = std::min((task+1)*instrumentsPerTask_,
+                                    parallel.size());
+                for (Size k=task*instrumentsPerTask_; k<end; ++k) {
+                    Size i = parallel[k];
+                    npv[i] = value(*instruments_[i],
+                                   *engines[worker][groups_[i]]);
+                }
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mutex);
+                freeWorkers.push_back(worker);
+                throw;
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            freeWorkers.push_back(worker);
+        });
+
+        return npv;
+    }
+
+}
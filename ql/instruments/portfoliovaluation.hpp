@@ -0,0 +1,104 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file portfoliovaluation.hpp
+    \brief valuation of a set of instruments on several threads
+*/
+
+#ifndef quantlib_portfolio_valuation_hpp
+#define quantlib_portfolio_valuation_hpp
+
+#include <ql/instrument.hpp>
+#include <functional>
+#include <vector>
+
+namespace QuantLib {
+
+    //! Valuation of a set of instruments on several threads
+    /*! Lazy objects are not thread-safe, and neither are pricing
+        engines, which store the arguments and results of the
+        instrument being priced.  Therefore, the valuation proceeds
+        as follows:
+        - the lazy objects added as dependencies (e.g., bootstrapped
+          curves or volatility cubes shared by the instruments) are
+          calculated on the calling thread;
+        - for each group of instruments added with an engine factory,
+          the factory is called on the calling thread to create a
+          separate engine for each worker thread;
+        - the first instrument of each group is priced on the calling
+          thread, so that any lazy object not declared as a
+          dependency but shared by the group is calculated;
+        - the coupons of swaps and bonds are inspected: the
+          forecasting curves of their indexes are calculated on the
+          calling thread, and the instruments whose coupon pricers
+          are shared with other instruments are priced there too,
+          since the pricers store the coupon being priced;
+        - the instruments are split in tasks, which are handed out to
+          the worker threads as soon as they are free.  Each
+          instrument is priced by the engine of its worker; the
+          results are returned without being stored in the
+          instrument, whose state is not modified.
+
+        Instruments added without an engine factory are priced on the
+        calling thread by their own engine.
+
+        \warning objects shared by the instruments must be safe to
+                 use concurrently once calculated.  Apart from the
+                 coupon pricers and index curves of swaps and bonds,
+                 which are handled as described above, this is not
+                 checked; instruments sharing other stateful objects
+                 (e.g., lazy objects used by coupon pricers, such as
+                 volatility cubes) must have them declared as
+                 dependencies or be added without an engine factory.
+                 Also, no observable should be modified while the
+                 valuation is running.
+    */
+    class PortfolioValuation {
+      public:
+        typedef std::function<std::shared_ptr<PricingEngine>()>
+                                                         engine_factory;
+        PortfolioValuation(Size threads, Size instrumentsPerTask = 64);
+        //! \name Portfolio construction
+        //@{
+        //! adds a lazy object to be calculated before the instruments
+        void addDependency(const std::shared_ptr<LazyObject>&);
+        //! adds instruments to be priced by engines built by the factory
+        void add(const std::vector<std::shared_ptr<Instrument> >&,
+                 const engine_factory&);
+        //! adds instruments to be priced by their own engines
+        void add(const std::vector<std::shared_ptr<Instrument> >&);
+        //@}
+        //! \name Results
+        //@{
+        //! number of instruments
+        Size size() const { return instruments_.size(); }
+        //! NPVs of the instruments, in the order they were added
+        std::vector<Real> NPV() const;
+        //@}
+      private:
+        Size threads_, instrumentsPerTask_;
+        std::vector<std::shared_ptr<LazyObject> > dependencies_;
+        std::vector<std::shared_ptr<Instrument> > instruments_;
+        // for each instrument, the index of its engine factory
+        std::vector<Size> groups_;
+        std::vector<engine_factory> factories_;
+    };
+
+}
+
+
+#endif
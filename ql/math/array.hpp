@@ -36,6 +36,7 @@
 #include <functional>
 #include <numeric>
 #include <iomanip>
+#include <utility>
 
 namespace QuantLib {
 
@@ -45,6 +46,11 @@ namespace QuantLib {
         As such, it is <b>not</b> meant to be used as a container -
         <tt>std::vector</tt> should be used instead.
 
+        Arithmetic operators and functions taking a temporary array
+        store their result in it instead of allocating a new one;
+        therefore, an expression such as <tt>a*b + c</tt> allocates a
+        single array.
+
         \test construction of arrays is checked in a number of cases
     */
     class Array {
@@ -163,6 +169,12 @@ namespace QuantLib {
         //@}
         //! \name Utilities
         //@{
+        /*! changes the size of the array, keeping the existing
+            elements; new elements are set to zero.  Shrinking the
+            array doesn't release its storage, so that it can be
+            reused as a buffer of varying size.
+        */
+        void resize(Size n);
         void swap(Array &) noexcept;  // never throws
         //@}
 
@@ -187,62 +199,143 @@ namespace QuantLib {
     /*! \relates Array */
     Array operator+(const Array &v);
 
+    /*! \relates Array */
+    Array operator+(Array &&v);
+
     /*! \relates Array */
     Array operator-(const Array &v);
 
+    /*! \relates Array */
+    Array operator-(Array &&v);
+
     // binary operators
     /*! \relates Array */
     Array operator+(const Array &, const Array &);
 
+    /*! \relates Array */
+    Array operator+(const Array &, Array &&);
+
+    /*! \relates Array */
+    Array operator+(Array &&, const Array &);
+
+    /*! \relates Array */
+    Array operator+(Array &&, Array &&);
+
     /*! \relates Array */
     Array operator+(const Array &, Real);
 
+    /*! \relates Array */
+    Array operator+(Array &&, Real);
+
     /*! \relates Array */
     Array operator+(Real, const Array &);
 
+    /*! \relates Array */
+    Array operator+(Real, Array &&);
+
     /*! \relates Array */
     Array operator-(const Array &, const Array &);
 
+    /*! \relates Array */
+    Array operator-(const Array &, Array &&);
+
+    /*! \relates Array */
+    Array operator-(Array &&, const Array &);
+
+    /*! \relates Array */
+    Array operator-(Array &&, Array &&);
+
     /*! \relates Array */
     Array operator-(const Array &, Real);
 
+    /*! \relates Array */
+    Array operator-(Array &&, Real);
+
     /*! \relates Array */
     Array operator-(Real, const Array &);
 
+    /*! \relates Array */
+    Array operator-(Real, Array &&);
+
     /*! \relates Array */
     Array operator*(const Array &, const Array &);
 
+    /*! \relates Array */
+    Array operator*(const Array &, Array &&);
+
+    /*! \relates Array */
+    Array operator*(Array &&, const Array &);
+
+    /*! \relates Array */
+    Array operator*(Array &&, Array &&);
+
     /*! \relates Array */
     Array operator*(const Array &, Real);
 
+    /*! \relates Array */
+    Array operator*(Array &&, Real);
+
     /*! \relates Array */
     Array operator*(Real, const Array &);
 
+    /*! \relates Array */
+    Array operator*(Real, Array &&);
+
     /*! \relates Array */
     Array operator/(const Array &, const Array &);
 
+    /*! \relates Array */
+    Array operator/(const Array &, Array &&);
+
+    /*! \relates Array */
+    Array operator/(Array &&, const Array &);
+
+    /*! \relates Array */
+    Array operator/(Array &&, Array &&);
+
     /*! \relates Array */
     Array operator/(const Array &, Real);
 
+    /*! \relates Array */
+    Array operator/(Array &&, Real);
+
     /*! \relates Array */
     Array operator/(Real, const Array &);
 
+    /*! \relates Array */
+    Array operator/(Real, Array &&);
+
     // math functions
     /*! \relates Array */
     Array Abs(const Array &);
 
+    /*! \relates Array */
+    Array Abs(Array &&);
+
     /*! \relates Array */
     Array Sqrt(const Array &);
 
+    /*! \relates Array */
+    Array Sqrt(Array &&);
+
     /*! \relates Array */
     Array Log(const Array &);
 
+    /*! \relates Array */
+    Array Log(Array &&);
+
     /*! \relates Array */
     Array Exp(const Array &);
 
+    /*! \relates Array */
+    Array Exp(Array &&);
+
     /*! \relates Array */
     Array Pow(const Array &, Real);
 
+    /*! \relates Array */
+    Array Pow(Array &&, Real);
+
     // utilities
     /*! \relates Array */
     void swap(Array &, Array &) noexcept;
@@ -340,7 +433,7 @@ namespace QuantLib {
                    "arrays with different sizes (" << data_.size() << ", "
                                                    << v.data_.size() << ") cannot be subtracted");
         std::transform(begin(), end(), v.begin(), begin(),
-                       [](Real i, Real j) { return i + j; });
+                       [](Real i, Real j) { return i - j; });
         return *this;
     }
 
@@ -487,6 +580,10 @@ namespace QuantLib {
         return data_.rend();
     }
 
+    inline void Array::resize(Size n) {
+        data_.resize(n, 0.0);
+    }
+
     inline void Array::swap(Array &from) noexcept {
         using std::swap;
         data_.swap(from.data_);
@@ -510,6 +607,10 @@ namespace QuantLib {
         return result;
     }
 
+    inline Array operator+(Array &&v) {
+        return std::move(v);
+    }
+
     inline Array operator-(const Array &v) {
         Array result(v.size());
         std::transform(v.begin(), v.end(), result.begin(),
@@ -517,6 +618,12 @@ namespace QuantLib {
         return result;
     }
 
+    inline Array operator-(Array &&v) {
+        std::transform(v.begin(), v.end(), v.begin(),
+                       [](Real i) { return -i; });
+        return std::move(v);
+    }
+
 
     // binary operators
 
@@ -531,6 +638,28 @@ namespace QuantLib {
         return result;
     }
 
+    inline Array operator+(const Array &v1, Array &&v2) {
+        QL_REQUIRE(v1.size() == v2.size(),
+                   "arrays with different sizes (" << v1.size() << ", "
+                                                   << v2.size() << ") cannot be added");
+        std::transform(v1.begin(), v1.end(), v2.begin(), v2.begin(),
+                       [](Real i, Real j) { return i + j; });
+        return std::move(v2);
+    }
+
+    inline Array operator+(Array &&v1, const Array &v2) {
+        QL_REQUIRE(v1.size() == v2.size(),
+                   "arrays with different sizes (" << v1.size() << ", "
+                                                   << v2.size() << ") cannot be added");
+        std::transform(v1.begin(), v1.end(), v2.begin(), v1.begin(),
+                       [](Real i, Real j) { return i + j; });
+        return std::move(v1);
+    }
+
+    inline Array operator+(Array &&v1, Array &&v2) {
+        return std::move(v1) + v2;
+    }
+
     inline Array operator+(const Array &v1, Real a) {
         Array result(v1.size());
         std::transform(v1.begin(), v1.end(), result.begin(),
@@ -538,6 +667,10 @@ namespace QuantLib {
         return result;
     }
 
+    inline Array operator+(Array &&v1, Real a) {
+        return std::move(v1 += a);
+    }
+
     inline Array operator+(Real a, const Array &v2) {
         Array result(v2.size());
         std::transform(v2.begin(), v2.end(), result.begin(),
@@ -545,6 +678,12 @@ namespace QuantLib {
         return result;
     }
 
+    inline Array operator+(Real a, Array &&v2) {
+        std::transform(v2.begin(), v2.end(), v2.begin(),
+                       [a](Real i) { return i + a; });
+        return std::move(v2);
+    }
+
     inline Array operator-(const Array &v1,
                                              const Array &v2) {
         QL_REQUIRE(v1.size() == v2.size(),
@@ -556,6 +695,28 @@ namespace QuantLib {
         return result;
     }
 
+    inline Array operator-(const Array &v1, Array &&v2) {
+        QL_REQUIRE(v1.size() == v2.size(),
+                   "arrays with different sizes (" << v1.size() << ", "
+                                                   << v2.size() << ") cannot be subtracted");
+        std::transform(v1.begin(), v1.end(), v2.begin(), v2.begin(),
+                       [](Real i, Real j) { return i - j; });
+        return std::move(v2);
+    }
+
+    inline Array operator-(Array &&v1, const Array &v2) {
+        QL_REQUIRE(v1.size() == v2.size(),
+                   "arrays with different sizes (" << v1.size() << ", "
+                                                   << v2.size() << ") cannot be subtracted");
+        std::transform(v1.begin(), v1.end(), v2.begin(), v1.begin(),
+                       [](Real i, Real j) { return i - j; });
+        return std::move(v1);
+    }
+
+    inline Array operator-(Array &&v1, Array &&v2) {
+        return std::move(v1) - v2;
+    }
+
     inline Array operator-(const Array &v1, Real a) {
         Array result(v1.size());
         std::transform(v1.begin(), v1.end(), result.begin(),
@@ -563,6 +724,10 @@ namespace QuantLib {
         return result;
     }
 
+    inline Array operator-(Array &&v1, Real a) {
+        return std::move(v1 -= a);
+    }
+
     inline Array operator-(Real a, const Array &v2) {
         Array result(v2.size());
         std::transform(v2.begin(), v2.end(), result.begin(),
@@ -570,6 +735,12 @@ namespace QuantLib {
         return result;
     }
 
+    inline Array operator-(Real a, Array &&v2) {
+        std::transform(v2.begin(), v2.end(), v2.begin(),
+                       [a](Real i) { return a - i; });
+        return std::move(v2);
+    }
+
     inline Array operator*(const Array &v1,
                                              const Array &v2) {
         QL_REQUIRE(v1.size() == v2.size(),
@@ -581,6 +752,28 @@ namespace QuantLib {
         return result;
     }
 
+    inline Array operator*(const Array &v1, Array &&v2) {
+        QL_REQUIRE(v1.size() == v2.size(),
+                   "arrays with different sizes (" << v1.size() << ", "
+                                                   << v2.size() << ") cannot be multiplied");
+        std::transform(v1.begin(), v1.end(), v2.begin(), v2.begin(),
+                       [](Real i, Real j) { return i * j; });
+        return std::move(v2);
+    }
+
+    inline Array operator*(Array &&v1, const Array &v2) {
+        QL_REQUIRE(v1.size() == v2.size(),
+                   "arrays with different sizes (" << v1.size() << ", "
+                                                   << v2.size() << ") cannot be multiplied");
+        std::transform(v1.begin(), v1.end(), v2.begin(), v1.begin(),
+                       [](Real i, Real j) { return i * j; });
+        return std::move(v1);
+    }
+
+    inline Array operator*(Array &&v1, Array &&v2) {
+        return std::move(v1) * v2;
+    }
+
     inline Array operator*(const Array &v1, Real a) {
         Array result(v1.size());
         std::transform(v1.begin(), v1.end(), result.begin(),
@@ -588,6 +781,10 @@ namespace QuantLib {
         return result;
     }
 
+    inline Array operator*(Array &&v1, Real a) {
+        return std::move(v1 *= a);
+    }
+
     inline Array operator*(Real a, const Array &v2) {
         Array result(v2.size());
         std::transform(v2.begin(), v2.end(), result.begin(),
@@ -595,6 +792,12 @@ namespace QuantLib {
         return result;
     }
 
+    inline Array operator*(Real a, Array &&v2) {
+        std::transform(v2.begin(), v2.end(), v2.begin(),
+                       [a](Real i) { return i * a; });
+        return std::move(v2);
+    }
+
     inline Array operator/(const Array &v1,
                                              const Array &v2) {
         QL_REQUIRE(v1.size() == v2.size(),
@@ -606,6 +809,28 @@ namespace QuantLib {
         return result;
     }
 
+    inline Array operator/(const Array &v1, Array &&v2) {
+        QL_REQUIRE(v1.size() == v2.size(),
+                   "arrays with different sizes (" << v1.size() << ", "
+                                                   << v2.size() << ") cannot be divided");
+        std::transform(v1.begin(), v1.end(), v2.begin(), v2.begin(),
+                       [](Real i, Real j) { return i / j; });
+        return std::move(v2);
+    }
+
+    inline Array operator/(Array &&v1, const Array &v2) {
+        QL_REQUIRE(v1.size() == v2.size(),
+                   "arrays with different sizes (" << v1.size() << ", "
+                                                   << v2.size() << ") cannot be divided");
+        std::transform(v1.begin(), v1.end(), v2.begin(), v1.begin(),
+                       [](Real i, Real j) { return i / j; });
+        return std::move(v1);
+    }
+
+    inline Array operator/(Array &&v1, Array &&v2) {
+        return std::move(v1) / v2;
+    }
+
     inline Array operator/(const Array &v1, Real a) {
         Array result(v1.size());
         std::transform(v1.begin(), v1.end(), result.begin(),
@@ -613,6 +838,10 @@ namespace QuantLib {
         return result;
     }
 
+    inline Array operator/(Array &&v1, Real a) {
+        return std::move(v1 /= a);
+    }
+
     inline Array operator/(Real a, const Array &v2) {
         Array result(v2.size());
         std::transform(v2.begin(), v2.end(), result.begin(),
@@ -620,6 +849,12 @@ namespace QuantLib {
         return result;
     }
 
+    inline Array operator/(Real a, Array &&v2) {
+        std::transform(v2.begin(), v2.end(), v2.begin(),
+                       [a](Real i) { return a / i; });
+        return std::move(v2);
+    }
+
     // functions
 
     inline Array Abs(const Array &v) {
@@ -629,6 +864,12 @@ namespace QuantLib {
         return result;
     }
 
+    inline Array Abs(Array &&v) {
+        std::transform(v.begin(), v.end(), v.begin(),
+                       [](Real i) { return std::fabs(i); });
+        return std::move(v);
+    }
+
     inline Array Sqrt(const Array &v) {
         Array result(v.size());
         std::transform(v.begin(), v.end(), result.begin(),
@@ -636,6 +877,12 @@ namespace QuantLib {
         return result;
     }
 
+    inline Array Sqrt(Array &&v) {
+        std::transform(v.begin(), v.end(), v.begin(),
+                       [](Real i) { return std::sqrt(i); });
+        return std::move(v);
+    }
+
     inline Array Log(const Array &v) {
         Array result(v.size());
         std::transform(v.begin(), v.end(), result.begin(),
@@ -643,6 +890,12 @@ namespace QuantLib {
         return result;
     }
 
+    inline Array Log(Array &&v) {
+        std::transform(v.begin(), v.end(), v.begin(),
+                       [](Real i) { return std::log(i); });
+        return std::move(v);
+    }
+
     inline Array Exp(const Array &v) {
         Array result(v.size());
         std::transform(v.begin(), v.end(), result.begin(),
@@ -650,6 +903,12 @@ namespace QuantLib {
         return result;
     }
 
+    inline Array Exp(Array &&v) {
+        std::transform(v.begin(), v.end(), v.begin(),
+                       [](Real i) { return std::exp(i); });
+        return std::move(v);
+    }
+
     inline Array Pow(const Array &v, Real alpha) {
         Array result(v.size());
         std::transform(v.begin(), v.end(), result.begin(),
@@ -658,6 +917,12 @@ namespace QuantLib {
         return result;
     }
 
+    inline Array Pow(Array &&v, Real alpha) {
+        std::transform(v.begin(), v.end(), v.begin(),
+                       [alpha](Real i) { return std::pow(i, alpha); });
+        return std::move(v);
+    }
+
 
     inline void swap(Array &v, Array &w) noexcept {
         v.swap(w);
@@ -20,6 +20,7 @@
  FOR A PARTICULAR PURPOSE.  See the license for more details.
 */
 
+#include <algorithm>
 #include <array>
 #include <ql/math/distributions/normaldistribution.hpp>
 #include <ql/math/comparison.hpp>
@@ -57,6 +58,15 @@ namespace QuantLib {
         return result;
     }
 
+    void CumulativeNormalDistribution::operator()(const Real* x, Real* y,
+                                                  Size n) const {
+        const Real average = average_, sigma = sigma_;
+        // erfc keeps the relative accuracy in the left tail, where
+        // 1+erf would cancel out in double precision
+        for (Size i=0; i<n; ++i)
+            y[i] = 0.5 * std::erfc(-(x[i] - average) / sigma * M_SQRT1_2);
+    }
+
     const CumulativeNormalDistribution InverseCumulativeNormal::f_;
 
     // Coefficients for the rational approximation.
@@ -118,6 +128,39 @@ namespace QuantLib {
         return z;
     }
 
+    void InverseCumulativeNormal::operator()(const Real* x, Real* y,
+                                             Size n) const {
+        const Real a1 = a1_, a2 = a2_, a3 = a3_, a4 = a4_, a5 = a5_, a6 = a6_;
+        const Real b1 = b1_, b2 = b2_, b3 = b3_, b4 = b4_, b5 = b5_;
+        const Real xLow = x_low_, xHigh = x_high_;
+        const Real average = average_, sigma = sigma_;
+
+        // points are processed in chunks, whose input is copied so
+        // that it's still available for the tails if y overwrites x
+        const Size chunkSize = 64;
+        Real chunk[chunkSize];
+        for (Size begin=0; begin<n; begin+=chunkSize) {
+            Size m = std::min(chunkSize, n-begin);
+            std::copy(x+begin, x+begin+m, chunk);
+            Real* result = y+begin;
+            for (Size i=0; i<m; ++i) {
+                Real z = chunk[i] - 0.5;
+                Real r = z * z;
+                result[i] =
+                    (((((a1 * r + a2) * r + a3) * r + a4) * r + a5) * r + a6) * z /
+                    (((((b1 * r + b2) * r + b3) * r + b4) * r + b5) * r + 1.0);
+            }
+            for (Size i=0; i<m; ++i) {
+                if (chunk[i] < xLow || xHigh < chunk[i])
+                    result[i] = tail_value(chunk[i]);
+            }
+            if (average != 0.0 || sigma != 1.0) {
+                for (Size i=0; i<m; ++i)
+                    result[i] = average + sigma * result[i];
+            }
+        }
+    }
+
     const long double MoroInverseCumulativeNormal::a0_ =  2.50662823884;
     const long double MoroInverseCumulativeNormal::a1_ =-18.61500062529;
     const long double MoroInverseCumulativeNormal::a2_ = 41.39119773534;
@@ -29,6 +29,7 @@
 #include <functional>
 #include <ql/math/errorfunction.hpp>
 #include <ql/errors.hpp>
+#include <ql/types.hpp>
 #include <random>
 
 namespace QuantLib {
@@ -82,6 +83,12 @@ namespace QuantLib {
 
         // function
         long double operator()(long double x) const;
+        //! values at the n points in x, written to y
+        /*! The calculation is performed in double precision, which
+            makes it a lot faster than calling the single-point
+            version in a loop; x and y can be the same array.
+        */
+        void operator()(const Real* x, Real* y, Size n) const;
 
         long double derivative(long double x) const;
 
@@ -119,6 +126,14 @@ namespace QuantLib {
         long double operator()(long double x) const {
             return average_ + sigma_ * standard_value(x);
         }
+        //! values at the n points in x, written to y
+        /*! The rational approximation for the central region is
+            evaluated in double precision for all points in a loop
+            that the compiler can vectorize, and the few points in the
+            tails are corrected afterwards; x and y can be the same
+            array.
+        */
+        void operator()(const Real* x, Real* y, Size n) const;
         // value for average=0, sigma=1
         /* Compared to operator(), this method avoids 2 floating point
            operations (we use average=0 and sigma=1 most of the
@@ -0,0 +1,121 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/math/incrementallinearleastsquares.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace QuantLib {
+
+    IncrementalLinearLeastSquares::IncrementalLinearLeastSquares(
+                                                            Size dimension)
+    : dimension_(dimension), size_(0),
+      r_(dimension, dimension, 0.0), qty_(dimension, 0.0), rss_(0.0),
+      buffer_(dimension) {}
+
+    void IncrementalLinearLeastSquares::add(const Real* x, Real y) {
+        std::copy(x, x+dimension_, buffer_.begin());
+        rotate(buffer_.begin(), y);
+        ++size_;
+    }
+
+    void IncrementalLinearLeastSquares::add(const Array& x, Real y) {
+        QL_REQUIRE(x.size() == dimension_,
+                   "wrong number of regressors (" << x.size()
+                   << " given, " << dimension_ << " required)");
+        std::copy(x.begin(), x.end(), buffer_.begin());
+        rotate(buffer_.begin(), y);
+        ++size_;
+    }
+
+    void IncrementalLinearLeastSquares::merge(
+                               const IncrementalLinearLeastSquares& other) {
+        QL_REQUIRE(other.dimension_ == dimension_,
+                   "mismatch between regression dimensions");
+        // the rows of the other factor are observations whose
+        // residuals were already accounted for
+        for (Size k=0; k<dimension_; ++k) {
+            std::copy(other.r_.row_begin(k), other.r_.row_end(k),
+                      buffer_.begin());
+            rotate(buffer_.begin(), other.qty_[k]);
+        }
+        rss_ += other.rss_;
+        size_ += other.size_;
+    }
+
+    void IncrementalLinearLeastSquares::reset() {
+        std::fill(r_.begin(), r_.end(), 0.0);
+        std::fill(qty_.begin(), qty_.end(), 0.0);
+        rss_ = 0.0;
+        size_ = 0;
+    }
+
+    void IncrementalLinearLeastSquares::rotate(Array::iterator x, Real y) {
+        for (Size k=0; k<dimension_; ++k) {
+            if (x[k] == 0.0)
+                continue;
+            Matrix::row_iterator r = r_.row_begin(k);
+            const Real h = std::hypot(r[k], x[k]);
+            const Real c = r[k]/h, s = x[k]/h;
+            r[k] = h;
+            for (Size j=k+1; j<dimension_; ++j) {
+                const Real t = r[j];
+                r[j] = c*t + s*x[j];
+                x[j] = c*x[j] - s*t;
+            }
+            const Real t = qty_[k];
+            qty_[k] = c*t + s*y;
+            y = c*y - s*t;
+        }
+        rss_ += y*y;
+    }
+
+    Real IncrementalLinearLeastSquares::threshold() const {
+        Real maxDiagonal = 0.0;
+        for (Size k=0; k<dimension_; ++k)
+            maxDiagonal = std::max(maxDiagonal, std::fabs(r_[k][k]));
+        return std::max(size_, dimension_) * QL_EPSILON * maxDiagonal;
+    }
+
+    Array IncrementalLinearLeastSquares::coefficients() const {
+        const Real tolerance = threshold();
+        Array a(dimension_, 0.0);
+        for (Size k=dimension_; k>0; --k) {
+            const Size i = k-1;
+            if (std::fabs(r_[i][i]) <= tolerance)
+                continue;
+            Real sum = qty_[i];
+            for (Size j=i+1; j<dimension_; ++j)
+                sum -= r_[i][j]*a[j];
+            a[i] = sum/r_[i][i];
+        }
+        return a;
+    }
+
+    Real IncrementalLinearLeastSquares::residualSumOfSquares() const {
+        // the fit doesn't explain the components along the
+        // dependent regressors
+        const Real tolerance = threshold();
+        Real rss = rss_;
+        for (Size k=0; k<dimension_; ++k) {
+            if (std::fabs(r_[k][k]) <= tolerance)
+                rss += qty_[k]*qty_[k];
+        }
+        return rss;
+    }
+
+}
@@ -0,0 +1,84 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file incrementallinearleastsquares.hpp
+    \brief linear least squares accumulated one observation at a time
+*/
+
+#ifndef quantlib_incremental_linear_least_squares_hpp
+#define quantlib_incremental_linear_least_squares_hpp
+
+#include <ql/math/matrix.hpp>
+
+namespace QuantLib {
+
+    //! linear least squares accumulated one observation at a time
+    /*! The observations are not stored; instead, each of them is
+        folded by Givens rotations into the triangular factor \f$ R \f$
+        of the QR decomposition of the design matrix, together with
+        the corresponding rotated values \f$ Q^T y \f$.  Memory usage
+        is therefore quadratic in the number of regressors and
+        independent of the number of observations, and the solution
+        doesn't suffer from the loss of accuracy of the normal
+        equations.
+
+        Instances accumulating disjoint sets of observations (e.g., on
+        different threads) can be merged; the result only depends on
+        the order of the merges.
+
+        Regressors whose contribution is numerically dependent on the
+        previous ones are given a null coefficient.
+
+        \test the results are tested against those of
+              GeneralLinearLeastSquares.
+    */
+    class IncrementalLinearLeastSquares {
+      public:
+        explicit IncrementalLinearLeastSquares(Size dimension = 0);
+        //! \name modifiers
+        //@{
+        //! adds the observation \f$ y \f$ with regressors x[0]...x[dimension()-1]
+        void add(const Real* x, Real y);
+        void add(const Array& x, Real y);
+        //! adds the observations accumulated by another instance
+        void merge(const IncrementalLinearLeastSquares& other);
+        void reset();
+        //@}
+        //! \name inspectors
+        //@{
+        //! number of regressors
+        Size dimension() const { return dimension_; }
+        //! number of observations
+        Size size() const { return size_; }
+        Array coefficients() const;
+        //! sum of the squared residuals of the fit
+        Real residualSumOfSquares() const;
+        //@}
+      private:
+        void rotate(Array::iterator x, Real y);
+        Real threshold() const;
+        Size dimension_, size_;
+        Matrix r_;
+        Array qty_;
+        Real rss_;
+        mutable Array buffer_;
+    };
+
+}
+
+
+#endif
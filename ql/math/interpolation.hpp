@@ -46,6 +46,11 @@ namespace QuantLib {
           public:
             virtual ~Impl() {}
             virtual void update() = 0;
+            /*! Called when only the y values from the given index
+                on were changed; local interpolations can override it
+                so that the unchanged segments are not recalculated.
+            */
+            virtual void updateFrom(Size) { update(); }
             virtual Real xMin() const = 0;
             virtual Real xMax() const = 0;
             virtual std::vector<Real> xValues() const = 0;
@@ -140,6 +145,10 @@ namespace QuantLib {
         void update() {
             impl_->update();
         }
+        //! update after a change of the y values from the i-th on
+        void updateFrom(Size i) {
+            impl_->updateFrom(i);
+        }
       protected:
         void checkRange(Real x, bool extrapolate) const {
             QL_REQUIRE(extrapolate || allowsExtrapolation() ||
@@ -25,6 +25,7 @@
 #define quantlib_backward_flat_interpolation_hpp
 
 #include <ql/math/interpolation.hpp>
+#include <algorithm>
 #include <vector>
 
 namespace QuantLib {
@@ -73,9 +74,12 @@ namespace QuantLib {
                                                  BackwardFlat::requiredPoints),
               primitive_(xEnd-xBegin) {}
             void update() {
+                updateFrom(0);
+            }
+            void updateFrom(Size from) {
                 Size n = this->xEnd_-this->xBegin_;
                 primitive_[0] = 0.0;
-                for (Size i=1; i<n; i++) {
+                for (Size i=std::max<Size>(from,1); i<n; i++) {
                     Real dx = this->xBegin_[i]-this->xBegin_[i-1];
                     primitive_[i] = primitive_[i-1] + dx*this->yBegin_[i];
                 }
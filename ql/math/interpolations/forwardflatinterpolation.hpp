@@ -25,6 +25,7 @@
 #define quantlib_forward_flat_interpolation_hpp
 
 #include <ql/math/interpolation.hpp>
+#include <algorithm>
 #include <vector>
 
 namespace QuantLib {
@@ -73,8 +74,11 @@ namespace QuantLib {
                                                  ForwardFlat::requiredPoints),
               primitive_(xEnd-xBegin), n_(xEnd-xBegin) {}
             void update() {
+                updateFrom(0);
+            }
+            void updateFrom(Size from) {
                 primitive_[0] = 0.0;
-                for (Size i=1; i<n_; i++) {
+                for (Size i=std::max<Size>(from,1); i<n_; i++) {
                     Real dx = this->xBegin_[i]-this->xBegin_[i-1];
                     primitive_[i] = primitive_[i-1] + dx*this->yBegin_[i-1];
                 }
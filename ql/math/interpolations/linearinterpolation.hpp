@@ -26,6 +26,7 @@
 #define quantlib_linear_interpolation_hpp
 
 #include <ql/math/interpolation.hpp>
+#include <algorithm>
 #include <vector>
 
 namespace QuantLib {
@@ -74,8 +75,12 @@ namespace QuantLib {
                                                  Linear::requiredPoints),
               primitiveConst_(xEnd-xBegin), s_(xEnd-xBegin) {}
             void update() {
+                updateFrom(0);
+            }
+            void updateFrom(Size from) {
                 primitiveConst_[0] = 0.0;
-                for (Size i=1; i<Size(this->xEnd_-this->xBegin_); ++i) {
+                for (Size i=std::max<Size>(from,1);
+                     i<Size(this->xEnd_-this->xBegin_); ++i) {
                     Real dx = this->xBegin_[i]-this->xBegin_[i-1];
                     s_[i-1] = (this->yBegin_[i]-this->yBegin_[i-1])/dx;
                     primitiveConst_[i] = primitiveConst_[i-1]
@@ -310,13 +310,16 @@ namespace QuantLib {
                                                      logY_.begin());
             }
             void update() {
-                for (Size i=0; i<logY_.size(); ++i) {
+                updateFrom(0);
+            }
+            void updateFrom(Size from) {
+                for (Size i=from; i<logY_.size(); ++i) {
                     QL_REQUIRE(this->yBegin_[i]>0.0,
                                "invalid value (" << this->yBegin_[i]
                                << ") at index " << i);
                     logY_[i] = std::log(this->yBegin_[i]);
                 }
-                interpolation_.update();
+                interpolation_.updateFrom(from);
             }
             Real value(Real x) const {
                 return std::exp(interpolation_(x, true));
@@ -44,7 +44,8 @@ namespace {
                                                      [](Real x, Real y) { return std::abs(x) < std::abs(y); });
             if (largest_element == 0.0)
                 return std::make_tuple(Matrix(size, size), std::vector<int>(size), 0);
-            vv[i] /= largest_element;
+            // implicit scaling uses the magnitude of the largest element
+            vv[i] /= std::abs(largest_element);
         }
 
         for (int k = 0; k < size; ++k) {
@@ -29,6 +29,7 @@
 
 #include <ql/math/array.hpp>
 #include <ql/utilities/steppingiterator.hpp>
+#include <algorithm>
 
 namespace QuantLib {
 
@@ -148,13 +149,31 @@ namespace QuantLib {
     /*! \relates Matrix */
     Matrix operator+(const Matrix&, const Matrix&);
     /*! \relates Matrix */
+    Matrix operator+(const Matrix&, Matrix&&);
+    /*! \relates Matrix */
+    Matrix operator+(Matrix&&, const Matrix&);
+    /*! \relates Matrix */
+    Matrix operator+(Matrix&&, Matrix&&);
+    /*! \relates Matrix */
     Matrix operator-(const Matrix&, const Matrix&);
     /*! \relates Matrix */
+    Matrix operator-(const Matrix&, Matrix&&);
+    /*! \relates Matrix */
+    Matrix operator-(Matrix&&, const Matrix&);
+    /*! \relates Matrix */
+    Matrix operator-(Matrix&&, Matrix&&);
+    /*! \relates Matrix */
     Matrix operator*(const Matrix&, Real);
     /*! \relates Matrix */
+    Matrix operator*(Matrix&&, Real);
+    /*! \relates Matrix */
     Matrix operator*(Real, const Matrix&);
     /*! \relates Matrix */
+    Matrix operator*(Real, Matrix&&);
+    /*! \relates Matrix */
     Matrix operator/(const Matrix&, Real);
+    /*! \relates Matrix */
+    Matrix operator/(Matrix&&, Real);
 
 
     // vectorial products
@@ -463,6 +482,26 @@ namespace QuantLib {
         return temp;
     }
 
+    inline Matrix operator+(const Matrix& m1, Matrix&& m2) {
+        QL_REQUIRE(m1.rows() == m2.rows() &&
+            m1.columns() == m2.columns(),
+            "matrices with different sizes (" <<
+            m1.rows() << "x" << m1.columns() << ", " <<
+            m2.rows() << "x" << m2.columns() << ") cannot be "
+            "added");
+        std::transform(m1.begin(), m1.end(), m2.begin(), m2.begin(),
+            std::plus<Real>());
+        return std::move(m2);
+    }
+
+    inline Matrix operator+(Matrix&& m1, const Matrix& m2) {
+        return std::move(m1 += m2);
+    }
+
+    inline Matrix operator+(Matrix&& m1, Matrix&& m2) {
+        return std::move(m1 += m2);
+    }
+
     inline Matrix operator-(const Matrix& m1,
         const Matrix& m2) {
         QL_REQUIRE(m1.rows() == m2.rows() &&
@@ -477,6 +516,26 @@ namespace QuantLib {
         return temp;
     }
 
+    inline Matrix operator-(const Matrix& m1, Matrix&& m2) {
+        QL_REQUIRE(m1.rows() == m2.rows() &&
+            m1.columns() == m2.columns(),
+            "matrices with different sizes (" <<
+            m1.rows() << "x" << m1.columns() << ", " <<
+            m2.rows() << "x" << m2.columns() << ") cannot be "
+            "subtracted");
+        std::transform(m1.begin(), m1.end(), m2.begin(), m2.begin(),
+            std::minus<Real>());
+        return std::move(m2);
+    }
+
+    inline Matrix operator-(Matrix&& m1, const Matrix& m2) {
+        return std::move(m1 -= m2);
+    }
+
+    inline Matrix operator-(Matrix&& m1, Matrix&& m2) {
+        return std::move(m1 -= m2);
+    }
+
     inline Matrix operator*(const Matrix& m, Real x) {
         Matrix temp(m.rows(), m.columns());
         std::transform(m.begin(), m.end(), temp.begin(),
@@ -484,6 +543,10 @@ namespace QuantLib {
         return temp;
     }
 
+    inline Matrix operator*(Matrix&& m, Real x) {
+        return std::move(m *= x);
+    }
+
     inline Matrix operator*(Real x, const Matrix& m) {
         Matrix temp(m.rows(), m.columns());
         std::transform(m.begin(), m.end(), temp.begin(),
@@ -491,6 +554,10 @@ namespace QuantLib {
         return temp;
     }
 
+    inline Matrix operator*(Real x, Matrix&& m) {
+        return std::move(m *= x);
+    }
+
     inline Matrix operator/(const Matrix& m, Real x) {
         Matrix temp(m.rows(), m.columns());
         std::transform(m.begin(), m.end(), temp.begin(),
@@ -498,16 +565,25 @@ namespace QuantLib {
         return temp;
     }
 
+    inline Matrix operator/(Matrix&& m, Real x) {
+        return std::move(m /= x);
+    }
+
     inline Array operator*(const Array& v, const Matrix& m) {
         QL_REQUIRE(v.size() == m.rows(),
             "vectors and matrices with different sizes ("
             << v.size() << ", " << m.rows() << "x" << m.columns() <<
             ") cannot be multiplied");
-        Array result(m.columns());
-        for (Size i = 0; i < result.size(); i++)
-            result[i] =
-            std::inner_product(v.begin(), v.end(),
-                m.column_begin(i), 0.0);
+        // rows are accumulated in turn so that the matrix is read
+        // contiguously; each element is still summed in row order.
+        Array result(m.columns(), 0.0);
+        for (Size i = 0; i < m.rows(); i++) {
+            const Real vi = v[i];
+            Matrix::const_row_iterator mi = m.row_begin(i);
+            Array::iterator r = result.begin();
+            for (Size j = 0; j < result.size(); j++)
+                r[j] += vi * mi[j];
+        }
         return result;
     }
 
@@ -516,10 +592,32 @@ namespace QuantLib {
             "vectors and matrices with different sizes ("
             << v.size() << ", " << m.rows() << "x" << m.columns() <<
             ") cannot be multiplied");
+        // four rows are processed together so that each element of v
+        // is loaded once for all of them; each row keeps its own sum.
         Array result(m.rows());
-        for (Size i = 0; i < result.size(); i++)
-            result[i] =
-            std::inner_product(v.begin(), v.end(), m.row_begin(i), 0.0);
+        const Size n = m.columns();
+        const Size rows = result.size(), grouped = rows - rows % 4;
+        Array::const_iterator x = v.begin();
+        Matrix::const_iterator mi = m.begin();
+        Size i = 0;
+        for (; i < grouped; i += 4, mi += 4*n) {
+            Matrix::const_iterator m0 = mi, m1 = m0 + n,
+                m2 = m1 + n, m3 = m2 + n;
+            Real s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+            for (Size k = 0; k < n; ++k) {
+                const Real xk = x[k];
+                s0 += m0[k] * xk;
+                s1 += m1[k] * xk;
+                s2 += m2[k] * xk;
+                s3 += m3[k] * xk;
+            }
+            result[i] = s0;
+            result[i+1] = s1;
+            result[i+2] = s2;
+            result[i+3] = s3;
+        }
+        for (; i < rows; i++, mi += n)
+            result[i] = std::inner_product(v.begin(), v.end(), mi, 0.0);
         return result;
     }
 
@@ -530,11 +628,27 @@ namespace QuantLib {
             m1.rows() << "x" << m1.columns() << ", " <<
             m2.rows() << "x" << m2.columns() << ") cannot be "
             "multiplied");
-        Matrix result(m1.rows(), m2.columns(), 0.0);
-        for (Size i = 0; i < result.rows(); ++i) {
-            for (Size k = 0; k < m1.columns(); ++k) {
-                for (Size j = 0; j < result.columns(); ++j) {
-                    result[i][j] += m1[i][k] * m2[k][j];
+        // The product is accumulated over blocks of the inner
+        // dimension and of the result columns, so that the block of
+        // m2 being used stays in cache while all rows of m1 go
+        // through it.  For each element, the terms are still summed
+        // in the order of the inner index.
+        const Size innerBlock = 64, columnBlock = 256;
+        const Size inner = m1.columns(), columns = m2.columns();
+        Matrix result(m1.rows(), columns, 0.0);
+        for (Size kk = 0; kk < inner; kk += innerBlock) {
+            const Size kEnd = std::min(kk + innerBlock, inner);
+            for (Size jj = 0; jj < columns; jj += columnBlock) {
+                const Size jEnd = std::min(jj + columnBlock, columns);
+                for (Size i = 0; i < result.rows(); ++i) {
+                    Matrix::const_row_iterator a = m1.row_begin(i);
+                    Matrix::row_iterator r = result.row_begin(i);
+                    for (Size k = kk; k < kEnd; ++k) {
+                        const Real aik = a[k];
+                        Matrix::const_row_iterator b = m2.row_begin(k);
+                        for (Size j = jj; j < jEnd; ++j)
+                            r[j] += aik * b[j];
+                    }
                 }
             }
         }
@@ -542,9 +656,21 @@ namespace QuantLib {
     }
 
     inline Matrix transpose(const Matrix& m) {
+        // copied by tiles, so that neither matrix is read or written
+        // with a large stride across cache lines
+        const Size tile = 32;
         Matrix result(m.columns(), m.rows());
-        for (Size i = 0; i < m.rows(); i++)
-            std::copy(m.row_begin(i), m.row_end(i), result.column_begin(i));
+        for (Size ii = 0; ii < m.rows(); ii += tile) {
+            const Size iEnd = std::min(ii + tile, m.rows());
+            for (Size jj = 0; jj < m.columns(); jj += tile) {
+                const Size jEnd = std::min(jj + tile, m.columns());
+                for (Size j = jj; j < jEnd; j++) {
+                    Matrix::row_iterator r = result.row_begin(j);
+                    for (Size i = ii; i < iEnd; i++)
+                        r[i] = m[i][j];
+                }
+            }
+        }
         return result;
     }
 
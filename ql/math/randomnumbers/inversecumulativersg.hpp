@@ -26,6 +26,8 @@
 #define quantlib_inversecumulative_rsg_h
 
 #include <ql/methods/montecarlo/sample.hpp>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace QuantLib {
@@ -51,7 +53,31 @@ namespace QuantLib {
             IC::IC();
             Real IC::operator() const;
         \endcode
+
+        If IC also provides the batch interface
+        \code
+            void IC::operator()(const Real* x, Real* y, Size n) const;
+        \endcode
+        (as, e.g., InverseCumulativeNormal does) the blocks returned
+        by nextSequences are transformed with a single call; the batch
+        interface must allow x and y to be the same buffer.  Since the
+        batch interface might have a different precision, nextSequence
+        always uses the scalar one so that the samples it returns don't
+        depend on IC providing a batch interface.
     */
+    namespace detail {
+
+        template <class IC, class = void>
+        struct has_batch_inverse_cumulative : std::false_type {};
+
+        template <class IC>
+        struct has_batch_inverse_cumulative<
+            IC, std::void_t<decltype(std::declval<const IC&>()(
+                    std::declval<const Real*>(), std::declval<Real*>(),
+                    std::declval<Size>()))> > : std::true_type {};
+
+    }
+
     template <class USG, class IC>
     class InverseCumulativeRsg {
       public:
@@ -61,8 +87,28 @@ namespace QuantLib {
                              const IC& inverseCumulative);
         //! returns next sample from the inverse cumulative distribution
         const sample_type& nextSequence() const;
+        //! fills a buffer with the next n samples
+        /*! The components of the \f$ i \f$-th sample are stored from
+            output[i*dimension()] on; the weights of the samples are
+            not returned.  The batch interface of IC is used if
+            available, so the samples can differ from those returned
+            by nextSequence within the precision of the batch
+            interface.  USG must implement the nextSequences method;
+            see RandomSequenceGenerator and SobolRsg.
+
+            The buffer returned by lastSequence is not updated.
+        */
+        void nextSequences(Size n, Real* output) const;
         const sample_type& lastSequence() const { return x_; }
         Size dimension() const { return dimension_; }
+        //! generator for the draws from the given offset on
+        /*! USG must implement the substream method; see
+            RandomSequenceGenerator and SobolRsg.
+        */
+        InverseCumulativeRsg substream(Size offset) const {
+            return InverseCumulativeRsg(
+                uniformSequenceGenerator_.substream(offset), ICD_);
+        }
       private:
         USG uniformSequenceGenerator_;
         Size dimension_;
@@ -87,7 +133,7 @@ namespace QuantLib {
     template <class USG, class IC>
     inline const typename InverseCumulativeRsg<USG, IC>::sample_type&
     InverseCumulativeRsg<USG, IC>::nextSequence() const {
-        typename USG::sample_type sample =
+        const typename USG::sample_type& sample =
             uniformSequenceGenerator_.nextSequence();
         x_.weight = sample.weight;
         for (Size i = 0; i < dimension_; i++) {
@@ -96,6 +142,19 @@ namespace QuantLib {
         return x_;
     }
 
+    template <class USG, class IC>
+    inline void InverseCumulativeRsg<USG, IC>::nextSequences(
+                                             Size n, Real* output) const {
+        uniformSequenceGenerator_.nextSequences(n, output);
+        if constexpr (detail::has_batch_inverse_cumulative<IC>::value) {
+            ICD_(output, output, n*dimension_);
+        } else {
+            for (Size i = 0; i < n*dimension_; i++) {
+                output[i] = ICD_(output[i]);
+            }
+        }
+    }
+
 }
 
 
@@ -74,6 +74,16 @@ namespace QuantLib {
             }
             return sequence_;
         }
+        //! fills a buffer with the next n sequences
+        /*! The components of the \f$ i \f$-th sequence are stored
+            from output[i*dimension()] on; the weights of the samples
+            are not returned.  The buffer returned by lastSequence is
+            not updated.
+        */
+        void nextSequences(Size n, Real* output) const {
+            for (Size i=0; i<n*dimensionality_; i++)
+                output[i] = rng_.next().value;
+        }
         std::vector<BigNatural> nextInt32Sequence() const {
             for (Size i=0; i<dimensionality_; i++) {
                 int32Sequence_[i] = rng_.nextInt32();
@@ -84,6 +94,31 @@ namespace QuantLib {
             return sequence_;
         }
         Size dimension() const {return dimensionality_;}
+        //! separate generator for the draws from the given offset on
+        /*! Pseudo-random sequences cannot be skipped ahead cheaply;
+            the returned generator is seeded instead from the current
+            state of this one and from the offset, so that the same
+            offset always yields the same stream.  The state of this
+            generator is not modified.
+
+            \warning the substreams are reseeded rather than jumped
+                     ahead; they are not guaranteed to be disjoint
+                     segments of the sequence of this generator, nor of
+                     each other's.  With the 2^19937-1 period of the
+                     Mersenne twister, overlaps are extremely unlikely
+                     for practical numbers of draws, but the results
+                     are not those of the serial generator.
+
+            Class RNG must be constructible from a vector of seeds.
+        */
+        RandomSequenceGenerator substream(Size offset) const {
+            RNG rng(rng_);
+            std::vector<unsigned long> seeds(3);
+            seeds[0] = rng.nextInt32();
+            seeds[1] = static_cast<unsigned long>(offset & 0xffffffffUL);
+            seeds[2] = static_cast<unsigned long>((offset >> 16) >> 16);
+            return RandomSequenceGenerator(dimensionality_, RNG(seeds));
+        }
       private:
         Size dimensionality_;
         RNG rng_;
@@ -54,6 +54,13 @@ namespace QuantLib {
             ursg_type g(dimension, seed);
             return (icInstance ? rsg_type(g, *icInstance) : rsg_type(g));
         }
+        //! separate generator for the given offset
+        /*! see RandomSequenceGenerator::substream */
+        static rsg_type make_sequence_generator(Size dimension,
+                                                BigNatural seed,
+                                                Size offset) {
+            return make_sequence_generator(dimension, seed).substream(offset);
+        }
         // data
         static std::shared_ptr<IC> icInstance;
     };
@@ -91,6 +98,15 @@ namespace QuantLib {
             ursg_type g(dimension, seed);
             return (icInstance ? rsg_type(g, *icInstance) : rsg_type(g));
         }
+        //! generator for the draws from the given offset on
+        /*! Workers or processes can be given contiguous blocks of
+            the same sequence by passing different offsets.
+        */
+        static rsg_type make_sequence_generator(Size dimension,
+                                                BigNatural seed,
+                                                Size offset) {
+            return make_sequence_generator(dimension, seed).substream(offset);
+        }
         // data
         static std::shared_ptr<IC> icInstance;
     };
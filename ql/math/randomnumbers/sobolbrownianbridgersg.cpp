@@ -32,22 +32,41 @@ namespace QuantLib {
         SobolRsg::DirectionIntegers directionIntegers)
     : factors_(factors), steps_(steps), dim_(factors*steps),
       seq_(sample_type::value_type(factors*steps), 1.0),
-      gen_(factors, steps, ordering, seed, directionIntegers) {
+      gen_(factors, steps, ordering, seed, directionIntegers),
+      output_(factors) {
     }
 
     const SobolBrownianBridgeRsg::sample_type&
     SobolBrownianBridgeRsg::nextSequence() const {
         gen_.nextPath();
-        std::vector<Real> output(factors_);
         for (Size i=0; i < steps_; ++i) {
-            gen_.nextStep(output);
-            std::copy(output.begin(), output.end(),
+            gen_.nextStep(output_);
+            std::copy(output_.begin(), output_.end(),
                       seq_.value.begin()+i*factors_);
         }
 
         return seq_;
     }
 
+    void SobolBrownianBridgeRsg::nextSequences(Size n,
+                                               Real* output) const {
+        for (Size k=0; k < n; ++k) {
+            gen_.nextPath();
+            for (Size i=0; i < steps_; ++i) {
+                gen_.nextStep(output_);
+                std::copy(output_.begin(), output_.end(),
+                          output + k*dim_ + i*factors_);
+            }
+        }
+    }
+
+    SobolBrownianBridgeRsg
+    SobolBrownianBridgeRsg::substream(Size offset) const {
+        SobolBrownianBridgeRsg rsg(*this);
+        rsg.gen_ = gen_.substream(offset);
+        return rsg;
+    }
+
     const SobolBrownianBridgeRsg::sample_type&
     SobolBrownianBridgeRsg::lastSequence() const {
         return seq_;
@@ -41,13 +41,23 @@ namespace QuantLib {
                                    = SobolRsg::JoeKuoD7);
 
         const sample_type& nextSequence() const;
+        //! fills a buffer with the next n sequences
+        /*! The components of the \f$ i \f$-th sequence are stored
+            from output[i*dimension()] on.  The buffer returned by
+            lastSequence is not updated.
+        */
+        void nextSequences(Size n, Real* output) const;
         const sample_type& lastSequence() const;
         Size dimension() const;
+        //! generator for the draws from the given offset on
+        /*! see SobolBrownianGenerator::substream */
+        SobolBrownianBridgeRsg substream(Size offset) const;
 
       private:
         const Size factors_, steps_, dim_;
         mutable sample_type seq_;
         mutable SobolBrownianGenerator gen_;
+        mutable std::vector<Real> output_;
     };
 }
 
@@ -27,6 +27,8 @@
 #define quantlib_sobol_ld_rsg_hpp
 
 #include <ql/methods/montecarlo/sample.hpp>
+#include <ql/errors.hpp>
+#include <algorithm>
 #include <vector>
 
 namespace QuantLib {
@@ -119,6 +121,20 @@ namespace QuantLib {
                  DirectionIntegers directionIntegers = Jaeckel);
         /*! skip to the n-th sample in the low-discrepancy sequence */
         void skipTo(unsigned long n);
+        //! generator for the draws from the given offset on
+        /*! The returned generator continues the sequence of this one
+            as if the given number of draws had been discarded; the
+            state of this generator is not modified.
+        */
+        SobolRsg substream(Size offset) const {
+            SobolRsg rsg(*this);
+            unsigned long next =
+                firstDraw_ ? sequenceCounter_ : sequenceCounter_+1;
+            rsg.skipTo(next + static_cast<unsigned long>(offset));
+            // the point at the new position is returned by the next draw
+            rsg.firstDraw_ = true;
+            return rsg;
+        }
         const std::vector<unsigned long>& nextInt32Sequence() const;
         const SobolRsg::sample_type& nextSequence() const {
             const std::vector<unsigned long>& v = nextInt32Sequence();
@@ -127,9 +143,27 @@ namespace QuantLib {
                 sequence_.value[k] = v[k] * normalizationFactor_;
             return sequence_;
         }
+        //! fills a buffer with the next n draws
+        /*! The components of the \f$ i \f$-th draw are stored from
+            output[i*dimension()] on.  The draws are the same that n
+            calls to nextInt32Sequence would return; each one is
+            obtained from the previous row of the buffer by XORing
+            the direction integers of a single bit, which are stored
+            contiguously across dimensions.
+
+            The buffer returned by lastSequence is not updated.  As
+            for the other methods, different threads should use
+            different generators; see substream.
+        */
+        void nextInt32Sequences(Size n, unsigned long* output) const;
+        //! fills a buffer with the next n draws normalized in (0,1)
+        /*! The layout is the same as for nextInt32Sequences. */
+        void nextSequences(Size n, Real* output) const;
         const sample_type& lastSequence() const { return sequence_; }
         Size dimension() const { return dimensionality_; }
       private:
+        void grayCodeStep(const unsigned long* from, unsigned long* to) const;
+        const std::vector<unsigned long>& directionsByBit() const;
         static const int bits_;
         static const double normalizationFactor_;
         Size dimensionality_;
@@ -138,8 +172,104 @@ namespace QuantLib {
         mutable sample_type sequence_;
         mutable std::vector<unsigned long> integerSequence_;
         std::vector<std::vector<unsigned long> > directionIntegers_;
+        // direction integers for all dimensions, stored by bit
+        mutable std::vector<unsigned long> directionsByBit_;
     };
 
+
+    // inline definitions
+
+    inline const std::vector<unsigned long>&
+    SobolRsg::directionsByBit() const {
+        if (directionsByBit_.empty()) {
+            directionsByBit_.resize(bits_*dimensionality_);
+            for (Size j=0; j<Size(bits_); ++j)
+                for (Size k=0; k<dimensionality_; ++k)
+                    directionsByBit_[j*dimensionality_+k] =
+                        directionIntegers_[k][j];
+        }
+        return directionsByBit_;
+    }
+
+    inline void SobolRsg::grayCodeStep(const unsigned long* from,
+                                       unsigned long* to) const {
+        // instead of using the counter n as new unique generating
+        // integer for the n-th draw use its Gray code G(n), as
+        // proposed by Antonov and Saleev; it changes in the bit
+        // given by the rightmost zero bit of n
+        unsigned long n = sequenceCounter_+1;
+        Size j = 0;
+        while (n & 1) {
+            n >>= 1;
+            ++j;
+        }
+        QL_REQUIRE(j < Size(bits_), "period exceeded");
+        const unsigned long* v = &directionsByBit()[j*dimensionality_];
+        for (Size k=0; k<dimensionality_; ++k)
+            to[k] = from[k] ^ v[k];
+        ++sequenceCounter_;
+    }
+
+    inline void SobolRsg::skipTo(unsigned long skip) {
+        // the point is the XOR of the direction integers of the bits
+        // set in the Gray code of skip+1
+        unsigned long N = skip+1;
+        unsigned long G = N ^ (N>>1);
+        const std::vector<unsigned long>& v = directionsByBit();
+        std::fill(integerSequence_.begin(), integerSequence_.end(), 0UL);
+        for (Size j=0; G != 0; ++j, G >>= 1) {
+            QL_REQUIRE(j < Size(bits_), "period exceeded");
+            if (G & 1) {
+                for (Size k=0; k<dimensionality_; ++k)
+                    integerSequence_[k] ^= v[j*dimensionality_+k];
+            }
+        }
+        sequenceCounter_ = skip;
+    }
+
+    inline const std::vector<unsigned long>&
+    SobolRsg::nextInt32Sequence() const {
+        if (firstDraw_) {
+            // it was precomputed in the constructor
+            firstDraw_ = false;
+            return integerSequence_;
+        }
+        grayCodeStep(&integerSequence_[0], &integerSequence_[0]);
+        return integerSequence_;
+    }
+
+    inline void SobolRsg::nextInt32Sequences(Size n,
+                                             unsigned long* output) const {
+        if (n == 0)
+            return;
+        const unsigned long* previous = &integerSequence_[0];
+        for (Size i=0; i<n; ++i, output += dimensionality_) {
+            if (firstDraw_) {
+                firstDraw_ = false;
+                std::copy(previous, previous+dimensionality_, output);
+            } else {
+                grayCodeStep(previous, output);
+            }
+            previous = output;
+        }
+        // the last draw is the state for the next one
+        std::copy(previous, previous+dimensionality_,
+                  integerSequence_.begin());
+    }
+
+    inline void SobolRsg::nextSequences(Size n, Real* output) const {
+        std::vector<unsigned long> x(integerSequence_);
+        for (Size i=0; i<n; ++i, output += dimensionality_) {
+            if (firstDraw_)
+                firstDraw_ = false;
+            else
+                grayCodeStep(&x[0], &x[0]);
+            for (Size k=0; k<dimensionality_; ++k)
+                output[k] = x[k] * normalizationFactor_;
+        }
+        integerSequence_.swap(x);
+    }
+
 }
 
 #endif
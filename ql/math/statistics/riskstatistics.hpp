@@ -26,6 +26,7 @@
 
 #include <ql/math/functional.hpp>
 #include <ql/math/statistics/gaussianstatistics.hpp>
+#include <ql/math/statistics/tdigeststatistics.hpp>
 
 namespace QuantLib {
 
@@ -123,6 +124,14 @@ namespace QuantLib {
     */
     typedef GenericRiskStatistics<GaussianStatistics> RiskStatistics;
 
+    //! risk measures tool with bounded memory
+    /*! Percentiles, value-at-risk and expected shortfall are
+        estimated from a t-digest instead of the stored samples; see
+        TDigestStatistics for details.
+    */
+    typedef GenericRiskStatistics<GenericGaussianStatistics<TDigestStatistics> >
+                                                        TDigestRiskStatistics;
+
 
 
     // inline definitions
@@ -153,6 +153,7 @@ namespace QuantLib {
     */
     typedef GenericSequenceStatistics<Statistics> SequenceStatistics;
     typedef GenericSequenceStatistics<IncrementalStatistics> SequenceStatisticsInc;
+    typedef GenericSequenceStatistics<TDigestRiskStatistics> SequenceStatisticsTDigest;
 
     // inline definitions
 
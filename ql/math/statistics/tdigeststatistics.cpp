@@ -0,0 +1,341 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/math/statistics/tdigeststatistics.hpp>
+#include <ql/mathconstants.hpp>
+#include <algorithm>
+#include <iterator>
+#include <cmath>
+
+namespace QuantLib {
+
+    namespace {
+
+        // scale function of the digest, see the paper cited in the
+        // header; adjacent centroids can be merged as long as they
+        // span at most a unit of it.  The logarithm makes centroids
+        // smaller in proportion to their distance from the ends.
+        Real scale(Real q, Real compression, Real normalizer) {
+            if (q <= 0.0)
+                return -QL_MAX_REAL;
+            if (q >= 1.0)
+                return QL_MAX_REAL;
+            return compression/normalizer * std::log(q/(1.0-q));
+        }
+
+    }
+
+    TDigestStatistics::TDigestStatistics(Real compression)
+    : compression_(compression) {
+        QL_REQUIRE(compression >= 10.0,
+                   "compression (" << compression << ") must be "
+                   "at least 10");
+        reset();
+    }
+
+    Real TDigestStatistics::mean() const {
+        QL_REQUIRE(weightSum_ > 0.0, "sampleWeight_= 0, unsufficient");
+        return mean_;
+    }
+
+    Real TDigestStatistics::variance() const {
+        Size N = samples();
+        QL_REQUIRE(N > 1, "sample number <=1, unsufficient");
+        QL_REQUIRE(weightSum_ > 0.0, "sampleWeight_= 0, unsufficient");
+        return (m2_/weightSum_) * N / (N - 1.0);
+    }
+
+    Real TDigestStatistics::standardDeviation() const {
+        return std::sqrt(variance());
+    }
+
+    Real TDigestStatistics::errorEstimate() const {
+        return std::sqrt(variance() / samples());
+    }
+
+    Real TDigestStatistics::skewness() const {
+        Size N = samples();
+        QL_REQUIRE(N > 2, "sample number <=2, unsufficient");
+        Real x = m3_/weightSum_;
+        Real sigma = standardDeviation();
+        return (x / (sigma * sigma * sigma)) * (N / (N - 1.0)) * (N / (N - 2.0));
+    }
+
+    Real TDigestStatistics::kurtosis() const {
+        Size N = samples();
+        QL_REQUIRE(N > 3, "sample number <=3, unsufficient");
+        Real x = m4_/weightSum_;
+        Real sigma2 = variance();
+        Real c1 = (N / (N - 1.0)) * (N / (N - 2.0)) * ((N + 1.0) / (N - 3.0));
+        Real c2 = 3.0 * ((N - 1.0) / (N - 2.0)) * ((N - 1.0) / (N - 3.0));
+        return c1 * (x / (sigma2 * sigma2)) - c2;
+    }
+
+    Real TDigestStatistics::min() const {
+        QL_REQUIRE(samples() > 0, "empty sample set");
+        return min_;
+    }
+
+    Real TDigestStatistics::max() const {
+        QL_REQUIRE(samples() > 0, "empty sample set");
+        return max_;
+    }
+
+    Real TDigestStatistics::percentile(Real percent) const {
+        QL_REQUIRE(percent > 0.0 && percent <= 1.0,
+                   "percentile (" << percent << ") must be in (0.0, 1.0]");
+        QL_REQUIRE(weightSum_ > 0.0, "empty sample set");
+
+        compress();
+        Real x = estimate(percent * weightSum_);
+        std::pair<Real, Real> bounds = percentileBounds(percent);
+        return std::min(std::max(x, bounds.first), bounds.second);
+    }
+
+    Real TDigestStatistics::topPercentile(Real percent) const {
+        QL_REQUIRE(percent > 0.0 && percent <= 1.0,
+                   "percentile (" << percent << ") must be in (0.0, 1.0]");
+        QL_REQUIRE(weightSum_ > 0.0, "empty sample set");
+
+        compress();
+        // the weight above the top percentile is the weight below
+        // the corresponding percentile
+        Real x = estimate((1.0 - percent) * weightSum_);
+        std::pair<Real, Real> bounds = topPercentileBounds(percent);
+        return std::min(std::max(x, bounds.first), bounds.second);
+    }
+
+    std::pair<Real, Real>
+    TDigestStatistics::percentileBounds(Real percent) const {
+        QL_REQUIRE(percent > 0.0 && percent <= 1.0,
+                   "percentile (" << percent << ") must be in (0.0, 1.0]");
+        QL_REQUIRE(weightSum_ > 0.0, "empty sample set");
+
+        compress();
+        // The weight of the samples below x is at most the weight of
+        // the centroids whose minimum is below x, and at least the
+        // weight of those whose maximum is.
+        std::vector<std::pair<Real, Real> > ends(centroids_.size());
+        Real target = percent * weightSum_;
+        std::pair<Real, Real> result;
+
+        for (Size i=0; i<centroids_.size(); ++i)
+            ends[i] = std::make_pair(centroids_[i].min, centroids_[i].weight);
+        std::sort(ends.begin(), ends.end());
+        Real integral = 0.0;
+        Size k = 0, l = ends.size()-1;
+        while ((integral += ends[k].second) < target && k != l)
+            ++k;
+        result.first = ends[k].first;
+
+        for (Size i=0; i<centroids_.size(); ++i)
+            ends[i] = std::make_pair(centroids_[i].max, centroids_[i].weight);
+        std::sort(ends.begin(), ends.end());
+        integral = 0.0;
+        k = 0;
+        while ((integral += ends[k].second) < target && k != l)
+            ++k;
+        result.second = ends[k].first;
+
+        return result;
+    }
+
+    std::pair<Real, Real>
+    TDigestStatistics::topPercentileBounds(Real percent) const {
+        QL_REQUIRE(percent > 0.0 && percent <= 1.0,
+                   "percentile (" << percent << ") must be in (0.0, 1.0]");
+        QL_REQUIRE(weightSum_ > 0.0, "empty sample set");
+
+        compress();
+        // same as above, walking down from the top
+        std::vector<std::pair<Real, Real> > ends(centroids_.size());
+        Real target = percent * weightSum_;
+        std::pair<Real, Real> result;
+
+        for (Size i=0; i<centroids_.size(); ++i)
+            ends[i] = std::make_pair(centroids_[i].min, centroids_[i].weight);
+        std::sort(ends.rbegin(), ends.rend());
+        Real integral = 0.0;
+        Size k = 0, l = ends.size()-1;
+        while ((integral += ends[k].second) < target && k != l)
+            ++k;
+        result.first = ends[k].first;
+
+        for (Size i=0; i<centroids_.size(); ++i)
+            ends[i] = std::make_pair(centroids_[i].max, centroids_[i].weight);
+        std::sort(ends.rbegin(), ends.rend());
+        integral = 0.0;
+        k = 0;
+        while ((integral += ends[k].second) < target && k != l)
+            ++k;
+        result.second = ends[k].first;
+
+        return result;
+    }
+
+    void TDigestStatistics::add(Real value, Real weight) {
+        QL_REQUIRE(weight >= 0.0, "negative weight not allowed");
+        if (samples_ == 0) {
+            min_ = max_ = value;
+        } else {
+            min_ = std::min(min_, value);
+            max_ = std::max(max_, value);
+        }
+        ++samples_;
+        // null weights don't contribute to the distribution
+        if (weight > 0.0) {
+            addMoments(weight, value, 0.0, 0.0, 0.0);
+            buffer_.emplace_back(value, weight);
+            if (buffer_.size() >= 5*compression_)
+                compress();
+        }
+    }
+
+    void TDigestStatistics::merge(const TDigestStatistics& other) {
+        if (other.samples_ == 0)
+            return;
+        if (samples_ == 0) {
+            min_ = other.min_;
+            max_ = other.max_;
+        } else {
+            min_ = std::min(min_, other.min_);
+            max_ = std::max(max_, other.max_);
+        }
+        samples_ += other.samples_;
+        if (other.weightSum_ > 0.0) {
+            // copies, in case other is this instance
+            Real w = other.weightSum_, m = other.mean_, m2 = other.m2_,
+                 m3 = other.m3_, m4 = other.m4_;
+            addMoments(w, m, m2, m3, m4);
+        }
+        other.compress();
+        std::vector<Centroid> centroids = other.centroids_;
+        buffer_.insert(buffer_.end(), centroids.begin(), centroids.end());
+        compress();
+    }
+
+    void TDigestStatistics::reset() {
+        samples_ = 0;
+        weightSum_ = mean_ = m2_ = m3_ = m4_ = 0.0;
+        min_ = max_ = Null<Real>();
+        centroids_.clear();
+        buffer_.clear();
+    }
+
+    void TDigestStatistics::addMoments(Real wB, Real meanB,
+                                       Real m2B, Real m3B, Real m4B) {
+        // pairwise update of central moments, see Pebay, "Formulas for
+        // robust, one-pass parallel computation of covariances and
+        // arbitrary-order statistical moments", 2008
+        Real wA = weightSum_, W = wA + wB;
+        Real delta = meanB - mean_;
+        Real d2 = delta*delta, wAB = wA*wB;
+        Real m2A = m2_, m3A = m3_;
+        m4_ += m4B + d2*d2*wAB*(wA*wA - wAB + wB*wB)/(W*W*W)
+            + 6.0*d2*(wA*wA*m2B + wB*wB*m2A)/(W*W)
+            + 4.0*delta*(wA*m3B - wB*m3A)/W;
+        m3_ += m3B + d2*delta*wAB*(wA - wB)/(W*W)
+            + 3.0*delta*(wA*m2B - wB*m2A)/W;
+        m2_ += m2B + d2*wAB/W;
+        mean_ += delta*wB/W;
+        weightSum_ = W;
+    }
+
+    Real TDigestStatistics::estimate(Real target) const {
+        // Samples are assumed to be spread evenly around the means of
+        // the centroids, so that the estimate is interpolated between
+        // the means of the centroids around the target weight.  Since
+        // the centroids in the tails often hold a single sample, the
+        // sample is returned when the target weight falls on it.
+        Size n = centroids_.size(), k = 0;
+        Real integral = 0.0;
+        while (integral + centroids_[k].weight < target && k != n-1) {
+            integral += centroids_[k].weight;
+            ++k;
+        }
+        const Centroid& c = centroids_[k];
+        if (c.count == 1)
+            return c.mean;
+
+        Real middle = integral + 0.5*c.weight;
+        Real x0, x1, w;
+        if (target < middle) {
+            if (k == 0)
+                return min_ + (c.mean - min_)*target/middle;
+            const Centroid& prev = centroids_[k-1];
+            x0 = prev.mean;
+            x1 = c.mean;
+            w = 0.5*(prev.weight + c.weight);
+            return x1 - (x1 - x0)*(middle - target)/w;
+        } else {
+            if (k == n-1)
+                return c.mean + (max_ - c.mean)*(target - middle)
+                                              /(0.5*c.weight);
+            const Centroid& next = centroids_[k+1];
+            x0 = c.mean;
+            x1 = next.mean;
+            w = 0.5*(c.weight + next.weight);
+            return x0 + (x1 - x0)*(target - middle)/w;
+        }
+    }
+
+    void TDigestStatistics::compress() const {
+        if (buffer_.empty())
+            return;
+
+        auto byMean = [](const Centroid& a, const Centroid& b) {
+            return a.mean < b.mean;
+        };
+        std::sort(buffer_.begin(), buffer_.end(), byMean);
+        std::vector<Centroid> all;
+        all.reserve(centroids_.size() + buffer_.size());
+        std::merge(centroids_.begin(), centroids_.end(),
+                   buffer_.begin(), buffer_.end(),
+                   std::back_inserter(all), byMean);
+        buffer_.clear();
+
+        Real W = 0.0;
+        for (Size i=0; i<all.size(); ++i)
+            W += all[i].weight;
+        Real normalizer =
+            4.0*std::log(std::max(samples_/compression_, 1.0)) + 24.0;
+
+        centroids_.clear();
+        Centroid current = all[0];
+        Real integral = 0.0;
+        Real k0 = scale(0.0, compression_, normalizer);
+        for (Size i=1; i<all.size(); ++i) {
+            const Centroid& next = all[i];
+            Real q = (integral + current.weight + next.weight)/W;
+            if (scale(q, compression_, normalizer) - k0 <= 1.0) {
+                Real w = current.weight + next.weight;
+                current.mean += (next.mean - current.mean)*next.weight/w;
+                current.weight = w;
+                current.min = std::min(current.min, next.min);
+                current.max = std::max(current.max, next.max);
+                current.count += next.count;
+            } else {
+                integral += current.weight;
+                centroids_.push_back(current);
+                k0 = scale(integral/W, compression_, normalizer);
+                current = next;
+            }
+        }
+        centroids_.push_back(current);
+    }
+
+}
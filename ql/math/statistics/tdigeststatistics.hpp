@@ -0,0 +1,254 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file tdigeststatistics.hpp
+    \brief statistics tool with bounded memory based on a t-digest
+*/
+
+#ifndef quantlib_tdigest_statistics_hpp
+#define quantlib_tdigest_statistics_hpp
+
+#include <ql/utilities/null.hpp>
+#include <ql/errors.hpp>
+#include <vector>
+#include <utility>
+
+namespace QuantLib {
+
+    //! Statistics tool with bounded memory
+    /*! This class accumulates a set of data and returns their
+        statistics based on the empirical distribution, as
+        GeneralStatistics does, without storing all samples.
+
+        Mean, variance, skewness, kurtosis, minimum and maximum are
+        accumulated exactly.  The distribution is summarized by a
+        t-digest (see Dunning and Ertl, "Computing extremely accurate
+        quantiles using t-digests", 2019), i.e., by a number of
+        centroids of the order of the compression parameter and
+        growing at most logarithmically with the number of samples.
+        Centroids are smaller towards the tails, where samples are
+        kept individually as long as possible; therefore, percentiles
+        used for risk measures are more accurate than central ones.
+
+        Percentiles and expectation values are estimated from the
+        centroids; percentileBounds() and topPercentileBounds() return
+        an interval which is guaranteed to contain the percentile that
+        GeneralStatistics would return for the same samples.
+
+        Statistics collected separately, e.g., on different threads,
+        can be combined by means of the merge() method.
+    */
+    class TDigestStatistics {
+      public:
+        typedef Real value_type;
+
+        explicit TDigestStatistics(Real compression = 500.0);
+
+        //! \name Inspectors
+        //@{
+        //! number of samples collected
+        Size samples() const { return samples_; }
+
+        template <class Predicate>
+        Size samples(const Predicate& inRange) const {
+            compress();
+            Size n = 0;
+            for (Size i=0; i<centroids_.size(); ++i)
+                if (inRange(centroids_[i].mean))
+                    n += centroids_[i].count;
+            return n;
+        }
+
+        //! sum of data weights
+        Real weightSum() const { return weightSum_; }
+
+        template <class Predicate>
+        Real weightSum(const Predicate& inRange) const {
+            compress();
+            Real w = 0.0;
+            for (Size i=0; i<centroids_.size(); ++i)
+                if (inRange(centroids_[i].mean))
+                    w += centroids_[i].weight;
+            return w;
+        }
+
+        //! number of centroids summarizing the data
+        Size centroids() const {
+            compress();
+            return centroids_.size();
+        }
+
+        /*! returns the mean, defined as
+            \f[ \langle x \rangle = \frac{\sum w_i x_i}{\sum w_i}. \f]
+        */
+        Real mean() const;
+
+        /*! returns the variance, defined as
+            \f[ \sigma^2 = \frac{N}{N-1} \left\langle \left(
+                x-\langle x \rangle \right)^2 \right\rangle. \f]
+        */
+        Real variance() const;
+
+        /*! returns the standard deviation \f$ \sigma \f$, defined as the
+            square root of the variance.
+        */
+        Real standardDeviation() const;
+
+        /*! returns the error estimate on the mean value, defined as
+            \f$ \epsilon = \sigma/\sqrt{N}. \f$
+        */
+        Real errorEstimate() const;
+
+        /*! returns the skewness, defined as
+            \f[ \frac{N^2}{(N-1)(N-2)} \frac{\left\langle \left(
+                x-\langle x \rangle \right)^3 \right\rangle}{\sigma^3}. \f]
+            The above evaluates to 0 for a Gaussian distribution.
+        */
+        Real skewness() const;
+
+        /*! returns the excess kurtosis, defined as
+            \f[ \frac{N^2(N+1)}{(N-1)(N-2)(N-3)}
+                \frac{\left\langle \left(x-\langle x \rangle \right)^4
+                \right\rangle}{\sigma^4} - \frac{3(N-1)^2}{(N-2)(N-3)}. \f]
+            The above evaluates to 0 for a Gaussian distribution.
+        */
+        Real kurtosis() const;
+
+        /*! returns the minimum sample value */
+        Real min() const;
+
+        /*! returns the maximum sample value */
+        Real max() const;
+
+        /*! Expectation value of a function \f$ f \f$ over R,
+            estimated from the centroids.
+        */
+        template <class Func>
+        Real expectationValue(const Func& f) const {
+            compress();
+            Real num = 0.0;
+            for (Size i=0; i<centroids_.size(); ++i)
+                num += f(centroids_[i].mean) * centroids_[i].weight;
+            return num / weightSum_;
+        }
+
+        /*! Expectation value of a function \f$ f \f$ on a given
+            range \f$ \mathcal{R} \f$, estimated from the centroids
+            whose mean belongs to the range.
+
+            The function returns a pair made of the result and
+            the number of observations in the given range.
+        */
+        template <class Func, class Predicate>
+        std::pair<Real, Size> expectationValue(const Func& f,
+                                               const Predicate& inRange) const {
+            compress();
+            Real num = 0.0, den = 0.0;
+            Size N = 0;
+            for (Size i=0; i<centroids_.size(); ++i) {
+                const Centroid& c = centroids_[i];
+                if (inRange(c.mean)) {
+                    num += f(c.mean) * c.weight;
+                    den += c.weight;
+                    N += c.count;
+                }
+            }
+            if (N == 0)
+                return std::make_pair<Real, Size>(Null<Real>(), 0);
+            else
+                return std::make_pair(num / den, N);
+        }
+
+        /*! \f$ y \f$-th percentile, defined as the value \f$ \bar{x} \f$
+            such that
+            \f[ y = \frac{\sum_{x_i < \bar{x}} w_i}{
+                          \sum_i w_i} \f]
+            and estimated from the centroids.
+
+            \pre \f$ y \f$ must be in the range \f$ (0-1]. \f$
+        */
+        Real percentile(Real percent) const;
+
+        /*! returns an interval containing the \f$ y \f$-th
+            percentile of the collected samples.
+        */
+        std::pair<Real, Real> percentileBounds(Real percent) const;
+
+        /*! \f$ y \f$-th top percentile, defined as the value
+            \f$ \bar{x} \f$ such that
+            \f[ y = \frac{\sum_{x_i > \bar{x}} w_i}{
+                          \sum_i w_i} \f]
+            and estimated from the centroids.
+
+            \pre \f$ y \f$ must be in the range \f$ (0-1]. \f$
+        */
+        Real topPercentile(Real percent) const;
+
+        /*! returns an interval containing the \f$ y \f$-th top
+            percentile of the collected samples.
+        */
+        std::pair<Real, Real> topPercentileBounds(Real percent) const;
+        //@}
+
+        //! \name Modifiers
+        //@{
+        //! adds a datum to the set, possibly with a weight
+        void add(Real value, Real weight = 1.0);
+
+        //! adds a sequence of data to the set, with default weight
+        template <class DataIterator>
+        void addSequence(DataIterator begin, DataIterator end) {
+            for (; begin != end; ++begin)
+                add(*begin);
+        }
+
+        //! adds a sequence of data to the set, each with its weight
+        template <class DataIterator, class WeightIterator>
+        void addSequence(DataIterator begin, DataIterator end,
+                         WeightIterator wbegin) {
+            for (; begin != end; ++begin, ++wbegin)
+                add(*begin, *wbegin);
+        }
+
+        //! adds the data collected by another instance
+        void merge(const TDigestStatistics& other);
+
+        //! resets the data to a null set
+        void reset();
+        //@}
+      private:
+        struct Centroid {
+            Centroid(Real value, Real weight)
+            : mean(value), weight(weight), min(value), max(value),
+              count(1) {}
+            Real mean, weight, min, max;
+            Size count;
+        };
+        void addMoments(Real weight, Real mean,
+                        Real m2, Real m3, Real m4);
+        Real estimate(Real target) const;
+        void compress() const;
+        Real compression_;
+        Size samples_;
+        Real weightSum_, mean_, m2_, m3_, m4_, min_, max_;
+        mutable std::vector<Centroid> centroids_, buffer_;
+    };
+
+}
+
+
+#endif
@@ -33,7 +33,8 @@ namespace QuantLib {
         Real strike,
         bool localVol,
         Real illegalLocalVolOverwrite,
-        Size direction)
+        Size direction,
+        const std::shared_ptr<FdmCoefficientCache>& cache)
     : mesher_(mesher),
       rTS_   (bsProcess->riskFreeRate().currentLink()),
       qTS_   (bsProcess->dividendYield().currentLink()),
@@ -46,10 +47,32 @@ namespace QuantLib {
       mapT_  (direction, mesher),
       strike_(strike),
       illegalLocalVolOverwrite_(illegalLocalVolOverwrite),
-      direction_(direction) {
+      direction_(direction),
+      cache_(cache) {
+        QL_REQUIRE(!cache_ || cache_->mesher() == mesher_,
+                   "coefficient cache built on a different mesher");
+        if (cache_) {
+            // the strike only matters for the Black volatility
+            cache_->bind(typeid(FdmBlackScholesOp),
+                         { Real(direction_), localVol ? 1.0 : 0.0,
+                           localVol ? illegalLocalVolOverwrite_ : strike_ },
+                         { bsProcess });
+        }
     }
 
     void FdmBlackScholesOp::setTime(Time t1, Time t2) {
+        if (cache_) {
+            const std::shared_ptr<const FdmCoefficientCache::Entry> entry
+                = cache_->find(t1, t2);
+            if (entry) {
+                // the map is shared with the cache, not copied
+                cachedMap_ = std::shared_ptr<const TripleBandLinearOp>(
+                                                   entry, &entry->maps[0]);
+                return;
+            }
+        }
+        cachedMap_.reset();
+
         const Rate r = rTS_->forwardRate(t1, t2, Continuous).rate();
         const Rate q = qTS_->forwardRate(t1, t2, Continuous).rate();
 
@@ -86,6 +109,12 @@ namespace QuantLib {
                         dxxMap_.mult(0.5*Array(mesher_->layout()->size(), v)),
                         Array(1, -r));
         }
+
+        if (cache_) {
+            FdmCoefficientCache::Entry entry;
+            entry.maps.push_back(mapT_);
+            cache_->store(t1, t2, std::move(entry));
+        }
     }
 
     Size FdmBlackScholesOp::size() const {
@@ -93,13 +122,13 @@ namespace QuantLib {
     }
 
     Array FdmBlackScholesOp::apply(const Array& u) const {
-        return mapT_.apply(u);
+        return map().apply(u);
     }
 
     Array FdmBlackScholesOp::apply_direction(Size direction,
                                                     const Array& r) const {
         if (direction == direction_)
-            return mapT_.apply(r);
+            return map().apply(r);
         else {
             Array retVal(r.size(), 0.0);
             return retVal;
@@ -114,7 +143,7 @@ namespace QuantLib {
     Array FdmBlackScholesOp::solve_splitting(Size direction,
                                                 const Array& r, Real dt) const {
         if (direction == direction_)
-            return mapT_.solve_splitting(r, dt, 1.0);
+            return map().solve_splitting(r, dt, 1.0);
         else {
             Array retVal(r);
             return retVal;
@@ -126,9 +155,41 @@ namespace QuantLib {
         return solve_splitting(direction_, r, dt);
     }
 
+    void FdmBlackScholesOp::apply(const Array& r, Array& result) const {
+        map().apply(r, result);
+    }
+
+    void FdmBlackScholesOp::apply_direction(Size direction,
+                                            const Array& r,
+                                            Array& result) const {
+        if (direction == direction_)
+            map().apply(r, result);
+        else if (result.size() == r.size())
+            std::fill(result.begin(), result.end(), 0.0);
+        else
+            result = Array(r.size(), 0.0);
+    }
+
+    void FdmBlackScholesOp::apply_mixed(const Array& r,
+                                        Array& result) const {
+        if (result.size() == r.size())
+            std::fill(result.begin(), result.end(), 0.0);
+        else
+            result = Array(r.size(), 0.0);
+    }
+
+    void FdmBlackScholesOp::solve_splitting(Size direction,
+                                            const Array& r, Real dt,
+                                            Array& result) const {
+        if (direction == direction_)
+            map().solve_splitting(r, dt, 1.0, result, tmp_);
+        else
+            result = r;
+    }
+
     std::vector<SparseMatrix> 
     FdmBlackScholesOp::toMatrixDecomp() const {
-        std::vector<SparseMatrix> retVal(1, mapT_.toMatrix());
+        std::vector<SparseMatrix> retVal(1, map().toMatrix());
         return retVal;
     }
 }
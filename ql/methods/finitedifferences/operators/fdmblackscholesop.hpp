@@ -31,6 +31,7 @@
 #include <ql/methods/finitedifferences/operators/firstderivativeop.hpp>
 #include <ql/methods/finitedifferences/operators/triplebandlinearop.hpp>
 #include <ql/methods/finitedifferences/operators/fdmlinearopcomposite.hpp>
+#include <ql/methods/finitedifferences/utilities/fdmcoefficientcache.hpp>
 
 namespace QuantLib {
 
@@ -42,7 +43,9 @@ namespace QuantLib {
             Real strike,
             bool localVol = false,
             Real illegalLocalVolOverwrite = -Null<Real>(),
-            Size direction = 0);
+            Size direction = 0,
+            const std::shared_ptr<FdmCoefficientCache>& cache
+                = std::shared_ptr<FdmCoefficientCache>());
 
         Size size() const;
         void setTime(Time t1, Time t2);
@@ -55,8 +58,19 @@ namespace QuantLib {
                                           const Array& r, Real s) const;
         Array preconditioner(const Array& r, Real s) const;
 
+        void apply(const Array& r, Array& result) const;
+        void apply_mixed(const Array& r, Array& result) const;
+        void apply_direction(Size direction, const Array& r,
+                             Array& result) const;
+        void solve_splitting(Size direction, const Array& r, Real s,
+                             Array& result) const;
+
         std::vector<SparseMatrix>  toMatrixDecomp() const;
       private:
+        // the coefficients set by the last call of setTime
+        const TripleBandLinearOp& map() const {
+            return cachedMap_ ? *cachedMap_ : mapT_;
+        }
         const std::shared_ptr<FdmMesher> mesher_;
         const std::shared_ptr<YieldTermStructure> rTS_, qTS_;
         const std::shared_ptr<BlackVolTermStructure> volTS_;
@@ -65,9 +79,12 @@ namespace QuantLib {
         const FirstDerivativeOp  dxMap_;
         const TripleBandLinearOp dxxMap_;
         TripleBandLinearOp mapT_;
+        std::shared_ptr<const TripleBandLinearOp> cachedMap_;
         const Real strike_;
         const Real illegalLocalVolOverwrite_;
         const Size direction_;
+        const std::shared_ptr<FdmCoefficientCache> cache_;
+        mutable Array tmp_;
     };
 }
 
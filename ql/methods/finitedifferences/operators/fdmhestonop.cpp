@@ -60,6 +60,9 @@ namespace QuantLib {
     }
 
     void FdmHestonEquityPart::setTime(Time t1, Time t2) {
+        cachedMap_.reset();
+        cachedL_.reset();
+
         const Rate r = rTS_->forwardRate(t1, t2, Continuous).rate();
         const Rate q = qTS_->forwardRate(t1, t2, Continuous).rate();
 
@@ -78,6 +81,13 @@ namespace QuantLib {
         }
     }
 
+    void FdmHestonEquityPart::setTime(
+                        const std::shared_ptr<const TripleBandLinearOp>& map,
+                        const std::shared_ptr<const Array>& L) {
+        cachedMap_ = map;
+        cachedL_ = L;
+    }
+
     Array FdmHestonEquityPart::getLeverageFctSlice(Time t1, Time t2)
     const {
         const std::shared_ptr<FdmLinearOpLayout> layout=mesher_->layout();
@@ -109,7 +119,7 @@ namespace QuantLib {
 
 
     const TripleBandLinearOp& FdmHestonEquityPart::getMap() const {
-        return mapT_;
+        return cachedMap_ ? *cachedMap_ : mapT_;
     }
 
     FdmHestonVariancePart::FdmHestonVariancePart(
@@ -125,19 +135,26 @@ namespace QuantLib {
     }
 
     void FdmHestonVariancePart::setTime(Time t1, Time t2) {
+        cachedMap_.reset();
         const Rate r = rTS_->forwardRate(t1, t2, Continuous).rate();
         mapT_.axpyb(Array(), dyMap_, dyMap_, Array(1,-0.5*r));
     }
 
+    void FdmHestonVariancePart::setTime(
+                       const std::shared_ptr<const TripleBandLinearOp>& map) {
+        cachedMap_ = map;
+    }
+
     const TripleBandLinearOp& FdmHestonVariancePart::getMap() const {
-        return mapT_;
+        return cachedMap_ ? *cachedMap_ : mapT_;
     }
 
     FdmHestonOp::FdmHestonOp(
         const std::shared_ptr<FdmMesher>& mesher,
         const std::shared_ptr<HestonProcess> & hestonProcess,
         const std::shared_ptr<FdmQuantoHelper>& quantoHelper,
-        const std::shared_ptr<LocalVolTermStructure>& leverageFct)
+        const std::shared_ptr<LocalVolTermStructure>& leverageFct,
+        const std::shared_ptr<FdmCoefficientCache>& cache)
     : correlationMap_(SecondOrderMixedDerivativeOp(0, 1, mesher)
                         .mult(hestonProcess->rho()*hestonProcess->sigma()
                                 *mesher->locations(1))),
@@ -149,13 +166,47 @@ namespace QuantLib {
              hestonProcess->riskFreeRate().currentLink(), 
              hestonProcess->dividendYield().currentLink(),
              quantoHelper, leverageFct),
-      leverageFct_(leverageFct) {
+      leverageFct_(leverageFct),
+      cache_(cache) {
+        QL_REQUIRE(!cache_ || cache_->mesher() == mesher,
+                   "coefficient cache built on a different mesher");
+        if (cache_) {
+            // the cached coefficients depend on the variance-process
+            // parameters, but not on the correlation
+            cache_->bind(typeid(FdmHestonOp),
+                         { hestonProcess->kappa(), hestonProcess->theta(),
+                           hestonProcess->sigma() },
+                         { hestonProcess, quantoHelper, leverageFct });
+        }
     }
 
 
     void FdmHestonOp::setTime(Time t1, Time t2) {
+        if (cache_) {
+            const std::shared_ptr<const FdmCoefficientCache::Entry> entry
+                = cache_->find(t1, t2);
+            if (entry) {
+                // the maps are shared with the cache, not copied
+                dxMap_.setTime(
+                    std::shared_ptr<const TripleBandLinearOp>(
+                                                   entry, &entry->maps[0]),
+                    std::shared_ptr<const Array>(entry, &entry->arrays[0]));
+                dyMap_.setTime(std::shared_ptr<const TripleBandLinearOp>(
+                                                   entry, &entry->maps[1]));
+                return;
+            }
+        }
+
         dxMap_.setTime(t1, t2);
         dyMap_.setTime(t1, t2);
+
+        if (cache_) {
+            FdmCoefficientCache::Entry entry;
+            entry.maps.push_back(dxMap_.getMap());
+            entry.maps.push_back(dyMap_.getMap());
+            entry.arrays.push_back(dxMap_.getL());
+            cache_->store(t1, t2, std::move(entry));
+        }
     }
 
     Size FdmHestonOp::size() const {
@@ -201,6 +252,39 @@ namespace QuantLib {
         return solve_splitting(0, r, dt);
     }
 
+    void FdmHestonOp::apply(const Array& u, Array& result) const {
+        dyMap_.getMap().apply(u, result);
+        dxMap_.getMap().apply(u, tmp_);
+        result += tmp_;
+        apply_mixed(u, tmp_);
+        result += tmp_;
+    }
+
+    void FdmHestonOp::apply_direction(Size direction, const Array& r,
+                                      Array& result) const {
+        if (direction == 0)
+            dxMap_.getMap().apply(r, result);
+        else if (direction == 1)
+            dyMap_.getMap().apply(r, result);
+        else
+            QL_FAIL("direction too large");
+    }
+
+    void FdmHestonOp::apply_mixed(const Array& r, Array& result) const {
+        correlationMap_.apply(r, result);
+        result *= dxMap_.getL();
+    }
+
+    void FdmHestonOp::solve_splitting(Size direction, const Array& r,
+                                      Real a, Array& result) const {
+        if (direction == 0)
+            dxMap_.getMap().solve_splitting(r, a, 1.0, result, tmp_);
+        else if (direction == 1)
+            dyMap_.getMap().solve_splitting(r, a, 1.0, result, tmp_);
+        else
+            QL_FAIL("direction too large");
+    }
+
     std::vector<SparseMatrix> 
     FdmHestonOp::toMatrixDecomp() const {
         std::vector<SparseMatrix> retVal(3);
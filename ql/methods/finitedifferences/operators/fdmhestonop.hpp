@@ -29,6 +29,7 @@
 
 #include <ql/processes/hestonprocess.hpp>
 #include <ql/methods/finitedifferences/utilities/fdmquantohelper.hpp>
+#include <ql/methods/finitedifferences/utilities/fdmcoefficientcache.hpp>
 #include <ql/methods/finitedifferences/operators/firstderivativeop.hpp>
 #include <ql/methods/finitedifferences/operators/triplebandlinearop.hpp>
 #include <ql/methods/finitedifferences/operators/ninepointlinearop.hpp>
@@ -48,8 +49,11 @@ namespace QuantLib {
                 = std::shared_ptr<LocalVolTermStructure>());
 
         void setTime(Time t1, Time t2);
+        //! uses the coefficients computed by a former call of setTime
+        void setTime(const std::shared_ptr<const TripleBandLinearOp>& map,
+                     const std::shared_ptr<const Array>& L);
         const TripleBandLinearOp& getMap() const;
-        const Array& getL() const { return L_; }
+        const Array& getL() const { return cachedL_ ? *cachedL_ : L_; }
 
       protected:
         Array getLeverageFctSlice(Time t1, Time t2) const;
@@ -63,6 +67,9 @@ namespace QuantLib {
         const std::shared_ptr<YieldTermStructure> rTS_, qTS_;
         const std::shared_ptr<FdmQuantoHelper> quantoHelper_;
         const std::shared_ptr<LocalVolTermStructure> leverageFct_;
+
+        std::shared_ptr<const TripleBandLinearOp> cachedMap_;
+        std::shared_ptr<const Array> cachedL_;
     };
 
     class FdmHestonVariancePart {
@@ -73,6 +80,8 @@ namespace QuantLib {
             Real sigma, Real kappa, Real theta);
 
         void setTime(Time t1, Time t2);
+        //! uses the coefficients computed by a former call of setTime
+        void setTime(const std::shared_ptr<const TripleBandLinearOp>& map);
         const TripleBandLinearOp& getMap() const;
 
       protected:
@@ -80,6 +89,8 @@ namespace QuantLib {
         TripleBandLinearOp mapT_;
 
         const std::shared_ptr<YieldTermStructure> rTS_;
+
+        std::shared_ptr<const TripleBandLinearOp> cachedMap_;
     };
 
 
@@ -91,7 +102,9 @@ namespace QuantLib {
             const std::shared_ptr<FdmQuantoHelper>& quantoHelper
                 = std::shared_ptr<FdmQuantoHelper>(),
             const std::shared_ptr<LocalVolTermStructure>& leverageFct
-                = std::shared_ptr<LocalVolTermStructure>());
+                = std::shared_ptr<LocalVolTermStructure>(),
+            const std::shared_ptr<FdmCoefficientCache>& cache
+                = std::shared_ptr<FdmCoefficientCache>());
 
         Size size() const;
         void setTime(Time t1, Time t2);
@@ -105,12 +118,21 @@ namespace QuantLib {
                                           const Array& r, Real s) const;
         Array preconditioner(const Array& r, Real s) const;
 
+        void apply(const Array& r, Array& result) const;
+        void apply_mixed(const Array& r, Array& result) const;
+        void apply_direction(Size direction, const Array& r,
+                             Array& result) const;
+        void solve_splitting(Size direction, const Array& r, Real s,
+                             Array& result) const;
+
         std::vector<SparseMatrix>  toMatrixDecomp() const;
       private:
         NinePointLinearOp correlationMap_;
         FdmHestonVariancePart dyMap_;
         FdmHestonEquityPart dxMap_;
         const std::shared_ptr<LocalVolTermStructure> leverageFct_;
+        const std::shared_ptr<FdmCoefficientCache> cache_;
+        mutable Array tmp_;
     };
 }
 
@@ -36,6 +36,15 @@ namespace QuantLib {
         typedef Array array_type;
         virtual ~FdmLinearOp() { }
         virtual array_type apply(const array_type& r) const = 0;
+        //! stores apply(r) in result, which must not be r
+        /*! The default implementation calls the method above;
+            operators used in time-stepping schemes override it so
+            that the result is written in place, without allocating
+            memory when result has already the right size.
+        */
+        virtual void apply(const array_type& r, array_type& result) const {
+            result = apply(r);
+        }
 
         virtual SparseMatrix toMatrix() const = 0;
     };
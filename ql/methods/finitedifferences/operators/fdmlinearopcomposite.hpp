@@ -49,6 +49,29 @@ namespace QuantLib {
         virtual Array 
             preconditioner(const Array& r, Real s) const = 0;
 
+        //! \name In-place variants
+        /*! These store their results in the given array, which must
+            not be the input array; the default implementations call
+            the corresponding methods above.
+
+            \warning Overrides can use workspace held by the operator,
+                     so the in-place methods must not be called
+                     concurrently on the same instance.
+        */
+        //@{
+        virtual void apply_mixed(const Array& r, Array& result) const {
+            result = apply_mixed(r);
+        }
+        virtual void apply_direction(Size direction, const Array& r,
+                                     Array& result) const {
+            result = apply_direction(direction, r);
+        }
+        virtual void solve_splitting(Size direction, const Array& r, Real s,
+                                     Array& result) const {
+            result = solve_splitting(direction, r, s);
+        }
+        //@}
+
         virtual std::vector<SparseMatrix>  toMatrixDecomp() const {
             QL_FAIL("FdmLinearOpComposite::toMatrixDecomp not implemented");
         }
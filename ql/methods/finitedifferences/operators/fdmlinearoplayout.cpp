@@ -19,7 +19,9 @@
  FOR A PARTICULAR PURPOSE.  See the license for more details.
 */
 
+#include <ql/errors.hpp>
 #include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
+#include <algorithm>
 
 namespace QuantLib {
 
@@ -85,4 +87,70 @@ namespace QuantLib {
 
         return retVal;
     }
+
+    std::shared_ptr<const std::vector<Size> >
+    FdmLinearOpLayout::neighbourhoods(Size i, Integer offset) const {
+        QL_REQUIRE(i < dim_.size(), "invalid direction " << i);
+
+        std::lock_guard<std::mutex> lock(tables_->mutex);
+        table_type& table = tables_->neighbourhoods[
+            std::make_tuple(i, offset, i, Integer(0))];
+        if (!table) {
+            std::vector<Size> indices(size_);
+            const FdmLinearOpIterator endIter = end();
+            for (FdmLinearOpIterator iter = begin(); iter != endIter; ++iter)
+                indices[iter.index()] = neighbourhood(iter, i, offset);
+            table = std::make_shared<const std::vector<Size> >(
+                std::move(indices));
+        }
+        return table;
+    }
+
+    std::shared_ptr<const std::vector<Size> >
+    FdmLinearOpLayout::neighbourhoods(Size i1, Integer offset1,
+                                      Size i2, Integer offset2) const {
+        QL_REQUIRE(i1 < dim_.size() && i2 < dim_.size() && i1 != i2,
+                   "invalid directions " << i1 << " and " << i2);
+
+        std::lock_guard<std::mutex> lock(tables_->mutex);
+        table_type& table = tables_->neighbourhoods[
+            std::make_tuple(i1, offset1, i2, offset2)];
+        if (!table) {
+            std::vector<Size> indices(size_);
+            const FdmLinearOpIterator endIter = end();
+            for (FdmLinearOpIterator iter = begin(); iter != endIter; ++iter)
+                indices[iter.index()] =
+                    neighbourhood(iter, i1, offset1, i2, offset2);
+            table = std::make_shared<const std::vector<Size> >(
+                std::move(indices));
+        }
+        return table;
+    }
+
+    std::shared_ptr<const std::vector<Size> >
+    FdmLinearOpLayout::reverseIndex(Size i) const {
+        QL_REQUIRE(i < dim_.size(), "invalid direction " << i);
+
+        std::lock_guard<std::mutex> lock(tables_->mutex);
+        table_type& table = tables_->reverseIndices[i];
+        if (!table) {
+            std::vector<Size> newDim(dim_);
+            std::iter_swap(newDim.begin(), newDim.begin() + i);
+            std::vector<Size> newSpacing = FdmLinearOpLayout(newDim).spacing();
+            std::iter_swap(newSpacing.begin(), newSpacing.begin() + i);
+
+            std::vector<Size> indices(size_);
+            const FdmLinearOpIterator endIter = end();
+            for (FdmLinearOpIterator iter = begin(); iter != endIter; ++iter) {
+                const std::vector<Size>& coordinates = iter.coordinates();
+                const Size newIndex =
+                    std::inner_product(coordinates.begin(), coordinates.end(),
+                                       newSpacing.begin(), Size(0));
+                indices[newIndex] = iter.index();
+            }
+            table = std::make_shared<const std::vector<Size> >(
+                std::move(indices));
+        }
+        return table;
+    }
 }
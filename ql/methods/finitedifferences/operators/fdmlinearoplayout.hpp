@@ -28,13 +28,18 @@
 
 #include <ql/methods/finitedifferences/operators/fdmlinearopiterator.hpp>
 #include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
 
 namespace QuantLib {
 
     class FdmLinearOpLayout {
       public:
         explicit FdmLinearOpLayout(const std::vector<Size>& dim)
-        : dim_(dim), spacing_(dim.size()) {
+        : dim_(dim), spacing_(dim.size()),
+          tables_(std::make_shared<IndexTables>()) {
             spacing_[0] = 1;
             std::partial_sum(dim.begin(), dim.end()-1,
                 spacing_.begin()+1, std::multiplies<Size>());
@@ -79,9 +84,40 @@ namespace QuantLib {
         FdmLinearOpIterator iter_neighbourhood(
             const FdmLinearOpIterator& iterator, Size i, Integer offset) const;
 
+        //! \name Index tables
+        /*! The tables below hold, for each point of the layout, the
+            index returned by the corresponding method above; they are
+            built in a single pass on first use and shared by all the
+            operators defined on this layout, so that building an
+            operator does not require walking the grid.  Tables are
+            kept for the lifetime of the layout.  Requesting them is
+            thread-safe.
+        */
+        //@{
+        std::shared_ptr<const std::vector<Size> > neighbourhoods(
+            Size i, Integer offset) const;
+
+        std::shared_ptr<const std::vector<Size> > neighbourhoods(
+            Size i1, Integer offset1, Size i2, Integer offset2) const;
+
+        /*! indices of the points sorted so that direction i moves
+            fastest, i.e., as lines along direction i. */
+        std::shared_ptr<const std::vector<Size> > reverseIndex(Size i) const;
+        //@}
+
       private:
+        typedef std::shared_ptr<const std::vector<Size> > table_type;
+        struct IndexTables {
+            std::mutex mutex;
+            std::map<std::tuple<Size, Integer, Size, Integer>,
+                     table_type> neighbourhoods;
+            std::map<Size, table_type> reverseIndices;
+        };
+
         Size size_;
         std::vector<Size> dim_, spacing_;
+        // copies of a layout share its tables
+        std::shared_ptr<IndexTables> tables_;
     };
 }
 
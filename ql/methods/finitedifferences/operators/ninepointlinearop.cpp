@@ -29,14 +29,6 @@ namespace QuantLib {
         Size d0, Size d1,
         const std::shared_ptr<FdmMesher>& mesher)
     : d0_(d0), d1_(d1),
-      i00_(mesher->layout()->size()),
-      i10_(mesher->layout()->size()),
-      i20_(mesher->layout()->size()),
-      i01_(mesher->layout()->size()),
-      i21_(mesher->layout()->size()),
-      i02_(mesher->layout()->size()),
-      i12_(mesher->layout()->size()),
-      i22_(mesher->layout()->size()),
       a00_(mesher->layout()->size()),
       a10_(mesher->layout()->size()),
       a20_(mesher->layout()->size()),
@@ -54,43 +46,53 @@ namespace QuantLib {
             "inconsistent derivative directions");
 
         const std::shared_ptr<FdmLinearOpLayout> layout = mesher->layout();
-        const FdmLinearOpIterator endIter = layout->end();
-
-        for (FdmLinearOpIterator iter = layout->begin(); iter!=endIter; ++iter) {
-            const Size i = iter.index();
-
-            i10_[i] = layout->neighbourhood(iter, d1_, -1);
-            i01_[i] = layout->neighbourhood(iter, d0_, -1);
-            i21_[i] = layout->neighbourhood(iter, d0_,  1);
-            i12_[i] = layout->neighbourhood(iter, d1_,  1);
-            i00_[i] = layout->neighbourhood(iter, d0_, -1, d1_, -1);
-            i20_[i] = layout->neighbourhood(iter, d0_,  1, d1_, -1);
-            i02_[i] = layout->neighbourhood(iter, d0_, -1, d1_,  1);
-            i22_[i] = layout->neighbourhood(iter, d0_,  1, d1_,  1);
-        }
+
+        i10_ = layout->neighbourhoods(d1_, -1);
+        i01_ = layout->neighbourhoods(d0_, -1);
+        i21_ = layout->neighbourhoods(d0_,  1);
+        i12_ = layout->neighbourhoods(d1_,  1);
+        i00_ = layout->neighbourhoods(d0_, -1, d1_, -1);
+        i20_ = layout->neighbourhoods(d0_,  1, d1_, -1);
+        i02_ = layout->neighbourhoods(d0_, -1, d1_,  1);
+        i22_ = layout->neighbourhoods(d0_,  1, d1_,  1);
     }
 
     Array NinePointLinearOp::apply(const Array& u)
         const {
+        Array retVal(u.size());
+        apply(u, retVal);
+        return retVal;
+    }
+
+    void NinePointLinearOp::apply(const Array& u, Array& retVal) const {
 
         const std::shared_ptr<FdmLinearOpLayout> index=mesher_->layout();
         QL_REQUIRE(u.size() == index->size(),"inconsistent length of r "
                     << u.size() << " vs " << index->size());
 
-        Array retVal(u.size());
+        if (retVal.size() != u.size())
+            retVal = Array(u.size());
+
+        const std::vector<Size>& i00 = *i00_;
+        const std::vector<Size>& i01 = *i01_;
+        const std::vector<Size>& i02 = *i02_;
+        const std::vector<Size>& i10 = *i10_;
+        const std::vector<Size>& i12 = *i12_;
+        const std::vector<Size>& i20 = *i20_;
+        const std::vector<Size>& i21 = *i21_;
+        const std::vector<Size>& i22 = *i22_;
         // #pragma omp parallel for
         for (Size i=0; i < retVal.size(); ++i) {
-            retVal[i] =   a00_[i]*u[i00_[i]]
-                        + a01_[i]*u[i01_[i]]
-                        + a02_[i]*u[i02_[i]]
-                        + a10_[i]*u[i10_[i]]
+            retVal[i] =   a00_[i]*u[i00[i]]
+                        + a01_[i]*u[i01[i]]
+                        + a02_[i]*u[i02[i]]
+                        + a10_[i]*u[i10[i]]
                         + a11_[i]*u[i]
-                        + a12_[i]*u[i12_[i]]
-                        + a20_[i]*u[i20_[i]]
-                        + a21_[i]*u[i21_[i]]
-                        + a22_[i]*u[i22_[i]];
+                        + a12_[i]*u[i12[i]]
+                        + a20_[i]*u[i20[i]]
+                        + a21_[i]*u[i21[i]]
+                        + a22_[i]*u[i22[i]];
         }
-        return retVal;
     }
 
     SparseMatrix NinePointLinearOp::toMatrix() const {
@@ -99,15 +101,15 @@ namespace QuantLib {
 
         SparseMatrix retVal(n, n, 9*n);
         for (Size i=0; i < index->size(); ++i) {
-            retVal(i, i00_[i]) += a00_[i];
-            retVal(i, i01_[i]) += a01_[i];
-            retVal(i, i02_[i]) += a02_[i];
-            retVal(i, i10_[i]) += a10_[i];
-            retVal(i, i      ) += a11_[i];
-            retVal(i, i12_[i]) += a12_[i];
-            retVal(i, i20_[i]) += a20_[i];
-            retVal(i, i21_[i]) += a21_[i];
-            retVal(i, i22_[i]) += a22_[i];
+            retVal(i, (*i00_)[i]) += a00_[i];
+            retVal(i, (*i01_)[i]) += a01_[i];
+            retVal(i, (*i02_)[i]) += a02_[i];
+            retVal(i, (*i10_)[i]) += a10_[i];
+            retVal(i, i         ) += a11_[i];
+            retVal(i, (*i12_)[i]) += a12_[i];
+            retVal(i, (*i20_)[i]) += a20_[i];
+            retVal(i, (*i21_)[i]) += a21_[i];
+            retVal(i, (*i22_)[i]) += a22_[i];
         }
 
         return retVal;
@@ -39,6 +39,7 @@ namespace QuantLib {
                 const std::shared_ptr<FdmMesher>& mesher);
 
         Array apply(const Array& r) const;
+        void apply(const Array& r, Array& result) const;
         NinePointLinearOp mult(const Array& u) const;
 
         void swap(NinePointLinearOp& m);
@@ -49,9 +50,10 @@ namespace QuantLib {
         NinePointLinearOp() {}
 
         Size d0_, d1_;
-        std::vector<Size> i00_, i10_, i20_;
-        std::vector<Size> i01_, i21_;
-        std::vector<Size> i02_, i12_, i22_;
+        // shared with the other operators on the same layout
+        std::shared_ptr<const std::vector<Size> > i00_, i10_, i20_;
+        std::shared_ptr<const std::vector<Size> > i01_, i21_;
+        std::shared_ptr<const std::vector<Size> > i02_, i12_, i22_;
         std::vector<Real> a00_, a10_, a20_;
         std::vector<Real> a01_, a11_, a21_;
         std::vector<Real> a02_, a12_, a22_;
@@ -24,42 +24,68 @@
 #include <ql/methods/finitedifferences/tridiagonaloperator.hpp>
 #include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
 #include <ql/methods/finitedifferences/operators/triplebandlinearop.hpp>
+#include <ql/methods/finitedifferences/utilities/fdmsettings.hpp>
+#include <ql/utilities/parallelfor.hpp>
 
 namespace QuantLib {
 
+    namespace {
+
+        /* Thomas algorithm for M independent lines of n points each,
+           stored one after the other in reverse-index order starting
+           from ri.  The lines are processed in lockstep so that the
+           innermost loops run across them and can be vectorized; the
+           operations on each line are the same as for a single one. */
+        template <Size M>
+        void solveLines(const Size* ri, Size n,
+                        const Real* lower, const Real* diag,
+                        const Real* upper, Real a, Real b,
+                        const Real* r, Real* x, Real* tmp) {
+            Size rim1[M];
+            Real bet[M];
+            for (Size k = 0; k < M; ++k) {
+                rim1[k] = ri[k*n];
+                bet[k] = 1.0 / (a * diag[rim1[k]] + b);
+                QL_REQUIRE(bet[k] != 0.0, "division by zero");
+                x[rim1[k]] = r[rim1[k]] * bet[k];
+            }
+
+            for (Size j = 1; j < n; ++j) {
+                bool singular = false;
+                for (Size k = 0; k < M; ++k) {
+                    const Size i = ri[k*n + j];
+                    const Real t = a * upper[rim1[k]] * bet[k];
+                    tmp[k*n + j] = t;
+
+                    const Real d = b + a * (diag[i] - t * lower[i]);
+                    singular = singular || d == 0.0;
+                    bet[k] = 1.0 / d;
+
+                    x[i] = (r[i] - a * lower[i] * x[rim1[k]]) * bet[k];
+                    rim1[k] = i;
+                }
+                QL_ENSURE(!singular, "division by zero");
+            }
+
+            for (Size j = n - 1; j-- > 0;) {
+                for (Size k = 0; k < M; ++k)
+                    x[ri[k*n + j]] -= tmp[k*n + j + 1] * x[ri[k*n + j + 1]];
+            }
+        }
+
+    }
+
     TripleBandLinearOp::TripleBandLinearOp(
             Size direction,
             const std::shared_ptr<FdmMesher> &mesher)
             : direction_(direction),
-              i0_(mesher->layout()->size()),
-              i2_(mesher->layout()->size()),
-              reverseIndex_(mesher->layout()->size()),
+              i0_(mesher->layout()->neighbourhoods(direction, -1)),
+              i2_(mesher->layout()->neighbourhoods(direction, 1)),
+              reverseIndex_(mesher->layout()->reverseIndex(direction)),
               lower_(mesher->layout()->size()),
               diag_(mesher->layout()->size()),
               upper_(mesher->layout()->size()),
-              mesher_(mesher) {
-
-        const std::shared_ptr<FdmLinearOpLayout> layout = mesher->layout();
-        const FdmLinearOpIterator endIter = layout->end();
-
-        std::vector<Size> newDim(layout->dim());
-        std::iter_swap(newDim.begin(), newDim.begin() + direction_);
-        std::vector<Size> newSpacing = FdmLinearOpLayout(newDim).spacing();
-        std::iter_swap(newSpacing.begin(), newSpacing.begin() + direction_);
-
-        for (FdmLinearOpIterator iter = layout->begin(); iter != endIter; ++iter) {
-            const Size i = iter.index();
-
-            i0_[i] = layout->neighbourhood(iter, direction, -1);
-            i2_[i] = layout->neighbourhood(iter, direction, 1);
-
-            const std::vector<Size> &coordinates = iter.coordinates();
-            const Size newIndex =
-                    std::inner_product(coordinates.begin(), coordinates.end(),
-                                       newSpacing.begin(), Size(0));
-            reverseIndex_[newIndex] = i;
-        }
-    }
+              mesher_(mesher) {}
 
     void TripleBandLinearOp::swap(TripleBandLinearOp &m) {
         std::swap(mesher_, m.mesher_);
@@ -237,18 +263,24 @@ namespace QuantLib {
     }
 
     Array TripleBandLinearOp::apply(const Array &r) const {
+        array_type retVal(r.size());
+        apply(r, retVal);
+        return retVal;
+    }
+
+    void TripleBandLinearOp::apply(const Array &r, Array &retVal) const {
         const std::shared_ptr<FdmLinearOpLayout> index = mesher_->layout();
 
         QL_REQUIRE(r.size() == index->size(), "inconsistent length of r");
 
-
-        array_type retVal(r.size());
+        if (retVal.size() != r.size())
+            retVal = Array(r.size());
+        const std::vector<Size>& i0 = *i0_;
+        const std::vector<Size>& i2 = *i2_;
         // #pragma omp parallel for
         for (Size i = 0; i < index->size(); ++i) {
-            retVal[i] = r[i0_[i]] * lower_[i] + r[i] * diag_[i] + r[i2_[i]] * upper_[i];
+            retVal[i] = r[i0[i]] * lower_[i] + r[i] * diag_[i] + r[i2[i]] * upper_[i];
         }
-
-        return retVal;
     }
 
     SparseMatrix TripleBandLinearOp::toMatrix() const {
@@ -257,9 +289,9 @@ namespace QuantLib {
 
         SparseMatrix retVal(n, n, 3 * n);
         for (Size i = 0; i < n; ++i) {
-            retVal(i, i0_[i]) += lower_[i];
+            retVal(i, (*i0_)[i]) += lower_[i];
             retVal(i, i) += diag_[i];
-            retVal(i, i2_[i]) += upper_[i];
+            retVal(i, (*i2_)[i]) += upper_[i];
         }
 
         return retVal;
@@ -268,6 +300,13 @@ namespace QuantLib {
 
     Array
     TripleBandLinearOp::solve_splitting(const Array &r, Real a, Real b) const {
+        Array retVal(r.size()), tmp(r.size());
+        solve_splitting(r, a, b, retVal, tmp);
+        return retVal;
+    }
+
+    void TripleBandLinearOp::solve_splitting(const Array &r, Real a, Real b,
+                                             Array &retVal, Array &tmp) const {
         const std::shared_ptr<FdmLinearOpLayout> layout = mesher_->layout();
         QL_REQUIRE(r.size() == layout->size(), "inconsistent size of rhs");
 
@@ -282,33 +321,47 @@ namespace QuantLib {
         }
 #endif
 
-        Array retVal(r.size()), tmp(r.size());
-
-
-        // Thomson algorithm to solve a tridiagonal system.
-        // Example code taken from Tridiagonalopertor and
-        // changed to fit for the triple band operator.
-        Size rim1 = reverseIndex_[0];
-        Real bet = 1.0 / (a * diag_[rim1] + b);
-        QL_REQUIRE(bet != 0.0, "division by zero");
-        retVal[reverseIndex_[0]] = r[rim1] * bet;
-
-        for (Size j = 1; j <= layout->size() - 1; j++) {
-            const Size ri = reverseIndex_[j];
-            tmp[j] = a * upper_[rim1] * bet;
-
-            bet = b + a * (diag_[ri] - tmp[j] * lower_[ri]);
-            QL_ENSURE(bet != 0.0, "division by zero");
-            bet = 1.0 / bet;
-
-            retVal[ri] = (r[ri] - a * lower_[ri] * retVal[rim1]) * bet;
-            rim1 = ri;
-        }
-        // cannot be j>=0 with Size j
-        for (Size j = layout->size() - 2; j > 0; --j)
-            retVal[reverseIndex_[j]] -= tmp[j + 1] * retVal[reverseIndex_[j + 1]];
-        retVal[reverseIndex_[0]] -= tmp[1] * retVal[reverseIndex_[1]];
-
-        return retVal;
+        if (retVal.size() != r.size())
+            retVal = Array(r.size());
+        if (tmp.size() != r.size())
+            tmp = Array(r.size());
+
+        // The system decouples into independent lines along the
+        // operator direction, which are contiguous in reverse-index
+        // order since the boundary entries connecting them are null.
+        // Lines are solved in groups of four, and groups are
+        // distributed across threads if required and if the system
+        // is large enough for this to pay off.
+        const Size n = layout->dim()[direction_];
+        const Size lines = layout->size() / n;
+        const Size lanes = 4, groups = (lines + lanes - 1) / lanes;
+        const Size groupsPerTask = std::max<Size>(1, 4096 / (lanes * n));
+        const Size tasks = (groups + groupsPerTask - 1) / groupsPerTask;
+
+        const Real *lower = lower_.data(), *diag = diag_.data(),
+                   *upper = upper_.data();
+        const Real* rhs = r.data();
+        Real *x = retVal.data(), *t = tmp.data();
+        const Size* reverseIndex = reverseIndex_->data();
+
+        const FdmSettings& settings = FdmSettings::instance();
+        const Size threads =
+            layout->size() >= settings.minParallelSize()
+            ? settings.threads() : 1;
+
+        parallelFor(tasks, threads, [&](Size task) {
+            const Size first = task * groupsPerTask * lanes;
+            const Size last =
+                std::min(first + groupsPerTask * lanes, lines);
+            Size line = first;
+            for (; line + lanes <= last; line += lanes)
+                solveLines<lanes>(&reverseIndex[line*n], n,
+                                  lower, diag, upper, a, b,
+                                  rhs, x, t + line*n);
+            for (; line < last; ++line)
+                solveLines<1>(&reverseIndex[line*n], n,
+                              lower, diag, upper, a, b,
+                              rhs, x, t + line*n);
+        });
     }
 }
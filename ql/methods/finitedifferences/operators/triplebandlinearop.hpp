@@ -39,8 +39,15 @@ namespace QuantLib {
                            const std::shared_ptr<FdmMesher>& mesher);
 
         Array apply(const Array& r) const;
+        void apply(const Array& r, Array& result) const;
         Array solve_splitting(const Array& r, Real a,
                                           Real b = 1.0) const;
+        //! in-place variant; tmp is used as workspace
+        /*! result and tmp are resized if needed; neither of them can
+            be r.
+        */
+        void solve_splitting(const Array& r, Real a, Real b,
+                             Array& result, Array& tmp) const;
 
         TripleBandLinearOp mult(const Array& u) const;
         // interpret u as the diagonal of a diagonal matrix, multiplied on LHS
@@ -61,8 +68,9 @@ namespace QuantLib {
         TripleBandLinearOp() {}
 
         Size direction_;
-        std::vector<Size> i0_, i2_;
-        std::vector<Size> reverseIndex_;
+        // shared with the other operators on the same layout
+        std::shared_ptr<const std::vector<Size> > i0_, i2_;
+        std::shared_ptr<const std::vector<Size> > reverseIndex_;
         std::vector<Real> lower_, diag_, upper_;
 
         std::shared_ptr<FdmMesher> mesher_;
@@ -55,6 +55,8 @@ namespace QuantLib {
         const Real mu_;
         const std::shared_ptr<FdmLinearOpComposite> map_;
         const BoundaryConditionSchemeHelper bcSet_;
+        // workspace reused across steps
+        Array y_, y0_, yt_, rhs_, diff_;
     };
 }
 
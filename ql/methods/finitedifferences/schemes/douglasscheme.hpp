@@ -54,6 +54,8 @@ namespace QuantLib {
         const Real theta_;
         const std::shared_ptr<FdmLinearOpComposite> map_;
         const BoundaryConditionSchemeHelper bcSet_;
+        // workspace reused across steps
+        Array y_, rhs_;
     };
 }
 
@@ -34,7 +34,9 @@ namespace QuantLib {
         bcSet_.setTime(std::max(0.0, t-dt_));
 
         bcSet_.applyBeforeApplying(*map_);
-        a += dt_ * map_->apply(a);
+        map_->apply(a, y_);
+        y_ *= dt_;
+        a += y_;
         bcSet_.applyAfterApplying(a);
     }
 
@@ -32,13 +32,15 @@ namespace QuantLib {
         const FdmSolverDesc& solverDesc,
         const FdmSchemeDesc& schemeDesc,
         bool localVol,
-        Real illegalLocalVolOverwrite)
+        Real illegalLocalVolOverwrite,
+        const std::shared_ptr<FdmCoefficientCache>& cache)
     : process_(process),
       strike_(strike),
       solverDesc_(solverDesc),
       schemeDesc_(schemeDesc),
       localVol_(localVol),
-      illegalLocalVolOverwrite_(illegalLocalVolOverwrite) {
+      illegalLocalVolOverwrite_(illegalLocalVolOverwrite),
+      cache_(cache) {
 
         registerWith(process_);
     }
@@ -46,7 +48,7 @@ namespace QuantLib {
     void FdmBlackScholesSolver::performCalculations() const {
         const std::shared_ptr<FdmBlackScholesOp> op(new FdmBlackScholesOp(
                 solverDesc_.mesher, process_.currentLink(), strike_,
-                localVol_, illegalLocalVolOverwrite_));
+                localVol_, illegalLocalVolOverwrite_, 0, cache_));
 
         solver_ = std::shared_ptr<Fdm1DimSolver>(
             new Fdm1DimSolver(solverDesc_, schemeDesc_, op));
@@ -29,6 +29,7 @@
 #include <ql/patterns/lazyobject.hpp>
 #include <ql/methods/finitedifferences/solvers/fdmsolverdesc.hpp>
 #include <ql/methods/finitedifferences/solvers/fdmbackwardsolver.hpp>
+#include <ql/methods/finitedifferences/utilities/fdmcoefficientcache.hpp>
 
 namespace QuantLib {
 
@@ -44,7 +45,9 @@ namespace QuantLib {
             const FdmSolverDesc& solverDesc,
             const FdmSchemeDesc& schemeDesc = FdmSchemeDesc::Douglas(),
             bool localVol = false,
-            Real illegalLocalVolOverwrite = -Null<Real>());
+            Real illegalLocalVolOverwrite = -Null<Real>(),
+            const std::shared_ptr<FdmCoefficientCache>& cache
+                = std::shared_ptr<FdmCoefficientCache>());
 
         Real valueAt(Real s) const;
         Real deltaAt(Real s) const;
@@ -61,6 +64,7 @@ namespace QuantLib {
         const FdmSchemeDesc schemeDesc_;
         const bool localVol_;
         const Real illegalLocalVolOverwrite_;
+        const std::shared_ptr<FdmCoefficientCache> cache_;
 
         mutable std::shared_ptr<Fdm1DimSolver> solver_;
     };
@@ -32,12 +32,14 @@ namespace QuantLib {
         const FdmSolverDesc& solverDesc,
         const FdmSchemeDesc& schemeDesc,
         const Handle<FdmQuantoHelper>& quantoHelper,
-        const std::shared_ptr<LocalVolTermStructure>& leverageFct)
+        const std::shared_ptr<LocalVolTermStructure>& leverageFct,
+        const std::shared_ptr<FdmCoefficientCache>& cache)
     : process_(process),
       solverDesc_(solverDesc),
       schemeDesc_(schemeDesc),
       quantoHelper_(quantoHelper),
-      leverageFct_(leverageFct){
+      leverageFct_(leverageFct),
+      cache_(cache) {
 
         registerWith(process_);
         registerWith(quantoHelper_);
@@ -49,7 +51,7 @@ namespace QuantLib {
                 solverDesc_.mesher, process_.currentLink(),
                 (!quantoHelper_.empty()) ? quantoHelper_.currentLink()
                              : std::shared_ptr<FdmQuantoHelper>(),
-                leverageFct_));
+                leverageFct_, cache_));
 
         solver_ = std::shared_ptr<Fdm2DimSolver>(
                                new Fdm2DimSolver(solverDesc_, schemeDesc_, op));
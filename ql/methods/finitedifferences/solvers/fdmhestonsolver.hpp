@@ -29,6 +29,7 @@
 #include <ql/handle.hpp>
 #include <ql/patterns/lazyobject.hpp>
 #include <ql/methods/finitedifferences/utilities/fdmquantohelper.hpp>
+#include <ql/methods/finitedifferences/utilities/fdmcoefficientcache.hpp>
 #include <ql/methods/finitedifferences/solvers/fdmsolverdesc.hpp>
 #include <ql/methods/finitedifferences/solvers/fdmbackwardsolver.hpp>
 #include <ql/methods/finitedifferences/utilities/fdmdirichletboundary.hpp>
@@ -48,7 +49,9 @@ namespace QuantLib {
             const Handle<FdmQuantoHelper>& quantoHelper
                                                 = Handle<FdmQuantoHelper>(),
             const std::shared_ptr<LocalVolTermStructure>& leverageFct
-                = std::shared_ptr<LocalVolTermStructure>());
+                = std::shared_ptr<LocalVolTermStructure>(),
+            const std::shared_ptr<FdmCoefficientCache>& cache
+                = std::shared_ptr<FdmCoefficientCache>());
 
         Real valueAt(Real s, Real v) const;
         Real thetaAt(Real s, Real v) const;
@@ -73,6 +76,7 @@ namespace QuantLib {
         const FdmSchemeDesc schemeDesc_;
         const Handle<FdmQuantoHelper> quantoHelper_;
         const std::shared_ptr<LocalVolTermStructure> leverageFct_;
+        const std::shared_ptr<FdmCoefficientCache> cache_;
 
         mutable std::shared_ptr<Fdm2DimSolver> solver_;
     };
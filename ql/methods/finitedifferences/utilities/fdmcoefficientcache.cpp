@@ -0,0 +1,123 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/methods/finitedifferences/meshers/fdmmesher.hpp>
+#include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
+#include <ql/methods/finitedifferences/utilities/fdmcoefficientcache.hpp>
+
+namespace QuantLib {
+
+    FdmCoefficientCache::FdmCoefficientCache(
+        const std::shared_ptr<FdmMesher>& mesher, Size maxMemory)
+    : mesher_(mesher), maxMemory_(maxMemory), op_(nullptr),
+      memoryUsage_(0) {
+        QL_REQUIRE(mesher_, "null mesher given");
+    }
+
+    std::shared_ptr<const FdmCoefficientCache::Entry>
+    FdmCoefficientCache::find(Time t1, Time t2) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const auto iter = entries_.find(std::make_pair(t1, t2));
+        return (iter != entries_.end()) ? iter->second
+                                        : std::shared_ptr<const Entry>();
+    }
+
+    bool FdmCoefficientCache::store(Time t1, Time t2, Entry entry) {
+        const Size bytes = memoryUsage(entry);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        const std::pair<Time, Time> key(t1, t2);
+        if (entries_.count(key) != 0)
+            return true;
+        if (bytes > maxMemory_ || memoryUsage_ > maxMemory_ - bytes)
+            return false;
+
+        entries_[key] = std::make_shared<const Entry>(std::move(entry));
+        memoryUsage_ += bytes;
+        return true;
+    }
+
+    void FdmCoefficientCache::clear() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        entries_.clear();
+        memoryUsage_ = 0;
+    }
+
+    void FdmCoefficientCache::bind(
+        const std::type_info& op,
+        const std::vector<Real>& parameters,
+        const std::vector<std::shared_ptr<Observable> >& marketData) {
+        bool changed;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (op_ == nullptr) {
+                op_ = &op;
+                parameters_ = parameters;
+            } else {
+                QL_REQUIRE(*op_ == op,
+                           "coefficient cache bound to a different operator");
+                QL_REQUIRE(parameters_ == parameters,
+                           "coefficient cache bound to an operator "
+                           "with different parameters");
+            }
+            // the coefficients depend on the market data
+            changed = (marketData_ != marketData);
+            if (changed) {
+                marketData_ = marketData;
+                entries_.clear();
+                memoryUsage_ = 0;
+            }
+        }
+        // outside the lock, which notifications take in clear()
+        if (changed) {
+            unregisterWithAll();
+            for (const auto& m : marketData)
+                registerWith(m);
+        }
+    }
+
+    void FdmCoefficientCache::update() {
+        clear();
+    }
+
+    const std::shared_ptr<FdmMesher>& FdmCoefficientCache::mesher() const {
+        return mesher_;
+    }
+
+    Size FdmCoefficientCache::size() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return entries_.size();
+    }
+
+    Size FdmCoefficientCache::memoryUsage() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return memoryUsage_;
+    }
+
+    Size FdmCoefficientCache::maxMemory() const {
+        return maxMemory_;
+    }
+
+    Size FdmCoefficientCache::memoryUsage(const Entry& entry) const {
+        // lower, diagonal and upper band of each map
+        Size n = 3*mesher_->layout()->size()*entry.maps.size();
+        for (const auto& a : entry.arrays)
+            n += a.size();
+        return n*sizeof(Real);
+    }
+
+}
@@ -0,0 +1,114 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fdmcoefficientcache.hpp
+    \brief cache of time-dependent operator coefficients
+*/
+
+#ifndef quantlib_fdm_coefficient_cache_hpp
+#define quantlib_fdm_coefficient_cache_hpp
+
+#include <ql/methods/finitedifferences/operators/triplebandlinearop.hpp>
+#include <ql/patterns/observable.hpp>
+#include <map>
+#include <mutex>
+#include <typeinfo>
+
+namespace QuantLib {
+
+    class FdmMesher;
+
+    //! cache of time-dependent operator coefficients
+    /*! Operators such as FdmBlackScholesOp and FdmHestonOp rebuild
+        their coefficients at each call of setTime.  When the same
+        operator is rolled back repeatedly over the same time grid,
+        e.g., for bumped re-pricing or for several payoffs on the same
+        mesher, the coefficients can instead be computed once per time
+        step and stored here.
+
+        Entries are keyed by the exact (t1, t2) pair passed to setTime.
+        The operators use the stored coefficients in place, so that a
+        hit doesn't copy them.
+        Once the memory budget is used up, further entries are not
+        stored and the operators recompute them at each step; the
+        entries already stored are kept, so that repeated roll-backs
+        keep hitting the same ones.
+
+        The operators bind the cache to their type and parameters
+        when built; operators of a different type, or with different
+        parameters (e.g., another strike) need a cache of their own.
+        The cache observes the market data the coefficients are
+        computed from, and discards its entries when notified.
+    */
+    class FdmCoefficientCache : public Observer {
+      public:
+        struct Entry {
+            std::vector<TripleBandLinearOp> maps;
+            std::vector<Array> arrays;
+        };
+
+        /*! \param maxMemory  upper bound, in bytes, on the memory
+                              taken by the stored coefficients.
+        */
+        FdmCoefficientCache(const std::shared_ptr<FdmMesher>& mesher,
+                            Size maxMemory);
+
+        //! returns a null pointer if no entry was stored for (t1, t2)
+        std::shared_ptr<const Entry> find(Time t1, Time t2) const;
+        /*! returns false, and discards the entry, if storing it would
+            exceed the memory budget.
+        */
+        bool store(Time t1, Time t2, Entry entry);
+        void clear();
+
+        /*! Binds the cache to the operators of the given type and
+            parameters; the first call records them and the following
+            ones require them to be the same.  The entries are
+            discarded if the market data differ from those of the
+            former call.
+        */
+        void bind(const std::type_info& op,
+                  const std::vector<Real>& parameters,
+                  const std::vector<std::shared_ptr<Observable> >&
+                                                              marketData);
+
+        void update();
+
+        const std::shared_ptr<FdmMesher>& mesher() const;
+        Size size() const;
+        Size memoryUsage() const;
+        Size maxMemory() const;
+
+      private:
+        Size memoryUsage(const Entry& entry) const;
+
+        const std::shared_ptr<FdmMesher> mesher_;
+        const Size maxMemory_;
+
+        const std::type_info* op_;
+        std::vector<Real> parameters_;
+        std::vector<std::shared_ptr<Observable> > marketData_;
+
+        mutable std::mutex mutex_;
+        std::map<std::pair<Time, Time>, std::shared_ptr<const Entry> >
+                                                                entries_;
+        Size memoryUsage_;
+    };
+
+}
+
+#endif
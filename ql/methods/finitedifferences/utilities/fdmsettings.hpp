@@ -0,0 +1,82 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fdmsettings.hpp
+    \brief run-time settings for finite-difference methods
+*/
+
+#ifndef quantlib_fdm_settings_hpp
+#define quantlib_fdm_settings_hpp
+
+#include <ql/patterns/singleton.hpp>
+#include <ql/types.hpp>
+
+namespace QuantLib {
+
+    //! global repository for run-time finite-difference settings
+    class FdmSettings : public Singleton<FdmSettings> {
+        friend class Singleton<FdmSettings>;
+      private:
+        FdmSettings();
+
+      public:
+        //! number of threads used by operators for independent work
+        /*! The tridiagonal systems solved by
+            TripleBandLinearOp::solve_splitting decouple into
+            independent lines along the operator direction; when
+            this is larger than 1, the lines are distributed across
+            as many threads.  The results don't depend on it.
+
+            The default is 1, so that engines running in parallel
+            at a higher level don't start threads of their own.
+        */
+        Size& threads();
+        Size threads() const;
+        //! minimum number of grid points for using several threads
+        /*! Smaller systems are solved on the calling thread, since
+            handing out their lines would cost more than solving
+            them.  The default is 16384.
+        */
+        Size& minParallelSize();
+        Size minParallelSize() const;
+      private:
+        Size threads_, minParallelSize_;
+    };
+
+
+    // inline definitions
+
+    inline Size& FdmSettings::threads() {
+        return threads_;
+    }
+
+    inline Size FdmSettings::threads() const {
+        return threads_;
+    }
+
+    inline Size& FdmSettings::minParallelSize() {
+        return minParallelSize_;
+    }
+
+    inline Size FdmSettings::minParallelSize() const {
+        return minParallelSize_;
+    }
+
+}
+
+
+#endif
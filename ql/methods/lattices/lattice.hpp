@@ -28,6 +28,7 @@
 #include <ql/numericalmethod.hpp>
 #include <ql/discretizedasset.hpp>
 #include <ql/patterns/curiouslyrecurring.hpp>
+#include <vector>
 
 namespace QuantLib {
 
@@ -51,6 +52,15 @@ namespace QuantLib {
                         Array& newValues) const;
         \endcode
 
+        The descendants and probabilities of the nodes are copied, the
+        first time each level is used, into contiguous arrays; the
+        discounts are not, since they might change during the life of
+        the lattice (e.g., when fitting the tree to a term structure).
+
+        State prices are computed once for each lattice; engines
+        pricing several instruments on the same tree share them.
+        See LatticeShortRateModelEngine.
+
         \ingroup lattices
     */
     template <class Impl>
@@ -61,8 +71,13 @@ namespace QuantLib {
                     Size n)
         : Lattice(timeGrid), n_(n) {
             QL_REQUIRE(n>0, "there is no zeronomial lattice!");
-            statePrices_ = std::vector<Array>(1, Array(1, 1.0));
+            // reserved so that references to the state prices at a
+            // given time are not invalidated when more are computed
+            statePrices_.reserve(timeGrid.size());
+            statePrices_.emplace_back(1, 1.0);
             statePricesLimit_ = 0;
+            descendants_.resize(timeGrid.size());
+            probabilities_.resize(timeGrid.size());
         }
 
         //! \name Lattice interface
@@ -87,25 +102,52 @@ namespace QuantLib {
         mutable std::vector<Array> statePrices_;
 
       private:
+        // descendants and probabilities at the i-th level, stored
+        // branch by branch
+        void computeBranching(Size i) const;
         Size n_;
         mutable Size statePricesLimit_;
+        mutable std::vector<std::vector<Size> > descendants_;
+        mutable std::vector<std::vector<Real> > probabilities_;
     };
 
 
     // template definitions
 
+    template <class Impl>
+    void TreeLattice<Impl>::computeBranching(Size i) const {
+        const Size size = this->impl().size(i);
+        std::vector<Size>& descendants = descendants_[i];
+        std::vector<Real>& probabilities = probabilities_[i];
+        descendants.resize(n_*size);
+        probabilities.resize(n_*size);
+        for (Size l=0; l<n_; l++) {
+            for (Size j=0; j<size; j++) {
+                descendants[l*size+j] = this->impl().descendant(i,j,l);
+                probabilities[l*size+j] = this->impl().probability(i,j,l);
+            }
+        }
+    }
+
     template <class Impl>
     void TreeLattice<Impl>::computeStatePrices(Size until) const {
         for (Size i=statePricesLimit_; i<until; i++) {
-            statePrices_.emplace_back(Array(this->impl().size(i+1), 0.0));
-            for (Size j=0; j<this->impl().size(i); j++) {
+            if (descendants_[i].empty())
+                computeBranching(i);
+            const Size size = this->impl().size(i);
+            const Size* descendants = descendants_[i].data();
+            const Real* probabilities = probabilities_[i].data();
+            const Array& statePrices = statePrices_[i];
+            Array nextStatePrices(this->impl().size(i+1), 0.0);
+            for (Size j=0; j<size; j++) {
                 DiscountFactor disc = this->impl().discount(i,j);
-                Real statePrice = statePrices_[i][j];
+                Real statePrice = statePrices[j];
                 for (Size l=0; l<n_; l++) {
-                    statePrices_[i+1][this->impl().descendant(i,j,l)] +=
-                        statePrice*disc*this->impl().probability(i,j,l);
+                    nextStatePrices[descendants[l*size+j]] +=
+                        statePrice*disc*probabilities[l*size+j];
                 }
             }
+            statePrices_.push_back(std::move(nextStatePrices));
         }
         statePricesLimit_ = until;
     }
@@ -152,11 +194,16 @@ namespace QuantLib {
         Integer iFrom = Integer(t_.index(from));
         Integer iTo = Integer(t_.index(to));
 
+        // the two buffers are swapped at each step; since the sizes of
+        // the levels don't increase going backwards, no further
+        // allocation is needed after the first step
+        Array& values = asset.values();
+        Array newValues;
         for (Integer i=iFrom-1; i>=iTo; --i) {
-            Array newValues(this->impl().size(i));
-            this->impl().stepback(i, asset.values(), newValues);
+            newValues.resize(this->impl().size(i));
+            this->impl().stepback(i, values, newValues);
             asset.time() = t_[i];
-            asset.values() = newValues;
+            values.swap(newValues);
             // skip the very last adjustment
             if (i != iTo)
                 asset.adjustValues();
@@ -166,16 +213,25 @@ namespace QuantLib {
     template <class Impl>
     void TreeLattice<Impl>::stepback(Size i, const Array& values,
                                      Array& newValues) const {
-        // #pragma omp parallel for
-        for (Size j=0; j<this->impl().size(i); j++) {
-            Real value = 0.0;
-            for (Size l=0; l<n_; l++) {
-                value += this->impl().probability(i,j,l) *
-                         values[this->impl().descendant(i,j,l)];
-            }
-            value *= this->impl().discount(i,j);
-            newValues[j] = value;
+        if (descendants_[i].empty())
+            computeBranching(i);
+        const Size size = this->impl().size(i);
+        const Size* descendants = descendants_[i].data();
+        const Real* probabilities = probabilities_[i].data();
+        const Real* v = values.data();
+        Real* newV = newValues.data();
+
+        // one branch at a time, so that the loops can be vectorized
+        for (Size j=0; j<size; j++)
+            newV[j] = probabilities[j] * v[descendants[j]];
+        for (Size l=1; l<n_; l++) {
+            descendants += size;
+            probabilities += size;
+            for (Size j=0; j<size; j++)
+                newV[j] += probabilities[j] * v[descendants[j]];
         }
+        for (Size j=0; j<size; j++)
+            newV[j] *= this->impl().discount(i,j);
     }
 
 }
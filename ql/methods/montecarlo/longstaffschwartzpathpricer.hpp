@@ -32,6 +32,7 @@
 #include <ql/math/statistics/incrementalstatistics.hpp>
 #include <ql/methods/montecarlo/pathpricer.hpp>
 #include <ql/methods/montecarlo/earlyexercisepathpricer.hpp>
+#include <ql/methods/montecarlo/lsmcalibrationdata.hpp>
 
 #include <functional>
 
@@ -64,6 +65,22 @@ namespace QuantLib {
 
         Real exerciseProbability() const;
 
+        //! stores regression data rather than paths for the calibration
+        /*! When the number of threads is not null, the calibration
+            paths are not stored; instead, for each exercise date, only
+            the exercise values of the paths in the money and the
+            values of the basis functions at their states are kept.
+            The regressions are accumulated in shards of the given
+            number of rows, which are distributed across the given
+            number of threads, and solved by QR decomposition; the
+            results don't depend on the number of threads.
+
+            This must be called before the calibration paths are added.
+
+            \warning post_processing is not called in this mode.
+        */
+        void setLeanCalibration(Size threads, Size rowsPerShard = 1024);
+
       protected:
         virtual void post_processing(const Size i,
                                      const std::vector<StateType> &state,
@@ -82,6 +99,14 @@ namespace QuantLib {
         const   std::vector<std::function<Real(const StateType&)>> v_;
 
         const Size len_;
+
+      private:
+        void calibrateLean();
+
+        Size leanThreads_, rowsPerShard_;
+        mutable Size calibrationPaths_;
+        mutable std::vector<Real> finalValues_, basisValues_;
+        mutable std::vector<LsmCalibrationData> calibrationData_;
     };
 
     template <class PathType> inline
@@ -95,7 +120,8 @@ namespace QuantLib {
       coeff_     (std::vector<Array>(times.size()-2)),
       dF_        (std::vector<DiscountFactor>(times.size()-1)),
       v_         (pathPricer_->basisSystem()),
-      len_       (times.size()) {
+      len_       (times.size()),
+      leanThreads_(0), rowsPerShard_(1024), calibrationPaths_(0) {
 
         for (Size i=0; i<times.size()-1; ++i) {
             dF_[i] =   termStructure->discount(times[i+1])
@@ -107,8 +133,23 @@ namespace QuantLib {
     Real LongstaffSchwartzPathPricer<PathType>::operator()
         (const PathType& path) const {
         if (calibrationPhase_) {
-            // store paths for the calibration
-            paths_.emplace_back(path);
+            if (leanThreads_ != 0) {
+                // store the regression data for the calibration
+                const Size j = calibrationPaths_++;
+                finalValues_.push_back((*pathPricer_)(path, len_-1));
+                for (Size i=1; i<len_-1; ++i) {
+                    const Real exercise = (*pathPricer_)(path, i);
+                    if (exercise > 0.0) {
+                        const StateType regValue = pathPricer_->state(path, i);
+                        for (Size l=0; l<v_.size(); ++l)
+                            basisValues_[l] = v_[l](regValue);
+                        calibrationData_[i-1].add(j, exercise, basisValues_);
+                    }
+                }
+            } else {
+                // store paths for the calibration
+                paths_.emplace_back(path);
+            }
             // result doesn't matter
             return 0.0;
         }
@@ -146,6 +187,11 @@ namespace QuantLib {
 
     template <class PathType> inline
     void LongstaffSchwartzPathPricer<PathType>::calibrate() {
+        if (leanThreads_ != 0) {
+            calibrateLean();
+            return;
+        }
+
         const Size n = paths_.size();
         Array prices(n), exercise(n);
         std::vector<StateType> p_state(n);
@@ -210,6 +256,57 @@ namespace QuantLib {
         calibrationPhase_ = false;
     }
 
+    template <class PathType> inline
+    void LongstaffSchwartzPathPricer<PathType>::calibrateLean() {
+        const Size n = calibrationPaths_;
+        Array prices(finalValues_.begin(), finalValues_.end());
+        std::vector<Real>().swap(finalValues_);
+
+        for (Size i=len_-2; i>0; --i) {
+            LsmCalibrationData& data = calibrationData_[i-1];
+
+            //roll back step
+            for (Size j=0; j<n; ++j)
+                prices[j] *= dF_[i];
+
+            coeff_[i-1] = data.regression(prices, 0.0,
+                                          leanThreads_, rowsPerShard_);
+            if (coeff_[i-1].empty()) {
+            // if number of itm paths is smaller then the number of
+            // calibration functions then early exercise if exerciseValue > 0
+                coeff_[i-1] = Array(v_.size(), 0.0);
+            }
+
+            const std::vector<Real> continuationValues =
+                data.continuationValues(coeff_[i-1],
+                                        leanThreads_, rowsPerShard_);
+            for (Size k=0; k<data.size(); ++k) {
+                if (continuationValues[k] < data.exercise(k))
+                    prices[data.path(k)] = data.exercise(k);
+            }
+
+            data.clear();
+        }
+
+        calibrationPaths_ = 0;
+        // entering the calculation phase
+        calibrationPhase_ = false;
+    }
+
+    template <class PathType> inline
+    void LongstaffSchwartzPathPricer<PathType>::setLeanCalibration(
+                                                     Size threads,
+                                                     Size rowsPerShard) {
+        QL_REQUIRE(calibrationPhase_ && paths_.empty()
+                   && calibrationPaths_ == 0,
+                   "calibration paths already added");
+        QL_REQUIRE(rowsPerShard > 0, "null number of rows per shard");
+        leanThreads_ = threads;
+        rowsPerShard_ = rowsPerShard;
+        basisValues_.resize(v_.size());
+        calibrationData_.assign(len_-2, LsmCalibrationData(v_.size()));
+    }
+
     template <class PathType> inline
     Real LongstaffSchwartzPathPricer<PathType>::exerciseProbability() const {
         return exerciseProbability_.mean();
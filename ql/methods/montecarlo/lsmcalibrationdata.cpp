@@ -0,0 +1,100 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/methods/montecarlo/lsmcalibrationdata.hpp>
+#include <ql/math/incrementallinearleastsquares.hpp>
+#include <ql/utilities/parallelfor.hpp>
+#include <algorithm>
+
+namespace QuantLib {
+
+    LsmCalibrationData::LsmCalibrationData(Size basisSize)
+    : basisSize_(basisSize) {}
+
+    void LsmCalibrationData::add(Size path, Real exercise,
+                                 const std::vector<Real>& basis) {
+        QL_REQUIRE(basis.size() == basisSize_,
+                   "wrong number of basis function values ("
+                   << basis.size() << " given, "
+                   << basisSize_ << " required)");
+        paths_.push_back(path);
+        exercises_.push_back(exercise);
+        basis_.insert(basis_.end(), basis.begin(), basis.end());
+    }
+
+    void LsmCalibrationData::clear() {
+        std::vector<Size>().swap(paths_);
+        std::vector<Real>().swap(exercises_);
+        std::vector<Real>().swap(basis_);
+    }
+
+    Array LsmCalibrationData::regression(const Array& values,
+                                         Real lowerBound,
+                                         Size threads,
+                                         Size rowsPerShard) const {
+        QL_REQUIRE(rowsPerShard > 0, "null number of rows per shard");
+        const Size n = paths_.size();
+        const Size m = basisSize_;
+        const Size rows =
+            std::count_if(exercises_.begin(), exercises_.end(),
+                          [=](Real e) { return e > lowerBound; });
+        if (rows < m)
+            return Array();
+
+        const Size shards = (n + rowsPerShard - 1) / rowsPerShard;
+        std::vector<IncrementalLinearLeastSquares> partial(
+            shards, IncrementalLinearLeastSquares(m));
+        parallelFor(shards, threads, [&](Size s) {
+            const Size end = std::min(n, (s+1)*rowsPerShard);
+            for (Size k=s*rowsPerShard; k<end; ++k) {
+                if (exercises_[k] > lowerBound)
+                    partial[s].add(&basis_[k*m], values[paths_[k]]);
+            }
+        });
+        for (Size s=1; s<shards; ++s)
+            partial[0].merge(partial[s]);
+        return partial[0].coefficients();
+    }
+
+    std::vector<Real> LsmCalibrationData::continuationValues(
+                                              const Array& coefficients,
+                                              Size threads,
+                                              Size rowsPerShard) const {
+        QL_REQUIRE(rowsPerShard > 0, "null number of rows per shard");
+        QL_REQUIRE(coefficients.size() == basisSize_,
+                   "wrong number of coefficients ("
+                   << coefficients.size() << " given, "
+                   << basisSize_ << " required)");
+        const Size n = paths_.size();
+        const Size m = basisSize_;
+        std::vector<Real> result(n);
+
+        const Size shards = (n + rowsPerShard - 1) / rowsPerShard;
+        parallelFor(shards, threads, [&](Size s) {
+            const Size end = std::min(n, (s+1)*rowsPerShard);
+            for (Size k=s*rowsPerShard; k<end; ++k) {
+                const Real* basis = &basis_[k*m];
+                Real value = 0.0;
+                for (Size l=0; l<m; ++l)
+                    value += coefficients[l] * basis[l];
+                result[k] = value;
+            }
+        });
+        return result;
+    }
+
+}
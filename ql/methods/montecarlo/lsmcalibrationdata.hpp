@@ -0,0 +1,84 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file lsmcalibrationdata.hpp
+    \brief regression data of Longstaff-Schwartz calibration paths
+*/
+
+#ifndef quantlib_lsm_calibration_data_hpp
+#define quantlib_lsm_calibration_data_hpp
+
+#include <ql/math/array.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    //! regression data of Longstaff-Schwartz calibration paths
+    /*! Stores, for a single exercise date, the paths that might be
+        exercised together with their exercise values and the values
+        of the basis functions at their states; this is all that the
+        calibration needs from the paths at that date, and takes far
+        less memory than the paths themselves.
+
+        The rows are processed in contiguous shards of a given size,
+        which can be distributed across threads; since the shards
+        don't depend on the number of threads, neither do the
+        results.
+
+        \ingroup mcarlo
+    */
+    class LsmCalibrationData {
+      public:
+        explicit LsmCalibrationData(Size basisSize = 0);
+        //! adds a row for the given path
+        void add(Size path, Real exercise, const std::vector<Real>& basis);
+        //! releases the stored rows
+        void clear();
+        //! \name inspectors
+        //@{
+        //! number of stored rows
+        Size size() const { return paths_.size(); }
+        Size basisSize() const { return basisSize_; }
+        Size path(Size k) const { return paths_[k]; }
+        Real exercise(Size k) const { return exercises_[k]; }
+        //@}
+        //! \name calculations
+        //@{
+        /*! returns the coefficients of the least-squares regression of
+            values[path(k)] over the basis functions for the rows whose
+            exercise value exceeds the lower bound, or an empty array
+            if there are fewer such rows than basis functions.
+        */
+        Array regression(const Array& values,
+                         Real lowerBound,
+                         Size threads,
+                         Size rowsPerShard) const;
+        //! continuation values of all rows for the given coefficients
+        std::vector<Real> continuationValues(const Array& coefficients,
+                                             Size threads,
+                                             Size rowsPerShard) const;
+        //@}
+      private:
+        Size basisSize_;
+        std::vector<Size> paths_;
+        std::vector<Real> exercises_, basis_;
+    };
+
+}
+
+
+#endif
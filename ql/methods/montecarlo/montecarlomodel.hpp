@@ -27,6 +27,7 @@
 
 #include <ql/methods/montecarlo/mctraits.hpp>
 #include <ql/math/statistics/statistics.hpp>
+#include <ql/utilities/parallelfor.hpp>
 #include <memory>
 #include <algorithm>
 
@@ -46,6 +47,10 @@ namespace QuantLib {
         provide the additional control option, namely the option path
         pricer and the option value.
 
+        Samples can be generated on several threads; see setThreads.
+        Paths can also be generated and priced in blocks; see
+        setBlockSize.
+
         \ingroup mcarlo
     */
     template <template <class> class MC, class RNG, class S = Statistics>
@@ -73,7 +78,8 @@ namespace QuantLib {
           sampleAccumulator_(sampleAccumulator),
           isAntitheticVariate_(antitheticVariate),
           cvPathPricer_(cvPathPricer), cvOptionValue_(cvOptionValue),
-          cvPathGenerator_(cvPathGenerator) {
+          cvPathGenerator_(cvPathGenerator), threads_(0),
+          samplesPerChunk_(1024), blockSize_(0), warmedUp_(false) {
             if (!cvPathPricer_)
                 isControlVariate_ = false;
             else
@@ -81,7 +87,48 @@ namespace QuantLib {
         }
         void addSamples(Size samples);
         const stats_type& sampleAccumulator(void) const;
+        //! distributes the samples added by addSamples across threads
+        /*! When the number of threads is not null, the samples of
+            each call to addSamples are split in chunks of the given
+            size, and the i-th chunk is drawn from the substream of
+            the path generators starting at the i-th chunk offset (see
+            PathGenerator::substream).  Chunks are simulated on the
+            given number of threads and added to the accumulator in
+            chunk order; therefore, results do not depend on the
+            number of threads.  For low-discrepancy generators, they
+            are also the same as the ones of the serial simulation;
+            pseudo-random generators are reseeded for each chunk
+            instead, so that their chunks are not guaranteed to be
+            disjoint (see RandomSequenceGenerator::substream).
+
+            The first chunk is simulated on the calling thread before
+            any other is started, so that lazy calculations in the
+            process or in the path pricer are performed serially.
+
+            \warning path pricers are shared across threads and must
+                     be safe to call concurrently.
+        */
+        void setThreads(Size threads, Size samplesPerChunk = 1024);
+        //! generates and prices paths in blocks of the given size
+        /*! When the block size is not null, paths are generated by
+            means of the nextBlock and antitheticBlock methods of the
+            path generator and priced by the block overload of the
+            path pricer, which allows both calculations to be
+            vectorized across paths.  Each path generator yields the
+            same sequence of paths as in the path-by-path simulation.
+        */
+        void setBlockSize(Size paths);
       private:
+        typedef std::pair<result_type,Real> weighted_result;
+        typedef typename path_generator_type::block_type block_type;
+        weighted_result nextSample(
+                        const path_generator_type& pathGenerator,
+                        const path_generator_type* cvPathGenerator) const;
+        void nextSamples(const path_generator_type& pathGenerator,
+                         const path_generator_type* cvPathGenerator,
+                         Size samples,
+                         std::vector<weighted_result>& result) const;
+        void addSamplesInChunks(Size samples);
         std::shared_ptr<path_generator_type> pathGenerator_;
         std::shared_ptr<path_pricer_type> pathPricer_;
         stats_type sampleAccumulator_;
@@ -90,43 +137,198 @@ namespace QuantLib {
         result_type cvOptionValue_;
         bool isControlVariate_;
         std::shared_ptr<path_generator_type> cvPathGenerator_;
+        Size threads_, samplesPerChunk_, blockSize_;
+        bool warmedUp_;
     };
 
     // inline definitions
     template <template <class> class MC, class RNG, class S>
     inline void MonteCarloModel<MC,RNG,S>::addSamples(Size samples) {
+        if (threads_ != 0) {
+            addSamplesInChunks(samples);
+            return;
+        }
+        if (blockSize_ != 0) {
+            std::vector<weighted_result> results;
+            for (Size j = 0; j < samples; j += blockSize_) {
+                results.clear();
+                nextSamples(*pathGenerator_, cvPathGenerator_.get(),
+                            std::min(blockSize_, samples-j), results);
+                for (Size i=0; i<results.size(); ++i)
+                    sampleAccumulator_.add(results[i].first,
+                                           results[i].second);
+            }
+            return;
+        }
         for(Size j = 1; j <= samples; j++) {
+            weighted_result sample =
+                nextSample(*pathGenerator_, cvPathGenerator_.get());
+            sampleAccumulator_.add(sample.first, sample.second);
+        }
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline typename MonteCarloModel<MC,RNG,S>::weighted_result
+    MonteCarloModel<MC,RNG,S>::nextSample(
+                    const path_generator_type& pathGenerator,
+                    const path_generator_type* cvPathGenerator) const {
+
+        const sample_type& path = pathGenerator.next();
+        result_type price = (*pathPricer_)(path.value);
 
-            const sample_type& path = pathGenerator_->next();
-            result_type price = (*pathPricer_)(path.value);
+        if (isControlVariate_) {
+            if (!cvPathGenerator) {
+                price += cvOptionValue_-(*cvPathPricer_)(path.value);
+            }
+            else {
+                const sample_type& cvPath = cvPathGenerator->next();
+                price += cvOptionValue_-(*cvPathPricer_)(cvPath.value);
+            }
+        }
 
+        if (isAntitheticVariate_) {
+            const sample_type& atPath = pathGenerator.antithetic();
+            result_type price2 = (*pathPricer_)(atPath.value);
             if (isControlVariate_) {
-                if (!cvPathGenerator_) {
-                    price += cvOptionValue_-(*cvPathPricer_)(path.value);
-                }
+                if (!cvPathGenerator)
+                    price2 += cvOptionValue_-(*cvPathPricer_)(atPath.value);
                 else {
-                    const sample_type& cvPath = cvPathGenerator_->next();
-                    price += cvOptionValue_-(*cvPathPricer_)(cvPath.value);
+                    const sample_type& cvPath = cvPathGenerator->antithetic();
+                    price2 += cvOptionValue_-(*cvPathPricer_)(cvPath.value);
                 }
             }
 
+            return weighted_result((price+price2)/2.0, path.weight);
+        } else {
+            return weighted_result(price, path.weight);
+        }
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline void MonteCarloModel<MC,RNG,S>::nextSamples(
+                    const path_generator_type& pathGenerator,
+                    const path_generator_type* cvPathGenerator,
+                    Size samples,
+                    std::vector<weighted_result>& result) const {
+
+        Size n = std::min(blockSize_, samples);
+        std::vector<result_type> price(n), price2(n), cvPrice(n);
+
+        for (Size first = 0; first < samples; first += n) {
+            Size m = std::min(n, samples-first);
+            price.resize(m);
+            price2.resize(m);
+            cvPrice.resize(m);
+
+            const block_type& paths = pathGenerator.nextBlock(m);
+            std::vector<Real> weights = paths.weights();
+            (*pathPricer_)(paths, &price[0]);
+
+            if (isControlVariate_) {
+                if (!cvPathGenerator)
+                    (*cvPathPricer_)(paths, &cvPrice[0]);
+                else
+                    (*cvPathPricer_)(cvPathGenerator->nextBlock(m),
+                                     &cvPrice[0]);
+                for (Size j=0; j<m; ++j)
+                    price[j] += cvOptionValue_-cvPrice[j];
+            }
+
             if (isAntitheticVariate_) {
-                const sample_type& atPath = pathGenerator_->antithetic();
-                result_type price2 = (*pathPricer_)(atPath.value);
+                const block_type& atPaths = pathGenerator.antitheticBlock();
+                (*pathPricer_)(atPaths, &price2[0]);
                 if (isControlVariate_) {
-                    if (!cvPathGenerator_)
-                        price2 += cvOptionValue_-(*cvPathPricer_)(atPath.value);
-                    else {
-                        const sample_type& cvPath = cvPathGenerator_->antithetic();
-                        price2 += cvOptionValue_-(*cvPathPricer_)(cvPath.value);
-                    }
+                    if (!cvPathGenerator)
+                        (*cvPathPricer_)(atPaths, &cvPrice[0]);
+                    else
+                        (*cvPathPricer_)(cvPathGenerator->antitheticBlock(),
+                                         &cvPrice[0]);
+                    for (Size j=0; j<m; ++j)
+                        price2[j] += cvOptionValue_-cvPrice[j];
                 }
-
-                sampleAccumulator_.add((price+price2)/2.0, path.weight);
+                for (Size j=0; j<m; ++j)
+                    result.push_back(
+                        weighted_result((price[j]+price2[j])/2.0,
+                                        weights[j]));
             } else {
-                sampleAccumulator_.add(price, path.weight);
+                for (Size j=0; j<m; ++j)
+                    result.push_back(weighted_result(price[j], weights[j]));
+            }
+        }
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline void MonteCarloModel<MC,RNG,S>::addSamplesInChunks(Size samples) {
+        if (samples == 0)
+            return;
+
+        Size chunks = (samples + samplesPerChunk_ - 1)/samplesPerChunk_;
+        // chunks are simulated in waves to bound the memory
+        // needed for storing their results
+        Size wave = 8*threads_;
+        std::vector<std::vector<weighted_result> > results;
+
+        auto simulateChunk = [&](Size chunk,
+                                 std::vector<weighted_result>& result) {
+            Size offset = chunk*samplesPerChunk_;
+            Size n = std::min(samplesPerChunk_, samples-offset);
+            const path_generator_type generator =
+                pathGenerator_->substream(offset);
+            std::unique_ptr<path_generator_type> cvGenerator;
+            if (cvPathGenerator_)
+                cvGenerator.reset(new path_generator_type(
+                                      cvPathGenerator_->substream(offset)));
+            result.clear();
+            result.reserve(n);
+            if (blockSize_ != 0)
+                nextSamples(generator, cvGenerator.get(), n, result);
+            else
+                for (Size j=0; j<n; ++j)
+                    result.push_back(nextSample(generator,
+                                                cvGenerator.get()));
+        };
+
+        for (Size first=0; first<chunks; first+=wave) {
+            Size last = std::min(first+wave, chunks);
+            results.resize(last-first);
+            Size start = 0;
+            if (!warmedUp_) {
+                simulateChunk(first, results[0]);
+                warmedUp_ = true;
+                start = 1;
+            }
+            parallelFor(last-first-start, threads_,
+                        [&](Size i) {
+                            simulateChunk(first+start+i,
+                                          results[start+i]);
+                        });
+            for (Size i=0; i<last-first; ++i) {
+                for (Size j=0; j<results[i].size(); ++j)
+                    sampleAccumulator_.add(results[i][j].first,
+                                           results[i][j].second);
             }
         }
+
+        // the next call starts after the substreams used by this one
+        pathGenerator_ = std::make_shared<path_generator_type>(
+                                       pathGenerator_->substream(samples));
+        if (cvPathGenerator_)
+            cvPathGenerator_ = std::make_shared<path_generator_type>(
+                                     cvPathGenerator_->substream(samples));
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline void MonteCarloModel<MC,RNG,S>::setThreads(Size threads,
+                                                      Size samplesPerChunk) {
+        QL_REQUIRE(samplesPerChunk > 0,
+                   "the number of samples per chunk must be positive");
+        threads_ = threads;
+        samplesPerChunk_ = samplesPerChunk;
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline void MonteCarloModel<MC,RNG,S>::setBlockSize(Size paths) {
+        blockSize_ = paths;
     }
 
     template <template <class> class MC, class RNG, class S>
@@ -28,6 +28,7 @@
 #define quantlib_multi_path_generator_hpp
 
 #include <ql/methods/montecarlo/multipath.hpp>
+#include <ql/methods/montecarlo/pathblock.hpp>
 #include <ql/methods/montecarlo/sample.hpp>
 #include <ql/stochasticprocess.hpp>
 
@@ -50,18 +51,30 @@ namespace QuantLib {
     class MultiPathGenerator {
       public:
         typedef Sample<MultiPath> sample_type;
+        typedef PathBlock<MultiPath> block_type;
         MultiPathGenerator(const std::shared_ptr<StochasticProcess>&,
                            const TimeGrid&,
                            GSG generator,
                            bool brownianBridge = false);
         const sample_type& next() const;
         const sample_type& antithetic() const;
+        //! next block of paths
+        /*! See PathGenerator::nextBlock. */
+        const block_type& nextBlock(Size paths) const;
+        //! antithetic paths of the last generated block
+        const block_type& antitheticBlock() const;
+        //! generator for the paths from the given offset on
+        /*! See PathGenerator::substream. */
+        MultiPathGenerator substream(Size offset) const;
       private:
         const sample_type& next(bool antithetic) const;
+        const block_type& block(bool antithetic) const;
         bool brownianBridge_;
         std::shared_ptr<StochasticProcess> process_;
         GSG generator_;
         mutable sample_type next_;
+        mutable block_type block_;
+        mutable std::vector<Real> draws_, temp_;
     };
 
 
@@ -87,6 +100,14 @@ namespace QuantLib {
                    "no times given");
     }
 
+    template <class GSG>
+    MultiPathGenerator<GSG>
+    MultiPathGenerator<GSG>::substream(Size offset) const {
+        MultiPathGenerator<GSG> generator(*this);
+        generator.generator_ = generator_.substream(offset);
+        return generator;
+    }
+
     template <class GSG>
     inline const typename MultiPathGenerator<GSG>::sample_type&
     MultiPathGenerator<GSG>::next() const {
@@ -150,6 +171,70 @@ namespace QuantLib {
         }
     }
 
+    template <class GSG>
+    const typename MultiPathGenerator<GSG>::block_type&
+    MultiPathGenerator<GSG>::nextBlock(Size paths) const {
+        QL_REQUIRE(!brownianBridge_, "Brownian bridge not supported");
+        QL_REQUIRE(paths > 0, "null number of paths");
+
+        Size steps = next_.value.pathSize()-1;
+        Size nf = process_->factors();
+        if (block_.size() != paths) {
+            block_ = block_type(process_->size(),
+                                next_.value[0].timeGrid(), paths);
+            draws_.resize(steps*nf*paths);
+            temp_.resize(nf*paths);
+        }
+
+        // for each time step, the draws for each factor are stored
+        // across paths
+        typedef typename GSG::sample_type sequence_type;
+        for (Size j=0; j<paths; ++j) {
+            const sequence_type& sequence_ = generator_.nextSequence();
+            for (Size i=0; i<steps; ++i)
+                for (Size k=0; k<nf; ++k)
+                    draws_[(i*nf+k)*paths+j] = sequence_.value[i*nf+k];
+            block_.weights()[j] = sequence_.weight;
+        }
+
+        return block(false);
+    }
+
+    template <class GSG>
+    const typename MultiPathGenerator<GSG>::block_type&
+    MultiPathGenerator<GSG>::antitheticBlock() const {
+        QL_REQUIRE(block_.size() > 0, "no block generated");
+        return block(true);
+    }
+
+    template <class GSG>
+    const typename MultiPathGenerator<GSG>::block_type&
+    MultiPathGenerator<GSG>::block(bool antithetic) const {
+        Size n = block_.size();
+        Size m = process_->size();
+        Size nf = process_->factors();
+
+        Array asset = process_->initialValues();
+        for (Size a=0; a<m; ++a)
+            std::fill(block_.values(0,a), block_.values(0,a)+n, asset[a]);
+
+        const TimeGrid& timeGrid = block_.timeGrid();
+        for (Size i=1; i<block_.pathSize(); ++i) {
+            Time t = timeGrid[i-1];
+            Time dt = timeGrid.dt(i-1);
+            const Real* dw = &draws_[(i-1)*nf*n];
+            if (antithetic) {
+                for (Size l=0; l<nf*n; ++l)
+                    temp_[l] = -dw[l];
+                dw = &temp_[0];
+            }
+            process_->evolveBlock(t, block_.values(i-1), dt, dw,
+                                  block_.values(i), n);
+        }
+
+        return block_;
+    }
+
 }
 
 #endif
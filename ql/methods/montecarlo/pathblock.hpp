@@ -0,0 +1,161 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file pathblock.hpp
+    \brief blocks of paths stored across paths
+*/
+
+#ifndef quantlib_montecarlo_path_block_hpp
+#define quantlib_montecarlo_path_block_hpp
+
+#include <ql/methods/montecarlo/multipath.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    //! block of path samples
+    /*! This generic version stores a sequence of paths and their
+        weights; it is specialized for Path and MultiPath so that
+        the values of all paths at a given time are contiguous in
+        memory, which allows calculations to be vectorized across
+        paths.
+
+        \ingroup mcarlo
+    */
+    template <class PathType>
+    class PathBlock {
+      public:
+        PathBlock() {}
+        PathBlock(const std::vector<PathType>& paths,
+                  const std::vector<Real>& weights)
+        : paths_(paths), weights_(weights) {
+            QL_REQUIRE(paths_.size() == weights_.size(),
+                       "mismatch between paths and weights");
+        }
+        //! number of paths in the block
+        Size size() const { return paths_.size(); }
+        const PathType& path(Size j) const { return paths_[j]; }
+        const std::vector<Real>& weights() const { return weights_; }
+      private:
+        std::vector<PathType> paths_;
+        std::vector<Real> weights_;
+    };
+
+
+    //! block of single-factor paths
+    /*! The values of the paths are stored time-major; for each point
+        of the time grid, values(i) points to the contiguous values of
+        all paths in the block at that point.
+
+        \ingroup mcarlo
+    */
+    template <>
+    class PathBlock<Path> {
+      public:
+        PathBlock() : size_(0) {}
+        PathBlock(const TimeGrid& timeGrid, Size paths)
+        : timeGrid_(timeGrid), size_(paths),
+          values_(timeGrid.size()*paths), weights_(paths, 1.0) {}
+        //! \name inspectors
+        //@{
+        //! number of paths in the block
+        Size size() const { return size_; }
+        //! number of points in each path
+        Size length() const { return timeGrid_.size(); }
+        const TimeGrid& timeGrid() const { return timeGrid_; }
+        //! values of all paths at the \f$ i \f$-th point
+        const Real* values(Size i) const { return &values_[i*size_]; }
+        Real* values(Size i) { return &values_[i*size_]; }
+        //! value of the \f$ j \f$-th path at the \f$ i \f$-th point
+        Real value(Size j, Size i) const { return values_[i*size_+j]; }
+        const std::vector<Real>& weights() const { return weights_; }
+        std::vector<Real>& weights() { return weights_; }
+        //@}
+        //! copy of the \f$ j \f$-th path
+        Path path(Size j) const {
+            Path p(timeGrid_);
+            for (Size i=0; i<p.length(); ++i)
+                p[i] = value(j, i);
+            return p;
+        }
+      private:
+        TimeGrid timeGrid_;
+        Size size_;
+        std::vector<Real> values_;
+        std::vector<Real> weights_;
+    };
+
+
+    //! block of multi-factor paths
+    /*! The values of the paths are stored time-major and, for each
+        time, asset-major; values(i) points to the contiguous values
+        of all assets of all paths at the \f$ i \f$-th point, with the
+        values of the \f$ a \f$-th asset starting at values(i,a).
+
+        \ingroup mcarlo
+    */
+    template <>
+    class PathBlock<MultiPath> {
+      public:
+        PathBlock() : assets_(0), size_(0) {}
+        PathBlock(Size nAsset, const TimeGrid& timeGrid, Size paths)
+        : timeGrid_(timeGrid), assets_(nAsset), size_(paths),
+          values_(timeGrid.size()*nAsset*paths), weights_(paths, 1.0) {
+            QL_REQUIRE(nAsset > 0, "number of asset must be positive");
+        }
+        //! \name inspectors
+        //@{
+        //! number of paths in the block
+        Size size() const { return size_; }
+        Size assetNumber() const { return assets_; }
+        //! number of points in each path
+        Size pathSize() const { return timeGrid_.size(); }
+        const TimeGrid& timeGrid() const { return timeGrid_; }
+        //! values of all assets of all paths at the \f$ i \f$-th point
+        const Real* values(Size i) const {
+            return &values_[i*assets_*size_];
+        }
+        Real* values(Size i) { return &values_[i*assets_*size_]; }
+        //! values of the given asset for all paths at the \f$ i \f$-th point
+        const Real* values(Size i, Size asset) const {
+            return &values_[(i*assets_+asset)*size_];
+        }
+        Real* values(Size i, Size asset) {
+            return &values_[(i*assets_+asset)*size_];
+        }
+        const std::vector<Real>& weights() const { return weights_; }
+        std::vector<Real>& weights() { return weights_; }
+        //@}
+        //! copy of the \f$ j \f$-th path
+        MultiPath path(Size j) const {
+            MultiPath p(assets_, timeGrid_);
+            for (Size a=0; a<assets_; ++a)
+                for (Size i=0; i<timeGrid_.size(); ++i)
+                    p[a][i] = values(i, a)[j];
+            return p;
+        }
+      private:
+        TimeGrid timeGrid_;
+        Size assets_, size_;
+        std::vector<Real> values_;
+        std::vector<Real> weights_;
+    };
+
+}
+
+
+#endif
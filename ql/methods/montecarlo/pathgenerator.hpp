@@ -27,7 +27,9 @@
 #define quantlib_montecarlo_path_generator_hpp
 
 #include <ql/methods/montecarlo/brownianbridge.hpp>
+#include <ql/methods/montecarlo/pathblock.hpp>
 #include <ql/stochasticprocess.hpp>
+#include <algorithm>
 
 namespace QuantLib {
     class StochasticProcess;
@@ -44,6 +46,7 @@ namespace QuantLib {
     class PathGenerator {
       public:
         typedef Sample<Path> sample_type;
+        typedef PathBlock<Path> block_type;
         // constructors
         PathGenerator(const std::shared_ptr<StochasticProcess>&,
                       Time length,
@@ -58,11 +61,27 @@ namespace QuantLib {
         //@{
         const sample_type& next() const;
         const sample_type& antithetic() const;
+        //! next block of paths
+        /*! The block contains the same paths that would be returned
+            by as many calls to next(); the paths are evolved together
+            by means of StochasticProcess::evolveBlock.
+        */
+        const block_type& nextBlock(Size paths) const;
+        //! antithetic paths of the last generated block
+        const block_type& antitheticBlock() const;
         Size size() const { return dimension_; }
         const TimeGrid& timeGrid() const { return timeGrid_; }
         //@}
+        //! generator for the paths from the given offset on
+        /*! The returned generator draws its paths from the substream
+            of the sequence generator starting at the given offset;
+            see e.g. SobolRsg::substream.  The state of this generator
+            is not modified.
+        */
+        PathGenerator substream(Size offset) const;
       private:
         const sample_type& next(bool antithetic) const;
+        const block_type& block(bool antithetic) const;
         bool brownianBridge_;
         GSG generator_;
         Size dimension_;
@@ -71,6 +90,8 @@ namespace QuantLib {
         mutable sample_type next_;
         mutable std::vector<Real> temp_;
         BrownianBridge bb_;
+        mutable block_type block_;
+        mutable std::vector<Real> draws_, row_;
     };
 
 
@@ -107,6 +128,13 @@ namespace QuantLib {
                    << ") != timeSteps (" << timeGrid_.size()-1 << ")");
     }
 
+    template <class GSG>
+    PathGenerator<GSG> PathGenerator<GSG>::substream(Size offset) const {
+        PathGenerator<GSG> generator(*this);
+        generator.generator_ = generator_.substream(offset);
+        return generator;
+    }
+
     template <class GSG>
     const typename PathGenerator<GSG>::sample_type&
     PathGenerator<GSG>::next() const {
@@ -154,6 +182,66 @@ namespace QuantLib {
         return next_;
     }
 
+    template <class GSG>
+    const typename PathGenerator<GSG>::block_type&
+    PathGenerator<GSG>::nextBlock(Size paths) const {
+        QL_REQUIRE(paths > 0, "null number of paths");
+        if (block_.size() != paths) {
+            block_ = block_type(timeGrid_, paths);
+            draws_.resize(dimension_*paths);
+            row_.resize(paths);
+        }
+
+        // draws are stored across paths for each time step
+        typedef typename GSG::sample_type sequence_type;
+        for (Size j=0; j<paths; ++j) {
+            const sequence_type& sequence_ = generator_.nextSequence();
+            if (brownianBridge_) {
+                bb_.transform(sequence_.value.begin(),
+                              sequence_.value.end(),
+                              temp_.begin());
+            } else {
+                std::copy(sequence_.value.begin(),
+                          sequence_.value.end(),
+                          temp_.begin());
+            }
+            for (Size i=0; i<dimension_; ++i)
+                draws_[i*paths+j] = temp_[i];
+            block_.weights()[j] = sequence_.weight;
+        }
+
+        return block(false);
+    }
+
+    template <class GSG>
+    const typename PathGenerator<GSG>::block_type&
+    PathGenerator<GSG>::antitheticBlock() const {
+        QL_REQUIRE(block_.size() > 0, "no block generated");
+        return block(true);
+    }
+
+    template <class GSG>
+    const typename PathGenerator<GSG>::block_type&
+    PathGenerator<GSG>::block(bool antithetic) const {
+        Size n = block_.size();
+        std::fill(block_.values(0), block_.values(0)+n, process_->x0());
+
+        for (Size i=1; i<block_.length(); i++) {
+            Time t = timeGrid_[i-1];
+            Time dt = timeGrid_.dt(i-1);
+            const Real* dw = &draws_[(i-1)*n];
+            if (antithetic) {
+                for (Size j=0; j<n; ++j)
+                    row_[j] = -dw[j];
+                dw = &row_[0];
+            }
+            process_->evolveBlock(t, block_.values(i-1), dt, dw,
+                                  block_.values(i), n);
+        }
+
+        return block_;
+    }
+
 }
 
 
@@ -25,6 +25,7 @@
 #ifndef quantlib_montecarlo_path_pricer_hpp
 #define quantlib_montecarlo_path_pricer_hpp
 
+#include <ql/methods/montecarlo/pathblock.hpp>
 #include <ql/option.hpp>
 #include <ql/types.hpp>
 #include <functional>
@@ -32,7 +33,8 @@
 namespace QuantLib {
 
     //! base class for path pricers
-    /*! Returns the value of an option on a given path.
+    /*! Returns the value of an option on a given path or, at once,
+        on each path of a block.
 
         \ingroup mcarlo
     */
@@ -43,6 +45,16 @@ namespace QuantLib {
         using argument_type = PathType;
         virtual ~PathPricer() {}
         virtual ValueType operator()(const PathType& path) const=0;
+        /*! stores in values[j] the value of the option on the
+            \f$ j \f$-th path of the block.  The default implementation
+            prices a copy of each path in turn; derived classes can
+            override it so that the payoff is evaluated across paths.
+        */
+        virtual void operator()(const PathBlock<PathType>& paths,
+                                ValueType* values) const {
+            for (Size j=0; j<paths.size(); ++j)
+                values[j] = (*this)(paths.path(j));
+        }
     };
 
 }
@@ -87,6 +87,9 @@ namespace QuantLib {
         void setPricingEngine(const std::shared_ptr<PricingEngine>& engine) {
             engine_ = engine;
         }
+        const std::shared_ptr<PricingEngine>& pricingEngine() const {
+            return engine_;
+        }
 
       protected:
         mutable Real marketValue_;
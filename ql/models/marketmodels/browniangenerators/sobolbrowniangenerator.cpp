@@ -208,6 +208,14 @@ namespace QuantLib {
 
     Size SobolBrownianGenerator::numberOfSteps() const { return steps_; }
 
+    SobolBrownianGenerator
+    SobolBrownianGenerator::substream(Size offset) const {
+        SobolBrownianGenerator g(*this);
+        g.generator_ = generator_.substream(offset);
+        g.lastStep_ = 0;
+        return g;
+    }
+
 
 
     SobolBrownianGeneratorFactory::SobolBrownianGeneratorFactory(
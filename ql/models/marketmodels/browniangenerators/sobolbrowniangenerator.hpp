@@ -59,6 +59,14 @@ namespace QuantLib {
 
         Size numberOfFactors() const;
         Size numberOfSteps() const;
+
+        //! generator for the paths from the given offset on
+        /*! The returned generator continues the paths of this one as
+            if the given number of paths had been drawn; the state of
+            this generator is not modified.  Different threads or
+            processes can be given contiguous blocks of paths.
+        */
+        SobolBrownianGenerator substream(Size offset) const;
         
         // test interface
         const std::vector<std::vector<Size> >& orderedIndices() const;
@@ -24,6 +24,8 @@
 #include <ql/math/optimization/projectedconstraint.hpp>
 
 #include <ql/utilities/null_deleter.hpp>
+#include <ql/utilities/parallelfor.hpp>
+#include <algorithm>
 
 using std::vector;
 using std::shared_ptr;
@@ -40,17 +42,20 @@ namespace QuantLib {
         CalibrationFunction(CalibratedModel* model,
                             const vector<shared_ptr<CalibrationHelper> >& h,
                             const vector<Real>& weights,
-                            const Projection& projection)
+                            const Projection& projection,
+                            Size threads = 1)
             : model_(model, null_deleter), instruments_(h),
-              weights_(weights), projection_(projection) { }
+              weights_(weights), projection_(projection),
+              threads_(std::min(threads, h.size())), evaluated_(false) { }
 
         virtual ~CalibrationFunction() {}
 
         virtual Real value(const Array& params) const {
             model_->setParams(projection_.include(params));
+            vector<Real> errors = calibrationErrors();
             Real value = 0.0;
             for (Size i=0; i<instruments_.size(); i++) {
-                Real diff = instruments_[i]->calibrationError();
+                Real diff = errors[i];
                 value += diff*diff*weights_[i];
             }
             return std::sqrt(value);
@@ -58,10 +63,10 @@ namespace QuantLib {
 
         virtual Array values(const Array& params) const {
             model_->setParams(projection_.include(params));
+            vector<Real> errors = calibrationErrors();
             Array values(instruments_.size());
             for (Size i=0; i<instruments_.size(); i++) {
-                values[i] = instruments_[i]->calibrationError()
-                           *std::sqrt(weights_[i]);
+                values[i] = errors[i]*std::sqrt(weights_[i]);
             }
             return values;
         }
@@ -69,10 +74,26 @@ namespace QuantLib {
         virtual Real finiteDifferenceEpsilon() const { return 1e-6; }
 
       private:
+        vector<Real> calibrationErrors() const {
+            Size n = instruments_.size();
+            vector<Real> errors(n);
+            // the first evaluation is serial so that lazy objects
+            // shared by the instruments are calculated beforehand
+            Size threads = evaluated_ ? threads_ : 1;
+            evaluated_ = true;
+            parallelFor(threads, threads, [&](Size k) {
+                for (Size i=k*n/threads; i<(k+1)*n/threads; i++)
+                    errors[i] = instruments_[i]->calibrationError();
+            });
+            return errors;
+        }
+
         shared_ptr<CalibratedModel> model_;
         const vector<shared_ptr<CalibrationHelper> >& instruments_;
         vector<Real> weights_;
         const Projection projection_;
+        Size threads_;
+        mutable bool evaluated_;
     };
 
     void CalibratedModel::calibrate(
@@ -82,6 +103,54 @@ namespace QuantLib {
                     const Constraint& additionalConstraint,
                     const vector<Real>& weights,
                     const vector<bool>& fixParameters) {
+        doCalibration(instruments, method, endCriteria, additionalConstraint,
+                      weights, fixParameters, 1);
+    }
+
+    void CalibratedModel::calibrate(
+                    const vector<shared_ptr<CalibrationHelper> >& instruments,
+                    OptimizationMethod& method,
+                    const EndCriteria& endCriteria,
+                    Size threads,
+                    const std::function<shared_ptr<PricingEngine>()>&
+                                                               engineFactory,
+                    const Constraint& additionalConstraint,
+                    const vector<Real>& weights,
+                    const vector<bool>& fixParameters) {
+
+        QL_REQUIRE(threads > 0, "at least one thread required");
+        Size n = instruments.size(), groups = std::min(threads, n);
+
+        vector<shared_ptr<PricingEngine> > engines(n);
+        for (Size i=0; i<n; i++)
+            engines[i] = instruments[i]->pricingEngine();
+        try {
+            for (Size k=0; k<groups; k++) {
+                shared_ptr<PricingEngine> engine = engineFactory();
+                QL_REQUIRE(engine, "null engine returned by factory");
+                for (Size i=k*n/groups; i<(k+1)*n/groups; i++)
+                    instruments[i]->setPricingEngine(engine);
+            }
+            doCalibration(instruments, method, endCriteria,
+                          additionalConstraint, weights, fixParameters,
+                          groups);
+        } catch (...) {
+            for (Size i=0; i<n; i++)
+                instruments[i]->setPricingEngine(engines[i]);
+            throw;
+        }
+        for (Size i=0; i<n; i++)
+            instruments[i]->setPricingEngine(engines[i]);
+    }
+
+    void CalibratedModel::doCalibration(
+                    const vector<shared_ptr<CalibrationHelper> >& instruments,
+                    OptimizationMethod& method,
+                    const EndCriteria& endCriteria,
+                    const Constraint& additionalConstraint,
+                    const vector<Real>& weights,
+                    const vector<bool>& fixParameters,
+                    Size threads) {
 
         QL_REQUIRE(weights.empty() || weights.size() == instruments.size(),
                    "mismatch between number of instruments (" <<
@@ -99,7 +168,7 @@ namespace QuantLib {
         Array prms = params();
         vector<bool> all(prms.size(), false);
         Projection proj(prms,fixParameters.size()>0 ? fixParameters : all);
-        CalibrationFunction f(this,instruments,w,proj);
+        CalibrationFunction f(this,instruments,w,proj,threads);
         ProjectedConstraint pc(c,proj);
         Problem prob(f, pc, proj.project(prms));
         shortRateEndCriteria_ = method.minimize(prob, endCriteria);
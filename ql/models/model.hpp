@@ -31,6 +31,7 @@
 #include <ql/models/parameter.hpp>
 #include <ql/models/calibrationhelper.hpp>
 #include <ql/math/optimization/endcriteria.hpp>
+#include <functional>
 
 namespace QuantLib {
 
@@ -104,6 +105,31 @@ namespace QuantLib {
                 const std::vector<Real>& weights = std::vector<Real>(),
                 const std::vector<bool>& fixParameters = std::vector<bool>());
 
+        //! Calibrate pricing the instruments concurrently
+        /*! The instruments are split into as many contiguous groups
+            as the given number of threads; each group is priced on
+            its own thread by an engine returned by engineFactory, and
+            the instruments get their engines back at the end.  The
+            first evaluation of the cost function is serial, so that
+            the market values of the instruments and any term
+            structure they use are calculated before being shared.
+
+            The results are the same as those of the serial version.
+
+            \warning the engines returned by engineFactory must not
+                     share any mutable state except through the model.
+        */
+        void calibrate(
+                const std::vector<std::shared_ptr<CalibrationHelper> >&,
+                OptimizationMethod& method,
+                const EndCriteria& endCriteria,
+                Size threads,
+                const std::function<std::shared_ptr<PricingEngine>()>&
+                                                               engineFactory,
+                const Constraint& constraint = Constraint(),
+                const std::vector<Real>& weights = std::vector<Real>(),
+                const std::vector<bool>& fixParameters = std::vector<bool>());
+
         Real value(const Array& params,
                    const std::vector<std::shared_ptr<CalibrationHelper> >&);
 
@@ -130,6 +156,14 @@ namespace QuantLib {
         Integer functionEvaluation_;
 
       private:
+        void doCalibration(
+                const std::vector<std::shared_ptr<CalibrationHelper> >&,
+                OptimizationMethod& method,
+                const EndCriteria& endCriteria,
+                const Constraint& constraint,
+                const std::vector<Real>& weights,
+                const std::vector<bool>& fixParameters,
+                Size threads);
         //! Constraint imposed on arguments
         class PrivateConstraint;
         //! Calibration cost function class
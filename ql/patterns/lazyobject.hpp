@@ -83,6 +83,13 @@ namespace QuantLib {
                      behavior.
         */
         void alwaysForwardNotifications();
+        /*! This method performs the calculations if the cached
+            results are not up to date, without returning any of
+            them; it allows client code to calculate lazy objects
+            beforehand, e.g., before using them from several threads.
+            Errors raised by the calculations are propagated.
+        */
+        void calculateIfNeeded() const;
       protected:
         /*! This method performs all needed calculations by calling
             the <i><b>performCalculations</b></i> method.
@@ -131,6 +138,10 @@ namespace QuantLib {
         }
     }
  
+    inline void LazyObject::calculateIfNeeded() const {
+        calculate();
+    }
+
     inline void LazyObject::recalculate() {
         bool wasFrozen = frozen_;
         calculated_ = frozen_ = false;
@@ -21,6 +21,18 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 
 #include <ql/patterns/observable.hpp>
 
+namespace QuantLib {
+
+    namespace {
+
+        // observables with more observers than this keep track of
+        // their positions; for fewer ones, a linear search is faster
+        const Size positionThreshold = 16;
+
+    }
+
+}
+
 #ifndef QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN
 
 namespace QuantLib {
@@ -30,29 +42,181 @@ namespace QuantLib {
         updatesDeferred_ = false;
 
         // if there are outstanding deferred updates, do the notification
-        if (deferredObservers_.size()) {
-            bool successful = true;
-            std::string errMsg;
+        if (deferredObservers_.size())
+            notifyDeferredObservers();
+    }
 
-            for (iterator i=deferredObservers_.begin();
-                i!=deferredObservers_.end(); ++i) {
-                try {
-                    (*i)->update();
-                } catch (std::exception& e) {
-                    successful = false;
-                    errMsg = e.what();
-                } catch (...) {
-                    successful = false;
+    void ObservableSettings::notifyDeferredObservers() {
+        Flush flush;
+        flush.epoch = ++epoch_;
+        flush.previous = flush_;
+
+        // Depth-first visit of the observers reachable from the
+        // deferred ones; observers are sorted by decreasing finishing
+        // time, so that each of them comes after the ones it depends
+        // upon (barring cycles, which are broken arbitrarily).
+        // The visit is iterative since dependency chains can be long.
+        std::vector<Observer*> finished;
+        std::vector<std::pair<Observer*, Size> > stack;
+        set_type roots;
+        roots.swap(deferredObservers_);
+        for (iterator r=roots.begin(); r!=roots.end(); ++r) {
+            if (!flush.positions.emplace(*r, 0).second)
+                continue;
+            stack.emplace_back(*r, 0);
+            while (!stack.empty()) {
+                Observer* o = stack.back().first;
+                Size& next = stack.back().second;
+                const Observable* observable =
+                    dynamic_cast<const Observable*>(o);
+                const Observable::set_type* children =
+                    observable != nullptr ? &observable->observers_
+                                          : nullptr;
+                while (children != nullptr && next < children->size()) {
+                    Observer* child = (*children)[next++];
+                    if (child != nullptr
+                        && flush.positions.emplace(child, 0).second) {
+                        stack.emplace_back(child, 0);
+                        break;
+                    }
+                }
+                if (stack.back().first == o
+                    && (children == nullptr || next == children->size())) {
+                    finished.push_back(o);
+                    stack.pop_back();
                 }
             }
+        }
 
-            deferredObservers_.clear();
+        flush.observers.assign(finished.rbegin(), finished.rend());
+        flush.scheduled.assign(flush.observers.size(), false);
+        for (Size i=0; i<flush.observers.size(); ++i) {
+            flush.positions[flush.observers[i]] = i;
+            // notifications from these observables go through the flush
+            Observable* observable =
+                dynamic_cast<Observable*>(flush.observers[i]);
+            if (observable != nullptr)
+                observable->flushEpoch_ = flush.epoch;
+        }
 
-            QL_ENSURE(successful,
+        // Only the deferred observers are updated up front; the others
+        // are queued when an observable they depend upon notifies them,
+        // so that the latter can decide whether to do so.  Positions
+        // only increase as the queue is processed, since observers
+        // are queued by the ones they depend upon.
+        flush_ = &flush;
+        std::vector<Observer*> deferred(roots.begin(), roots.end());
+        schedule(deferred);
+        bool successful = true;
+        std::string errMsg;
+        while (!flush.pending.empty()) {
+            Observer* o = flush.observers[flush.pending.top()];
+            flush.pending.pop();
+            if (o == nullptr)
+                continue;
+            try {
+                o->update();
+            } catch (std::exception& e) {
+                successful = false;
+                errMsg = e.what();
+            } catch (...) {
+                successful = false;
+            }
+        }
+        flush_ = flush.previous;
+
+        QL_ENSURE(successful,
+                  "could not notify one or more observers: " << errMsg);
+    }
+
+    void ObservableSettings::schedule(
+                                const std::vector<Observer*>& observers) {
+        // observers registered after the flush started are not part
+        // of it and are notified right away
+        std::vector<Observer*> others;
+        for (Size i=0; i<observers.size(); ++i) {
+            if (observers[i] == nullptr)
+                continue;
+            auto p = flush_->positions.find(observers[i]);
+            if (p == flush_->positions.end()) {
+                others.push_back(observers[i]);
+            } else if (!flush_->scheduled[p->second]) {
+                flush_->scheduled[p->second] = true;
+                flush_->pending.push(p->second);
+            }
+        }
+
+        bool successful = true;
+        std::string errMsg;
+        for (Size i=0; i<others.size(); ++i) {
+            try {
+                others[i]->update();
+            } catch (std::exception& e) {
+                successful = false;
+                errMsg = e.what();
+            } catch (...) {
+                successful = false;
+            }
+        }
+        QL_ENSURE(successful,
                   "could not notify one or more observers: " << errMsg);
+    }
+
+
+    void Observable::registerObserver(Observer* o) {
+        observers_.push_back(o);
+        if (!positions_.empty()) {
+            positions_[o] = observers_.size()-1;
+        } else if (observers_.size() > positionThreshold) {
+            for (Size i=0; i<observers_.size(); ++i) {
+                if (observers_[i])
+                    positions_[observers_[i]] = i;
+            }
         }
     }
 
+    Size Observable::unregisterObserver(Observer* o) {
+        if (settings_.updatesDeferred() || settings_.flush_ != nullptr)
+            settings_.unregisterDeferredObserver(o);
+
+        Size i;
+        if (positions_.empty()) {
+            i = std::find(observers_.begin(), observers_.end(), o)
+                - observers_.begin();
+            if (i == observers_.size())
+                return 0;
+        } else {
+            auto p = positions_.find(o);
+            if (p == positions_.end())
+                return 0;
+            i = p->second;
+            positions_.erase(p);
+        }
+
+        if (notifying_ > 0) {
+            // the observers are being iterated over; their positions
+            // must not change until the notification is over
+            observers_[i] = nullptr;
+            hasHoles_ = true;
+        } else {
+            observers_[i] = observers_.back();
+            observers_.pop_back();
+            if (!positions_.empty() && i < observers_.size())
+                positions_[observers_[i]] = i;
+        }
+        return 1;
+    }
+
+    void Observable::compact() {
+        observers_.erase(std::remove(observers_.begin(), observers_.end(),
+                                     static_cast<Observer*>(nullptr)),
+                         observers_.end());
+        if (!positions_.empty()) {
+            for (Size i=0; i<observers_.size(); ++i)
+                positions_[observers_[i]] = i;
+        }
+        hasHoles_ = false;
+    }
 
     void Observable::notifyObservers() {
         if (!settings_.updatesEnabled()) {
@@ -60,12 +224,26 @@ namespace QuantLib {
             // these are held centrally by the settings singleton
             settings_.registerDeferredObservers(observers_);
         }
+        else if (settings_.isScheduled(*this)) {
+            // a flush of deferred updates is in progress and will
+            // notify the observers in due time
+            settings_.schedule(observers_);
+        }
         else if (observers_.size()) {
             bool successful = true;
             std::string errMsg;
-            for (iterator i=observers_.begin(); i!=observers_.end(); ++i) {
+            // observers registered during the notification are
+            // appended and not notified; the ones unregistered are
+            // set to null.  Indices are used since appending might
+            // invalidate iterators.
+            Size n = observers_.size();
+            ++notifying_;
+            for (Size i=0; i<n; ++i) {
+                Observer* o = observers_[i];
+                if (!o)
+                    continue;
                 try {
-                    (*i)->update();
+                    o->update();
                 } catch (std::exception& e) {
                     // quite a dilemma. If we don't catch the exception,
                     // other observers will not receive the notification
@@ -80,6 +258,8 @@ namespace QuantLib {
                     successful = false;
                 }
             }
+            if (--notifying_ == 0 && hasHoles_)
+                compact();
             QL_ENSURE(successful,
                   "could not notify one or more observers: " << errMsg);
         }
@@ -93,14 +273,39 @@ namespace QuantLib {
 
     void Observable::registerObserver(const std::shared_ptr<Observer::Proxy> &observerProxy) {
         std::scoped_lock<std::recursive_mutex> lock(mutex_);
-        observers_.insert(observerProxy);
-
+        observers_.push_back(observerProxy);
+        if (!positions_.empty()) {
+            positions_[observerProxy.get()] = observers_.size()-1;
+        } else if (observers_.size() > positionThreshold) {
+            for (Size i=0; i<observers_.size(); ++i)
+                positions_[observers_[i].get()] = i;
+        }
+        std::atomic_store(&snapshot_, std::shared_ptr<const set_type>());
     }
 
     void Observable::unregisterObserver(const std::shared_ptr<Observer::Proxy> &observerProxy) {
         {
             std::scoped_lock<std::recursive_mutex> lock(mutex_);
-            observers_.erase(observerProxy);
+            Size i;
+            if (positions_.empty()) {
+                i = std::find(observers_.begin(), observers_.end(),
+                              observerProxy) - observers_.begin();
+            } else {
+                auto p = positions_.find(observerProxy.get());
+                i = (p != positions_.end()) ? p->second : observers_.size();
+                if (p != positions_.end())
+                    positions_.erase(p);
+            }
+            if (i < observers_.size()) {
+                // notifications in progress use their own snapshot,
+                // so the order of the observers can be changed
+                observers_[i] = observers_.back();
+                observers_.pop_back();
+                if (!positions_.empty() && i < observers_.size())
+                    positions_[observers_[i].get()] = i;
+                std::atomic_store(&snapshot_,
+                                  std::shared_ptr<const set_type>());
+            }
         }
 
         if (settings_.updatesDeferred()) {
@@ -111,11 +316,25 @@ namespace QuantLib {
         }
     }
 
+    std::shared_ptr<const Observable::set_type>
+    Observable::snapshot() const {
+        std::shared_ptr<const set_type> observers =
+            std::atomic_load(&snapshot_);
+        if (!observers) {
+            std::scoped_lock<std::recursive_mutex> lock(mutex_);
+            observers = std::atomic_load(&snapshot_);
+            if (!observers) {
+                observers = std::make_shared<const set_type>(observers_);
+                std::atomic_store(&snapshot_, observers);
+            }
+        }
+        return observers;
+    }
+
     void Observable::notifyObservers() {
         if (settings_.updatesEnabled()) {
-            std::scoped_lock<std::recursive_mutex> lock(mutex_);
-            set_type observers_copy_(observers_);
-            for (auto const &o : observers_copy_) {
+            const std::shared_ptr<const set_type> observers = snapshot();
+            for (auto const &o : *observers) {
                 if (o) {
                     o->update();
                 }
@@ -125,9 +344,8 @@ namespace QuantLib {
 
         std::scoped_lock<std::mutex> sLock(settings_.mutex_);
         if (settings_.updatesEnabled()) {
-            std::scoped_lock<std::recursive_mutex> lock(mutex_);
-            set_type observers_copy_(observers_);
-            for (auto const &o : observers_copy_) {
+            const std::shared_ptr<const set_type> observers = snapshot();
+            for (auto const &o : *observers) {
                 if (o) {
                     o->update();
                 }
@@ -142,7 +360,7 @@ namespace QuantLib {
     }
 
     Observable::Observable()
-            : settings_(ObservableSettings::instance()), observers_(1000) {}
+            : settings_(ObservableSettings::instance()) {}
 
     Observable::Observable(const Observable &)
             : settings_(ObservableSettings::instance()) {
@@ -35,7 +35,11 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 
 #include <memory>
 #include <algorithm>
+#include <functional>
+#include <queue>
+#include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 
 #ifndef QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN
@@ -58,6 +62,14 @@ namespace QuantLib {
             updatesDeferred_ = deferred;
         }
 
+        /*! If updates were deferred, the observers of the
+            observables changed in the meantime are notified.  Each
+            of them decides as usual whether to forward the
+            notification (lazy objects that are frozen, for instance,
+            don't); the observers reached this way are notified at
+            most once, and only after all the notified observers
+            they depend upon.
+        */
         void enableUpdates();
 
         bool updatesEnabled() { return updatesEnabled_; }
@@ -66,31 +78,61 @@ namespace QuantLib {
 
     private:
         ObservableSettings()
-                : updatesEnabled_(true),
-                  updatesDeferred_(false) {}
+                : flush_(nullptr), epoch_(0),
+                  updatesEnabled_(true), updatesDeferred_(false) {}
 
         void registerDeferredObservers(
-                const std::unordered_set<Observer *> &observers);
+                const std::vector<Observer *> &observers);
 
         void unregisterDeferredObserver(Observer *);
 
+        void notifyDeferredObservers();
+
+        // whether the given observable was reached by the current
+        // flush of deferred updates
+        bool isScheduled(const Observable &) const;
+
+        // queues the given observers for notification by the current
+        // flush, in dependency order
+        void schedule(const std::vector<Observer *> &observers);
+
         typedef std::unordered_set<Observer *> set_type;
         typedef set_type::iterator iterator;
         set_type deferredObservers_;
 
+        // observers that can be reached by a flush of deferred
+        // updates, sorted so that each comes after the ones it
+        // depends upon; only the ones actually notified are updated
+        struct Flush {
+            std::vector<Observer *> observers;
+            std::unordered_map<Observer *, Size> positions;
+            std::vector<bool> scheduled;
+            std::priority_queue<Size, std::vector<Size>,
+                                std::greater<Size> > pending;
+            Size epoch;
+            Flush *previous;
+        };
+        Flush *flush_;
+        Size epoch_;
+
         bool updatesEnabled_, updatesDeferred_;
     };
 
     //! Object that notifies its changes to a set of observers
-    /*! \ingroup patterns */
+    /*! Observers are stored contiguously, so that notifying them
+        is a linear scan; observables with many observers also keep
+        the position of each of them, so that unregistering is done
+        in constant time.
+
+        \ingroup patterns
+    */
     class Observable {
         friend class Observer;
+        friend class ObservableSettings;
 
     public:
         // constructors, assignment, destructor
-        // set the bucket size to prevent unordered_set rehashing, which invalidates iterators if inserting into
-        // unordered_set while iterating!!
-        Observable() : settings_(ObservableSettings::instance()), observers_(1000) {}
+        Observable();
 
         Observable(const Observable &);
 
@@ -104,13 +146,24 @@ namespace QuantLib {
         void notifyObservers();
 
     private:
-        typedef std::unordered_set<Observer *>::iterator iterator;
+        typedef std::vector<Observer *> set_type;
 
-        std::pair<iterator, bool> registerObserver(Observer *);
+        void registerObserver(Observer *);
 
         Size unregisterObserver(Observer *);
 
-        std::unordered_set<Observer *> observers_;
+        void compact();
+
+        set_type observers_;
+        // position of each observer in observers_; it is only kept
+        // when the number of observers exceeds a given threshold
+        std::unordered_map<Observer *, Size> positions_;
+        // observers unregistered while a notification is in progress
+        // are set to null and removed when the notification ends
+        Size notifying_;
+        bool hasHoles_;
+        // last flush of deferred updates that scheduled the observers
+        Size flushEpoch_;
         ObservableSettings &settings_;
     };
 
@@ -158,18 +211,38 @@ namespace QuantLib {
     // inline definitions
 
     inline void ObservableSettings::registerDeferredObservers(
-            const std::unordered_set<Observer *> &observers) {
+            const std::vector<Observer *> &observers) {
         if (updatesDeferred()) {
-            deferredObservers_.insert(observers.begin(), observers.end());
+            for (Size i = 0; i < observers.size(); ++i) {
+                if (observers[i])
+                    deferredObservers_.insert(observers[i]);
+            }
         }
     }
 
     inline void ObservableSettings::unregisterDeferredObserver(Observer *o) {
         deferredObservers_.erase(o);
+        // observers being destroyed during a flush must be skipped
+        for (Flush *f = flush_; f != nullptr; f = f->previous) {
+            auto i = f->positions.find(o);
+            if (i != f->positions.end()) {
+                f->observers[i->second] = nullptr;
+                f->positions.erase(i);
+            }
+        }
+    }
+
+    inline bool ObservableSettings::isScheduled(const Observable &o) const {
+        return flush_ != nullptr && o.flushEpoch_ == flush_->epoch;
     }
 
+    inline Observable::Observable()
+            : notifying_(0), hasHoles_(false), flushEpoch_(0),
+              settings_(ObservableSettings::instance()) {}
+
     inline Observable::Observable(const Observable &)
-            : settings_(ObservableSettings::instance()) {
+            : notifying_(0), hasHoles_(false), flushEpoch_(0),
+              settings_(ObservableSettings::instance()) {
         // the observer set is not copied; no observer asked to
         // register with this object
     }
@@ -190,18 +263,6 @@ namespace QuantLib {
         return *this;
     }
 
-    inline std::pair<std::unordered_set<Observer *>::iterator, bool>
-    Observable::registerObserver(Observer *o) {
-        return observers_.insert(o);
-    }
-
-    inline Size Observable::unregisterObserver(Observer *o) {
-        if (settings_.updatesDeferred())
-            settings_.unregisterDeferredObserver(o);
-
-        return observers_.erase(o);
-    }
-
 
     inline Observer::Observer(const Observer &o)
             : observables_(o.observables_) {
@@ -227,8 +288,11 @@ namespace QuantLib {
     inline std::pair<Observer::iterator, bool>
     Observer::registerWith(const std::shared_ptr<Observable> &h) {
         if (h) {
-            h->registerObserver(this);
-            return observables_.insert(h);
+            // observables don't check for duplicates
+            std::pair<iterator, bool> result = observables_.insert(h);
+            if (result.second)
+                h->registerObserver(this);
+            return result;
         }
         return std::make_pair(observables_.end(), false);
     }
@@ -244,7 +308,7 @@ namespace QuantLib {
 
     inline
     Size Observer::unregisterWith(const std::shared_ptr<Observable> &h) {
-        if (h)
+        if (h && observables_.count(h) != 0)
             h->unregisterObserver(this);
         return observables_.erase(h);
     }
@@ -350,11 +414,16 @@ namespace QuantLib {
 
     //! Object that notifies its changes to a set of observers
     /*! \ingroup patterns */
+    /*! Observers are stored contiguously; notifications iterate
+        over an immutable copy of the observers, which is shared by
+        all notifications until an observer is registered or
+        unregistered.  Therefore, notifications don't lock the
+        observable and can run concurrently with registrations.
+    */
     class Observable {
         friend class Observer;
       public:
-        typedef std::unordered_set<std::shared_ptr<Observer::Proxy> >
-            set_type;
+        typedef std::vector<std::shared_ptr<Observer::Proxy> > set_type;
         typedef set_type::iterator iterator;
 
         // constructors, assignment, destructor
@@ -369,8 +438,15 @@ namespace QuantLib {
       private:
         void registerObserver(const std::shared_ptr<Observer::Proxy>&);
         void unregisterObserver(const std::shared_ptr<Observer::Proxy>&);
+        std::shared_ptr<const set_type> snapshot() const;
 
         set_type observers_;
+        // position of each observer in observers_; it is only kept
+        // when the number of observers exceeds a given threshold
+        std::unordered_map<Observer::Proxy*, Size> positions_;
+        // copy of observers_ used by notifications; it is reset
+        // when the observers change and accessed atomically
+        mutable std::shared_ptr<const set_type> snapshot_;
         mutable std::recursive_mutex mutex_;
 
         ObservableSettings& settings_;
@@ -519,8 +595,11 @@ namespace QuantLib {
         }
 
         if (h) {
-            h->registerObserver(proxy_);
-            return observables_.insert(h);
+            // observables don't check for duplicates
+            std::pair<iterator, bool> result = observables_.insert(h);
+            if (result.second)
+                h->registerObserver(proxy_);
+            return result;
         }
         return std::make_pair(observables_.end(), false);
     }
@@ -540,7 +619,7 @@ namespace QuantLib {
     inline Size Observer::unregisterWith(const std::shared_ptr<Observable>& h) {
         std::scoped_lock<std::recursive_mutex> lock(mutex_);
 
-        if (h)  {
+        if (h && observables_.count(h) != 0)  {
             QL_REQUIRE(proxy_, "unregister called without a proxy");
             h->unregisterObserver(proxy_);
         }
@@ -558,4 +637,63 @@ namespace QuantLib {
     }
 }
 #endif
+
+namespace QuantLib {
+
+    //! Batch of changes to observables
+    /*! Notifications are deferred from the construction of an
+        instance until commit() is called or, failing that, until
+        the instance is destroyed.  At that point, the observers
+        depending on the changed observables are notified as
+        described in ObservableSettings::enableUpdates; for instance,
+        a lazy object depending on several changed quotes, directly
+        or through other lazy objects, is only notified once.
+
+        If updates are already disabled when the instance is
+        created, e.g., by an enclosing transaction, the instance
+        has no effect.
+
+        \ingroup patterns
+    */
+    class UpdateTransaction {
+      public:
+        UpdateTransaction();
+        UpdateTransaction(const UpdateTransaction&) = delete;
+        UpdateTransaction& operator=(const UpdateTransaction&) = delete;
+        /*! Notifications are sent if commit() wasn't called; since
+            destructors can't throw, errors raised by observers are
+            lost.
+        */
+        ~UpdateTransaction();
+        //! notifies the observers of the changes made so far
+        void commit();
+      private:
+        bool active_;
+    };
+
+
+    // inline definitions
+
+    inline UpdateTransaction::UpdateTransaction() {
+        ObservableSettings& settings = ObservableSettings::instance();
+        active_ = settings.updatesEnabled();
+        if (active_)
+            settings.disableUpdates(true);
+    }
+
+    inline UpdateTransaction::~UpdateTransaction() {
+        try {
+            commit();
+        } catch (...) {}
+    }
+
+    inline void UpdateTransaction::commit() {
+        if (active_) {
+            active_ = false;
+            ObservableSettings::instance().enableUpdates();
+        }
+    }
+
+}
+
 #endif
@@ -180,6 +180,7 @@ namespace QuantLib {
         MakeMCDiscreteArithmeticAPEngine& withAbsoluteTolerance(Real tolerance);
         MakeMCDiscreteArithmeticAPEngine& withMaxSamples(Size samples);
         MakeMCDiscreteArithmeticAPEngine& withSeed(BigNatural seed);
+        MakeMCDiscreteArithmeticAPEngine& withThreads(Size threads);
         MakeMCDiscreteArithmeticAPEngine& withAntitheticVariate(bool b = true);
         MakeMCDiscreteArithmeticAPEngine& withControlVariate(bool b = true);
         // conversion to pricing engine
@@ -191,6 +192,7 @@ namespace QuantLib {
         Real tolerance_;
         bool brownianBridge_;
         BigNatural seed_;
+        Size threads_;
     };
 
     template <class RNG, class S>
@@ -199,7 +201,8 @@ namespace QuantLib {
              const std::shared_ptr<GeneralizedBlackScholesProcess>& process)
     : process_(process), antithetic_(false), controlVariate_(false),
       samples_(Null<Size>()), maxSamples_(Null<Size>()),
-      tolerance_(Null<Real>()), brownianBridge_(true), seed_(0) {}
+      tolerance_(Null<Real>()), brownianBridge_(true), seed_(0),
+      threads_(0) {}
 
     template <class RNG, class S>
     inline MakeMCDiscreteArithmeticAPEngine<RNG,S>&
@@ -237,6 +240,13 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG, class S>
+    inline MakeMCDiscreteArithmeticAPEngine<RNG,S>&
+    MakeMCDiscreteArithmeticAPEngine<RNG,S>::withThreads(Size threads) {
+        threads_ = threads;
+        return *this;
+    }
+
     template <class RNG, class S>
     inline MakeMCDiscreteArithmeticAPEngine<RNG,S>&
     MakeMCDiscreteArithmeticAPEngine<RNG,S>::withBrownianBridge(bool b) {
@@ -262,13 +272,15 @@ namespace QuantLib {
     inline
     MakeMCDiscreteArithmeticAPEngine<RNG,S>::operator std::shared_ptr<PricingEngine>()
                                                                       const {
-        return std::shared_ptr<PricingEngine>(new
-            MCDiscreteArithmeticAPEngine<RNG,S>(process_,
-                                                brownianBridge_,
-                                                antithetic_, controlVariate_,
-                                                samples_, tolerance_,
-                                                maxSamples_,
-                                                seed_));
+        std::shared_ptr<MCDiscreteArithmeticAPEngine<RNG,S> > engine(
+            new MCDiscreteArithmeticAPEngine<RNG,S>(process_,
+                                                    brownianBridge_,
+                                                    antithetic_, controlVariate_,
+                                                    samples_, tolerance_,
+                                                    maxSamples_,
+                                                    seed_));
+        engine->setThreads(threads_);
+        return engine;
     }
 
 
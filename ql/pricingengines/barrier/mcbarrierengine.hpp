@@ -79,6 +79,10 @@ namespace QuantLib {
             Real spot = process_->x0();
             QL_REQUIRE(spot >= 0.0, "negative or null underlying given");
             QL_REQUIRE(!triggered(spot), "barrier touched");
+            // the unbiased path pricer draws its own random numbers
+            QL_REQUIRE(isBiased_ || this->threads_ == 0,
+                       "multi-threaded simulation only supported "
+                       "by the biased path pricer");
             McSimulation<SingleVariate,RNG,S>::calculate(requiredTolerance_,
                                                          requiredSamples_,
                                                          maxSamples_);
@@ -126,6 +130,7 @@ namespace QuantLib {
         MakeMCBarrierEngine& withMaxSamples(Size samples);
         MakeMCBarrierEngine& withBias(bool b = true);
         MakeMCBarrierEngine& withSeed(BigNatural seed);
+        MakeMCBarrierEngine& withThreads(Size threads);
         // conversion to pricing engine
         operator std::shared_ptr<PricingEngine>() const;
       private:
@@ -134,6 +139,7 @@ namespace QuantLib {
         Size steps_, stepsPerYear_, samples_, maxSamples_;
         Real tolerance_;
         BigNatural seed_;
+        Size threads_;
     };
 
 
@@ -278,7 +284,7 @@ namespace QuantLib {
     : process_(process), brownianBridge_(false), antithetic_(false),
       biased_(false), steps_(Null<Size>()), stepsPerYear_(Null<Size>()),
       samples_(Null<Size>()), maxSamples_(Null<Size>()),
-      tolerance_(Null<Real>()), seed_(0) {}
+      tolerance_(Null<Real>()), seed_(0), threads_(0) {}
 
     template <class RNG, class S>
     inline MakeMCBarrierEngine<RNG,S>&
@@ -350,6 +356,13 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG, class S>
+    inline MakeMCBarrierEngine<RNG,S>&
+    MakeMCBarrierEngine<RNG,S>::withThreads(Size threads) {
+        threads_ = threads;
+        return *this;
+    }
+
     template <class RNG, class S>
     inline
     MakeMCBarrierEngine<RNG,S>::operator std::shared_ptr<PricingEngine>()
@@ -358,16 +371,18 @@ namespace QuantLib {
                    "number of steps not given");
         QL_REQUIRE(steps_ == Null<Size>() || stepsPerYear_ == Null<Size>(),
                    "number of steps overspecified");
-        return std::shared_ptr<PricingEngine>(new
-            MCBarrierEngine<RNG,S>(process_,
-                                   steps_,
-                                   stepsPerYear_,
-                                   brownianBridge_,
-                                   antithetic_,
-                                   samples_, tolerance_,
-                                   maxSamples_,
-                                   biased_,
-                                   seed_));
+        std::shared_ptr<MCBarrierEngine<RNG,S> > engine(
+            new MCBarrierEngine<RNG,S>(process_,
+                                       steps_,
+                                       stepsPerYear_,
+                                       brownianBridge_,
+                                       antithetic_,
+                                       samples_, tolerance_,
+                                       maxSamples_,
+                                       biased_,
+                                       seed_));
+        engine->setThreads(threads_);
+        return engine;
     }
 
 }
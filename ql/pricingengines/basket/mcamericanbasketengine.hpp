@@ -80,12 +80,14 @@ namespace QuantLib {
         MakeMCAmericanBasketEngine& withMaxSamples(Size samples);
         MakeMCAmericanBasketEngine& withSeed(BigNatural seed);
         MakeMCAmericanBasketEngine& withCalibrationSamples(Size samples);
+        MakeMCAmericanBasketEngine& withLeanCalibration(Size threads = 1);
         // conversion to pricing engine
         operator std::shared_ptr<PricingEngine>() const;
       private:
         std::shared_ptr<StochasticProcessArray> process_;
         bool brownianBridge_, antithetic_;
         Size steps_, stepsPerYear_, samples_, maxSamples_, calibrationSamples_;
+        Size leanCalibrationThreads_;
         Real tolerance_;
         BigNatural seed_;
     };
@@ -180,7 +182,7 @@ namespace QuantLib {
     : process_(process), brownianBridge_(false), antithetic_(false),
       steps_(Null<Size>()), stepsPerYear_(Null<Size>()),
       samples_(Null<Size>()), maxSamples_(Null<Size>()),
-      calibrationSamples_(Null<Size>()),
+      calibrationSamples_(Null<Size>()), leanCalibrationThreads_(0),
       tolerance_(Null<Real>()), seed_(0) {}
 
     template <class RNG>
@@ -253,6 +255,13 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG>
+    inline MakeMCAmericanBasketEngine<RNG>&
+    MakeMCAmericanBasketEngine<RNG>::withLeanCalibration(Size threads) {
+        leanCalibrationThreads_ = threads;
+        return *this;
+    }
+
     template <class RNG>
     inline
     MakeMCAmericanBasketEngine<RNG>::operator
@@ -261,17 +270,19 @@ namespace QuantLib {
                    "number of steps not given");
         QL_REQUIRE(steps_ == Null<Size>() || stepsPerYear_ == Null<Size>(),
                    "number of steps overspecified");
-        return std::shared_ptr<PricingEngine>(new
-            MCAmericanBasketEngine<RNG>(process_,
-                                        steps_,
-                                        stepsPerYear_,
-                                        brownianBridge_,
-                                        antithetic_,
-                                        samples_,
-                                        tolerance_,
-                                        maxSamples_,
-                                        seed_,
-                                        calibrationSamples_));
+        std::shared_ptr<MCAmericanBasketEngine<RNG> > engine(
+            new MCAmericanBasketEngine<RNG>(process_,
+                                            steps_,
+                                            stepsPerYear_,
+                                            brownianBridge_,
+                                            antithetic_,
+                                            samples_,
+                                            tolerance_,
+                                            maxSamples_,
+                                            seed_,
+                                            calibrationSamples_));
+        engine->setLeanCalibration(leanCalibrationThreads_);
+        return engine;
     }
 
 }
@@ -579,4 +579,219 @@ namespace QuantLib {
     }
 
 
+    namespace {
+
+        void checkBatchSizes(Size strikes, Size forwards, Size values) {
+            QL_REQUIRE(forwards == strikes,
+                       "mismatch between strikes (" << strikes
+                       << ") and forwards (" << forwards << ")");
+            QL_REQUIRE(values == strikes,
+                       "mismatch between strikes (" << strikes
+                       << ") and values (" << values << ")");
+        }
+
+    }
+
+    std::vector<Real> blackFormula(Option::Type optionType,
+                                   const std::vector<Real>& strikes,
+                                   const std::vector<Real>& forwards,
+                                   const std::vector<Real>& stdDevs,
+                                   Real discount,
+                                   Real displacement) {
+        Size n = strikes.size();
+        checkBatchSizes(n, forwards.size(), stdDevs.size());
+        QL_REQUIRE(discount>0.0,
+                   "discount (" << discount << ") must be positive");
+        for (Size i=0; i<n; ++i) {
+            checkParameters(strikes[i], forwards[i], displacement);
+            QL_REQUIRE(stdDevs[i]>=0.0,
+                       "stdDev (" << stdDevs[i] << ") must be non-negative");
+        }
+        if (n == 0)
+            return std::vector<Real>();
+
+        // the same calculations as the single-option version, one
+        // step at a time for the whole batch; null standard deviations
+        // and strikes are dealt with at the end
+        std::vector<Real> nd1(n), nd2(n), result(n);
+        for (Size i=0; i<n; ++i) {
+            Real forward = forwards[i] + displacement;
+            Real strike = strikes[i] + displacement;
+            Real d1 = std::log(forward/strike)/stdDevs[i] + 0.5*stdDevs[i];
+            nd1[i] = optionType*d1;
+            nd2[i] = optionType*(d1 - stdDevs[i]);
+        }
+        CumulativeNormalDistribution phi;
+        phi(&nd1[0], &nd1[0], n);
+        phi(&nd2[0], &nd2[0], n);
+        for (Size i=0; i<n; ++i) {
+            Real forward = forwards[i] + displacement;
+            Real strike = strikes[i] + displacement;
+            result[i] =
+                discount * optionType * (forward*nd1[i] - strike*nd2[i]);
+        }
+
+        for (Size i=0; i<n; ++i) {
+            if (stdDevs[i]==0.0 || strikes[i]+displacement==0.0)
+                result[i] = blackFormula(optionType, strikes[i], forwards[i],
+                                         stdDevs[i], discount, displacement);
+            QL_ENSURE(result[i]>=0.0,
+                      "negative value (" << result[i] << ") for " <<
+                      stdDevs[i] << " stdDev, " <<
+                      optionType << " option, " <<
+                      strikes[i] << " strike , " <<
+                      forwards[i] << " forward");
+        }
+        return result;
+    }
+
+    std::vector<Real> blackFormulaImpliedStdDev(
+                                   Option::Type optionType,
+                                   const std::vector<Real>& strikes,
+                                   const std::vector<Real>& forwards,
+                                   const std::vector<Real>& blackPrices,
+                                   Real discount,
+                                   Real displacement,
+                                   Real accuracy,
+                                   Natural maxIterations) {
+        Size n = strikes.size();
+        checkBatchSizes(n, forwards.size(), blackPrices.size());
+        QL_REQUIRE(discount>0.0,
+                   "discount (" << discount << ") must be positive");
+        if (n == 0)
+            return std::vector<Real>();
+
+        // Each option is mapped to the out-of-the-money call with the
+        // same normalized price
+        //   b(x,s) = exp(x/2) N(x/s+s/2) - exp(-x/2) N(x/s-s/2)
+        // where x = -|log(F/K)| and s is the standard deviation.  The
+        // equation g(s) = log b(x,s) - log beta = 0 is well-behaved
+        // even for the low prices of far out-of-the-money options;
+        // with v = b'/b and u = x^2/s^3 - s/4, the derivatives of g
+        // are g' = v, g'' = v (u - v) and
+        //   g''' = v (u^2 - 3x^2/s^4 - 1/4 - 3uv + 2v^2).
+        std::vector<Real> x(n), beta(n), stdDev(n), step(n, 0.0);
+        std::vector<Real> nd1(n), nd2(n), d1(n);
+        std::vector<bool> solvable(n, true);
+        const Real maxStdDev = 24.0; // as in the single-option version
+        for (Size i=0; i<n; ++i) {
+            checkParameters(strikes[i], forwards[i], displacement);
+            QL_REQUIRE(blackPrices[i]>=0.0,
+                       "option price (" << blackPrices[i]
+                       << ") must be non-negative");
+            Real forward = forwards[i] + displacement;
+            Real strike = strikes[i] + displacement;
+            Real price = blackPrices[i];
+            Real otherPrice =
+                price - optionType*(forwards[i]-strikes[i])*discount;
+            Option::Type type = optionType;
+            if ((optionType==Option::Put && strike>forward) ||
+                (optionType==Option::Call && strike<forward)) {
+                type = Option::Type(-optionType);
+                price = otherPrice;
+            }
+            x[i] = -std::fabs(std::log(forward/strike));
+            beta[i] = price/(discount*std::sqrt(forward*strike));
+            // degenerate and arbitrageable prices are left to the
+            // single-option version, which also reports the errors;
+            // placeholder values keep the iterations finite
+            if (!(otherPrice>=0.0 && beta[i]>0.0 &&
+                  beta[i]<std::exp(0.5*x[i]) && std::isfinite(x[i]))) {
+                solvable[i] = false;
+                x[i] = 0.0;
+                beta[i] = 0.5;
+                stdDev[i] = 1.0;
+                continue;
+            }
+            Real guess = blackFormulaImpliedStdDevApproximation(
+                              type, strike, forward, price, discount, 0.0);
+            if (!(guess > 0.0 && guess < maxStdDev))
+                guess = std::sqrt(2.0*std::fabs(x[i]));
+            stdDev[i] = std::max(guess, accuracy);
+        }
+
+        // third-order Householder iterations for the whole batch
+        const Real sqrt2pi = std::sqrt(2.0*M_PI);
+        CumulativeNormalDistribution phi;
+        bool converged = false;
+        for (Natural iteration=0; iteration<maxIterations && !converged;
+             ++iteration) {
+            for (Size i=0; i<n; ++i) {
+                Real s = stdDev[i];
+                d1[i] = x[i]/s + 0.5*s;
+                nd2[i] = x[i]/s - 0.5*s;
+            }
+            phi(&d1[0], &nd1[0], n);
+            phi(&nd2[0], &nd2[0], n);
+            converged = true;
+            for (Size i=0; i<n; ++i) {
+                Real s = stdDev[i], x2 = x[i]*x[i], e = std::exp(0.5*x[i]);
+                Real b = e*nd1[i] - nd2[i]/e;
+                Real v = e*std::exp(-0.5*d1[i]*d1[i])/(sqrt2pi*b);
+                Real u = x2/(s*s*s) - 0.25*s;
+                Real h2 = u - v;
+                Real h3 = u*u - 3.0*x2/(s*s*s*s) - 0.25 - 3.0*u*v + 2.0*v*v;
+                Real nu = -std::log(b/beta[i])/v;
+                Real next =
+                    s + nu*(1.0 + 0.5*h2*nu)/(1.0 + h2*nu + h3*nu*nu/6.0);
+                // keep the iterations within the admissible range
+                if (!(next > 0.0))
+                    next = 0.5*s;
+                else if (next > maxStdDev)
+                    next = 0.5*(s + maxStdDev);
+                step[i] = next - s;
+                stdDev[i] = next;
+                converged = converged &&
+                    (std::fabs(step[i]) <= accuracy || !solvable[i]);
+            }
+        }
+
+        for (Size i=0; i<n; ++i) {
+            if (!solvable[i] || !(std::fabs(step[i]) <= accuracy))
+                stdDev[i] = blackFormulaImpliedStdDev(
+                    optionType, strikes[i], forwards[i], blackPrices[i],
+                    discount, displacement, Null<Real>(), accuracy,
+                    maxIterations);
+        }
+        return stdDev;
+    }
+
+    std::vector<Real> bachelierBlackFormula(Option::Type optionType,
+                                            const std::vector<Real>& strikes,
+                                            const std::vector<Real>& forwards,
+                                            const std::vector<Real>& stdDevs,
+                                            Real discount) {
+        Size n = strikes.size();
+        checkBatchSizes(n, forwards.size(), stdDevs.size());
+        QL_REQUIRE(discount>0.0,
+                   "discount (" << discount << ") must be positive");
+        for (Size i=0; i<n; ++i)
+            QL_REQUIRE(stdDevs[i]>=0.0,
+                       "stdDev (" << stdDevs[i] << ") must be non-negative");
+        if (n == 0)
+            return std::vector<Real>();
+
+        std::vector<Real> h(n), nh(n), result(n);
+        for (Size i=0; i<n; ++i)
+            h[i] = (forwards[i]-strikes[i])*optionType/stdDevs[i];
+        CumulativeNormalDistribution phi;
+        phi(&h[0], &nh[0], n);
+        for (Size i=0; i<n; ++i) {
+            Real d = (forwards[i]-strikes[i])*optionType;
+            if (stdDevs[i]==0.0)
+                result[i] = discount*std::max(d, 0.0);
+            else
+                result[i] = discount*(stdDevs[i]*phi.derivative(h[i])
+                                      + d*nh[i]);
+            QL_ENSURE(result[i]>=0.0,
+                      "negative value (" << result[i] << ") for " <<
+                      stdDevs[i] << " stdDev, " <<
+                      optionType << " option, " <<
+                      strikes[i] << " strike , " <<
+                      forwards[i] << " forward");
+        }
+        return result;
+    }
+
+
 }
@@ -33,6 +33,7 @@
 
 #include <ql/option.hpp>
 #include <ql/instruments/payoffs.hpp>
+#include <vector>
 
 namespace QuantLib {
 
@@ -287,6 +288,57 @@ namespace QuantLib {
                                                 Real stdDev,
                                                 Real discount = 1.0);
 
+
+    /*! \name Batch versions
+        These functions work on arrays of options of the same type
+        and return the same results (up to rounding) as the functions
+        called on each option, but they're arranged so that each
+        step (e.g., the calculation of the normal distribution) is
+        performed on the whole arrays at once.
+    */
+    //@{
+    /*! Black 1976 formula for a batch of options
+        \warning instead of volatility it uses standard deviation,
+                 i.e. volatility*sqrt(timeToMaturity)
+    */
+    std::vector<Real> blackFormula(Option::Type optionType,
+                                   const std::vector<Real>& strikes,
+                                   const std::vector<Real>& forwards,
+                                   const std::vector<Real>& stdDevs,
+                                   Real discount = 1.0,
+                                   Real displacement = 0.0);
+
+    /*! Black 1976 implied standard deviation for a batch of options.
+
+        The whole batch is solved at the same time by means of
+        third-order Householder iterations on the logarithm of the
+        normalized price of the out-of-the-money option, starting
+        from the Corrado-Miller approximation; options for which the
+        iterations don't converge are solved one at a time as in
+        blackFormulaImpliedStdDev.
+    */
+    std::vector<Real> blackFormulaImpliedStdDev(
+                                   Option::Type optionType,
+                                   const std::vector<Real>& strikes,
+                                   const std::vector<Real>& forwards,
+                                   const std::vector<Real>& blackPrices,
+                                   Real discount = 1.0,
+                                   Real displacement = 0.0,
+                                   Real accuracy = 1.0e-6,
+                                   Natural maxIterations = 100);
+
+    /*! Bachelier formula for a batch of options
+        \warning Bachelier model needs absolute volatility, not
+                 percentage volatility. Standard deviation is
+                 absoluteVolatility*sqrt(timeToMaturity)
+    */
+    std::vector<Real> bachelierBlackFormula(Option::Type optionType,
+                                            const std::vector<Real>& strikes,
+                                            const std::vector<Real>& forwards,
+                                            const std::vector<Real>& stdDevs,
+                                            Real discount = 1.0);
+    //@}
+
 }
 
 #endif
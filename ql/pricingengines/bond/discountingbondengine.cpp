@@ -25,9 +25,11 @@ namespace QuantLib {
 
     DiscountingBondEngine::DiscountingBondEngine(
                              const Handle<YieldTermStructure>& discountCurve,
-                             std::optional<bool> includeSettlementDateFlows)
+                             std::optional<bool> includeSettlementDateFlows,
+                             bool calculateDiscountAdjoints)
     : discountCurve_(discountCurve),
-      includeSettlementDateFlows_(includeSettlementDateFlows) {
+      includeSettlementDateFlows_(includeSettlementDateFlows),
+      calculateDiscountAdjoints_(calculateDiscountAdjoints) {
         registerWith(discountCurve_);
     }
 
@@ -42,11 +44,22 @@ namespace QuantLib {
             *includeSettlementDateFlows_ :
             Settings::instance().includeReferenceDateEvents();
 
-        results_.value = CashFlows::npv(arguments_.cashflows,
-                                        **discountCurve_,
-                                        includeRefDateFlows,
-                                        results_.valuationDate,
-                                        results_.valuationDate);
+        if (calculateDiscountAdjoints_) {
+            std::map<Date, Real> adjoints;
+            results_.value = CashFlows::npv(arguments_.cashflows,
+                                            **discountCurve_,
+                                            includeRefDateFlows,
+                                            results_.valuationDate,
+                                            results_.valuationDate,
+                                            1.0, adjoints);
+            results_.additionalResults["discountAdjoints"] = adjoints;
+        } else {
+            results_.value = CashFlows::npv(arguments_.cashflows,
+                                            **discountCurve_,
+                                            includeRefDateFlows,
+                                            results_.valuationDate,
+                                            results_.valuationDate);
+        }
 
         // a bond's cashflow on settlement date is never taken into
         // account, so we might have to play it safe and recalculate
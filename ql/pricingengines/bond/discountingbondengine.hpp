@@ -31,12 +31,18 @@
 
 namespace QuantLib {
 
+    /*! If required, the engine also returns as the additional
+        result "discountAdjoints", of type std::map<Date, Real>, the
+        derivatives of the bond NPV with respect to the discount
+        factors of its curve at the dates it uses; see CashFlows::npv.
+    */
     class DiscountingBondEngine : public Bond::engine {
       public:
         DiscountingBondEngine(
               const Handle<YieldTermStructure>& discountCurve =
                                                 Handle<YieldTermStructure>(),
-              std::optional<bool> includeSettlementDateFlows = std::nullopt);
+              std::optional<bool> includeSettlementDateFlows = std::nullopt,
+              bool calculateDiscountAdjoints = false);
         void calculate() const;
         Handle<YieldTermStructure> discountCurve() const {
             return discountCurve_;
@@ -44,6 +50,7 @@ namespace QuantLib {
       private:
         Handle<YieldTermStructure> discountCurve_;
         std::optional<bool> includeSettlementDateFlows_;
+        bool calculateDiscountAdjoints_;
     };
 
 }
@@ -49,9 +49,21 @@ namespace QuantLib {
                                const TimeGrid& timeGrid);
         void update();
       protected:
+        /*! returns the lattice passed at construction, if any, or
+            one built on the mandatory times of the instrument with
+            the given number of steps.  The latter is kept and
+            returned again, together with the state prices it has
+            cached, while the mandatory times are the same and the
+            model doesn't change.
+        */
+        std::shared_ptr<Lattice> lattice(
+                               const std::vector<Time>& mandatoryTimes) const;
         TimeGrid timeGrid_;
         Size timeSteps_;
         std::shared_ptr<Lattice> lattice_;
+      private:
+        mutable std::vector<Time> mandatoryTimes_;
+        mutable std::shared_ptr<Lattice> sharedLattice_;
     };
 
     template <class Arguments, class Results>
@@ -90,9 +102,25 @@ namespace QuantLib {
     {
         if (!timeGrid_.empty())
             lattice_ = this->model_->tree(timeGrid_);
+        sharedLattice_.reset();
         GenericModelEngine<ShortRateModel, Arguments, Results>::update();
     }
 
+    template <class Arguments, class Results>
+    std::shared_ptr<Lattice>
+    LatticeShortRateModelEngine<Arguments, Results>::lattice(
+                            const std::vector<Time>& mandatoryTimes) const {
+        if (lattice_)
+            return lattice_;
+        if (!sharedLattice_ || mandatoryTimes != mandatoryTimes_) {
+            TimeGrid timeGrid(mandatoryTimes.begin(), mandatoryTimes.end(),
+                              timeSteps_);
+            sharedLattice_ = this->model_->tree(timeGrid);
+            mandatoryTimes_ = mandatoryTimes;
+        }
+        return sharedLattice_;
+    }
+
 }
 
 
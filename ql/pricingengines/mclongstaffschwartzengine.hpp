@@ -89,6 +89,13 @@ namespace QuantLib {
 
         void calculate() const;
 
+        //! calibrates on regression data rather than stored paths
+        /*! See LongstaffSchwartzPathPricer::setLeanCalibration for
+            details.  A null number of threads (the default) selects
+            the calibration on stored paths.
+        */
+        void setLeanCalibration(Size threads, Size rowsPerShard = 1024);
+
       protected:
         virtual std::shared_ptr<LongstaffSchwartzPathPricer<path_type> >
                                                    lsmPathPricer() const = 0;
@@ -109,6 +116,7 @@ namespace QuantLib {
         const bool brownianBridgeCalibration_;
         const bool antitheticVariateCalibration_;
         const BigNatural seedCalibration_;
+        Size leanThreads_, rowsPerShard_;
 
         mutable std::shared_ptr<LongstaffSchwartzPathPricer<path_type> >
             pathPricer_;
@@ -150,7 +158,8 @@ namespace QuantLib {
       antitheticVariateCalibration_(antitheticVariateCalibration ?
                                     *antitheticVariateCalibration : antitheticVariate),
       seedCalibration_(seedCalibration != Null<Real>() ?
-                         seedCalibration : (seed == 0 ? 0 : seed+1768237423L))
+                         seedCalibration : (seed == 0 ? 0 : seed+1768237423L)),
+      leanThreads_(0), rowsPerShard_(1024)
     {
         QL_REQUIRE(timeSteps != Null<Size>() ||
                    timeStepsPerYear != Null<Size>(),
@@ -182,8 +191,13 @@ namespace QuantLib {
               class S, class RNG_Calibration>
     inline void MCLongstaffSchwartzEngine<GenericEngine, MC, RNG, S,
                                           RNG_Calibration>::calculate() const {
+        // the path pricer collects statistics while pricing
+        QL_REQUIRE(this->threads_ == 0,
+                   "multi-threaded simulation not supported");
         // calibration
         pathPricer_ = this->lsmPathPricer();
+        if (leanThreads_ != 0)
+            pathPricer_->setLeanCalibration(leanThreads_, rowsPerShard_);
         Size dimensions = process_->factors();
         TimeGrid grid = this->timeGrid();
         typename RNG_Calibration::rsg_type generator =
@@ -214,6 +228,16 @@ namespace QuantLib {
         }
     }
 
+    template <class GenericEngine, template <class> class MC, class RNG,
+              class S, class RNG_Calibration>
+    inline void MCLongstaffSchwartzEngine<GenericEngine, MC, RNG, S,
+                                          RNG_Calibration>::
+    setLeanCalibration(Size threads, Size rowsPerShard) {
+        QL_REQUIRE(rowsPerShard > 0, "null number of rows per shard");
+        leanThreads_ = threads;
+        rowsPerShard_ = rowsPerShard;
+    }
+
     template <class GenericEngine, template <class> class MC, class RNG,
               class S, class RNG_Calibration>
     inline TimeGrid
@@ -65,11 +65,24 @@ namespace QuantLib {
         void calculate(Real requiredTolerance,
                        Size requiredSamples,
                        Size maxSamples) const;
+        //! distributes the generation of samples across threads
+        /*! See MonteCarloModel::setThreads for details.  A null
+            number of threads (the default) selects the serial
+            simulation.
+        */
+        void setThreads(Size threads, Size samplesPerChunk = 1024);
+        //! generates and prices paths in blocks
+        /*! See MonteCarloModel::setBlockSize for details.  A null
+            block size (the default) selects the path-by-path
+            simulation.
+        */
+        void setBlockSize(Size paths);
       protected:
         McSimulation(bool antitheticVariate,
                      bool controlVariate)
         : antitheticVariate_(antitheticVariate),
-          controlVariate_(controlVariate) {}
+          controlVariate_(controlVariate), threads_(0),
+          samplesPerChunk_(1024), blockSize_(0) {}
         virtual std::shared_ptr<path_pricer_type> pathPricer() const = 0;
         virtual std::shared_ptr<path_generator_type> pathGenerator()
                                                                    const = 0;
@@ -97,6 +110,7 @@ namespace QuantLib {
         
         mutable std::shared_ptr<MonteCarloModel<MC,RNG,S> > mcModel_;
         bool antitheticVariate_, controlVariate_;
+        Size threads_, samplesPerChunk_, blockSize_;
     };
 
 
@@ -195,6 +209,11 @@ namespace QuantLib {
                            this->antitheticVariate_));
         }
 
+        if (threads_ != 0)
+            this->mcModel_->setThreads(threads_, samplesPerChunk_);
+        if (blockSize_ != 0)
+            this->mcModel_->setBlockSize(blockSize_);
+
         if (requiredTolerance != Null<Real>()) {
             if (maxSamples != Null<Size>())
                 this->value(requiredTolerance, maxSamples);
@@ -206,6 +225,20 @@ namespace QuantLib {
 
     }
 
+    template <template <class> class MC, class RNG, class S>
+    inline void McSimulation<MC,RNG,S>::setThreads(Size threads,
+                                                   Size samplesPerChunk) {
+        QL_REQUIRE(samplesPerChunk > 0,
+                   "the number of samples per chunk must be positive");
+        threads_ = threads;
+        samplesPerChunk_ = samplesPerChunk;
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline void McSimulation<MC,RNG,S>::setBlockSize(Size paths) {
+        blockSize_ = paths;
+    }
+
     template <template <class> class MC, class RNG, class S>
     inline typename McSimulation<MC,RNG,S>::result_type
         McSimulation<MC,RNG,S>::errorEstimate() const {
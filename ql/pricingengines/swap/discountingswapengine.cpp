@@ -28,10 +28,12 @@ namespace QuantLib {
                             const Handle<YieldTermStructure>& discountCurve,
                             std::optional<bool> includeSettlementDateFlows,
                             Date settlementDate,
-                            Date npvDate)
+                            Date npvDate,
+                            bool calculateDiscountAdjoints)
     : discountCurve_(discountCurve),
       includeSettlementDateFlows_(includeSettlementDateFlows),
-      settlementDate_(settlementDate), npvDate_(npvDate) {
+      settlementDate_(settlementDate), npvDate_(npvDate),
+      calculateDiscountAdjoints_(calculateDiscountAdjoints) {
         registerWith(discountCurve_);
     }
 
@@ -109,6 +111,16 @@ namespace QuantLib {
             }
             results_.value += results_.legNPV[i];
         }
+
+        if (calculateDiscountAdjoints_) {
+            std::map<Date, Real> adjoints;
+            for (Size i=0; i<n; ++i)
+                CashFlows::npv(arguments_.legs[i], **discountCurve_,
+                               includeRefDateFlows, settlementDate,
+                               results_.valuationDate,
+                               arguments_.payer[i], adjoints);
+            results_.additionalResults["discountAdjoints"] = adjoints;
+        }
     }
 
 }
@@ -31,6 +31,11 @@
 
 namespace QuantLib {
 
+    /*! If required, the engine also returns as the additional
+        result "discountAdjoints", of type std::map<Date, Real>, the
+        derivatives of the swap NPV with respect to the discount
+        factors of its curve at the dates it uses; see CashFlows::npv.
+    */
     class DiscountingSwapEngine : public Swap::engine {
       public:
         DiscountingSwapEngine(
@@ -38,7 +43,8 @@ namespace QuantLib {
                                                  Handle<YieldTermStructure>(),
                std::optional<bool> includeSettlementDateFlows = std::nullopt,
                Date settlementDate = Date(),
-               Date npvDate = Date());
+               Date npvDate = Date(),
+               bool calculateDiscountAdjoints = false);
         void calculate() const;
         Handle<YieldTermStructure> discountCurve() const {
             return discountCurve_;
@@ -47,6 +53,7 @@ namespace QuantLib {
         Handle<YieldTermStructure> discountCurve_;
         std::optional<bool> includeSettlementDateFlows_;
         Date settlementDate_, npvDate_;
+        bool calculateDiscountAdjoints_;
     };
 
 }
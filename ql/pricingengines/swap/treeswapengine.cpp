@@ -63,13 +63,7 @@ namespace QuantLib {
         DiscretizedSwap swap(arguments_, referenceDate, dayCounter);
         std::vector<Time> times = swap.mandatoryTimes();
 
-        std::shared_ptr<Lattice> lattice;
-        if (lattice_) {
-            lattice = lattice_;
-        } else {
-            TimeGrid timeGrid(times.begin(), times.end(), timeSteps_);
-            lattice = model_->tree(timeGrid);
-        }
+        std::shared_ptr<Lattice> lattice = this->lattice(times);
 
         swap.initialize(lattice, times.back());
         swap.rollback(0.0);
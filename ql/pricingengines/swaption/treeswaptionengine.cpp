@@ -73,15 +73,8 @@ namespace QuantLib {
         }
 
         DiscretizedSwaption swaption(arguments_, referenceDate, dayCounter);
-        std::shared_ptr<Lattice> lattice;
-
-        if (lattice_) {
-            lattice = lattice_;
-        } else {
-            std::vector<Time> times = swaption.mandatoryTimes();
-            TimeGrid timeGrid(times.begin(), times.end(), timeSteps_);
-            lattice = model_->tree(timeGrid);
-        }
+        std::shared_ptr<Lattice> lattice =
+            this->lattice(swaption.mandatoryTimes());
 
         std::vector<Time> stoppingTimes(arguments_.exercise->dates().size());
         for (Size i=0; i<stoppingTimes.size(); ++i)
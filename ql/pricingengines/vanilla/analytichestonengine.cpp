@@ -109,6 +109,11 @@ namespace QuantLib {
 
         Real operator()(Real phi) const;
 
+        // exponent of the integrand at phi without the term depending
+        // on the strike, and integrand given that exponent
+        std::complex<Real> exponent(Real phi) const;
+        Real value(Real phi, const std::complex<Real>& exponent) const;
+
     private:
         const Size j_;
         //     const VanillaOption::arguments& arg_;
@@ -205,6 +210,21 @@ namespace QuantLib {
 
 
     Real AnalyticHestonEngine::Fj_Helper::operator()(Real phi) const {
+        return value(phi, exponent(phi));
+    }
+
+    Real AnalyticHestonEngine::Fj_Helper::value(
+                    Real phi, const std::complex<Real>& exponent) const {
+        if (cpxLog_ == Gatheral && phi == 0.0)
+            return dd_ - sx_ + exponent.real();
+
+        return std::exp(exponent
+                        + std::complex<Real>(0.0, phi * (dd_ - sx_))
+        ).imag() / phi;
+    }
+
+    std::complex<Real> AnalyticHestonEngine::Fj_Helper::exponent(
+                                                           Real phi) const {
         const Real rpsig(rsigma_ *phi);
 
         const std::complex<Real> t1 = t0_ + std::complex<Real>(0, -rpsig);
@@ -222,41 +242,35 @@ namespace QuantLib {
                     const std::complex<Real> g
                             = std::log((1.0 - p * ex) / (1.0 - p));
 
-                    return
-                            std::exp(v0_ * (t1 - d) * (1.0 - ex) / (sigma2_ * (1.0 - ex * p))
-                                     + (kappa_ * theta_) / sigma2_ * ((t1 - d) * term_ - 2.0 * g)
-                                     + std::complex<Real>(0.0, phi * (dd_ - sx_))
-                                     + addOnTerm
-                            ).imag() / phi;
+                    return v0_ * (t1 - d) * (1.0 - ex) / (sigma2_ * (1.0 - ex * p))
+                           + (kappa_ * theta_) / sigma2_ * ((t1 - d) * term_ - 2.0 * g)
+                           + addOnTerm;
                 } else {
                     const std::complex<Real> td = phi / (2.0 * t1)
                                                   * std::complex<Real>(-phi, (j_ == 1) ? 1 : -1);
                     const std::complex<Real> p = td * sigma2_ / (t1 + d);
                     const std::complex<Real> g = p * (1.0 - ex);
 
-                    return
-                            std::exp(v0_ * td * (1.0 - ex) / (1.0 - p * ex)
-                                     + (kappa_ * theta_) * (td * term_ - 2.0 * g / sigma2_)
-                                     + std::complex<Real>(0.0, phi * (dd_ - sx_))
-                                     + addOnTerm
-                            ).imag() / phi;
+                    return v0_ * td * (1.0 - ex) / (1.0 - p * ex)
+                           + (kappa_ * theta_) * (td * term_ - 2.0 * g / sigma2_)
+                           + addOnTerm;
                 }
             } else {
-                // use l'Hospital's rule to get lim_{phi->0}
+                // use l'Hospital's rule to get lim_{phi->0}; the
+                // returned value is the limit of the integrand
+                // minus dd_ - sx_
                 if (j_ == 1) {
                     const Real kmr = rsigma_ - kappa_;
                     if (std::fabs(kmr) > 1e-7) {
-                        return dd_ - sx_
-                               + (std::exp(kmr * term_) * kappa_ * theta_
-                                  - kappa_ * theta_ * (kmr * term_ + 1.0)) / (2 * kmr * kmr)
+                        return (std::exp(kmr * term_) * kappa_ * theta_
+                                - kappa_ * theta_ * (kmr * term_ + 1.0)) / (2 * kmr * kmr)
                                - v0_ * (1.0 - std::exp(kmr * term_)) / (2.0 * kmr);
                     } else
                         // \kappa = \rho * \sigma
-                        return dd_ - sx_ + 0.25 * kappa_ * theta_ * term_ * term_
+                        return 0.25 * kappa_ * theta_ * term_ * term_
                                + 0.5 * v0_ * term_;
                 } else {
-                    return dd_ - sx_
-                           - (std::exp(-kappa_ * term_) * kappa_ * theta_
+                    return - (std::exp(-kappa_ * term_) * kappa_ * theta_
                               + kappa_ * theta_ * (kappa_ * term_ - 1.0)) / (2 * kappa_ * kappa_)
                            - v0_ * (1.0 - std::exp(-kappa_ * term_)) / (2 * kappa_);
                 }
@@ -304,11 +318,9 @@ namespace QuantLib {
             g_km1_ = g.imag();
             g += std::complex<Real>(0, 2 * b_ * M_PI);
 
-            return std::exp(v0_ * (t1 + d) * (ex - 1.0) / (sigma2_ * (ex - p))
-                            + (kappa_ * theta_) / sigma2_ * ((t1 + d) * term_ - 2.0 * g)
-                            + std::complex<Real>(0, phi * (dd_ - sx_))
-                            + addOnTerm
-            ).imag() / phi;
+            return v0_ * (t1 + d) * (ex - 1.0) / (sigma2_ * (ex - p))
+                   + (kappa_ * theta_) / sigma2_ * ((t1 + d) * term_ - 2.0 * g)
+                   + addOnTerm;
         } else {
             QL_FAIL("unknown complex logarithm formula");
         }
@@ -370,6 +382,25 @@ namespace QuantLib {
                                              const AnalyticHestonEngine *const enginePtr,
                                              Real &value,
                                              Size &evaluations) {
+        doCalculation(riskFreeDiscount, dividendDiscount, spotPrice,
+                      strikePrice, term, kappa, theta, sigma, v0, rho,
+                      type, integration, cpxLog, enginePtr, nullptr,
+                      value, evaluations);
+    }
+
+    void AnalyticHestonEngine::doCalculation(Real riskFreeDiscount,
+                                             Real dividendDiscount,
+                                             Real spotPrice,
+                                             Real strikePrice,
+                                             Real term,
+                                             Real kappa, Real theta, Real sigma, Real v0, Real rho,
+                                             const TypePayoff &type,
+                                             const Integration &integration,
+                                             const ComplexLogFormula cpxLog,
+                                             const AnalyticHestonEngine *const enginePtr,
+                                             CachedExponents *exponents,
+                                             Real &value,
+                                             Size &evaluations) {
 
         const Real ratio = riskFreeDiscount / dividendDiscount;
 
@@ -377,15 +408,41 @@ namespace QuantLib {
                                                   std::sqrt(1.0 - square(rho)) / sigma))
                            * (v0 + kappa * theta * term);
 
+        const auto integrate = [&](Size j, Exponents *cache) -> Real {
+            const Fj_Helper f(kappa, theta, sigma, v0, spotPrice, rho, enginePtr,
+                              cpxLog, term, strikePrice, ratio, j);
+            if (!cache)
+                return integration.calculate(c_inf, f);
+
+            // non-adaptive integrations visit the same nodes in the
+            // same order at each call: the exponents are stored the
+            // first time and read afterwards.
+            const bool stored = !cache->empty();
+            bool valid = true;
+            Size k = 0;
+            Real result = integration.calculate(c_inf, [&](Real phi) -> Real {
+                if (!stored) {
+                    cache->push_back(std::make_pair(phi, f.exponent(phi)));
+                    return f.value(phi, cache->back().second);
+                }
+                valid = valid && k < cache->size() && (*cache)[k].first == phi;
+                return valid ? f.value(phi, (*cache)[k++].second) : 0.0;
+            });
+            if (stored && !(valid && k == cache->size())) {
+                // not expected, but safe: start afresh
+                cache->clear();
+                result = integration.calculate(c_inf,
+                    Fj_Helper(kappa, theta, sigma, v0, spotPrice, rho, enginePtr,
+                              cpxLog, term, strikePrice, ratio, j));
+            }
+            return result;
+        };
+
         evaluations = 0;
-        const Real p1 = integration.calculate(c_inf,
-                                              Fj_Helper(kappa, theta, sigma, v0, spotPrice, rho, enginePtr,
-                                                        cpxLog, term, strikePrice, ratio, 1)) / M_PI;
+        const Real p1 = integrate(1, exponents ? &exponents->first : nullptr) / M_PI;
         evaluations += integration.numberOfEvaluations();
 
-        const Real p2 = integration.calculate(c_inf,
-                                              Fj_Helper(kappa, theta, sigma, v0, spotPrice, rho, enginePtr,
-                                                        cpxLog, term, strikePrice, ratio, 2)) / M_PI;
+        const Real p2 = integrate(2, exponents ? &exponents->second : nullptr) / M_PI;
         evaluations += integration.numberOfEvaluations();
 
         switch (type.optionType()) {
@@ -425,6 +482,14 @@ namespace QuantLib {
         const Real strikePrice = payoff->strike();
         const Real term = process->time(arguments_.exercise->lastDate());
 
+        CachedExponents* exponents = nullptr;
+        if (!integration_->isAdaptiveIntegration()) {
+            if (exponents_.size() >= maxCachedMaturities
+                && exponents_.count(term) == 0)
+                exponents_.clear();
+            exponents = &exponents_[term];
+        }
+
         doCalculation(riskFreeDiscount,
                       dividendDiscount,
                       spotPrice,
@@ -439,10 +504,18 @@ namespace QuantLib {
                       *integration_,
                       cpxLog_,
                       this,
+                      exponents,
                       results_.value,
                       evaluations_);
     }
 
+    void AnalyticHestonEngine::update() {
+        exponents_.clear();
+        GenericModelEngine<HestonModel,
+                           VanillaOption::arguments,
+                           VanillaOption::results>::update();
+    }
+
 
     AnalyticHestonEngine::Integration::Integration(
             Algorithm intAlgo,
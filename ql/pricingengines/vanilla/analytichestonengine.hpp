@@ -33,6 +33,9 @@
 
 #include <functional>
 #include <complex>
+#include <map>
+#include <utility>
+#include <vector>
 
 namespace QuantLib {
 
@@ -103,6 +106,7 @@ namespace QuantLib {
 
 
         void calculate() const;
+        void update();
         Size numberOfEvaluations() const;
 
         static void doCalculation(Real riskFreeDiscount,
@@ -128,9 +132,37 @@ namespace QuantLib {
       private:
         class Fj_Helper;
 
+        /* exponents of the characteristic function at the nodes
+           visited by the integration, for the two probabilities.
+           They don't depend on the strike; therefore, when a
+           non-adaptive integration is used, they're stored by
+           maturity and reused for all options with that maturity
+           until the model changes (as during a calibration, where
+           options with several strikes are priced for each maturity).
+        */
+        typedef std::vector<std::pair<Real, std::complex<Real> > >
+                                                              Exponents;
+        typedef std::pair<Exponents, Exponents> CachedExponents;
+        static const Size maxCachedMaturities = 100;
+
+        static void doCalculation(Real riskFreeDiscount,
+                                  Real dividendDiscount,
+                                  Real spotPrice,
+                                  Real strikePrice,
+                                  Real term,
+                                  Real kappa, Real theta, Real sigma, Real v0, Real rho,
+                                  const TypePayoff& type,
+                                  const Integration& integration,
+                                  const ComplexLogFormula cpxLog,
+                                  const AnalyticHestonEngine* const enginePtr,
+                                  CachedExponents* exponents,
+                                  Real& value,
+                                  Size& evaluations);
+
         mutable Size evaluations_;
         const ComplexLogFormula cpxLog_;
         const std::shared_ptr<Integration> integration_;
+        mutable std::map<Time, CachedExponents> exponents_;
     };
 
 
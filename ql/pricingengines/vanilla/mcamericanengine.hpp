@@ -123,6 +123,7 @@ namespace QuantLib {
         MakeMCAmericanEngine& withCalibrationSamples(Size calibrationSamples);
         MakeMCAmericanEngine& withAntitheticVariateCalibration(bool b = true);
         MakeMCAmericanEngine& withSeedCalibration(BigNatural seed);
+        MakeMCAmericanEngine& withLeanCalibration(Size threads = 1);
 
         // conversion to pricing engine
         operator std::shared_ptr<PricingEngine>() const;
@@ -137,6 +138,7 @@ namespace QuantLib {
         LsmBasisSystem::PolynomType polynomType_;
         std::optional<bool> antitheticCalibration_;
         BigNatural seedCalibration_;
+        Size leanCalibrationThreads_;
     };
 
     template <class RNG, class S, class RNG_Calibration>
@@ -259,7 +261,8 @@ namespace QuantLib {
           samples_(Null<Size>()), maxSamples_(Null<Size>()),
           calibrationSamples_(2048), tolerance_(Null<Real>()), seed_(0),
           polynomOrder_(2), polynomType_(LsmBasisSystem::Monomial),
-          antitheticCalibration_(std::nullopt), seedCalibration_(Null<Size>()) {}
+          antitheticCalibration_(std::nullopt), seedCalibration_(Null<Size>()),
+          leanCalibrationThreads_(0) {}
 
     template <class RNG, class S, class RNG_Calibration>
     inline MakeMCAmericanEngine<RNG, S, RNG_Calibration> &
@@ -367,6 +370,14 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG, class S, class RNG_Calibration>
+    inline MakeMCAmericanEngine<RNG, S, RNG_Calibration> &
+    MakeMCAmericanEngine<RNG, S, RNG_Calibration>::withLeanCalibration(
+        Size threads) {
+        leanCalibrationThreads_ = threads;
+        return *this;
+    }
+
     template <class RNG, class S, class RNG_Calibration>
     inline MakeMCAmericanEngine<RNG, S, RNG_Calibration>::
     operator std::shared_ptr<PricingEngine>() const {
@@ -374,8 +385,8 @@ namespace QuantLib {
                    "number of steps not given");
         QL_REQUIRE(steps_ == Null<Size>() || stepsPerYear_ == Null<Size>(),
                    "number of steps overspecified");
-        return std::shared_ptr<PricingEngine>(new
-           MCAmericanEngine<RNG, S, RNG_Calibration>(process_,
+        std::shared_ptr<MCAmericanEngine<RNG, S, RNG_Calibration> > engine(
+           new MCAmericanEngine<RNG, S, RNG_Calibration>(process_,
                                      steps_,
                                      stepsPerYear_,
                                      antithetic_,
@@ -388,6 +399,8 @@ namespace QuantLib {
                                      calibrationSamples_,
                                      antitheticCalibration_,
                                      seedCalibration_));
+        engine->setLeanCalibration(leanCalibrationThreads_);
+        return engine;
     }
 
 }
@@ -79,6 +79,8 @@ namespace QuantLib {
         MakeMCEuropeanEngine& withAbsoluteTolerance(Real tolerance);
         MakeMCEuropeanEngine& withMaxSamples(Size samples);
         MakeMCEuropeanEngine& withSeed(BigNatural seed);
+        MakeMCEuropeanEngine& withThreads(Size threads);
+        MakeMCEuropeanEngine& withBlockSize(Size paths);
         MakeMCEuropeanEngine& withAntitheticVariate(bool b = true);
         // conversion to pricing engine
         operator std::shared_ptr<PricingEngine>() const;
@@ -89,6 +91,7 @@ namespace QuantLib {
         Real tolerance_;
         bool brownianBridge_;
         BigNatural seed_;
+        Size threads_, blockSize_;
     };
 
     class EuropeanPathPricer : public PathPricer<Path> {
@@ -97,6 +100,7 @@ namespace QuantLib {
                            Real strike,
                            DiscountFactor discount);
         Real operator()(const Path& path) const;
+        void operator()(const PathBlock<Path>& paths, Real* values) const;
       private:
         PlainVanillaPayoff payoff_;
         DiscountFactor discount_;
@@ -159,7 +163,8 @@ namespace QuantLib {
     : process_(process), antithetic_(false),
       steps_(Null<Size>()), stepsPerYear_(Null<Size>()),
       samples_(Null<Size>()), maxSamples_(Null<Size>()),
-      tolerance_(Null<Real>()), brownianBridge_(false), seed_(0) {}
+      tolerance_(Null<Real>()), brownianBridge_(false), seed_(0), threads_(0),
+      blockSize_(0) {}
 
     template <class RNG, class S>
     inline MakeMCEuropeanEngine<RNG,S>&
@@ -210,6 +215,20 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG, class S>
+    inline MakeMCEuropeanEngine<RNG,S>&
+    MakeMCEuropeanEngine<RNG,S>::withThreads(Size threads) {
+        threads_ = threads;
+        return *this;
+    }
+
+    template <class RNG, class S>
+    inline MakeMCEuropeanEngine<RNG,S>&
+    MakeMCEuropeanEngine<RNG,S>::withBlockSize(Size paths) {
+        blockSize_ = paths;
+        return *this;
+    }
+
     template <class RNG, class S>
     inline MakeMCEuropeanEngine<RNG,S>&
     MakeMCEuropeanEngine<RNG,S>::withBrownianBridge(bool brownianBridge) {
@@ -232,15 +251,18 @@ namespace QuantLib {
                    "number of steps not given");
         QL_REQUIRE(steps_ == Null<Size>() || stepsPerYear_ == Null<Size>(),
                    "number of steps overspecified");
-        return std::shared_ptr<PricingEngine>(new
-            MCEuropeanEngine<RNG,S>(process_,
-                                    steps_,
-                                    stepsPerYear_,
-                                    brownianBridge_,
-                                    antithetic_,
-                                    samples_, tolerance_,
-                                    maxSamples_,
-                                    seed_));
+        std::shared_ptr<MCEuropeanEngine<RNG,S> > engine(
+            new MCEuropeanEngine<RNG,S>(process_,
+                                        steps_,
+                                        stepsPerYear_,
+                                        brownianBridge_,
+                                        antithetic_,
+                                        samples_, tolerance_,
+                                        maxSamples_,
+                                        seed_));
+        engine->setThreads(threads_);
+        engine->setBlockSize(blockSize_);
+        return engine;
     }
 
 
@@ -258,6 +280,16 @@ namespace QuantLib {
         return payoff_(path.back()) * discount_;
     }
 
+    inline void EuropeanPathPricer::operator()(const PathBlock<Path>& paths,
+                                               Real* values) const {
+        QL_REQUIRE(paths.length() > 0, "the paths cannot be empty");
+        const Real* s = paths.values(paths.length()-1);
+        const Real k = payoff_.strike();
+        const Real phi = payoff_.optionType() == Option::Call ? 1.0 : -1.0;
+        for (Size j=0; j<paths.size(); ++j)
+            values[j] = std::max(phi*(s[j]-k), 0.0) * discount_;
+    }
+
 }
 
 
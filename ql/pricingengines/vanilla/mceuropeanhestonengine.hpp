@@ -68,6 +68,7 @@ namespace QuantLib {
         MakeMCEuropeanHestonEngine& withAbsoluteTolerance(Real tolerance);
         MakeMCEuropeanHestonEngine& withMaxSamples(Size samples);
         MakeMCEuropeanHestonEngine& withSeed(BigNatural seed);
+        MakeMCEuropeanHestonEngine& withThreads(Size threads);
         MakeMCEuropeanHestonEngine& withAntitheticVariate(bool b = true);
         // conversion to pricing engine
         operator std::shared_ptr<PricingEngine>() const;
@@ -77,6 +78,7 @@ namespace QuantLib {
         Size steps_, stepsPerYear_, samples_, maxSamples_;
         Real tolerance_;
         BigNatural seed_;
+        Size threads_;
     };
 
 
@@ -86,6 +88,8 @@ namespace QuantLib {
                                  Real strike,
                                  DiscountFactor discount);
         Real operator()(const MultiPath& Multipath) const;
+        void operator()(const PathBlock<MultiPath>& paths,
+                        Real* values) const;
       private:
         PlainVanillaPayoff payoff_;
         DiscountFactor discount_;
@@ -137,7 +141,7 @@ namespace QuantLib {
     : process_(process), antithetic_(false),
       steps_(Null<Size>()), stepsPerYear_(Null<Size>()),
       samples_(Null<Size>()), maxSamples_(Null<Size>()),
-      tolerance_(Null<Real>()), seed_(0) {}
+      tolerance_(Null<Real>()), seed_(0), threads_(0) {}
 
     template <class RNG, class S,class P>
     inline MakeMCEuropeanHestonEngine<RNG,S,P>&
@@ -192,6 +196,13 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG, class S, class P>
+    inline MakeMCEuropeanHestonEngine<RNG,S,P>&
+    MakeMCEuropeanHestonEngine<RNG,S,P>::withThreads(Size threads) {
+        threads_ = threads;
+        return *this;
+    }
+
     template <class RNG, class S, class P>
     inline MakeMCEuropeanHestonEngine<RNG,S,P>&
     MakeMCEuropeanHestonEngine<RNG,S,P>::withAntitheticVariate(bool b) {
@@ -205,14 +216,16 @@ namespace QuantLib {
     operator std::shared_ptr<PricingEngine>() const {
         QL_REQUIRE(steps_ != Null<Size>() || stepsPerYear_ != Null<Size>(),
                    "number of steps not given");
-        return std::shared_ptr<PricingEngine>(
-               new MCEuropeanHestonEngine<RNG,S,P>(process_,
-                                                   steps_,
-                                                   stepsPerYear_,
-                                                   antithetic_,
-                                                   samples_, tolerance_,
-                                                   maxSamples_,
-                                                   seed_));
+        std::shared_ptr<MCEuropeanHestonEngine<RNG,S,P> > engine(
+            new MCEuropeanHestonEngine<RNG,S,P>(process_,
+                                                steps_,
+                                                stepsPerYear_,
+                                                antithetic_,
+                                                samples_, tolerance_,
+                                                maxSamples_,
+                                                seed_));
+        engine->setThreads(threads_);
+        return engine;
     }
 
 
@@ -235,6 +248,18 @@ namespace QuantLib {
         return payoff_(path.back()) * discount_;
     }
 
+    inline void EuropeanHestonPathPricer::operator()(
+                                           const PathBlock<MultiPath>& paths,
+                                           Real* values) const {
+        const Size n = paths.pathSize();
+        QL_REQUIRE(n>0, "the paths cannot be empty");
+        const Real* s = paths.values(n-1, 0);
+        const Real k = payoff_.strike();
+        const Real phi = payoff_.optionType() == Option::Call ? 1.0 : -1.0;
+        for (Size j=0; j<paths.size(); ++j)
+            values[j] = std::max(phi*(s[j]-k), 0.0) * discount_;
+    }
+
 }
 
 
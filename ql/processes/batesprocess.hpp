@@ -61,6 +61,10 @@ namespace QuantLib {
         Array drift(Time t, const Array& x) const;
         Array evolve(Time t0, const Array& x0,
                                  Time dt, const Array& dw) const;
+        void evolveBlock(Time t0, const Real* x0, Time dt,
+                         const Real* dw, Real* x, Size n) const {
+            StochasticProcess::evolveBlock(t0, x0, dt, dw, x, n);
+        }
 
         Real lambda() const;
         Real nu()     const;
@@ -128,6 +128,28 @@ namespace QuantLib {
                                  stdDeviation(t0, x0, dt) * dw);
     }
 
+    void GeneralizedBlackScholesProcess::evolveBlock(Time t0, const Real* x0,
+                                                     Time dt, const Real* dw,
+                                                     Real* x, Size n) const {
+        localVolatility(); // trigger update
+        if (n > 0 && isStrikeIndependent_ && !forceDiscretization_) {
+            // the exact step doesn't depend on the state and can be
+            // calculated once for the whole block
+            Real var = variance(t0, x0[0], dt);
+            Real drift = (riskFreeRate_->forwardRate(t0, t0 + dt, Continuous,
+                                                     NoFrequency, true) -
+                          dividendYield_->forwardRate(t0, t0 + dt, Continuous,
+                                                      NoFrequency, true)) *
+                             dt -
+                         0.5 * var;
+            Real stdDev = std::sqrt(var);
+            for (Size j=0; j<n; ++j)
+                x[j] = x0[j] * std::exp(stdDev * dw[j] + drift);
+        } else {
+            StochasticProcess1D::evolveBlock(t0, x0, dt, dw, x, n);
+        }
+    }
+
     Time GeneralizedBlackScholesProcess::time(const Date& d) const {
         return riskFreeRate_->dayCounter().yearFraction(
                                            riskFreeRate_->referenceDate(), d);
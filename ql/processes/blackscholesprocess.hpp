@@ -77,6 +77,8 @@ namespace QuantLib {
         Real stdDeviation(Time t0, Real x0, Time dt) const;
         Real variance(Time t0, Real x0, Time dt) const;
         Real evolve(Time t0, Real x0, Time dt, Real dw) const;
+        void evolveBlock(Time t0, const Real* x0, Time dt,
+                         const Real* dw, Real* x, Size n) const;
         //@}
         Time time(const Date&) const;
         //! \name Observer interface
@@ -44,4 +44,15 @@ namespace QuantLib {
         return sigma_ * x;
     }
 
+    void GeometricBrownianMotionProcess::evolveBlock(Time, const Real* x0,
+                                                     Time dt, const Real* dw,
+                                                     Real* x, Size n) const {
+        // same operations as the Euler discretization, in the same
+        // order, so that the results match the ones of evolve
+        const Real sqrtDt = std::sqrt(dt);
+        for (Size j=0; j<n; ++j)
+            x[j] = (x0[j] + (mue_ * x0[j]) * dt)
+                 + ((sigma_ * x0[j]) * sqrtDt) * dw[j];
+    }
+
 }
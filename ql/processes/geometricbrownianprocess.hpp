@@ -46,6 +46,12 @@ namespace QuantLib {
         Real x0() const;
         Real drift(Time t, Real x) const;
         Real diffusion(Time t, Real x) const;
+        /*! performs the same Euler step as evolve for all values at
+            once; classes overriding drift or diffusion must override
+            this method as well.
+        */
+        void evolveBlock(Time t0, const Real* x0, Time dt,
+                         const Real* dw, Real* x, Size n) const;
       protected:
         double initialValue_;
         double mue_;
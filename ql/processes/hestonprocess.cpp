@@ -551,6 +551,65 @@ namespace QuantLib {
         return retVal;
     }
 
+    void HestonProcess::evolveBlock(Time t0, const Real* x0, Time dt,
+                                    const Real* dw, Real* x, Size n) const {
+        if (discretization_ != PartialTruncation
+            && discretization_ != FullTruncation
+            && discretization_ != Reflection) {
+            StochasticProcess::evolveBlock(t0, x0, dt, dw, x, n);
+            return;
+        }
+
+        const Real sdt = std::sqrt(dt);
+        const Real sqrhov = std::sqrt(1.0 - rho_*rho_);
+        const Real r =   riskFreeRate_->forwardRate(t0, t0+dt, Continuous)
+                       - dividendYield_->forwardRate(t0, t0+dt, Continuous);
+
+        // same schemes as in evolve, with states and increments
+        // stored across paths
+        const Real* s0 = x0;
+        const Real* v0 = x0 + n;
+        const Real* dw0 = dw;
+        const Real* dw1 = dw + n;
+        Real* s = x;
+        Real* v = x + n;
+
+        switch (discretization_) {
+          case PartialTruncation:
+            for (Size j=0; j<n; ++j) {
+                const Real vol = (v0[j] > 0.0) ? std::sqrt(v0[j]) : 0.0;
+                const Real mu = r - 0.5*vol*vol;
+                const Real nu = kappa_*(theta_ - v0[j]);
+                s[j] = s0[j] * std::exp(mu*dt+vol*dw0[j]*sdt);
+                v[j] = v0[j] + nu*dt
+                     + sigma_*vol*sdt*(rho_*dw0[j] + sqrhov*dw1[j]);
+            }
+            break;
+          case FullTruncation:
+            for (Size j=0; j<n; ++j) {
+                const Real vol = (v0[j] > 0.0) ? std::sqrt(v0[j]) : 0.0;
+                const Real mu = r - 0.5*vol*vol;
+                const Real nu = kappa_*(theta_ - vol*vol);
+                s[j] = s0[j] * std::exp(mu*dt+vol*dw0[j]*sdt);
+                v[j] = v0[j] + nu*dt
+                     + sigma_*vol*sdt*(rho_*dw0[j] + sqrhov*dw1[j]);
+            }
+            break;
+          case Reflection:
+            for (Size j=0; j<n; ++j) {
+                const Real vol = std::sqrt(std::fabs(v0[j]));
+                const Real mu = r - 0.5*vol*vol;
+                const Real nu = kappa_*(theta_ - vol*vol);
+                s[j] = s0[j] * std::exp(mu*dt+vol*dw0[j]*sdt);
+                v[j] = vol*vol + nu*dt
+                     + sigma_*vol*sdt*(rho_*dw0[j] + sqrhov*dw1[j]);
+            }
+            break;
+          default:
+            QL_FAIL("unknown discretization schema");
+        }
+    }
+
     const Handle<Quote>& HestonProcess::s0() const {
         return s0_;
     }
@@ -71,6 +71,11 @@ namespace QuantLib {
         Array apply(const Array& x0, const Array& dx) const;
         Array evolve(Time t0, const Array& x0,
                                  Time dt, const Array& dw) const;
+        /*! the truncation and reflection schemes are vectorized
+            across states; the other schemes evolve each state in turn.
+        */
+        void evolveBlock(Time t0, const Real* x0, Time dt,
+                         const Real* dw, Real* x, Size n) const;
 
         Real v0()    const { return v0_; }
         Real rho()   const { return rho_; }
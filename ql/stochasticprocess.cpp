@@ -64,6 +64,22 @@ namespace QuantLib {
         return x0 + dx;
     }
 
+    void StochasticProcess::evolveBlock(Time t0, const Real* x0, Time dt,
+                                        const Real* dw, Real* x,
+                                        Size n) const {
+        Size m = size(), f = factors();
+        Array state(m), increment(f);
+        for (Size j=0; j<n; ++j) {
+            for (Size k=0; k<m; ++k)
+                state[k] = x0[k*n+j];
+            for (Size k=0; k<f; ++k)
+                increment[k] = dw[k*n+j];
+            Array result = evolve(t0, state, dt, increment);
+            for (Size k=0; k<m; ++k)
+                x[k*n+j] = result[k];
+        }
+    }
+
     Time StochasticProcess::time(const Date& ) const {
         QL_FAIL("date/time conversion not supported");
     }
@@ -102,4 +118,11 @@ namespace QuantLib {
         return x0 + dx;
     }
 
+    void StochasticProcess1D::evolveBlock(Time t0, const Real* x0, Time dt,
+                                          const Real* dw, Real* x,
+                                          Size n) const {
+        for (Size j=0; j<n; ++j)
+            x[j] = evolve(t0, x0[j], dt, dw[j]);
+    }
+
 }
@@ -128,6 +128,23 @@ namespace QuantLib {
         */
         virtual Array apply(const Array& x0,
                                         const Array& dx) const;
+        /*! evolves the given number of states at once over the same
+            time interval.  States and increments are stored across
+            states, i.e., the \f$ k \f$-th component of the \f$ j \f$-th
+            state is x0[k*n+j] and the \f$ k \f$-th factor of its
+            increment is dw[k*n+j]; the results are stored in x with
+            the same layout as x0, which must not overlap with x.
+
+            By default, each state is evolved in turn by calling
+            evolve; derived classes can override this method so that
+            the calculation is vectorized across states.
+        */
+        virtual void evolveBlock(Time t0,
+                                 const Real* x0,
+                                 Time dt,
+                                 const Real* dw,
+                                 Real* x,
+                                 Size n) const;
         //@}
 
         //! \name utilities
@@ -220,6 +237,16 @@ namespace QuantLib {
             returns \f$ x + \Delta x \f$.
         */
         virtual Real apply(Real x0, Real dx) const;
+        /*! evolves the given number of values at once, i.e., it
+            sets x[j] to evolve(t0, x0[j], dt, dw[j]).  By default,
+            evolve is called for each value.
+        */
+        void evolveBlock(Time t0,
+                         const Real* x0,
+                         Time dt,
+                         const Real* dw,
+                         Real* x,
+                         Size n) const;
         //@}
       protected:
         StochasticProcess1D();
@@ -65,7 +65,10 @@ namespace QuantLib {
     template <class Curve>
     Real BootstrapError<Curve>::operator()(Real guess) const {
         Traits::updateGuess(curve_->data_, guess, segment_);
-        curve_->interpolation_.update();
+        // the guess changes the data at the current node (and at the
+        // initial one when the first segment is bootstrapped); local
+        // interpolations don't need to recalculate earlier segments
+        curve_->interpolation_.updateFrom(segment_-1);
         return helper_->quoteError();
     }
     #endif
@@ -0,0 +1,351 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file globalbootstrap.hpp
+    \brief global bootstrapper for piecewise curves
+*/
+
+#ifndef quantlib_global_bootstrap_hpp
+#define quantlib_global_bootstrap_hpp
+
+#include <ql/termstructures/bootstraphelper.hpp>
+#include <ql/math/interpolations/linearinterpolation.hpp>
+#include <ql/math/matrix.hpp>
+#include <ql/utilities/dataformatters.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace QuantLib {
+
+    //! Global piecewise-term-structure bootstrapper.
+    /*! Unlike IterativeBootstrap, which solves for one pillar at a
+        time and, for non-local interpolations, needs to repeat the
+        whole pass until the curve converges, this class solves for
+        all pillars at once by means of a Newton method on the
+        vector of helper errors.
+
+        The Jacobian of the implied quotes with respect to the curve
+        nodes is calculated by finite differences, since helpers
+        don't provide analytic derivatives.  It is reused across
+        Newton steps as long as the errors decrease fast enough, and
+        steps are halved when they don't decrease the errors.  When
+        the curve is recalculated, e.g. after a change of quotes,
+        its previous state is used as a starting point.
+
+        After the curve is bootstrapped, the Jacobian can be
+        retrieved for risk purposes; its inverse is the sensitivity
+        of the curve nodes to the helper quotes.
+    */
+    template <class Curve>
+    class GlobalBootstrap {
+        typedef typename Curve::traits_type Traits;
+        typedef typename Curve::interpolator_type Interpolator;
+      public:
+        GlobalBootstrap();
+        void setup(Curve* ts);
+        void calculate() const;
+        /*! Returns the derivatives of the implied quotes of the alive
+            helpers, sorted by pillar date, with respect to the curve
+            nodes following the first one; the element \f$ (i,j) \f$
+            is the derivative of the \f$ i \f$-th quote with respect
+            to the \f$ (j+1) \f$-th node.
+
+            \pre the curve must be calculated.
+        */
+        const Matrix& jacobian() const;
+      private:
+        void initialize() const;
+        void solve() const;
+        void setNodes(const Array& x) const;
+        Array errors(const Array& x) const;
+        void calculateJacobian(const Array& x, const Array& errors) const;
+        Curve* ts_;
+        Size n_;
+        mutable bool initialized_, validCurve_, validJacobian_;
+        mutable Size firstAliveHelper_, alive_;
+        mutable Matrix jacobian_, inverse_;
+    };
+
+
+    // template definitions
+
+    template <class Curve>
+    GlobalBootstrap<Curve>::GlobalBootstrap()
+    : ts_(0), initialized_(false), validCurve_(false),
+      validJacobian_(false) {}
+
+    template <class Curve>
+    void GlobalBootstrap<Curve>::setup(Curve* ts) {
+
+        ts_ = ts;
+        n_ = ts_->instruments_.size();
+        QL_REQUIRE(n_ > 0, "no bootstrap helpers given")
+        for (Size j=0; j<n_; ++j)
+            ts_->registerWith(ts_->instruments_[j]);
+
+        // do not initialize yet: instruments could be invalid here
+        // but valid later when bootstrapping is actually required
+    }
+
+    template <class Curve>
+    void GlobalBootstrap<Curve>::initialize() const {
+        // ensure helpers are sorted
+        std::sort(ts_->instruments_.begin(), ts_->instruments_.end(),
+                  detail::BootstrapHelperSorter());
+        // skip expired helpers
+        Date firstDate = Traits::initialDate(ts_);
+        QL_REQUIRE(ts_->instruments_[n_-1]->pillarDate()>firstDate,
+                   "all instruments expired");
+        firstAliveHelper_ = 0;
+        while (ts_->instruments_[firstAliveHelper_]->pillarDate() <= firstDate)
+            ++firstAliveHelper_;
+        alive_ = n_-firstAliveHelper_;
+        QL_REQUIRE(alive_>=Interpolator::requiredPoints-1,
+                   "not enough alive instruments: " << alive_ <<
+                   " provided, " << Interpolator::requiredPoints-1 <<
+                   " required");
+
+        // calculate dates and times
+        std::vector<Date>& dates = ts_->dates_;
+        std::vector<Time>& times = ts_->times_;
+        dates.resize(alive_+1);
+        times.resize(alive_+1);
+        dates[0] = firstDate;
+        times[0] = ts_->timeFromReference(dates[0]);
+
+        Date latestRelevantDate, maxDate = firstDate;
+        for (Size i=1, j=firstAliveHelper_; j<n_; ++i, ++j) {
+            const std::shared_ptr<typename Traits::helper>& helper =
+                                                        ts_->instruments_[j];
+            dates[i] = helper->pillarDate();
+            times[i] = ts_->timeFromReference(dates[i]);
+            // check for duplicated pillars
+            QL_REQUIRE(dates[i-1]!=dates[i],
+                       "more than one instrument with pillar " << dates[i]);
+
+            latestRelevantDate = helper->latestRelevantDate();
+            QL_REQUIRE(latestRelevantDate > maxDate,
+                       io::ordinal(j+1) << " instrument (pillar: " <<
+                       dates[i] << ") has latestRelevantDate (" <<
+                       latestRelevantDate << ") before or equal to "
+                       "previous instrument's latestRelevantDate (" <<
+                       maxDate << ")");
+            maxDate = latestRelevantDate;
+        }
+        ts_->maxDate_ = maxDate;
+
+        // the current curve can be used as guess only if it has the
+        // same nodes
+        if (ts_->data_.size() != alive_+1)
+            validCurve_ = false;
+        initialized_ = true;
+    }
+
+    template <class Curve>
+    void GlobalBootstrap<Curve>::calculate() const {
+
+        // as in IterativeBootstrap, helpers might be date relative
+        if (!initialized_ || ts_->moving_)
+            initialize();
+        validJacobian_ = false;
+
+        // setup helpers
+        for (Size j=firstAliveHelper_; j<n_; ++j) {
+            const std::shared_ptr<typename Traits::helper>& helper =
+                                                        ts_->instruments_[j];
+            // check for valid quote
+            QL_REQUIRE(helper->quote()->isValid(),
+                       io::ordinal(j + 1) << " instrument (maturity: " <<
+                       helper->maturityDate() << ", pillar: " <<
+                       helper->pillarDate() << ") has an invalid quote");
+            // don't try this at home!
+            // This call creates helpers, and removes "const".
+            // There is a significant interaction with observability.
+            helper->setTermStructure(const_cast<Curve*>(ts_));
+        }
+
+        try {
+            solve();
+        } catch (std::exception&) {
+            if (!validCurve_)
+                throw;
+            // the previous curve state could have been a bad guess;
+            // let's restart without using it
+            validCurve_ = false;
+            solve();
+        }
+        validCurve_ = true;
+    }
+
+    template <class Curve>
+    void GlobalBootstrap<Curve>::solve() const {
+
+        const std::vector<Time>& times = ts_->times_;
+        std::vector<Real>& data = ts_->data_;
+
+        if (!validCurve_) {
+            // first guess as in the first pass of IterativeBootstrap,
+            // extending the curve a pillar at a time
+            data = std::vector<Real>(alive_+1, Traits::initialValue(ts_));
+            for (Size i=1; i<=alive_; ++i) {
+                Traits::updateGuess(data,
+                                    Traits::guess(i, ts_, false,
+                                                  firstAliveHelper_),
+                                    i);
+                try {
+                    ts_->interpolation_ = ts_->interpolator_.interpolate(
+                        times.begin(), times.begin()+i+1, data.begin());
+                } catch (...) {
+                    if (!Interpolator::global || i == alive_)
+                        throw;
+                    ts_->interpolation_ = Linear().interpolate(
+                        times.begin(), times.begin()+i+1, data.begin());
+                }
+                ts_->interpolation_.update();
+            }
+        }
+
+        Array x(alive_);
+        for (Size k=0; k<alive_; ++k)
+            x[k] = data[k+1];
+
+        Real accuracy = ts_->accuracy_;
+        Size maxIterations = Traits::maxIterations();
+
+        Array f = errors(x);
+        calculateJacobian(x, f);
+        // the Jacobian was calculated at the current point
+        bool freshJacobian = true;
+
+        for (Size iteration=0; ; ++iteration) {
+            QL_REQUIRE(iteration < maxIterations,
+                       "global bootstrap: convergence not reached after "
+                       << iteration << " iterations");
+
+            // Newton step; the errors are quotes minus implied quotes
+            Array dx = inverse_ * f;
+            Real error = DotProduct(f, f), step = 0.0;
+            for (Size k=0; k<alive_; ++k) {
+                QL_REQUIRE(std::isfinite(dx[k]),
+                           "global bootstrap: singular Jacobian, "
+                           "reference date " << ts_->dates_[0]);
+                step = std::max(step, std::fabs(dx[k]));
+            }
+
+            // halve the step until the errors decrease
+            Array y(alive_), g;
+            Real lambda = 1.0;
+            bool decreased = false;
+            for (Size trial=0; trial<20 && !decreased; ++trial) {
+                for (Size k=0; k<alive_; ++k)
+                    y[k] = x[k] + lambda*dx[k];
+                try {
+                    g = errors(y);
+                    decreased = (DotProduct(g, g) < error);
+                } catch (Error&) {
+                    // the interpolation can fail far from the solution
+                }
+                if (!decreased)
+                    lambda /= 2.0;
+            }
+
+            if (!decreased) {
+                if (step <= accuracy) {
+                    // no improvement possible at this accuracy
+                    setNodes(x);
+                    break;
+                }
+                QL_REQUIRE(!freshJacobian,
+                           "global bootstrap: " << io::ordinal(iteration+1)
+                           << " iteration failed to decrease errors, "
+                           "reference date " << ts_->dates_[0]);
+                setNodes(x);
+                calculateJacobian(x, f);
+                freshJacobian = true;
+                continue;
+            }
+
+            x.swap(y);
+            f.swap(g);
+            if (step <= accuracy)  // convergence reached
+                break;
+
+            // the Jacobian is kept as long as full steps halve the errors
+            if (lambda < 1.0 || DotProduct(f, f) > 0.25*error) {
+                calculateJacobian(x, f);
+                freshJacobian = true;
+            } else {
+                freshJacobian = false;
+            }
+        }
+    }
+
+    template <class Curve>
+    const Matrix& GlobalBootstrap<Curve>::jacobian() const {
+        QL_REQUIRE(validCurve_, "curve not bootstrapped");
+        if (!validJacobian_) {
+            // the one used by the solver might not be at the solution
+            Array x(alive_);
+            for (Size k=0; k<alive_; ++k)
+                x[k] = ts_->data_[k+1];
+            calculateJacobian(x, errors(x));
+            validJacobian_ = true;
+        }
+        return jacobian_;
+    }
+
+    template <class Curve>
+    void GlobalBootstrap<Curve>::setNodes(const Array& x) const {
+        for (Size k=0; k<alive_; ++k)
+            Traits::updateGuess(ts_->data_, x[k], k+1);
+        ts_->interpolation_.update();
+    }
+
+    template <class Curve>
+    Array GlobalBootstrap<Curve>::errors(const Array& x) const {
+        setNodes(x);
+        Array f(alive_);
+        for (Size i=0; i<alive_; ++i)
+            f[i] = ts_->instruments_[firstAliveHelper_+i]->quoteError();
+        return f;
+    }
+
+    template <class Curve>
+    void GlobalBootstrap<Curve>::calculateJacobian(const Array& x,
+                                                   const Array& f) const {
+        // forward differences; each node is bumped and restored in
+        // turn, so that only the interpolation from it on is updated
+        if (jacobian_.rows() != alive_)
+            jacobian_ = Matrix(alive_, alive_);
+        for (Size k=0; k<alive_; ++k) {
+            Real h = std::sqrt(QL_EPSILON)*std::max(std::fabs(x[k]), 1.0);
+            Traits::updateGuess(ts_->data_, x[k]+h, k+1);
+            ts_->interpolation_.updateFrom(k);
+            for (Size i=0; i<alive_; ++i) {
+                Real error =
+                    ts_->instruments_[firstAliveHelper_+i]->quoteError();
+                jacobian_[i][k] = (f[i]-error)/h;
+            }
+            Traits::updateGuess(ts_->data_, x[k], k+1);
+            ts_->interpolation_.updateFrom(k);
+        }
+        inverse_ = inverse(jacobian_);
+    }
+
+}
+
+#endif
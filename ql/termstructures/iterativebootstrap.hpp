@@ -32,6 +32,7 @@
 #include <ql/math/interpolations/linearinterpolation.hpp>
 #include <ql/math/solvers1d/finitedifferencenewtonsafe.hpp>
 #include <ql/math/solvers1d/brent.hpp>
+#include <ql/math/matrix.hpp>
 #include <ql/utilities/dataformatters.hpp>
 
 namespace QuantLib {
@@ -45,16 +46,27 @@ namespace QuantLib {
         IterativeBootstrap();
         void setup(Curve* ts);
         void calculate() const;
+        /*! Returns the derivatives of the implied quotes of the alive
+            helpers, sorted by pillar date, with respect to the curve
+            nodes following the first one; the element \f$ (i,j) \f$
+            is the derivative of the \f$ i \f$-th quote with respect
+            to the \f$ (j+1) \f$-th node.  They are calculated by
+            forward differences when first required.
+
+            \pre the curve must be calculated.
+        */
+        const Matrix& jacobian() const;
       private:
         void initialize() const;
         Curve* ts_;
         Size n_;
         Brent firstSolver_;
         FiniteDifferenceNewtonSafe solver_;
-        mutable bool initialized_, validCurve_, loopRequired_;
+        mutable bool initialized_, validCurve_, loopRequired_, validJacobian_;
         mutable Size firstAliveHelper_, alive_;
         mutable std::vector<Real> previousData_;
         mutable std::vector<std::shared_ptr<BootstrapError<Curve> > > errors_;
+        mutable Matrix jacobian_;
     };
 
 
@@ -63,7 +75,7 @@ namespace QuantLib {
     template <class Curve>
     IterativeBootstrap<Curve>::IterativeBootstrap()
         : ts_(0), initialized_(false), validCurve_(false), 
-          loopRequired_(Interpolator::global) {}
+          loopRequired_(Interpolator::global), validJacobian_(false) {}
 
     template <class Curve>
     void IterativeBootstrap<Curve>::setup(Curve* ts) {
@@ -159,6 +171,7 @@ namespace QuantLib {
         // non-moving curve if the evaluation date changes
         if (!initialized_ || ts_->moving_)
             initialize();
+        validJacobian_ = false;
 
         // setup helpers
         for (Size j=firstAliveHelper_; j<n_; ++j) {
@@ -261,6 +274,36 @@ namespace QuantLib {
         validCurve_ = true;
     }
 
+    template <class Curve>
+    const Matrix& IterativeBootstrap<Curve>::jacobian() const {
+        QL_REQUIRE(validCurve_, "curve not bootstrapped");
+        if (!validJacobian_) {
+            // forward differences; each node is bumped and restored in
+            // turn, so that only the interpolation from it on is updated
+            std::vector<Real>& data = ts_->data_;
+            Array f(alive_);
+            for (Size i=0; i<alive_; ++i)
+                f[i] = ts_->instruments_[firstAliveHelper_+i]->quoteError();
+            if (jacobian_.rows() != alive_)
+                jacobian_ = Matrix(alive_, alive_);
+            for (Size k=0; k<alive_; ++k) {
+                Real x = data[k+1];
+                Real h = std::sqrt(QL_EPSILON)*std::max(std::fabs(x), 1.0);
+                Traits::updateGuess(data, x+h, k+1);
+                ts_->interpolation_.updateFrom(k);
+                for (Size i=0; i<alive_; ++i) {
+                    Real error =
+                        ts_->instruments_[firstAliveHelper_+i]->quoteError();
+                    jacobian_[i][k] = (f[i]-error)/h;
+                }
+                Traits::updateGuess(data, x, k+1);
+                ts_->interpolation_.updateFrom(k);
+            }
+            validJacobian_ = true;
+        }
+        return jacobian_;
+    }
+
 }
 
 #endif
@@ -0,0 +1,66 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/termstructures/multicurvebootstrap.hpp>
+#include <ql/utilities/dataformatters.hpp>
+#include <ql/utilities/parallelfor.hpp>
+#include <algorithm>
+
+namespace QuantLib {
+
+    MultiCurveBootstrap::MultiCurveBootstrap(Size threads)
+    : threads_(threads) {}
+
+    void MultiCurveBootstrap::add(
+              const std::shared_ptr<LazyObject>& curve,
+              const std::vector<std::shared_ptr<LazyObject> >& dependencies) {
+        QL_REQUIRE(curve, "null curve");
+        QL_REQUIRE(std::find(curves_.begin(), curves_.end(), curve)
+                   == curves_.end(),
+                   "curve already added");
+        Size wave = 0;
+        for (Size i=0; i<dependencies.size(); ++i) {
+            auto j = std::find(curves_.begin(), curves_.end(),
+                               dependencies[i]);
+            QL_REQUIRE(j != curves_.end(),
+                       io::ordinal(i+1) << " dependency not in the set");
+            wave = std::max(wave, waves_[j-curves_.begin()]+1);
+        }
+        curves_.push_back(curve);
+        waves_.push_back(wave);
+    }
+
+    void MultiCurveBootstrap::calculate() const {
+        Size waves = 0;
+        for (Size i=0; i<waves_.size(); ++i)
+            waves = std::max(waves, waves_[i]+1);
+
+        std::vector<Size> wave;
+        for (Size w=0; w<waves; ++w) {
+            wave.clear();
+            for (Size i=0; i<curves_.size(); ++i)
+                if (waves_[i] == w)
+                    wave.push_back(i);
+            // a failure in this wave stops the bootstrap, since the
+            // following waves would depend on the failed curves
+            parallelFor(wave.size(), threads_, [&](Size k) {
+                curves_[wave[k]]->calculateIfNeeded();
+            });
+        }
+    }
+
+}
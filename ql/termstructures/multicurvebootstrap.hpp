@@ -0,0 +1,73 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file multicurvebootstrap.hpp
+    \brief concurrent bootstrap of a set of curves
+*/
+
+#ifndef quantlib_multi_curve_bootstrap_hpp
+#define quantlib_multi_curve_bootstrap_hpp
+
+#include <ql/patterns/lazyobject.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    //! Bootstrap of a multi-curve set on several threads
+    /*! Each curve is added together with the curves of the set it
+        depends upon, e.g., the discount curve used by the helpers of
+        a forwarding curve; dependencies must have been added before.
+        The curves are bootstrapped in waves: a curve is bootstrapped
+        after all its dependencies, and the curves of each wave are
+        bootstrapped concurrently.
+
+        Curves already calculated are not bootstrapped again; in
+        particular, curves whose quotes moved keep using their
+        previous state as a guess, as they do when bootstrapped on
+        their own.
+
+        \warning the curves and helpers of a wave must not share any
+                 lazy object which is not already calculated, nor any
+                 quote, index or handle that is modified by the
+                 bootstrap; for instance, curves added as independent
+                 must not forecast each other's fixings.  Also, no
+                 observable should be modified while the bootstrap is
+                 running, and updates must not be deferred.
+    */
+    class MultiCurveBootstrap {
+      public:
+        explicit MultiCurveBootstrap(Size threads);
+        //! adds a curve depending on the given curves of the set
+        void add(const std::shared_ptr<LazyObject>& curve,
+                 const std::vector<std::shared_ptr<LazyObject> >&
+                                dependencies =
+                                std::vector<std::shared_ptr<LazyObject> >());
+        //! number of curves
+        Size size() const { return curves_.size(); }
+        //! bootstraps the curves that are not calculated
+        void calculate() const;
+      private:
+        Size threads_;
+        std::vector<std::shared_ptr<LazyObject> > curves_;
+        // for each curve, the wave in which it is bootstrapped
+        std::vector<Size> waves_;
+    };
+
+}
+
+
+#endif
@@ -37,6 +37,7 @@
 #include <ql/math/interpolations/backwardflatlinearinterpolation.hpp>
 #include <ql/math/interpolations/bilinearinterpolation.hpp>
 #include <ql/quote.hpp>
+#include <ql/utilities/parallelfor.hpp>
 
 #include <memory>
 #include <algorithm>
@@ -109,6 +110,20 @@ namespace QuantLib {
             bool backwardFlat_;
             mutable std::vector< std::shared_ptr<Interpolation2D> > interpolators_;
          };
+        // inputs and results of the fit of the smile at one node
+        struct SmileCalibration {
+            Time optionTime;
+            Rate forward;
+            Real shift;
+            std::vector<Real> strikes, volatilities, guess;
+            // alpha, beta, nu, rho, forward, error, max error, end criteria
+            std::vector<Real> result;
+        };
+        // smile fits of a whole cube, ordered by option time and swap length
+        struct CubeCalibration {
+            std::vector<Time> optionTimes, swapLengths;
+            std::vector<SmileCalibration> smiles;
+        };
       public:
         SwaptionVolCube1x(
             const Handle<SwaptionVolatilityStructure>& atmVolStructure,
@@ -163,6 +178,34 @@ namespace QuantLib {
                            const std::vector<Real> &beta,
                            const Period& swapTenor);
         void updateAfterRecalibration();
+        //! \name Calibration settings
+        //@{
+        /*! Fits the smiles at the different nodes on the given number
+            of threads; a null number of threads (the default) fits them
+            serially.  Each fit only depends on its own node, so the
+            results do not depend on the number of threads.
+
+            \warning a user-supplied optimization method keeps its state
+                     during the minimization and is shared by all fits;
+                     when one is given, the smiles are fitted serially.
+        */
+        void setThreads(Size threads) { threads_ = threads; }
+        /*! When enabled, the fit at each node starts from the parameters
+            found by the previous calibration of the same node instead of
+            the parameters guess; fixed parameters are still taken from
+            the guess.  When quotes move by small amounts, this usually
+            saves most of the optimization; the calibrated parameters
+            might differ from those of a cold start within the
+            optimization accuracy.
+        */
+        void setWarmStart(bool warmStart) { warmStart_ = warmStart; }
+        /*! When enabled, nodes whose forward, shift, strikes,
+            volatilities and parameters guess did not change since the
+            previous calibration keep their previous parameters without
+            being fitted again.
+        */
+        void setSkipUnchangedSmiles(bool skip) { skipUnchangedSmiles_ = skip; }
+        //@}
      protected:
         void registerWithParametersGuess();
         void setParameterGuess() const;
@@ -171,12 +214,21 @@ namespace QuantLib {
                                     Time swapLength,
                                     const Cube& sabrParametersCube) const;
         Cube sabrCalibration(const Cube &marketVolCube) const;
+        Cube sabrCalibration(const Cube &marketVolCube,
+                             CubeCalibration &calibration) const;
         void fillVolatilityCube() const;
         void createSparseSmiles() const;
         std::vector<Real> spreadVolInterpolation(const Date& atmOptionDate,
                                                  const Period& atmSwapTenor) const;
       private:
         Size requiredNumberOfStrikes() const { return 1; }
+        SmileCalibration smileCalibrationInputs(const Cube& marketVolCube,
+                                                Size j, Size k) const;
+        void calibrateSmiles(
+                    std::vector<SmileCalibration>& smiles,
+                    const std::vector<const SmileCalibration*>& previous) const;
+        CubeCalibration* calibrationCache(const Cube& marketVolCube,
+                                          const Cube& parametersCube) const;
         mutable Cube marketVolCube_;
         mutable Cube volCubeAtmCalibrated_;
         mutable Cube sparseParameters_;
@@ -195,6 +247,9 @@ namespace QuantLib {
         const Size maxGuesses_;
         const bool backwardFlat_;
         const Real cutoffStrike_;
+        Size threads_;
+        bool warmStart_, skipUnchangedSmiles_;
+        mutable CubeCalibration sparseCalibration_, denseCalibration_;
 
         class PrivateObserver : public Observer {
           public:
@@ -241,7 +296,8 @@ namespace QuantLib {
           isAtmCalibrated_(isAtmCalibrated), endCriteria_(endCriteria),
           optMethod_(optMethod),
           useMaxError_(useMaxError), maxGuesses_(maxGuesses),
-          backwardFlat_(backwardFlat), cutoffStrike_(cutoffStrike) {
+          backwardFlat_(backwardFlat), cutoffStrike_(cutoffStrike),
+          threads_(0), warmStart_(false), skipUnchangedSmiles_(false) {
 
         // the current implementations are all lognormal, if we have
         // a normal one, we can move this check to the implementing classes
@@ -312,7 +368,8 @@ namespace QuantLib {
         }
         marketVolCube_.updateInterpolators();
 
-        sparseParameters_ = sabrCalibration(marketVolCube_);
+        sparseParameters_ = sabrCalibration(marketVolCube_,
+                                            sparseCalibration_);
         //parametersGuess_ = sparseParameters_;
         sparseParameters_.updateInterpolators();
         //parametersGuess_.updateInterpolators();
@@ -320,7 +377,8 @@ namespace QuantLib {
 
         if(isAtmCalibrated_){
             fillVolatilityCube();
-            denseParameters_ = sabrCalibration(volCubeAtmCalibrated_);
+            denseParameters_ = sabrCalibration(volCubeAtmCalibrated_,
+                                               denseCalibration_);
             denseParameters_.updateInterpolators();
         }
     }
@@ -329,7 +387,8 @@ namespace QuantLib {
         volCubeAtmCalibrated_ = marketVolCube_;
         if(isAtmCalibrated_){
             fillVolatilityCube();
-            denseParameters_ = sabrCalibration(volCubeAtmCalibrated_);
+            denseParameters_ = sabrCalibration(volCubeAtmCalibrated_,
+                                               denseCalibration_);
             denseParameters_.updateInterpolators();
         }
         notifyObservers();
@@ -338,6 +397,15 @@ namespace QuantLib {
     template <class Model>
     typename SwaptionVolCube1x<Model>::Cube
     SwaptionVolCube1x<Model>::sabrCalibration(const Cube &marketVolCube) const {
+        CubeCalibration calibration;
+        return sabrCalibration(marketVolCube, calibration);
+    }
+
+    template <class Model>
+    typename SwaptionVolCube1x<Model>::Cube
+    SwaptionVolCube1x<Model>::sabrCalibration(
+                                    const Cube &marketVolCube,
+                                    CubeCalibration &calibration) const {
 
         const std::vector<Time>& optionTimes = marketVolCube.optionTimes();
         const std::vector<Time>& swapLengths = marketVolCube.swapLengths();
@@ -352,58 +420,39 @@ namespace QuantLib {
         Matrix maxErrors(alphas);
         Matrix endCriteria(alphas);
 
-        const std::vector<Matrix>& tmpMarketVolCube = marketVolCube.points();
-
-        std::vector<Real> strikes(strikeSpreads_.size());
-        std::vector<Real> volatilities(strikeSpreads_.size());
+        // the previous fits can only be reused on the same nodes
+        bool sameNodes = calibration.optionTimes == optionTimes &&
+                         calibration.swapLengths == swapLengths;
 
+        // market data are collected serially, the smiles are then fitted
+        // independently of one another
+        std::vector<SmileCalibration> smiles;
+        std::vector<const SmileCalibration*> previous;
+        smiles.reserve(optionTimes.size()*swapLengths.size());
         for (Size j=0; j<optionTimes.size(); j++) {
             for (Size k=0; k<swapLengths.size(); k++) {
-                Rate atmForward = atmStrike(optionDates[j], swapTenors[k]);
-                Real shiftTmp = atmVol_->shift(optionTimes[j], swapLengths[k]);
-                strikes.clear();
-                volatilities.clear();
-                for (Size i=0; i<nStrikes_; i++){
-                    Real strike = atmForward+strikeSpreads_[i];
-                    if(strike + shiftTmp >=cutoffStrike_) {
-                        strikes.emplace_back(strike);
-                        volatilities.emplace_back(tmpMarketVolCube[i][j][k]);
-                    }
-                }
+                smiles.emplace_back(smileCalibrationInputs(marketVolCube, j, k));
+                previous.emplace_back(sameNodes ?
+                    &calibration.smiles[j*swapLengths.size()+k] : nullptr);
+            }
+        }
+        calibrateSmiles(smiles, previous);
 
-                const std::vector<Real>& guess = parametersGuess_.operator()(
-                    optionTimes[j], swapLengths[k]);
-
-                const std::shared_ptr<typename Model::Interpolation> sabrInterpolation =
-                    std::shared_ptr<typename Model::Interpolation>(new
-                                          (typename Model::Interpolation)(strikes.begin(), strikes.end(),
-                                          volatilities.begin(),
-                                          optionTimes[j], atmForward,
-                                          guess[0], guess[1],
-                                          guess[2], guess[3],
-                                          isParameterFixed_[0],
-                                          isParameterFixed_[1],
-                                          isParameterFixed_[2],
-                                          isParameterFixed_[3],
-                                          vegaWeightedSmileFit_,
-                                          endCriteria_,
-                                          optMethod_,
-                                          errorAccept_,
-                                          useMaxError_,
-                                          maxGuesses_,
-                                          shiftTmp));
-                sabrInterpolation->update();
-
-                Real rmsError = sabrInterpolation->rmsError();
-                Real maxError = sabrInterpolation->maxError();
-                alphas     [j][k] = sabrInterpolation->alpha();
-                betas      [j][k] = sabrInterpolation->beta();
-                nus        [j][k] = sabrInterpolation->nu();
-                rhos       [j][k] = sabrInterpolation->rho();
-                forwards   [j][k] = atmForward;
+        for (Size j=0; j<optionTimes.size(); j++) {
+            for (Size k=0; k<swapLengths.size(); k++) {
+                const std::vector<Real>& result =
+                    smiles[j*swapLengths.size()+k].result;
+
+                Real rmsError = result[5];
+                Real maxError = result[6];
+                alphas     [j][k] = result[0];
+                betas      [j][k] = result[1];
+                nus        [j][k] = result[2];
+                rhos       [j][k] = result[3];
+                forwards   [j][k] = result[4];
                 errors     [j][k] = rmsError;
                 maxErrors  [j][k] = maxError;
-                endCriteria[j][k] = sabrInterpolation->endCriteria();
+                endCriteria[j][k] = result[7];
 
                 QL_ENSURE(endCriteria[j][k]!=EndCriteria::MaxIterations,
                           "global swaptions calibration failed: "
@@ -446,6 +495,10 @@ namespace QuantLib {
         sabrParametersCube.setLayer(6, maxErrors);
         sabrParametersCube.setLayer(7, endCriteria);
 
+        calibration.optionTimes = optionTimes;
+        calibration.swapLengths = swapLengths;
+        calibration.smiles.swap(smiles);
+
         return sabrParametersCube;
 
     }
@@ -464,57 +517,21 @@ namespace QuantLib {
                            swapTenor) - swapTenors.begin();
         QL_REQUIRE(k != swapTenors.size(), "swap tenor not found");
 
-        std::vector<Real> calibrationResult(8,0.);
-        const std::vector<Matrix>& tmpMarketVolCube = marketVolCube.points();
-
-        std::vector<Real> strikes(strikeSpreads_.size());
-        std::vector<Real> volatilities(strikeSpreads_.size());
+        CubeCalibration* calibration =
+            calibrationCache(marketVolCube, parametersCube);
 
+        std::vector<SmileCalibration> smiles;
+        std::vector<const SmileCalibration*> previous;
+        smiles.reserve(optionTimes.size());
         for (Size j=0; j<optionTimes.size(); j++) {
-            Rate atmForward = atmStrike(optionDates[j], swapTenors[k]);
-            Real shiftTmp = atmVol_->shift(optionTimes[j], swapLengths[k]);
-            strikes.clear();
-            volatilities.clear();
-            for (Size i=0; i<nStrikes_; i++){
-                Real strike = atmForward+strikeSpreads_[i];
-                if(strike+shiftTmp>=cutoffStrike_) {
-                    strikes.emplace_back(strike);
-                    volatilities.emplace_back(tmpMarketVolCube[i][j][k]);
-                }
-            }
-
-            const std::vector<Real>& guess = parametersGuess_.operator()(
-                optionTimes[j], swapLengths[k]);
-
-                const std::shared_ptr<typename Model::Interpolation> sabrInterpolation =
-                    std::shared_ptr<typename Model::Interpolation>(new
-                                          (typename Model::Interpolation)(strikes.begin(), strikes.end(),
-                                      volatilities.begin(),
-                                      optionTimes[j], atmForward,
-                                      guess[0], guess[1],
-                                      guess[2], guess[3],
-                                      isParameterFixed_[0],
-                                      isParameterFixed_[1],
-                                      isParameterFixed_[2],
-                                      isParameterFixed_[3],
-                                      vegaWeightedSmileFit_,
-                                      endCriteria_,
-                                      optMethod_,
-                                      errorAccept_,
-                                      useMaxError_,
-                                      maxGuesses_,
-                                      shiftTmp));
+            smiles.emplace_back(smileCalibrationInputs(marketVolCube, j, k));
+            previous.emplace_back(calibration != nullptr ?
+                &calibration->smiles[j*swapLengths.size()+k] : nullptr);
+        }
+        calibrateSmiles(smiles, previous);
 
-            sabrInterpolation->update();
-            Real interpolationError = sabrInterpolation->rmsError();
-            calibrationResult[0]=sabrInterpolation->alpha();
-            calibrationResult[1]=sabrInterpolation->beta();
-            calibrationResult[2]=sabrInterpolation->nu();
-            calibrationResult[3]=sabrInterpolation->rho();
-            calibrationResult[4]=atmForward;
-            calibrationResult[5]=interpolationError;
-            calibrationResult[6]=sabrInterpolation->maxError();
-            calibrationResult[7]=sabrInterpolation->endCriteria();
+        for (Size j=0; j<optionTimes.size(); j++) {
+            const std::vector<Real>& calibrationResult = smiles[j].result;
 
             QL_ENSURE(calibrationResult[7]!=EndCriteria::MaxIterations,
                       "section calibration failed: "
@@ -548,10 +565,119 @@ namespace QuantLib {
                                     optionTimes[j], swapLengths[k],
                                     calibrationResult);
             parametersCube.updateInterpolators();
+            if (calibration != nullptr)
+                calibration->smiles[j*swapLengths.size()+k] = smiles[j];
         }
 
     }
 
+    template <class Model>
+    typename SwaptionVolCube1x<Model>::SmileCalibration
+    SwaptionVolCube1x<Model>::smileCalibrationInputs(const Cube& marketVolCube,
+                                                     Size j, Size k) const {
+        Time optionTime = marketVolCube.optionTimes()[j];
+        Time swapLength = marketVolCube.swapLengths()[k];
+        const std::vector<Matrix>& tmpMarketVolCube = marketVolCube.points();
+
+        SmileCalibration smile;
+        smile.optionTime = optionTime;
+        smile.forward = atmStrike(marketVolCube.optionDates()[j],
+                                  marketVolCube.swapTenors()[k]);
+        smile.shift = atmVol_->shift(optionTime, swapLength);
+        for (Size i=0; i<nStrikes_; i++){
+            Real strike = smile.forward+strikeSpreads_[i];
+            if(strike + smile.shift >=cutoffStrike_) {
+                smile.strikes.emplace_back(strike);
+                smile.volatilities.emplace_back(tmpMarketVolCube[i][j][k]);
+            }
+        }
+        smile.guess = parametersGuess_(optionTime, swapLength);
+        return smile;
+    }
+
+    template <class Model>
+    void SwaptionVolCube1x<Model>::calibrateSmiles(
+                std::vector<SmileCalibration>& smiles,
+                const std::vector<const SmileCalibration*>& previous) const {
+
+        // optimization methods are stateful, a shared one can't be used
+        // by concurrent fits
+        Size threads = optMethod_ ? 0 : threads_;
+
+        parallelFor(smiles.size(), threads, [&](Size n) {
+            SmileCalibration& smile = smiles[n];
+            const SmileCalibration* last =
+                (previous[n] != nullptr && !previous[n]->result.empty()) ?
+                previous[n] : nullptr;
+
+            if (skipUnchangedSmiles_ && last != nullptr &&
+                last->forward == smile.forward &&
+                last->shift == smile.shift &&
+                last->strikes == smile.strikes &&
+                last->volatilities == smile.volatilities &&
+                last->guess == smile.guess) {
+                smile.result = last->result;
+                return;
+            }
+
+            std::vector<Real> guess(smile.guess);
+            if (warmStart_ && last != nullptr &&
+                last->result[7] != EndCriteria::MaxIterations) {
+                for (Size i=0; i<4; i++)
+                    if (!isParameterFixed_[i])
+                        guess[i] = last->result[i];
+            }
+
+            const std::shared_ptr<typename Model::Interpolation> sabrInterpolation =
+                std::shared_ptr<typename Model::Interpolation>(new
+                                      (typename Model::Interpolation)(
+                                      smile.strikes.begin(), smile.strikes.end(),
+                                      smile.volatilities.begin(),
+                                      smile.optionTime, smile.forward,
+                                      guess[0], guess[1],
+                                      guess[2], guess[3],
+                                      isParameterFixed_[0],
+                                      isParameterFixed_[1],
+                                      isParameterFixed_[2],
+                                      isParameterFixed_[3],
+                                      vegaWeightedSmileFit_,
+                                      endCriteria_,
+                                      optMethod_,
+                                      errorAccept_,
+                                      useMaxError_,
+                                      maxGuesses_,
+                                      smile.shift));
+            sabrInterpolation->update();
+
+            smile.result.resize(8);
+            smile.result[0] = sabrInterpolation->alpha();
+            smile.result[1] = sabrInterpolation->beta();
+            smile.result[2] = sabrInterpolation->nu();
+            smile.result[3] = sabrInterpolation->rho();
+            smile.result[4] = smile.forward;
+            smile.result[5] = sabrInterpolation->rmsError();
+            smile.result[6] = sabrInterpolation->maxError();
+            smile.result[7] = sabrInterpolation->endCriteria();
+        });
+    }
+
+    template <class Model>
+    typename SwaptionVolCube1x<Model>::CubeCalibration*
+    SwaptionVolCube1x<Model>::calibrationCache(
+                                    const Cube& marketVolCube,
+                                    const Cube& parametersCube) const {
+        CubeCalibration* calibration = nullptr;
+        if (&parametersCube == &sparseParameters_)
+            calibration = &sparseCalibration_;
+        else if (&parametersCube == &denseParameters_)
+            calibration = &denseCalibration_;
+        if (calibration != nullptr &&
+            calibration->optionTimes == marketVolCube.optionTimes() &&
+            calibration->swapLengths == marketVolCube.swapLengths())
+            return calibration;
+        return nullptr;
+    }
+
     template<class Model> void SwaptionVolCube1x<Model>::fillVolatilityCube() const {
 
         const std::shared_ptr<SwaptionVolatilityDiscrete> atmVolStructure =
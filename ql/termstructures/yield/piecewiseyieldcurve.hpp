@@ -30,6 +30,7 @@
 #include <ql/termstructures/localbootstrap.hpp>
 #include <ql/termstructures/yield/bootstraptraits.hpp>
 #include <ql/patterns/lazyobject.hpp>
+#include <ql/math/matrix.hpp>
 
 namespace QuantLib {
 
@@ -169,6 +170,28 @@ namespace QuantLib {
         const std::vector<Real>& data() const;
         std::vector<std::pair<Date, Real> > nodes() const;
         //@}
+        //! \name Bootstrap
+        //@{
+        //! the helpers, sorted by pillar date
+        /*! the last dates().size()-1 ones are alive; their pillars
+            are the curve nodes following the first one.
+        */
+        const std::vector<std::shared_ptr<typename Traits::helper> >&
+        instruments() const;
+        /*! derivatives of the quotes implied by the alive helpers
+            with respect to the curve nodes following the first one;
+            only available with bootstrappers calculating them, such
+            as IterativeBootstrap and GlobalBootstrap.
+        */
+        const Matrix& jacobian() const;
+        /*! derivatives of the discount factors at the given dates
+            with respect to the curve nodes following the first one.
+            They are calculated by finite differences on the
+            interpolation; the curve is not bootstrapped again and
+            its observers are not notified.
+        */
+        Matrix discountJacobian(const std::vector<Date>& dates) const;
+        //@}
         //! \name Observer interface
         //@{
         void update();
@@ -229,6 +252,42 @@ namespace QuantLib {
         return base_curve::nodes();
     }
 
+    template <class C, class I, template <class> class B>
+    inline const std::vector<std::shared_ptr<typename C::helper> >&
+    PiecewiseYieldCurve<C,I,B>::instruments() const {
+        calculate();
+        return instruments_;
+    }
+
+    template <class C, class I, template <class> class B>
+    inline const Matrix& PiecewiseYieldCurve<C,I,B>::jacobian() const {
+        calculate();
+        return bootstrap_.jacobian();
+    }
+
+    template <class C, class I, template <class> class B>
+    Matrix PiecewiseYieldCurve<C,I,B>::discountJacobian(
+                                    const std::vector<Date>& dates) const {
+        calculate();
+        Size n = this->data_.size()-1;
+        std::vector<DiscountFactor> discounts(dates.size());
+        for (Size i=0; i<dates.size(); ++i)
+            discounts[i] = this->discount(dates[i]);
+
+        Matrix result(dates.size(), n);
+        for (Size k=0; k<n; ++k) {
+            Real x = this->data_[k+1];
+            Real h = std::sqrt(QL_EPSILON)*std::max(std::fabs(x), 1.0);
+            C::updateGuess(this->data_, x+h, k+1);
+            this->interpolation_.updateFrom(k);
+            for (Size i=0; i<dates.size(); ++i)
+                result[i][k] = (this->discount(dates[i])-discounts[i])/h;
+            C::updateGuess(this->data_, x, k+1);
+            this->interpolation_.updateFrom(k);
+        }
+        return result;
+    }
+
     template <class C, class I, template <class> class B>
     inline void PiecewiseYieldCurve<C,I,B>::update() {
 
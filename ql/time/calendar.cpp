@@ -25,6 +25,258 @@
 
 namespace QuantLib {
 
+    namespace {
+
+        const Size wordsPerBlock = 8;
+        const Size daysPerBlock = 64*wordsPerBlock;
+
+        Date::serial_type firstSerialNumber() {
+            static const Date::serial_type first =
+                Date::minDate().serialNumber();
+            return first;
+        }
+
+        Size numberOfDays() {
+            static const Size days =
+                Date::maxDate().serialNumber() - firstSerialNumber() + 1;
+            return days;
+        }
+
+        int bitCount(std::uint64_t x) {
+            #if defined(__GNUC__)
+            return __builtin_popcountll(x);
+            #else
+            x = x - ((x >> 1) & 0x5555555555555555ULL);
+            x = (x & 0x3333333333333333ULL)
+                + ((x >> 2) & 0x3333333333333333ULL);
+            x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+            return int((x * 0x0101010101010101ULL) >> 56);
+            #endif
+        }
+
+        // index of the lowest and highest set bit; x must not be null
+        Size lowestBit(std::uint64_t x) {
+            #if defined(__GNUC__)
+            return __builtin_ctzll(x);
+            #else
+            Size i = 0;
+            while (!(x & 1)) {
+                x >>= 1;
+                ++i;
+            }
+            return i;
+            #endif
+        }
+
+        Size highestBit(std::uint64_t x) {
+            #if defined(__GNUC__)
+            return 63 - __builtin_clzll(x);
+            #else
+            Size i = 63;
+            while (!(x >> 63)) {
+                x <<= 1;
+                --i;
+            }
+            return i;
+            #endif
+        }
+
+    }
+
+    struct Calendar::BusinessDays::Block {
+        std::uint64_t bits[wordsPerBlock];
+        std::uint64_t known[wordsPerBlock];
+    };
+
+    Calendar::BusinessDays::BusinessDays() {
+        Size n = (numberOfDays()+daysPerBlock-1)/daysPerBlock;
+        blocks_.reset(new std::atomic<Block*>[n]);
+        for (Size i=0; i<n; ++i)
+            blocks_[i].store(nullptr, std::memory_order_relaxed);
+    }
+
+    Calendar::BusinessDays::~BusinessDays() {
+        Size n = (numberOfDays()+daysPerBlock-1)/daysPerBlock;
+        for (Size i=0; i<n; ++i)
+            delete blocks_[i].load(std::memory_order_relaxed);
+    }
+
+    void Calendar::BusinessDays::reset() {
+        // blocks can be freed right away because holidays can't be
+        // changed while being read anyway
+        Size n = (numberOfDays()+daysPerBlock-1)/daysPerBlock;
+        for (Size i=0; i<n; ++i)
+            delete blocks_[i].exchange(nullptr, std::memory_order_acq_rel);
+    }
+
+    const Calendar::BusinessDays::Block*
+    Calendar::BusinessDays::block(const Impl& impl, Size i) const {
+        Block* current = blocks_[i].load(std::memory_order_acquire);
+        if (current != nullptr)
+            return current;
+
+        std::unique_ptr<Block> fresh(new Block);
+        Date::serial_type first = firstSerialNumber() + i*daysPerBlock;
+        Size days = std::min(daysPerBlock, numberOfDays() - i*daysPerBlock);
+        std::fill(fresh->bits, fresh->bits+wordsPerBlock, 0);
+        std::fill(fresh->known, fresh->known+wordsPerBlock, 0);
+        for (Size k=0; k<days; ++k) {
+            Date d(first + k);
+            std::uint64_t bit = std::uint64_t(1) << (k%64);
+            try {
+                if (impl.addedHolidays.find(d) == impl.addedHolidays.end()
+                    && (impl.removedHolidays.find(d)
+                            != impl.removedHolidays.end()
+                        || impl.isBusinessDay(d)))
+                    fresh->bits[k/64] |= bit;
+                fresh->known[k/64] |= bit;
+            } catch (std::exception&) {
+                // e.g., a year not covered by the calendar; the error
+                // is raised again if the date is queried
+            }
+        }
+        // days past Date::maxDate() are known not to be business days
+        for (Size k=days; k<daysPerBlock; ++k)
+            fresh->known[k/64] |= std::uint64_t(1) << (k%64);
+
+        // another thread might have built the block in the meantime;
+        // if so, we use its version and ours is discarded.  Published
+        // blocks are only freed by reset.
+        if (blocks_[i].compare_exchange_strong(current, fresh.get(),
+                                               std::memory_order_acq_rel,
+                                               std::memory_order_acquire))
+            return fresh.release();
+        else
+            return current;
+    }
+
+    std::uint64_t Calendar::BusinessDays::word(const Impl& impl, Size i,
+                                               std::uint64_t& known) const {
+        const Block* b = block(impl, i/wordsPerBlock);
+        known = b->known[i%wordsPerBlock];
+        return b->bits[i%wordsPerBlock];
+    }
+
+    bool Calendar::BusinessDays::isBusinessDay(const Impl& impl,
+                                               Size offset,
+                                               bool& result) const {
+        std::uint64_t known, bits = word(impl, offset/64, known);
+        result = (bits >> (offset%64)) & 1;
+        return (known >> (offset%64)) & 1;
+    }
+
+    bool Calendar::BusinessDays::count(const Impl& impl,
+                                       Size first, Size last,
+                                       Size& result) const {
+        const std::uint64_t all = ~std::uint64_t(0);
+        Size i = first/64, j = last/64;
+        result = 0;
+        for (Size k=i; k<=j; ++k) {
+            std::uint64_t mask = all;
+            if (k == i)
+                mask &= all << (first%64);
+            if (k == j)
+                mask &= all >> (63 - last%64);
+            std::uint64_t known, bits = word(impl, k, known);
+            if ((known & mask) != mask)
+                return false;
+            result += bitCount(bits & mask);
+        }
+        return true;
+    }
+
+    bool Calendar::BusinessDays::advance(const Impl& impl,
+                                         Size& offset, Integer n) const {
+        Size words = (numberOfDays()+63)/64;
+        std::uint64_t known;
+        if (n > 0) {
+            if (offset+1 == numberOfDays())
+                return false;
+            Size i = (offset+1)/64;
+            std::uint64_t mask = ~std::uint64_t(0) << ((offset+1)%64);
+            std::uint64_t x = word(impl, i, known) & mask;
+            if ((known & mask) != mask)
+                return false;
+            for (Integer c = bitCount(x); c < n; c = bitCount(x)) {
+                n -= c;
+                if (++i == words)
+                    return false;
+                x = word(impl, i, known);
+                if (~known != 0)
+                    return false;
+            }
+            // clear the lowest n-1 business days in the word
+            for (; n > 1; --n)
+                x &= x-1;
+            offset = i*64 + lowestBit(x);
+        } else {
+            if (offset == 0)
+                return false;
+            Size i = (offset-1)/64;
+            std::uint64_t mask = ~std::uint64_t(0) >> (63 - (offset-1)%64);
+            std::uint64_t x = word(impl, i, known) & mask;
+            if ((known & mask) != mask)
+                return false;
+            for (Integer c = bitCount(x); c < -n; c = bitCount(x)) {
+                n += c;
+                if (i-- == 0)
+                    return false;
+                x = word(impl, i, known);
+                if (~known != 0)
+                    return false;
+            }
+            // clear the highest -n-1 business days in the word
+            for (; n < -1; ++n)
+                x &= ~(std::uint64_t(1) << highestBit(x));
+            offset = i*64 + highestBit(x);
+        }
+        return true;
+    }
+
+
+    Calendar::Impl::~Impl() {
+        for (auto& c : dependencies_) {
+            std::lock_guard<std::mutex> lock(c->mutex_);
+            auto i = std::find(c->dependents_.begin(),
+                               c->dependents_.end(), this);
+            if (i != c->dependents_.end())
+                c->dependents_.erase(i);
+        }
+    }
+
+    void Calendar::Impl::resetBusinessDays() {
+        // holidays can't be changed while being read, so the cached
+        // business days of the dependent calendars can be reset too
+        businessDays_.reset();
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto d : dependents_)
+            d->resetBusinessDays();
+    }
+
+    void Calendar::Impl::dependOn(const Calendar& c) {
+        if (!c.impl_)
+            return;
+        dependencies_.push_back(c.impl_);
+        std::lock_guard<std::mutex> lock(c.impl_->mutex_);
+        c.impl_->dependents_.push_back(this);
+    }
+
+
+    bool Calendar::isBusinessDay(const Date& d) const {
+        QL_REQUIRE(impl_, "no implementation provided");
+        Date::serial_type offset = d.serialNumber() - firstSerialNumber();
+        bool result;
+        if (offset >= 0 && Size(offset) < numberOfDays()
+            && impl_->businessDays_.isBusinessDay(*impl_, offset, result))
+            return result;
+        // the null date or a day not covered by the implementation
+        if (impl_->addedHolidays.find(d) != impl_->addedHolidays.end())
+            return false;
+        if (impl_->removedHolidays.find(d) != impl_->removedHolidays.end())
+            return true;
+        return impl_->isBusinessDay(d);
+    }
+
     void Calendar::addHoliday(const Date& d) {
         QL_REQUIRE(impl_, "no implementation provided");
         // if d was a genuine holiday previously removed, revert the change
@@ -33,6 +285,7 @@ namespace QuantLib {
         // Otherwise, add it.
         if (impl_->isBusinessDay(d))
             impl_->addedHolidays.insert(d);
+        impl_->resetBusinessDays();
     }
 
     void Calendar::removeHoliday(const Date& d) {
@@ -43,6 +296,7 @@ namespace QuantLib {
         // Otherwise, add it.
         if (!impl_->isBusinessDay(d))
             impl_->removedHolidays.insert(d);
+        impl_->resetBusinessDays();
     }
 
     Date Calendar::adjust(const Date& d,
@@ -99,6 +353,12 @@ namespace QuantLib {
         if (n == 0) {
             return adjust(d,c);
         } else if (unit == Days) {
+            QL_REQUIRE(impl_, "no implementation provided");
+            Size offset = d.serialNumber() - firstSerialNumber();
+            if (impl_->businessDays_.advance(*impl_, offset, n))
+                return Date(firstSerialNumber() + offset);
+            // past the cached range or through days not covered by the
+            // implementation; this raises the usual error
             Date d1 = d;
             if (n > 0) {
                 while (n > 0) {
@@ -143,7 +403,16 @@ namespace QuantLib {
                                                     bool includeLast) const {
         Date::serial_type wd = 0;
         if (from != to) {
-            if (from < to) {
+            QL_REQUIRE(impl_, "no implementation provided");
+            QL_REQUIRE(from != Date() && to != Date(), "null date");
+            Size first = std::min(from, to).serialNumber()
+                - firstSerialNumber();
+            Size last = std::max(from, to).serialNumber()
+                - firstSerialNumber();
+            Size count;
+            if (impl_->businessDays_.count(*impl_, first, last, count)) {
+                wd = count;
+            } else if (from < to) {
                 // the last one is treated separately to avoid
                 // incrementing Date::maxDate()
                 for (Date d = from; d < to; ++d) {
@@ -152,7 +421,7 @@ namespace QuantLib {
                 }
                 if (isBusinessDay(to))
                     ++wd;
-            } else if (from > to) {
+            } else {
                 for (Date d = to; d < from; ++d) {
                     if (isBusinessDay(d))
                         ++wd;
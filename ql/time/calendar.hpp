@@ -31,6 +31,9 @@
 #include <ql/time/businessdayconvention.hpp>
 #include <memory>
 #include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
 #include <set>
 #include <vector>
 #include <string>
@@ -51,6 +54,14 @@ namespace QuantLib {
         or for general country holiday schedule. Legacy city holiday schedule
         calendars will be moved to the exchange/country convention.
 
+
+        Business days between Date::minDate() and Date::maxDate() are
+        cached by each implementation as a bitmap, which is built
+        lazily in blocks of consecutive days and can be read safely
+        from multiple threads.  The cache of a calendar is discarded
+        when holidays are added to or removed from it, together with
+        the ones of joint calendars and the like depending on it.
+
         \ingroup datetime
 
         \test the methods for adding and removing holidays are tested
@@ -58,15 +69,70 @@ namespace QuantLib {
               invocation.
     */
     class Calendar {
+      protected:
+        class Impl;
+      private:
+        //! lazily-built bitmap of the business days of an implementation
+        class BusinessDays {
+          public:
+            BusinessDays();
+            ~BusinessDays();
+            BusinessDays(const BusinessDays&) = delete;
+            BusinessDays& operator=(const BusinessDays&) = delete;
+            /* Offsets are counted in days from Date::minDate() and
+               must not exceed the one of Date::maxDate().  Days for
+               which the implementation throws are not cached; the
+               methods below return false when they need any of them.
+            */
+            //! whether the given day is a business day
+            bool isBusinessDay(const Impl&, Size offset,
+                               bool& result) const;
+            //! number of business days between two offsets, both included
+            bool count(const Impl&, Size first, Size last,
+                       Size& result) const;
+            /*! finds the offset of the n-th business day after (or,
+                for negative n, before) the given one; also returns
+                false if it falls outside the cached range.
+            */
+            bool advance(const Impl&, Size& offset, Integer n) const;
+            //! discards the cached blocks
+            void reset();
+          private:
+            struct Block;
+            // business days in the given 64-day word, and which of
+            // them are known
+            std::uint64_t word(const Impl&, Size i,
+                               std::uint64_t& known) const;
+            const Block* block(const Impl&, Size i) const;
+            std::unique_ptr<std::atomic<Block*>[]> blocks_;
+        };
       protected:
         //! abstract base class for calendar implementations
         class Impl {
           public:
-            virtual ~Impl() {}
+            virtual ~Impl();
             virtual std::string name() const = 0;
             virtual bool isBusinessDay(const Date&) const = 0;
             virtual bool isWeekend(Weekday) const = 0;
             std::set<Date> addedHolidays, removedHolidays;
+          protected:
+            /*! Implementations whose business days can change after
+                construction must call this method when they do.
+            */
+            void resetBusinessDays();
+            /*! Implementations depending on other calendars must
+                call this method for each of them, so that their
+                cached business days are discarded when the holidays
+                of the latter change.
+            */
+            void dependOn(const Calendar&);
+          private:
+            friend class Calendar;
+            BusinessDays businessDays_;
+            // calendars depending on this one, and the other way round
+            std::mutex mutex_;
+            std::vector<Impl*> dependents_;
+            std::vector<std::shared_ptr<Impl> > dependencies_;
         };
         std::shared_ptr<Impl> impl_;
       public:
@@ -195,15 +261,6 @@ namespace QuantLib {
         return impl_->name();
     }
 
-    inline bool Calendar::isBusinessDay(const Date& d) const {
-        QL_REQUIRE(impl_, "no implementation provided");
-        if (impl_->addedHolidays.find(d) != impl_->addedHolidays.end())
-            return false;
-        if (impl_->removedHolidays.find(d) != impl_->removedHolidays.end())
-            return true;
-        return impl_->isBusinessDay(d);
-    }
-
     inline bool Calendar::isEndOfMonth(const Date& d) const {
         return (d.month() != adjust(d+1).month());
     }
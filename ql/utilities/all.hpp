@@ -7,6 +7,7 @@
 #include <ql/utilities/null.hpp>
 #include <ql/utilities/null_deleter.hpp>
 #include <ql/utilities/observablevalue.hpp>
+#include <ql/utilities/parallelfor.hpp>
 #include <ql/utilities/steppingiterator.hpp>
 #include <ql/utilities/stringutils.hpp>
 #include <ql/utilities/tracing.hpp>
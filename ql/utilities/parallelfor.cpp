@@ -0,0 +1,84 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/utilities/parallelfor.hpp>
+#include <algorithm>
+#include <system_error>
+
+namespace QuantLib {
+
+    namespace detail {
+
+        ParallelForPool& ParallelForPool::instance() {
+            static ParallelForPool pool;
+            return pool;
+        }
+
+        ParallelForPool::~ParallelForPool() {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                stop_ = true;
+            }
+            condition_.notify_all();
+            for (auto& worker : workers_)
+                worker.join();
+        }
+
+        Size ParallelForPool::submit(const std::function<void()>& task,
+                                     Size copies) {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                while (workers_.size() < copies) {
+                    try {
+                        workers_.emplace_back([this]() { run(); });
+                    } catch (std::system_error&) {
+                        break;
+                    }
+                }
+                copies = std::min(copies, Size(workers_.size()));
+                for (Size i=0; i<copies; ++i)
+                    tasks_.push_back(task);
+            }
+            condition_.notify_all();
+            return copies;
+        }
+
+        Size ParallelForPool::workers() const {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return workers_.size();
+        }
+
+        void ParallelForPool::run() {
+            for (;;) {
+                std::function<void()> task;
+                {
+                    std::unique_lock<std::mutex> lock(mutex_);
+                    condition_.wait(lock, [this]() {
+                        return stop_ || !tasks_.empty();
+                    });
+                    if (tasks_.empty())
+                        return;
+                    task = std::move(tasks_.front());
+                    tasks_.pop_front();
+                }
+                task();
+            }
+        }
+
+    }
+
+}
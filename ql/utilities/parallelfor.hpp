@@ -0,0 +1,177 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file parallelfor.hpp
+    \brief loop over an index range distributed across threads
+*/
+
+#ifndef quantlib_utilities_parallel_for_hpp
+#define quantlib_utilities_parallel_for_hpp
+
+#include <ql/types.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace QuantLib {
+
+    namespace detail {
+
+        //! process-wide pool of worker threads used by parallelFor
+        /*! Workers are started the first time they are needed and
+            are kept until the end of the program, so that loops run
+            repeatedly (e.g., at each step of a finite-difference
+            scheme) don't pay for starting and joining threads.
+        */
+        class ParallelForPool {
+          public:
+            static ParallelForPool& instance();
+            ~ParallelForPool();
+            /*! queues the given number of copies of the task, starting
+                workers if needed; returns the number of copies queued,
+                which is lower than requested if fewer workers could
+                be started.
+            */
+            Size submit(const std::function<void()>& task, Size copies);
+            Size workers() const;
+          private:
+            ParallelForPool() = default;
+            void run();
+            mutable std::mutex mutex_;
+            std::condition_variable condition_;
+            std::deque<std::function<void()> > tasks_;
+            std::vector<std::thread> workers_;
+            bool stop_ = false;
+        };
+
+        // bookkeeping of the pool workers taking part in a loop
+        class ParallelForState {
+          public:
+            // returns false if the loop is already over
+            bool enter() {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (closed_)
+                    return false;
+                ++running_;
+                return true;
+            }
+            void leave() {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (--running_ == 0)
+                    condition_.notify_all();
+            }
+            // prevents further workers from entering and waits for
+            // the ones that did
+            void close() {
+                std::unique_lock<std::mutex> lock(mutex_);
+                closed_ = true;
+                condition_.wait(lock, [this]() { return running_ == 0; });
+            }
+          private:
+            std::mutex mutex_;
+            std::condition_variable condition_;
+            Size running_ = 0;
+            bool closed_ = false;
+        };
+
+    }
+
+    //! calls f(i) for each i in [0,n) using up to the given number of threads
+    /*! Indices are handed out one at a time to whichever thread is
+        free, the calling thread included; the function returns when
+        all calls are completed.  Therefore, the order in which calls
+        are made is unspecified and any result that must not depend on
+        the number of threads should be stored by index and combined
+        afterwards.
+
+        The additional threads are taken from a persistent pool, so
+        that a call costs a few synchronizations rather than the
+        creation of threads; still, that cost is in the order of
+        microseconds and f(i) should do substantially more work than
+        that.  Workers busy elsewhere, e.g., in an enclosing
+        parallelFor, are not waited for: the calling thread runs
+        whatever indices they don't pick up.
+
+        If any call throws, no further indices are handed out and the
+        exception raised by the lowest failing index is rethrown once
+        all threads are done.  If fewer threads can be started than
+        requested, the loop runs on the available ones.
+
+        \warning f is called concurrently and must be safe to call so;
+                 when sessions are enabled, singletons accessed from
+                 the worker threads belong to the session returned by
+                 sessionId() for those threads.
+    */
+    template <class F>
+    void parallelFor(Size n, Size threads, const F& f) {
+        if (threads > n)
+            threads = n;
+        if (threads <= 1) {
+            for (Size i=0; i<n; ++i)
+                f(i);
+            return;
+        }
+
+        std::atomic<Size> next(0);
+        std::atomic<bool> failed(false);
+        std::mutex errorMutex;
+        Size errorIndex = n;
+        std::exception_ptr error;
+
+        auto work = [&]() {
+            for (Size i = next++; i < n && !failed; i = next++) {
+                try {
+                    f(i);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(errorMutex);
+                    if (i < errorIndex) {
+                        errorIndex = i;
+                        error = std::current_exception();
+                    }
+                    failed = true;
+                }
+            }
+        };
+
+        // queued tasks can outlive this call; they only use the
+        // loop variables after entering, which close() prevents
+        const auto state = std::make_shared<detail::ParallelForState>();
+        detail::ParallelForPool::instance().submit(
+            [state, &work]() {
+                if (state->enter()) {
+                    work();
+                    state->leave();
+                }
+            },
+            threads-1);
+        work();
+        state->close();
+
+        if (error)
+            std::rethrow_exception(error);
+    }
+
+}
+
+
+#endif
@@ -208,3 +208,93 @@ TEST_CASE("Array_ArrayFunctions", "[Array]") {
 
 }
 
+
+TEST_CASE("Array_SubtractionAssignment", "[Array]") {
+
+    INFO("Testing array subtraction assignment...");
+
+    const Size n = 5;
+    Array a(n), b(n);
+    for (Size i=0; i < n; ++i) {
+        a[i] = 2.0*i + 1.0;
+        b[i] = 0.5*i*i - 3.0;
+    }
+
+    Array d = a;
+    d -= b;
+
+    if (d.size() != n)
+        FAIL("wrong size " << d.size() << " after subtraction assignment");
+    for (Size i=0; i < n; ++i) {
+        Real expected = a[i] - b[i];
+        if (std::fabs(d[i]-expected) > 10*QL_EPSILON)
+            FAIL_CHECK("subtraction assignment failed for "
+                       << io::ordinal(i+1) << " element:"
+                       << "\n    calculated: " << d[i]
+                       << "\n    expected:   " << expected);
+    }
+
+    // the subtracted array must not be modified
+    for (Size i=0; i < n; ++i) {
+        if (b[i] != 0.5*i*i - 3.0)
+            FAIL_CHECK("subtracted array modified at "
+                       << io::ordinal(i+1) << " element");
+    }
+
+    try {
+        d -= Array(n+1);
+        FAIL_CHECK("arrays with different sizes were subtracted");
+    } catch (Error&) {}
+}
+
+
+TEST_CASE("Array_AlgebraOnTemporaries", "[Array]") {
+
+    INFO("Testing array algebra on temporary arrays...");
+
+    const Size n = 7;
+    Array a(n), b(n), c(n);
+    for (Size i=0; i < n; ++i) {
+        a[i] = std::sin(Real(i))+1.1;
+        b[i] = std::cos(Real(i))+1.5;
+        c[i] = 0.5*i+0.25;
+    }
+
+    // expected values computed element by element
+    auto check = [&](const std::string& expression, const Array& result,
+                     const std::function<Real(Size)>& expected) {
+        if (result.size() != n)
+            FAIL_CHECK(expression << ": wrong size " << result.size());
+        for (Size i=0; i < std::min(n, result.size()); ++i) {
+            if (std::fabs(result[i]-expected(i)) > 10*QL_EPSILON)
+                FAIL_CHECK(expression << ": " << io::ordinal(i+1)
+                           << " element is " << result[i]
+                           << ", expected " << expected(i));
+        }
+    };
+
+    check("a*b + c", a*b + c, [&](Size i) { return a[i]*b[i] + c[i]; });
+    check("c - a*b", c - a*b, [&](Size i) { return c[i] - a[i]*b[i]; });
+    check("(a+b) - (b*c)", (a+b) - (b*c),
+          [&](Size i) { return (a[i]+b[i]) - b[i]*c[i]; });
+    check("c / (a+b)", c / (a+b), [&](Size i) { return c[i]/(a[i]+b[i]); });
+    check("(a+b) / c", (a+b) / c, [&](Size i) { return (a[i]+b[i])/c[i]; });
+    check("2.0 - (a*b)", 2.0 - (a*b), [&](Size i) { return 2.0-a[i]*b[i]; });
+    check("3.0 / (a+b)", 3.0 / (a+b), [&](Size i) { return 3.0/(a[i]+b[i]); });
+    check("(a*b) - 2.0", (a*b) - 2.0, [&](Size i) { return a[i]*b[i]-2.0; });
+    check("-(a-b)", -(a-b), [&](Size i) { return b[i]-a[i]; });
+    check("Exp(a*b)", Exp(a*b), [&](Size i) { return std::exp(a[i]*b[i]); });
+    check("Sqrt(a+b)", Sqrt(a+b),
+          [&](Size i) { return std::sqrt(a[i]+b[i]); });
+    check("Pow(a+b, 1.5)", Pow(a+b, 1.5),
+          [&](Size i) { return std::pow(a[i]+b[i], 1.5); });
+
+    // the operands must not be modified
+    check("a", a, [&](Size i) { return std::sin(Real(i))+1.1; });
+    check("b", b, [&](Size i) { return std::cos(Real(i))+1.5; });
+
+    try {
+        Array x = Array(n+1) + a*b;
+        FAIL_CHECK("arrays with different sizes were added");
+    } catch (Error&) {}
+}
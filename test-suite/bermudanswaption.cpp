@@ -227,6 +227,63 @@ TEST_CASE("BermudanSwaption_CachedValues", "[BermudanSwaption]") {
                     << "expected:   " << otmValue);
 }
 
+TEST_CASE("BermudanSwaption_SharedTree", "[BermudanSwaption]") {
+
+    INFO("Testing Bermudan swaptions priced on a shared tree...");
+
+    CommonVars vars;
+
+    vars.today = Date(15, February, 2002);
+
+    Settings::instance().evaluationDate() = vars.today;
+
+    vars.settlement = Date(19, February, 2002);
+    vars.termStructure.linkTo(flatRate(vars.settlement,
+                                          0.04875825,
+                                          Actual365Fixed()));
+
+    Rate atmRate = vars.makeSwap(0.0)->fairRate();
+    Rate strikes[] = { 0.8*atmRate, atmRate, 1.2*atmRate };
+
+    std::shared_ptr<HullWhite> model(new HullWhite(vars.termStructure,
+                                                     0.048696, 0.0058904));
+    std::shared_ptr<VanillaSwap> atmSwap = vars.makeSwap(atmRate);
+    std::vector<Date> exerciseDates;
+    const Leg& leg = atmSwap->fixedLeg();
+    for (Size i=0; i<leg.size(); i++) {
+        std::shared_ptr<Coupon> coupon =
+            std::dynamic_pointer_cast<Coupon>(leg[i]);
+        exerciseDates.emplace_back(coupon->accrualStartDate());
+    }
+    std::shared_ptr<Exercise> exercise(new BermudanExercise(exerciseDates));
+
+    // the swaptions have the same mandatory times, so that the
+    // engine prices them all on the tree built for the first one
+    std::shared_ptr<PricingEngine> sharedEngine =
+        std::make_shared<TreeSwaptionEngine>(model, 50);
+
+    Real tolerance = 1.0e-12;
+
+    for (Size k=0; k<2; ++k) {
+        for (Size i=0; i<LENGTH(strikes); ++i) {
+            Swaption swaption(vars.makeSwap(strikes[i]), exercise);
+            swaption.setPricingEngine(sharedEngine);
+            Real calculated = swaption.NPV();
+            swaption.setPricingEngine(
+                std::make_shared<TreeSwaptionEngine>(model, 50));
+            Real expected = swaption.NPV();
+            if (std::fabs(calculated-expected) > tolerance)
+                FAIL_CHECK("failed to reproduce swaption value "
+                           "on a shared tree:"
+                           << "\n    strike:     " << strikes[i]
+                           << "\n    calculated: " << calculated
+                           << "\n    expected:   " << expected);
+        }
+        // the shared tree must be rebuilt after the model changes
+        model->setParams(model->params()*1.1);
+    }
+}
+
 TEST_CASE("BermudanSwaption_CachedG2Values", "[BermudanSwaption]") {
     INFO(
         "Testing Bermudan swaption with G2 model against cached values...");
@@ -116,3 +116,99 @@ TEST_CASE("BlackFormula_ChambersImpliedVol", "[BlackFormula]") {
     }
 }
 
+
+TEST_CASE("BlackFormula_Batch", "[BlackFormula]") {
+
+    INFO("Testing batch Black formula and implied standard deviation...");
+
+    Option::Type types[] = {Option::Call, Option::Put};
+    Real displacements[] = {0.0000, 0.0100};
+    Real forwards[] = {0.0050, 0.0200, 0.0500, 1.0000};
+    Real strikeRatios[] = {0.20, 0.50, 0.80, 0.95, 1.00, 1.05, 1.25,
+                           2.00, 5.00};
+    Real stdDevs[] = {0.0, 0.01, 0.05, 0.10, 0.20, 0.50, 1.00, 2.00};
+    Real discount = 0.95;
+
+    for (Size i1 = 0; i1 < LENGTH(types); ++i1) {
+        for (Size i2 = 0; i2 < LENGTH(displacements); ++i2) {
+            std::vector<Real> K, F, S;
+            for (Size i3 = 0; i3 < LENGTH(forwards); ++i3) {
+                for (Size i4 = 0; i4 < LENGTH(strikeRatios); ++i4) {
+                    for (Size i5 = 0; i5 < LENGTH(stdDevs); ++i5) {
+                        K.push_back(forwards[i3]*strikeRatios[i4]);
+                        F.push_back(forwards[i3]);
+                        S.push_back(stdDevs[i5]);
+                    }
+                }
+            }
+
+            std::vector<Real> premiums = blackFormula(
+                types[i1], K, F, S, discount, displacements[i2]);
+            std::vector<Real> bachelierPremiums =
+                bachelierBlackFormula(types[i1], K, F, S, discount);
+            for (Size i = 0; i < K.size(); ++i) {
+                Real expected = blackFormula(types[i1], K[i], F[i], S[i],
+                                             discount, displacements[i2]);
+                if (std::fabs(premiums[i] - expected) >
+                    1.0e-15*std::max(expected, 1.0))
+                    FAIL_CHECK("batch Black formula differs from "
+                               "single-option one for " << types[i1]
+                               << " displacement=" << displacements[i2]
+                               << " forward=" << F[i]
+                               << " strike=" << K[i]
+                               << " stddev=" << S[i]
+                               << "\n    batch:  " << premiums[i]
+                               << "\n    single: " << expected);
+                expected = bachelierBlackFormula(types[i1], K[i], F[i],
+                                                 S[i], discount);
+                // the two versions might be compiled with different
+                // contractions of multiplications and additions
+                if (std::fabs(bachelierPremiums[i] - expected) >
+                    1.0e-15*std::max(expected, 1.0))
+                    FAIL_CHECK("batch Bachelier formula differs from "
+                               "single-option one for " << types[i1]
+                               << " forward=" << F[i]
+                               << " strike=" << K[i]
+                               << " stddev=" << S[i]
+                               << "\n    batch:  " << bachelierPremiums[i]
+                               << "\n    single: " << expected);
+            }
+
+            // prices without time value can't be inverted, nor can
+            // calls with the price of the underlying
+            std::vector<Real> k, f, s, p;
+            for (Size i = 0; i < K.size(); ++i) {
+                Real intrinsic = std::max(
+                    (F[i]-K[i])*types[i1], 0.0)*discount;
+                Real limit = (types[i1] == Option::Call ?
+                              (F[i]+displacements[i2])*discount :
+                              (K[i]+displacements[i2])*discount);
+                if (premiums[i] > intrinsic + 1.0e-10 &&
+                    premiums[i] < limit - 1.0e-10) {
+                    k.push_back(K[i]);
+                    f.push_back(F[i]);
+                    s.push_back(S[i]);
+                    p.push_back(premiums[i]);
+                }
+            }
+            std::vector<Real> impliedStdDevs = blackFormulaImpliedStdDev(
+                types[i1], k, f, p, discount, displacements[i2], 1.0e-10);
+            for (Size i = 0; i < k.size(); ++i) {
+                // the price must be reproduced; the standard deviation
+                // might not be when the price is barely sensitive to it
+                Real premium = blackFormula(types[i1], k[i], f[i],
+                                            impliedStdDevs[i], discount,
+                                            displacements[i2]);
+                if (std::fabs(premium - p[i]) > 1.0e-12)
+                    FAIL_CHECK("batch implied stddev failed for "
+                               << types[i1]
+                               << " displacement=" << displacements[i2]
+                               << " forward=" << f[i]
+                               << " strike=" << k[i]
+                               << " price=" << p[i]
+                               << "\n    stddev:  " << s[i]
+                               << "\n    implied: " << impliedStdDevs[i]);
+            }
+        }
+    }
+}
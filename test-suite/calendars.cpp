@@ -35,6 +35,7 @@
 #include <ql/time/calendars/southkorea.hpp>
 #include <ql/time/calendars/jointcalendar.hpp>
 #include <ql/time/calendars/bespokecalendar.hpp>
+#include <ql/utilities/parallelfor.hpp>
 #include <ql/errors.hpp>
 #include <fstream>
 
@@ -1782,6 +1783,117 @@ TEST_CASE("Calendar_BusinessDaysBetween", "[Calendar]") {
 }
 
 
+TEST_CASE("Calendar_BusinessDayCache", "[Calendar]") {
+
+    INFO("Testing cached business days against day-by-day stepping...");
+
+    std::vector<Calendar> calendars = {
+        TARGET(), UnitedKingdom(), UnitedStates(UnitedStates::NYSE),
+        Japan(), JointCalendar(TARGET(), UnitedKingdom()) };
+
+    std::vector<Date> dates = {
+        Date(1,January,1901), Date(15,February,1950), Date(31,May,2003),
+        Date(25,December,2024), Date(1,December,2199) };
+
+    for (auto& calendar : calendars) {
+        for (auto& d : dates) {
+            // forwards and backwards, within the allowed date range
+            Integer n = 0;
+            Date d1 = d;
+            while (n < 500 && d1 < Date(31,December,2199)) {
+                ++d1;
+                if (calendar.isBusinessDay(d1)) {
+                    ++n;
+                    Date calculated = calendar.advance(d, n, Days);
+                    if (calculated != d1)
+                        FAIL_CHECK(calendar.name() << ": advancing " << d
+                                   << " by " << n << " business days:"
+                                   << "\n    calculated: " << calculated
+                                   << "\n    expected:   " << d1);
+                    Date::serial_type days =
+                        calendar.businessDaysBetween(d, d1, false, true);
+                    if (days != n)
+                        FAIL_CHECK(calendar.name() << ": business days "
+                                   << "between " << d << " and " << d1 << ":"
+                                   << "\n    calculated: " << days
+                                   << "\n    expected:   " << n);
+                }
+            }
+            n = 0;
+            d1 = d;
+            while (n < 500 && d1 > Date(1,January,1901)) {
+                --d1;
+                if (calendar.isBusinessDay(d1)) {
+                    ++n;
+                    Date calculated = calendar.advance(d, -n, Days);
+                    if (calculated != d1)
+                        FAIL_CHECK(calendar.name() << ": advancing " << d
+                                   << " by " << -n << " business days:"
+                                   << "\n    calculated: " << calculated
+                                   << "\n    expected:   " << d1);
+                    Date::serial_type days =
+                        calendar.businessDaysBetween(d, d1, false, true);
+                    if (days != -n)
+                        FAIL_CHECK(calendar.name() << ": business days "
+                                   << "between " << d << " and " << d1 << ":"
+                                   << "\n    calculated: " << days
+                                   << "\n    expected:   " << -n);
+                }
+            }
+        }
+    }
+
+    INFO("Testing that cached business days are kept up to date...");
+
+    Calendar target = TARGET(), uk = UnitedKingdom();
+    Calendar joint = JointCalendar(target, uk);
+    Calendar nested = JointCalendar(joint, Japan());
+    Date d(15,March,2023);
+    if (!joint.isBusinessDay(d) || !nested.isBusinessDay(d))
+        FAIL_CHECK(d << " erroneously detected as holiday");
+    target.addHoliday(d);
+    bool stale = joint.isBusinessDay(d);
+    bool staleNested = nested.isBusinessDay(d);
+    target.removeHoliday(d);
+    if (stale || staleNested)
+        FAIL_CHECK(d << " not detected as holiday after being added to "
+                   << target.name());
+    if (!joint.isBusinessDay(d) || !nested.isBusinessDay(d))
+        FAIL_CHECK(d << " not detected as business day after being "
+                   "removed from the holidays of " << target.name());
+
+    // calendars no longer depending on target are not reset
+    {
+        Calendar temporary = JointCalendar(target, Japan());
+        temporary.isBusinessDay(d);
+    }
+    target.addHoliday(d);
+    target.removeHoliday(d);
+
+    INFO("Testing concurrent reads of cached business days...");
+
+    Calendar fresh = JointCalendar(UnitedStates(UnitedStates::NYSE),
+                                   Japan(), JoinBusinessDays);
+    Date start(1,January,2000);
+    Size n = 20*366;
+    std::vector<int> expected(n), calculated(n);
+    for (Size i=0; i<n; ++i)
+        expected[i] = fresh.isBusinessDay(start+Integer(i));
+    fresh = JointCalendar(UnitedStates(UnitedStates::NYSE),
+                          Japan(), JoinBusinessDays);
+    parallelFor(n, 4, [&](Size i) {
+        calculated[i] = fresh.isBusinessDay(start+Integer(i));
+    });
+    for (Size i=0; i<n; ++i) {
+        if (calculated[i] != expected[i])
+            FAIL_CHECK("concurrent read of " << fresh.name()
+                       << " at " << start+Integer(i) << ":"
+                       << "\n    calculated: " << calculated[i]
+                       << "\n    expected:   " << expected[i]);
+    }
+}
+
+
 TEST_CASE("Calendar_BespokeCalendars", "[Calendar]") {
 
     INFO("Testing bespoke calendars...");
@@ -25,6 +25,9 @@
 #include <ql/experimental/credit/randomdefaultlatentmodel.hpp>
 #include <ql/experimental/credit/inhomogeneouspooldef.hpp>
 #include <ql/experimental/credit/homogeneouspooldef.hpp>
+#include <ql/experimental/credit/binomiallossmodel.hpp>
+#include <ql/experimental/credit/recursivelossmodel.hpp>
+#include <ql/experimental/credit/saddlepointlossmodel.hpp>
 
 #include <ql/experimental/credit/gaussianlhplossmodel.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
@@ -86,6 +89,18 @@ namespace {
                            << found << " vs. " << expected);
     }
 
+    // exposes the confidence interval of the expected tranche loss and
+    //   the simulated portfolio losses it is computed from
+    class RandomDefaultLMInspector
+        : public RandomDefaultLM<GaussianCopulaPolicy> {
+      public:
+        using RandomDefaultLM<GaussianCopulaPolicy>::RandomDefaultLM;
+        std::pair<Real, Real> interval(const Date& d) const {
+            return expectedTrancheLossInterval(d, 0.95);
+        }
+        const std::vector<Real>& losses() const { return losses_; }
+    };
+
 }
 
 void testHW(unsigned dataSet) {
@@ -362,3 +377,258 @@ TEST_CASE("Cdo_HW", "[Cdo]") {
     for (unsigned i=0; i < LENGTH(hwData7); ++i)
 	    testHW(i);
 }
+
+TEST_CASE("Cdo_RandomDefaultLMThreads", "[Cdo]") {
+
+    INFO("Testing multi-threaded random default latent model...");
+
+    Date asofDate = Date(31, August, 2006);
+    Settings::instance().evaluationDate() = asofDate;
+
+    Size poolSize = 20;
+    Size numSims = 2000;
+    Real recovery = 0.4;
+
+    std::shared_ptr<Pool> pool (new Pool());
+    vector<string> names;
+    for (Size i=0; i<poolSize; ++i) {
+        ostringstream o;
+        o << "issuer-" << i;
+        names.emplace_back(o.str());
+        Handle<Quote> hazardRate(std::make_shared<SimpleQuote>(
+            0.01 + 0.002*i));
+        vector<pair<DefaultProbKey,
+               Handle<DefaultProbabilityTermStructure> > > probabilities;
+        probabilities.emplace_back(std::make_pair(
+            NorthAmericaCorpDefaultKey(EURCurrency(), SeniorSec,
+                                       Period(0,Weeks), 10.),
+            Handle<DefaultProbabilityTermStructure>(
+                std::make_shared<FlatHazardRate>(asofDate, hazardRate,
+                                                 ActualActual()))));
+        pool->add(names.back(), Issuer(probabilities),
+                  NorthAmericaCorpDefaultKey(EURCurrency(),
+                                             QuantLib::SeniorSec,
+                                             Period(), 1.));
+    }
+    vector<Real> nominals(poolSize, 100.0);
+
+    Handle<Quote> correlation(std::make_shared<SimpleQuote>(0.3));
+    std::shared_ptr<GaussianConstantLossLM> lm(new GaussianConstantLossLM(
+        correlation, std::vector<Real>(poolSize, recovery),
+        LatentModelIntegrationType::GaussianQuadrature, poolSize,
+        GaussianCopulaPolicy::initTraits()));
+
+    std::shared_ptr<RandomDefaultLMInspector> serial(
+        new RandomDefaultLMInspector(lm, numSims));
+    std::shared_ptr<RandomDefaultLMInspector> threaded(
+        new RandomDefaultLMInspector(lm, numSims));
+    threaded->setThreads(3, 300);
+
+    Date d = asofDate + 3*Years;
+    Real attachment[] = { 0.00, 0.03, 0.06, 0.00 };
+    Real detachment[] = { 0.03, 0.06, 1.00, 1.00 };
+    Real trancheLosses[4];
+
+    for (Size j=0; j<LENGTH(attachment); ++j) {
+        std::shared_ptr<Basket> basket(new Basket(asofDate, names, nominals,
+            pool, attachment[j], detachment[j]));
+
+        basket->setLossModel(serial);
+        Real expectedLoss = basket->expectedTrancheLoss(d);
+        Real percentile = basket->percentile(d, 0.99);
+        Real shortfall = basket->expectedShortfall(d, 0.95);
+        Probability atLeastTwo = basket->probAtLeastNEvents(2, d);
+        trancheLosses[j] = expectedLoss;
+
+        // the interval is the one a GeneralStatistics instance gives
+        std::pair<Real, Real> interval = serial->interval(d);
+        GeneralStatistics stats;
+        for (Real loss : serial->losses())
+            stats.add(std::min(std::max(loss - basket->attachmentAmount(),
+                                        0.0),
+                               basket->detachmentAmount()
+                               - basket->attachmentAmount()));
+        Real halfWidth = stats.errorEstimate() *
+            InverseCumulativeNormal::standard_value(0.975);
+        if (std::fabs(interval.first - stats.mean()) >
+                1.0e-12 * std::max(stats.mean(), 1.0) ||
+            std::fabs(interval.second - halfWidth) > 1.0e-10 * halfWidth)
+            FAIL_CHECK("expected loss and its error estimate differ from "
+                       "sample statistics for tranche ["
+                       << attachment[j] << ", " << detachment[j] << "]:"
+                       << std::setprecision(12)
+                       << "\n    calculated: " << interval.first
+                       << " +/- " << interval.second
+                       << "\n    expected:   " << stats.mean()
+                       << " +/- " << halfWidth);
+
+        // Sobol substreams reproduce the serial sequence
+        basket->setLossModel(threaded);
+        Real calculated[] = {
+            basket->expectedTrancheLoss(d),
+            basket->percentile(d, 0.99),
+            basket->expectedShortfall(d, 0.95),
+            basket->probAtLeastNEvents(2, d),
+            threaded->interval(d).second };
+        Real expected[] = { expectedLoss, percentile, shortfall, atLeastTwo,
+                            interval.second };
+        const char* statistic[] = { "expected loss", "99% percentile",
+                                    "95% expected shortfall",
+                                    "probability of two or more defaults",
+                                    "expected loss error estimate" };
+        for (Size k=0; k<LENGTH(expected); ++k) {
+            if (std::fabs(calculated[k] - expected[k]) >
+                1.0e-12 * std::max(std::fabs(expected[k]), 1.0))
+                FAIL_CHECK("multi-threaded " << statistic[k]
+                           << " differs from serial one for tranche ["
+                           << attachment[j] << ", " << detachment[j] << "]:"
+                           << std::setprecision(12)
+                           << "\n    multi-threaded: " << calculated[k]
+                           << "\n    serial:         " << expected[k]);
+        }
+    }
+
+    // tranche losses add up to the portfolio loss
+    Real sum = trancheLosses[0] + trancheLosses[1] + trancheLosses[2];
+    if (std::fabs(sum - trancheLosses[3]) > 1.0e-10 * trancheLosses[3])
+        FAIL_CHECK("expected tranche losses don't add up to "
+                   "the expected portfolio loss:"
+                   << std::setprecision(12)
+                   << "\n    sum of tranches: " << sum
+                   << "\n    portfolio:       " << trancheLosses[3]);
+}
+
+TEST_CASE("Cdo_LatentModelBatchIntegration", "[Cdo]") {
+
+    INFO("Testing batched conditional probabilities and "
+         "multi-threaded latent model integration...");
+
+    Date asofDate = Date(31, August, 2006);
+    Settings::instance().evaluationDate() = asofDate;
+
+    Size poolSize = 30;
+    Real recovery = 0.4;
+
+    // two-factor model with heterogeneous loadings
+    vector<vector<Real> > factorWeights(poolSize, vector<Real>(2));
+    vector<Real> invCumYProbs(poolSize);
+    for (Size i=0; i<poolSize; ++i) {
+        factorWeights[i][0] = 0.2 + 0.015*i;
+        factorWeights[i][1] = 0.3 - 0.008*i;
+    }
+    GaussianConstantLossLM lm2(factorWeights,
+        std::vector<Real>(poolSize, recovery),
+        LatentModelIntegrationType::GaussianQuadrature);
+    for (Size i=0; i<poolSize; ++i)
+        invCumYProbs[i] = lm2.inverseCumulativeY(0.005 + 0.004*i, i);
+
+    vector<vector<Real> > nodes;
+    for (Real m1 = -4.0; m1 <= 4.0; m1 += 1.0)
+        for (Real m2 = -3.0; m2 <= 3.0; m2 += 1.5)
+            nodes.emplace_back(vector<Real>{m1, m2});
+
+    vector<Probability> perNode, nodeMajor;
+    lm2.conditionalDefaultProbabilitiesInvP(invCumYProbs, nodes, nodeMajor);
+    for (Size k=0; k<nodes.size(); ++k) {
+        lm2.conditionalDefaultProbabilitiesInvP(invCumYProbs, nodes[k],
+                                                perNode);
+        for (Size i=0; i<poolSize; ++i) {
+            Probability expected =
+                lm2.conditionalDefaultProbabilityInvP(invCumYProbs[i], i,
+                                                      nodes[k]);
+            // the batch cumulative is computed differently in the tails
+            Real tolerance = expected > 1.0e-8 ? 1.0e-15 : 1.0e-6*expected;
+            if (std::fabs(perNode[i] - expected) > tolerance ||
+                std::fabs(nodeMajor[k*poolSize+i] - expected) > tolerance)
+                FAIL_CHECK("batch conditional default probability differs "
+                           "from single-name one for name " << i
+                           << " at (" << nodes[k][0] << ", " << nodes[k][1]
+                           << "):" << QL_SCIENTIFIC
+                           << "\n    per node:   " << perNode[i]
+                           << "\n    node major: "
+                           << nodeMajor[k*poolSize+i]
+                           << "\n    single:     " << expected);
+        }
+    }
+
+    // tranche losses integrated serially and on several threads
+    std::shared_ptr<Pool> pool (new Pool());
+    vector<string> names;
+    for (Size i=0; i<poolSize; ++i) {
+        ostringstream o;
+        o << "issuer-" << i;
+        names.emplace_back(o.str());
+        Handle<Quote> hazardRate(std::make_shared<SimpleQuote>(
+            0.005 + 0.001*i));
+        vector<pair<DefaultProbKey,
+               Handle<DefaultProbabilityTermStructure> > > probabilities;
+        probabilities.emplace_back(std::make_pair(
+            NorthAmericaCorpDefaultKey(EURCurrency(), SeniorSec,
+                                       Period(0,Weeks), 10.),
+            Handle<DefaultProbabilityTermStructure>(
+                std::make_shared<FlatHazardRate>(asofDate, hazardRate,
+                                                 ActualActual()))));
+        pool->add(names.back(), Issuer(probabilities),
+                  NorthAmericaCorpDefaultKey(EURCurrency(),
+                                             QuantLib::SeniorSec,
+                                             Period(), 1.));
+    }
+    vector<Real> nominals(poolSize, 100.0);
+
+    Handle<Quote> correlation(std::make_shared<SimpleQuote>(0.3));
+    std::shared_ptr<GaussianConstantLossLM> serialLM(
+        new GaussianConstantLossLM(correlation,
+            std::vector<Real>(poolSize, recovery),
+            LatentModelIntegrationType::GaussianQuadrature, poolSize,
+            GaussianCopulaPolicy::initTraits()));
+    std::shared_ptr<GaussianConstantLossLM> threadedLM(
+        new GaussianConstantLossLM(correlation,
+            std::vector<Real>(poolSize, recovery),
+            LatentModelIntegrationType::GaussianQuadrature, poolSize,
+            GaussianCopulaPolicy::initTraits()));
+    threadedLM->setIntegrationThreads(3);
+
+    vector<string> modelNames;
+    vector<std::shared_ptr<DefaultLossModel> > serialModels, threadedModels;
+    modelNames.emplace_back("binomial");
+    serialModels.emplace_back(
+        std::make_shared<GaussianBinomialLossModel>(serialLM));
+    threadedModels.emplace_back(
+        std::make_shared<GaussianBinomialLossModel>(threadedLM));
+    modelNames.emplace_back("recursive");
+    serialModels.emplace_back(
+        std::make_shared<RecursiveGaussLossModel>(serialLM));
+    threadedModels.emplace_back(
+        std::make_shared<RecursiveGaussLossModel>(threadedLM));
+    modelNames.emplace_back("saddle point");
+    serialModels.emplace_back(
+        std::make_shared<SaddlePointLossModel<GaussianCopulaPolicy> >(
+            serialLM));
+    threadedModels.emplace_back(
+        std::make_shared<SaddlePointLossModel<GaussianCopulaPolicy> >(
+            threadedLM));
+
+    Date d = asofDate + 5*Years;
+    Real attachment[] = { 0.00, 0.03, 0.07 };
+    Real detachment[] = { 0.03, 0.07, 0.15 };
+
+    for (Size j=0; j<LENGTH(attachment); ++j) {
+        std::shared_ptr<Basket> basket(new Basket(asofDate, names, nominals,
+            pool, attachment[j], detachment[j]));
+        for (Size im=0; im<modelNames.size(); ++im) {
+            basket->setLossModel(serialModels[im]);
+            Real expected = basket->expectedTrancheLoss(d);
+            basket->setLossModel(threadedModels[im]);
+            Real calculated = basket->expectedTrancheLoss(d);
+            if (std::fabs(calculated - expected) >
+                1.0e-12 * std::max(std::fabs(expected), 1.0))
+                FAIL_CHECK("multi-threaded " << modelNames[im]
+                           << " expected loss differs from serial one "
+                           << "for tranche [" << attachment[j] << ", "
+                           << detachment[j] << "]:"
+                           << std::setprecision(12)
+                           << "\n    multi-threaded: " << calculated
+                           << "\n    serial:         " << expected);
+        }
+    }
+}
@@ -29,6 +29,9 @@
 #include <ql/math/distributions/chisquaredistribution.hpp>
 #include <ql/math/distributions/poissondistribution.hpp>
 #include <ql/math/randomnumbers/stochasticcollocationinvcdf.hpp>
+#include <ql/math/randomnumbers/inversecumulativersg.hpp>
+#include <ql/math/randomnumbers/mt19937uniformrng.hpp>
+#include <ql/math/randomnumbers/randomsequencegenerator.hpp>
 #include <ql/math/comparison.hpp>
 #include <ql/math/functional.hpp>
 
@@ -299,6 +302,90 @@ TEST_CASE("Distribution_Normal", "[Distribution]") {
     }
 }
 
+TEST_CASE("Distribution_NormalBatch", "[Distribution]") {
+
+    INFO("Testing batch normal distributions...");
+
+    CumulativeNormalDistribution cum(average,sigma);
+    InverseCumulativeNormal invCum(average,sigma);
+
+    // enough points to span several chunks of the batch versions
+    Size N = 1001;
+    std::vector<Real> x(N), y(N), z(N);
+    for (Size i=0; i<N; ++i)
+        x[i] = average + (-30.0 + 60.0*i/(N-1))*sigma;
+
+    cum(&x[0], &y[0], N);
+    for (Size i=0; i<N; ++i) {
+        Real expected = cum(x[i]);
+        // the single-point version switches to an asymptotic
+        // expansion in the far left tail
+        Real tolerance = expected > 1.0e-8 ? 1.0e-15 : 1.0e-6*expected;
+        if (std::fabs(y[i] - expected) > tolerance)
+            FAIL_CHECK("batch cumulative normal differs from "
+                       "single-point one at " << x[i] << ":"
+                       << QL_SCIENTIFIC
+                       << "\n    batch:  " << y[i]
+                       << "\n    single: " << expected);
+    }
+
+    for (Size i=0; i<N; ++i)
+        y[i] = Real(i+1)/(N+1);
+    y[0] = 1.0e-12;
+    y[N-1] = 1.0 - 1.0e-12;
+    // the rational approximation loses a few digits in double
+    // precision near the tails; its own error is about 1e-9 anyway
+    invCum(&y[0], &z[0], N);
+    for (Size i=0; i<N; ++i) {
+        Real expected = invCum(y[i]);
+        if (std::fabs(z[i] - expected) > 1.0e-12*std::fabs(expected))
+            FAIL_CHECK("batch inverse cumulative normal differs from "
+                       "single-point one at " << y[i] << ":"
+                       << QL_SCIENTIFIC
+                       << "\n    batch:  " << z[i]
+                       << "\n    single: " << expected);
+    }
+
+    invCum(&y[0], &y[0], N);
+    for (Size i=0; i<N; ++i) {
+        if (y[i] != z[i])
+            FAIL_CHECK("in-place batch inverse cumulative normal differs "
+                       "from out-of-place one:"
+                       << QL_SCIENTIFIC
+                       << "\n    in place:     " << y[i]
+                       << "\n    out of place: " << z[i]);
+    }
+
+    // sequence generators use the batch version for blocks of
+    // samples only; single samples are unchanged
+    typedef RandomSequenceGenerator<MersenneTwisterUniformRng> usg_type;
+    usg_type usg(100, 42), usg2(100, 42), usg3(100, 42);
+    InverseCumulativeRsg<usg_type, InverseCumulativeNormal> rsg(usg),
+                                                            rsg3(usg3);
+    std::vector<Real> block(10*100);
+    rsg3.nextSequences(10, &block[0]);
+    for (Size k=0; k<10; ++k) {
+        const std::vector<Real>& u = usg2.nextSequence().value;
+        const std::vector<Real>& g = rsg.nextSequence().value;
+        for (Size i=0; i<u.size(); ++i) {
+            Real expected = InverseCumulativeNormal::standard_value(u[i]);
+            if (g[i] != expected)
+                FAIL_CHECK("inverse-cumulative sequence generator differs "
+                           "from single-point inverse cumulative:"
+                           << QL_SCIENTIFIC
+                           << "\n    generator: " << g[i]
+                           << "\n    single:    " << expected);
+            if (std::fabs(block[k*100+i] - expected)
+                                            > 1.0e-12*std::fabs(expected))
+                FAIL_CHECK("block of inverse-cumulative samples differs "
+                           "from single-point inverse cumulative:"
+                           << QL_SCIENTIFIC
+                           << "\n    block:  " << block[k*100+i]
+                           << "\n    single: " << expected);
+        }
+    }
+}
+
 TEST_CASE("Distribution_Bivariate", "[Distribution]") {
 
     INFO("Testing bivariate cumulative normal distribution...");
@@ -1558,3 +1558,153 @@ TEST_CASE("EuropeanOption_AnalyticEngineDiscountCurve", "[EuropeanOption]") {
     npvMultiCurve = option.NPV();
     CHECK(npvSingleCurve != npvMultiCurve);
 }
+
+TEST_CASE("EuropeanOption_MultiThreadedMcEngines", "[EuropeanOption]") {
+    INFO("Testing multi-threaded Monte Carlo European engines...");
+
+    SavedSettings backup;
+
+    DayCounter dc = Actual360();
+    Date today = Date::todaysDate();
+
+    std::shared_ptr<SimpleQuote> spot(new SimpleQuote(100.0));
+    std::shared_ptr<YieldTermStructure> qTS = flatRate(today, 0.02, dc);
+    std::shared_ptr<YieldTermStructure> rTS = flatRate(today, 0.05, dc);
+    std::shared_ptr<BlackVolTermStructure> volTS = flatVol(today, 0.25, dc);
+    std::shared_ptr<BlackScholesMertonProcess> stochProcess(new
+        BlackScholesMertonProcess(Handle<Quote>(spot),
+                                  Handle<YieldTermStructure>(qTS),
+                                  Handle<YieldTermStructure>(rTS),
+                                  Handle<BlackVolTermStructure>(volTS)));
+
+    std::shared_ptr<StrikedTypePayoff> payoff(new
+        PlainVanillaPayoff(Option::Put, 105.0));
+    std::shared_ptr<Exercise> exercise(
+                          new EuropeanExercise(today + Period(1, Years)));
+    EuropeanOption option(payoff, exercise);
+
+    option.setPricingEngine(std::shared_ptr<PricingEngine>(
+                             new AnalyticEuropeanEngine(stochProcess)));
+    Real expected = option.NPV();
+
+    const Size samples = 10000;
+    Real pseudoNPV = Null<Real>();
+    for (Size threads = 1; threads <= 4; ++threads) {
+        option.setPricingEngine(
+            MakeMCEuropeanEngine<PseudoRandom>(stochProcess)
+            .withSteps(10)
+            .withAntitheticVariate()
+            .withSamples(samples)
+            .withSeed(42)
+            .withThreads(threads));
+        Real calculated = option.NPV();
+        if (pseudoNPV == Null<Real>())
+            pseudoNPV = calculated;
+        if (calculated != pseudoNPV)
+            FAIL_CHECK("pseudo-random result depends on the number of threads:"
+                       << std::setprecision(16)
+                       << "\n    threads:    " << threads
+                       << "\n    calculated: " << calculated
+                       << "\n    expected:   " << pseudoNPV);
+        if (std::fabs(calculated - expected) > 4.0*option.errorEstimate())
+            FAIL_CHECK("pseudo-random result out of tolerance:"
+                       << "\n    threads:    " << threads
+                       << "\n    calculated: " << calculated
+                       << "\n    expected:   " << expected
+                       << "\n    error:      " << option.errorEstimate());
+    }
+
+    // low-discrepancy chunks continue the serial sequence
+    option.setPricingEngine(
+        MakeMCEuropeanEngine<LowDiscrepancy>(stochProcess)
+        .withSteps(10)
+        .withSamples(4095));
+    Real serialNPV = option.NPV();
+    for (Size threads = 1; threads <= 4; ++threads) {
+        option.setPricingEngine(
+            MakeMCEuropeanEngine<LowDiscrepancy>(stochProcess)
+            .withSteps(10)
+            .withSamples(4095)
+            .withThreads(threads));
+        Real calculated = option.NPV();
+        if (std::fabs(calculated - serialNPV) > 1.0e-12)
+            FAIL_CHECK("low-discrepancy result differs from serial one:"
+                       << std::setprecision(16)
+                       << "\n    threads:    " << threads
+                       << "\n    calculated: " << calculated
+                       << "\n    expected:   " << serialNPV);
+    }
+}
+
+TEST_CASE("EuropeanOption_BlockMcEngine", "[EuropeanOption]") {
+    INFO("Testing block Monte Carlo European engine...");
+
+    SavedSettings backup;
+
+    DayCounter dc = Actual360();
+    Date today = Date::todaysDate();
+
+    std::shared_ptr<SimpleQuote> spot(new SimpleQuote(100.0));
+    std::shared_ptr<YieldTermStructure> qTS = flatRate(today, 0.02, dc);
+    std::shared_ptr<YieldTermStructure> rTS = flatRate(today, 0.05, dc);
+    std::shared_ptr<BlackVolTermStructure> volTS = flatVol(today, 0.25, dc);
+    std::shared_ptr<BlackScholesMertonProcess> stochProcess(new
+        BlackScholesMertonProcess(Handle<Quote>(spot),
+                                  Handle<YieldTermStructure>(qTS),
+                                  Handle<YieldTermStructure>(rTS),
+                                  Handle<BlackVolTermStructure>(volTS)));
+
+    std::shared_ptr<StrikedTypePayoff> payoff(new
+        PlainVanillaPayoff(Option::Put, 105.0));
+    std::shared_ptr<Exercise> exercise(
+                          new EuropeanExercise(today + Period(1, Years)));
+    EuropeanOption option(payoff, exercise);
+
+    option.setPricingEngine(
+        MakeMCEuropeanEngine<PseudoRandom>(stochProcess)
+        .withSteps(10)
+        .withAntitheticVariate()
+        .withSamples(5000)
+        .withSeed(42));
+    Real expected = option.NPV();
+
+    // the block size doesn't divide the number of samples
+    option.setPricingEngine(
+        MakeMCEuropeanEngine<PseudoRandom>(stochProcess)
+        .withSteps(10)
+        .withAntitheticVariate()
+        .withSamples(5000)
+        .withSeed(42)
+        .withBlockSize(128));
+    Real calculated = option.NPV();
+    if (std::fabs(calculated - expected) > 1.0e-12)
+        FAIL_CHECK("block result differs from path-by-path one:"
+                   << std::setprecision(16)
+                   << "\n    calculated: " << calculated
+                   << "\n    expected:   " << expected);
+
+    option.setPricingEngine(
+        MakeMCEuropeanEngine<PseudoRandom>(stochProcess)
+        .withSteps(10)
+        .withAntitheticVariate()
+        .withSamples(5000)
+        .withSeed(42)
+        .withThreads(2));
+    expected = option.NPV();
+
+    option.setPricingEngine(
+        MakeMCEuropeanEngine<PseudoRandom>(stochProcess)
+        .withSteps(10)
+        .withAntitheticVariate()
+        .withSamples(5000)
+        .withSeed(42)
+        .withThreads(2)
+        .withBlockSize(100));
+    calculated = option.NPV();
+    if (std::fabs(calculated - expected) > 1.0e-12)
+        FAIL_CHECK("multi-threaded block result differs "
+                   "from path-by-path one:"
+                   << std::setprecision(16)
+                   << "\n    calculated: " << calculated
+                   << "\n    expected:   " << expected);
+}
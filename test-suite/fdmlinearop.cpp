@@ -36,6 +36,7 @@
 #include <ql/math/randomnumbers/rngtraits.hpp>
 #include <ql/models/equity/hestonmodel.hpp>
 #include <ql/termstructures/yield/zerocurve.hpp>
+#include <ql/termstructures/volatility/equityfx/localconstantvol.hpp>
 #include <ql/pricingengines/vanilla/analyticeuropeanengine.hpp>
 #include <ql/pricingengines/vanilla/mchestonhullwhiteengine.hpp>
 #include <ql/methods/finitedifferences/finitedifferencemodel.hpp>
@@ -51,6 +52,8 @@
 #include <ql/methods/finitedifferences/solvers/fdmbackwardsolver.hpp>
 #include <ql/methods/finitedifferences/operators/fdmblackscholesop.hpp>
 #include <ql/methods/finitedifferences/utilities/fdmmesherintegral.hpp>
+#include <ql/methods/finitedifferences/utilities/fdmsettings.hpp>
+#include <ql/methods/finitedifferences/utilities/fdmcoefficientcache.hpp>
 #include <ql/methods/finitedifferences/utilities/fdminnervaluecalculator.hpp>
 #include <ql/methods/finitedifferences/operators/fdmlinearop.hpp>
 #include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
@@ -59,6 +62,7 @@
 #include <ql/methods/finitedifferences/meshers/fdmhestonvariancemesher.hpp>
 #include <ql/methods/finitedifferences/operators/fdmhestonop.hpp>
 #include <ql/methods/finitedifferences/solvers/fdmhestonsolver.hpp>
+#include <ql/methods/finitedifferences/solvers/fdmblackscholessolver.hpp>
 #include <ql/methods/finitedifferences/meshers/fdmmeshercomposite.hpp>
 #include <ql/methods/finitedifferences/solvers/fdmndimsolver.hpp>
 #include <ql/methods/finitedifferences/solvers/fdm3dimsolver.hpp>
@@ -208,6 +212,76 @@ TEST_CASE("FdmLinearOp_FdmLinearOpLayout", "[FdmLinearOp]") {
     }
 }
 
+TEST_CASE("FdmLinearOp_FdmLinearOpLayoutIndexTables", "[FdmLinearOp]") {
+
+    INFO("Testing index tables of a linear operator layout...");
+
+    Size dims[] = {5, 7, 8};
+    const std::vector<Size> dim(dims, dims + LENGTH(dims));
+
+    FdmLinearOpLayout layout = FdmLinearOpLayout(dim);
+    const FdmLinearOpIterator endIter = layout.end();
+
+    for (Size i = 0; i < dim.size(); ++i) {
+        for (Integer offset = -2; offset <= 2; ++offset) {
+            std::shared_ptr<const std::vector<Size> > table =
+                layout.neighbourhoods(i, offset);
+            if (table != layout.neighbourhoods(i, offset))
+                FAIL_CHECK("neighbourhood table for direction " << i
+                           << " and offset " << offset
+                           << " is not shared");
+            for (FdmLinearOpIterator iter = layout.begin();
+                 iter != endIter; ++iter) {
+                Size expected = layout.neighbourhood(iter, i, offset);
+                if ((*table)[iter.index()] != expected)
+                    FAIL("neighbourhood table entry is "
+                         << (*table)[iter.index()]
+                         << " but should be " << expected);
+            }
+        }
+
+        for (Size j = 0; j < dim.size(); ++j) {
+            if (i == j)
+                continue;
+            for (Integer o1 = -1; o1 <= 1; o1 += 2) {
+                for (Integer o2 = -1; o2 <= 1; o2 += 2) {
+                    std::shared_ptr<const std::vector<Size> > table =
+                        layout.neighbourhoods(i, o1, j, o2);
+                    for (FdmLinearOpIterator iter = layout.begin();
+                         iter != endIter; ++iter) {
+                        Size expected =
+                            layout.neighbourhood(iter, i, o1, j, o2);
+                        if ((*table)[iter.index()] != expected)
+                            FAIL("mixed neighbourhood table entry is "
+                                 << (*table)[iter.index()]
+                                 << " but should be " << expected);
+                    }
+                }
+            }
+        }
+
+        // the reverse index lists the points line by line along i
+        const std::vector<Size>& reverseIndex = *layout.reverseIndex(i);
+        std::vector<bool> visited(layout.size(), false);
+        for (Size k = 0; k < reverseIndex.size(); ++k) {
+            const Size index = reverseIndex[k];
+            if (visited[index])
+                FAIL("point " << index << " appears twice in the "
+                     "reverse index for direction " << i);
+            visited[index] = true;
+            if (k % dim[i] != 0
+                && index != reverseIndex[k-1] + layout.spacing()[i])
+                FAIL("reverse index for direction " << i
+                     << " does not follow the direction at position " << k);
+        }
+    }
+
+    // copies of a layout share its tables
+    FdmLinearOpLayout copy(layout);
+    if (copy.neighbourhoods(1, 1) != layout.neighbourhoods(1, 1))
+        FAIL_CHECK("neighbourhood table not shared by layout copy");
+}
+
 TEST_CASE("FdmLinearOp_UniformGridMesher", "[FdmLinearOp]") {
 
     INFO("Testing uniform grid mesher...");
@@ -734,6 +808,356 @@ TEST_CASE("FdmLinearOp_TripleBandMapSolve", "[FdmLinearOp]") {
     }
 }
 
+TEST_CASE("FdmLinearOp_ParallelSplittingSolve", "[FdmLinearOp]") {
+
+    INFO("Testing multi-threaded triple-band map solution...");
+
+    // large enough for the lines to be split in several tasks
+    Size dims[] = {41, 33, 30};
+    const std::vector<Size> dim(dims, dims + LENGTH(dims));
+
+    std::shared_ptr < FdmLinearOpLayout > layout(new FdmLinearOpLayout(dim));
+
+    std::vector<std::pair<Real, Real> > boundaries(
+        3, std::pair < Real, Real > (0, 1.0));
+
+    std::shared_ptr < FdmMesher > mesher(
+            new UniformGridMesher(layout, boundaries));
+
+    Array u(layout->size());
+    for (Size i = 0; i < layout->size(); ++i)
+        u[i] = std::sin(0.1 * i) + std::cos(0.35 * i);
+
+    const Size threads = FdmSettings::instance().threads();
+    const Size minParallelSize = FdmSettings::instance().minParallelSize();
+    FdmSettings::instance().minParallelSize() = 0;
+
+    for (Size direction = 0; direction < dim.size(); ++direction) {
+        SecondDerivativeOp op(direction, mesher);
+        op.axpyb(Array(1, 0.5), op, FirstDerivativeOp(direction, mesher),
+                 Array(1, 1.0));
+
+        const Array r = op.apply(u);
+
+        FdmSettings::instance().threads() = 1;
+        const Array serial = op.solve_splitting(r, 1.0, 0.0);
+        FdmSettings::instance().threads() = 4;
+        const Array parallel = op.solve_splitting(r, 1.0, 0.0);
+        FdmSettings::instance().threads() = threads;
+
+        if (serial != parallel)
+            FAIL_CHECK("results depend on the number of threads"
+                       << "\n    direction: " << direction);
+
+        for (Size i = 0; i < u.size(); ++i) {
+            if (std::fabs(u[i] - serial[i]) > 1e-6) {
+                FAIL("solve and apply are not consistent "
+                             << "\n direction     : " << direction
+                             << "\n expected      : " << u[i]
+                             << "\n calculated    : " << serial[i]);
+            }
+        }
+    }
+
+    FdmSettings::instance().minParallelSize() = minParallelSize;
+}
+
+TEST_CASE("FdmLinearOp_InPlaceOperators", "[FdmLinearOp]") {
+
+    INFO("Testing in-place application and solution of operators...");
+
+    SavedSettings backup;
+
+    Size dims[] = {40, 30};
+    const std::vector<Size> dim(dims, dims + LENGTH(dims));
+
+    std::shared_ptr < FdmLinearOpLayout > layout(new FdmLinearOpLayout(dim));
+
+    std::vector<std::pair<Real, Real> > boundaries;
+    boundaries.emplace_back(std::pair < Real, Real > (3.8, 4.905274778));
+    boundaries.emplace_back(std::pair < Real, Real > (0.000, 1.0));
+
+    std::shared_ptr < FdmMesher > mesher(
+            new UniformGridMesher(layout, boundaries));
+
+    Handle<Quote> s0(std::shared_ptr < Quote > (new SimpleQuote(100.0)));
+    Handle<YieldTermStructure> rTS(flatRate(0.05, Actual365Fixed()));
+    Handle<YieldTermStructure> qTS(flatRate(0.02, Actual365Fixed()));
+
+    std::shared_ptr < FdmLinearOpComposite > hestonOp(
+            new FdmHestonOp(mesher, std::make_shared<HestonProcess>(
+                rTS, qTS, s0, 0.04, 2.5, 0.04, 0.66, -0.8)));
+    std::shared_ptr < FdmLinearOpComposite > bsOp(
+            new FdmBlackScholesOp(mesher,
+                std::make_shared<BlackScholesMertonProcess>(
+                    s0, qTS, rTS, Handle<BlackVolTermStructure>(
+                        flatVol(0.2, Actual365Fixed()))),
+                100.0));
+
+    Array u(layout->size());
+    for (Size i = 0; i < layout->size(); ++i)
+        u[i] = std::sin(0.1 * i) + std::cos(0.35 * i);
+
+    // the results must be the same whatever the initial content
+    // and size of the array receiving them
+    auto check = [&](const std::string& name,
+                     const Array& expected,
+                     const std::function<void(Array&)>& inPlace) {
+        Array sized(u.size(), 42.0), empty;
+        inPlace(sized);
+        inPlace(empty);
+        if (sized != expected || empty != expected)
+            FAIL_CHECK("in-place " << name << " differs from "
+                       "the result returned by value");
+    };
+
+    const std::shared_ptr<FdmLinearOpComposite> ops[] = { hestonOp, bsOp };
+    for (const auto& op : ops) {
+        op->setTime(0.5, 0.6);
+
+        check("apply", op->apply(u),
+              [&](Array& r) { op->apply(u, r); });
+        check("apply_mixed", op->apply_mixed(u),
+              [&](Array& r) { op->apply_mixed(u, r); });
+        for (Size d = 0; d < op->size(); ++d) {
+            check("apply_direction", op->apply_direction(d, u),
+                  [&](Array& r) { op->apply_direction(d, u, r); });
+            check("solve_splitting", op->solve_splitting(d, u, -0.05),
+                  [&](Array& r) { op->solve_splitting(d, u, -0.05, r); });
+        }
+    }
+}
+
+TEST_CASE("FdmLinearOp_CoefficientCache", "[FdmLinearOp]") {
+
+    INFO("Testing cached time-dependent operator coefficients...");
+
+    SavedSettings backup;
+
+    Size dims[] = {40, 30};
+    const std::vector<Size> dim(dims, dims + LENGTH(dims));
+
+    std::shared_ptr < FdmLinearOpLayout > layout(new FdmLinearOpLayout(dim));
+
+    std::vector<std::pair<Real, Real> > boundaries;
+    boundaries.emplace_back(std::pair < Real, Real > (3.8, 4.905274778));
+    boundaries.emplace_back(std::pair < Real, Real > (0.000, 1.0));
+
+    std::shared_ptr < FdmMesher > mesher(
+            new UniformGridMesher(layout, boundaries));
+
+    Handle<Quote> s0(std::shared_ptr < Quote > (new SimpleQuote(100.0)));
+    Handle<YieldTermStructure> rTS(flatRate(0.05, Actual365Fixed()));
+    Handle<YieldTermStructure> qTS(flatRate(0.02, Actual365Fixed()));
+
+    const std::shared_ptr<HestonProcess> hestonProcess(
+        std::make_shared<HestonProcess>(
+            rTS, qTS, s0, 0.04, 2.5, 0.04, 0.66, -0.8));
+    const std::shared_ptr<LocalVolTermStructure> leverageFct(
+        std::make_shared<LocalConstantVol>(
+            Settings::instance().evaluationDate(), 0.8,
+            Actual365Fixed()));
+    const std::shared_ptr<BlackScholesMertonProcess> bsProcess(
+        std::make_shared<BlackScholesMertonProcess>(
+            s0, qTS, rTS, Handle<BlackVolTermStructure>(
+                flatVol(0.2, Actual365Fixed()))));
+
+    const Size entries = 5;
+    const Size budget = 3*3*layout->size()*sizeof(Real);
+
+    const std::shared_ptr<FdmCoefficientCache> hestonCache(
+        std::make_shared<FdmCoefficientCache>(mesher, QL_MAX_INTEGER));
+    const std::shared_ptr<FdmCoefficientCache> bsCache(
+        std::make_shared<FdmCoefficientCache>(mesher, budget));
+
+    auto hestonOp = [&](const std::shared_ptr<FdmCoefficientCache>& c) {
+        return std::make_shared<FdmHestonOp>(
+            mesher, hestonProcess, std::shared_ptr<FdmQuantoHelper>(),
+            leverageFct, c);
+    };
+    auto bsOp = [&](const std::shared_ptr<FdmCoefficientCache>& c) {
+        return std::make_shared<FdmBlackScholesOp>(
+            mesher, bsProcess, 100.0, true, -Null<Real>(), 0, c);
+    };
+
+    Array u(layout->size());
+    for (Size i = 0; i < layout->size(); ++i)
+        u[i] = std::sin(0.1 * i) + std::cos(0.35 * i);
+
+    // the second operator of each pair is built afresh and only
+    // reads the coefficients stored by the first one
+    const std::shared_ptr<FdmLinearOpComposite> ops[][3] = {
+        { hestonOp(nullptr), hestonOp(hestonCache), hestonOp(hestonCache) },
+        { bsOp(nullptr), bsOp(bsCache), bsOp(bsCache) }
+    };
+    for (const auto& op : ops) {
+        for (Size pass = 0; pass < 2; ++pass) {
+            for (Size k = entries; k > 0; --k) {
+                const Time t1 = 0.2*(k-1), t2 = 0.2*k;
+                for (const auto& o : op)
+                    o->setTime(t1, t2);
+
+                const Array expected = op[0]->apply(u);
+                for (Size j = 1; j < 3; ++j) {
+                    if (op[j]->apply(u) != expected)
+                        FAIL_CHECK("cached operator differs from "
+                                   "uncached one at t=" << t1);
+                    for (Size d = 0; d < op[0]->size(); ++d)
+                        if (op[j]->solve_splitting(d, u, -0.05)
+                            != op[0]->solve_splitting(d, u, -0.05))
+                            FAIL_CHECK("cached splitting solve differs "
+                                       "from uncached one at t=" << t1);
+                }
+            }
+        }
+    }
+
+    if (hestonCache->size() != entries)
+        FAIL_CHECK("unexpected number of cached Heston coefficients"
+                   << "\n    calculated: " << hestonCache->size()
+                   << "\n    expected:   " << entries);
+    if (bsCache->size() != 3 || bsCache->memoryUsage() != budget)
+        FAIL_CHECK("memory budget not respected"
+                   << "\n    entries:      " << bsCache->size()
+                   << "\n    memory usage: " << bsCache->memoryUsage()
+                   << "\n    budget:       " << budget);
+
+    bsCache->clear();
+    if (bsCache->size() != 0 || bsCache->memoryUsage() != 0)
+        FAIL_CHECK("coefficient cache not cleared");
+
+    // the entries of a Black-Scholes operator don't fit a Heston one
+    bool failed = false;
+    try {
+        hestonOp(bsCache);
+    } catch (Error&) {
+        failed = true;
+    }
+    if (!failed)
+        FAIL_CHECK("coefficient cache shared by different operators");
+
+    // the Heston coefficients depend on the variance process, but
+    // not on the correlation
+    auto hestonOpWith = [&](Real kappa, Real rho,
+                            const std::shared_ptr<FdmCoefficientCache>& c) {
+        return std::make_shared<FdmHestonOp>(
+            mesher, std::make_shared<HestonProcess>(
+                        rTS, qTS, s0, 0.04, kappa, 0.04, 0.66, rho),
+            std::shared_ptr<FdmQuantoHelper>(), leverageFct, c);
+    };
+    const std::shared_ptr<FdmCoefficientCache> parameterCache(
+        std::make_shared<FdmCoefficientCache>(mesher, QL_MAX_INTEGER));
+    hestonOpWith(2.5, -0.8, parameterCache);
+    hestonOpWith(2.5, -0.5, parameterCache);
+    failed = false;
+    try {
+        hestonOpWith(3.0, -0.8, parameterCache);
+    } catch (Error&) {
+        failed = true;
+    }
+    if (!failed)
+        FAIL_CHECK("coefficient cache shared by Heston operators with "
+                   "different mean-reversion speeds");
+}
+
+TEST_CASE("FdmLinearOp_CoefficientCacheInvalidation", "[FdmLinearOp]") {
+
+    INFO("Testing invalidation of cached operator coefficients...");
+
+    SavedSettings backup;
+
+    const Date today(28, March, 2020);
+    Settings::instance().evaluationDate() = today;
+    const DayCounter dc = Actual365Fixed();
+
+    const std::shared_ptr<SimpleQuote> spot(
+        std::make_shared<SimpleQuote>(100.0));
+    const std::shared_ptr<SimpleQuote> rate(
+        std::make_shared<SimpleQuote>(0.05));
+    const std::shared_ptr<BlackScholesMertonProcess> process(
+        std::make_shared<BlackScholesMertonProcess>(
+            Handle<Quote>(spot),
+            Handle<YieldTermStructure>(flatRate(today, 0.02, dc)),
+            Handle<YieldTermStructure>(flatRate(today, rate, dc)),
+            Handle<BlackVolTermStructure>(flatVol(today, 0.2, dc))));
+
+    const Real strike = 100.0;
+    const Date maturityDate = today + Period(1, Years);
+    const Time maturity = dc.yearFraction(today, maturityDate);
+
+    const std::shared_ptr<FdmMesher> mesher(
+        std::make_shared<FdmMesherComposite>(
+            std::make_shared<FdmBlackScholesMesher>(
+                100, process, maturity, strike)));
+    const std::shared_ptr<FdmInnerValueCalculator> calculator(
+        std::make_shared<FdmLogInnerValue>(
+            std::make_shared<PlainVanillaPayoff>(Option::Call, strike),
+            mesher, 0));
+    const FdmSolverDesc solverDesc = {
+        mesher, FdmBoundaryConditionSet(),
+        FdmStepConditionComposite::vanillaComposite(
+            DividendSchedule(),
+            std::make_shared<EuropeanExercise>(maturityDate),
+            mesher, calculator, today, dc),
+        calculator, maturity, 50, 0 };
+
+    const std::shared_ptr<FdmCoefficientCache> cache(
+        std::make_shared<FdmCoefficientCache>(mesher, QL_MAX_INTEGER));
+    const Handle<GeneralizedBlackScholesProcess> processHandle(process);
+    const FdmBlackScholesSolver cached(
+        processHandle, strike, solverDesc, FdmSchemeDesc::Douglas(),
+        false, -Null<Real>(), cache);
+    const FdmBlackScholesSolver uncached(processHandle, strike, solverDesc);
+
+    const Real tol = 1e-12;
+    const Real before = cached.valueAt(spot->value());
+    if (std::fabs(before - uncached.valueAt(spot->value())) > tol)
+        FAIL_CHECK("cached solver differs from uncached one"
+                   << "\n    cached:   " << before
+                   << "\n    uncached: " << uncached.valueAt(spot->value()));
+    if (cache->size() == 0)
+        FAIL_CHECK("no coefficients cached");
+
+    // the cached coefficients depend on the rate
+    rate->setValue(0.07);
+    if (cache->size() != 0)
+        FAIL_CHECK("coefficient cache not cleared after rate change");
+
+    const Real after = cached.valueAt(spot->value());
+    const Real expected = uncached.valueAt(spot->value());
+    if (std::fabs(after - expected) > tol || std::fabs(after - before) < 0.1)
+        FAIL_CHECK("cached solver not updated after rate change"
+                   << "\n    before:   " << before
+                   << "\n    after:    " << after
+                   << "\n    expected: " << expected);
+
+    INFO("Testing operators sharing a coefficient cache...");
+
+    // the Black volatility depends on the strike
+    const std::shared_ptr<FdmCoefficientCache> shared(
+        std::make_shared<FdmCoefficientCache>(mesher, QL_MAX_INTEGER));
+    FdmBlackScholesOp op(mesher, process, strike, false,
+                         -Null<Real>(), 0, shared);
+    bool failed = false;
+    try {
+        FdmBlackScholesOp other(mesher, process, 1.1*strike, false,
+                                -Null<Real>(), 0, shared);
+    } catch (Error&) {
+        failed = true;
+    }
+    if (!failed)
+        FAIL_CHECK("coefficient cache shared by operators with "
+                   "different strikes");
+
+    // with local volatility, it doesn't
+    const std::shared_ptr<FdmCoefficientCache> localVolCache(
+        std::make_shared<FdmCoefficientCache>(mesher, QL_MAX_INTEGER));
+    FdmBlackScholesOp localVolOp(mesher, process, strike, true,
+                                 -Null<Real>(), 0, localVolCache);
+    FdmBlackScholesOp otherLocalVolOp(mesher, process, 1.1*strike, true,
+                                      -Null<Real>(), 0, localVolCache);
+}
+
 TEST_CASE("FdmLinearOp_FdmHestonBarrier", "[FdmLinearOp]") {
 
     INFO("Testing FDM with barrier option in Heston model...");
@@ -26,6 +26,7 @@
 #include <ql/math/distributions/chisquaredistribution.hpp>
 #include <ql/math/integrals/gaussianquadratures.hpp>
 #include <ql/experimental/math/gaussiannoncentralchisquaredpolynomial.hpp>
+#include <ql/experimental/math/multidimquadrature.hpp>
 
 
 using namespace QuantLib;
@@ -232,3 +233,28 @@ TEST_CASE("GaussianQuadratures_NonCentralChiSquaredSumOfNotes", "[GaussianQuadra
     }
 }
 
+TEST_CASE("GaussianQuadratures_MultidimVector", "[GaussianQuadratures]") {
+    INFO("Testing multi-dimensional Gauss-Hermite quadrature "
+         "of vector functions...");
+
+    // Gaussian moments over the plane; the rule is exact for these
+    // since they are polynomials times the Hermite weight
+    GaussianQuadMultidimIntegrator quad(2, 10);
+    std::function<std::vector<Real>(const std::vector<Real>&)> f =
+        [](const std::vector<Real>& x) {
+            Real g = std::exp(-x[0]*x[0] - x[1]*x[1]);
+            return std::vector<Real>{ g, g*x[0]*x[0], g*x[0]*x[0]*x[1]*x[1] };
+        };
+    std::vector<Real> calculated = quad(f);
+    std::vector<Real> expected = { M_PI, M_PI/2.0, M_PI/4.0 };
+
+    REQUIRE(calculated.size() == expected.size());
+    for (Size i=0; i<expected.size(); ++i) {
+        if (std::fabs(calculated[i] - expected[i]) > 1.0e-12)
+            FAIL_CHECK("failed to reproduce component " << i
+                       << " of vector integral:"
+                       << std::setprecision(12)
+                       << "\n    calculated: " << calculated[i]
+                       << "\n    expected:   " << expected[i]);
+    }
+}
@@ -293,6 +293,69 @@ TEST_CASE("HestonModel_DAXCalibration", "[HestonModel]") {
     }
 }
 
+TEST_CASE("HestonModel_ConcurrentDAXCalibration", "[HestonModel]") {
+
+    INFO("Testing concurrent Heston model calibration "
+         "using DAX volatility data...");
+
+    SavedSettings backup;
+
+    Date settlementDate(5, July, 2002);
+    Settings::instance().evaluationDate() = settlementDate;
+
+    CalibrationMarketData marketData = getDAXCalibrationMarketData();
+
+    const std::vector<std::shared_ptr<CalibrationHelper> > options
+            = marketData.options;
+
+    const std::shared_ptr<HestonProcess> process(
+            std::make_shared<HestonProcess>(
+                    marketData.riskFreeTS, marketData.dividendYield,
+                    marketData.s0, 0.1, 1.0, 0.1, 0.5, -0.5));
+
+    const std::shared_ptr<HestonModel> model(
+            std::make_shared<HestonModel>(process));
+
+    const std::shared_ptr<PricingEngine> engine =
+            std::make_shared<AnalyticHestonEngine>(model, 64);
+    for (Size i = 0; i < options.size(); ++i)
+        options[i]->setPricingEngine(engine);
+
+    const Array params = model->params();
+    const EndCriteria endCriteria(400, 40, 1.0e-8, 1.0e-8, 1.0e-8);
+
+    LevenbergMarquardt om(1e-8, 1e-8, 1e-8);
+    model->calibrate(options, om, endCriteria);
+    const Array expected = model->params();
+
+    const Size threads[] = { 1, 3, 4, 200 };
+    for (Size j = 0; j < LENGTH(threads); ++j) {
+        model->setParams(params);
+        LevenbergMarquardt om(1e-8, 1e-8, 1e-8);
+        model->calibrate(options, om, endCriteria, threads[j],
+                         [&]() -> std::shared_ptr<PricingEngine> {
+                             return std::make_shared<AnalyticHestonEngine>(
+                                 model, 64);
+                         });
+        const Array calculated = model->params();
+
+        for (Size k = 0; k < expected.size(); ++k) {
+            if (calculated[k] != expected[k])
+                FAIL_CHECK("failed to reproduce serial calibration"
+                           << "\n    threads:    " << threads[j]
+                           << "\n    parameter:  " << k
+                           << QL_SCIENTIFIC
+                           << "\n    calculated: " << calculated[k]
+                           << "\n    expected:   " << expected[k]);
+        }
+        for (Size i = 0; i < options.size(); ++i) {
+            if (options[i]->pricingEngine() != engine)
+                FAIL_CHECK("pricing engine of calibration helper #" << i
+                           << " not restored after calibration");
+        }
+    }
+}
+
 TEST_CASE("HestonModel_AnalyticVsBlack", "[HestonModel]") {
     INFO("Testing analytic Heston engine against Black formula...");
 
@@ -1055,6 +1118,99 @@ TEST_CASE("HestonModel_MultipleStrikesEngine", "[HestonModel]") {
 }
 
 
+TEST_CASE("HestonModel_CachedCharacteristicFunction", "[HestonModel]") {
+    INFO("Testing analytic Heston engine reusing the characteristic "
+         "function across strikes...");
+
+    SavedSettings backup;
+
+    Date settlementDate(27, December, 2004);
+    Settings::instance().evaluationDate() = settlementDate;
+
+    DayCounter dayCounter = ActualActual();
+
+    Handle<YieldTermStructure> riskFreeTS(flatRate(0.06, dayCounter));
+    Handle<YieldTermStructure> dividendTS(flatRate(0.02, dayCounter));
+
+    Handle<Quote> s0(std::shared_ptr < Quote > (new SimpleQuote(1.05)));
+
+    std::shared_ptr < HestonProcess > process(new HestonProcess(
+            riskFreeTS, dividendTS, s0, 0.16, 2.5, 0.09, 0.8, -0.8));
+    std::shared_ptr < HestonModel > model(new HestonModel(process));
+
+    const AnalyticHestonEngine::ComplexLogFormula cpxLogs[] = {
+            AnalyticHestonEngine::Gatheral,
+            AnalyticHestonEngine::BranchCorrection
+    };
+    const AnalyticHestonEngine::Integration integrations[] = {
+            AnalyticHestonEngine::Integration::gaussLaguerre(64),
+            AnalyticHestonEngine::Integration::gaussLegendre(128)
+    };
+    const Period maturities[] = { 3 * Months, 1 * Years, 5 * Years };
+    const Real strikes[] = { 0.5, 0.9, 1.05, 1.2, 2.0 };
+    const Option::Type types[] = { Option::Call, Option::Put };
+
+    const Array params = model->params();
+    for (Size i = 0; i < LENGTH(cpxLogs); ++i) {
+        for (Size j = 0; j < LENGTH(integrations); ++j) {
+            std::shared_ptr < PricingEngine > engine(
+                    new AnalyticHestonEngine(model, cpxLogs[i],
+                                             integrations[j]));
+            model->setParams(params);
+            for (Size n = 0; n < 2; ++n) {
+                // the maturities are visited by strike, as in a
+                // calibration, and the options priced again after
+                // the model parameters changed
+                if (n == 1) {
+                    Array newParams = params;
+                    newParams[0] *= 1.1;
+                    newParams[2] *= 0.9;
+                    model->setParams(newParams);
+                }
+                for (Size k = 0; k < LENGTH(strikes); ++k) {
+                    for (Size m = 0; m < LENGTH(maturities); ++m) {
+                        const Date exerciseDate =
+                                settlementDate + maturities[m];
+                        for (Size l = 0; l < LENGTH(types); ++l) {
+                            const std::shared_ptr<PlainVanillaPayoff>
+                                    payoff(new PlainVanillaPayoff(
+                                            types[l], strikes[k]));
+                            VanillaOption option(
+                                payoff,
+                                std::shared_ptr<Exercise>(
+                                    new EuropeanExercise(exerciseDate)));
+                            option.setPricingEngine(engine);
+                            const Real calculated = option.NPV();
+
+                            Real expected;
+                            Size evaluations;
+                            AnalyticHestonEngine::doCalculation(
+                                riskFreeTS->discount(exerciseDate),
+                                dividendTS->discount(exerciseDate),
+                                s0->value(), strikes[k],
+                                process->time(exerciseDate),
+                                model->kappa(), model->theta(),
+                                model->sigma(), model->v0(),
+                                model->rho(), *payoff, integrations[j],
+                                cpxLogs[i], nullptr, expected,
+                                evaluations);
+
+                            if (calculated != expected)
+                                FAIL_CHECK(
+                                    "failed to reproduce Heston price "
+                                    "with cached characteristic function"
+                                    << "\n    maturity:   " << exerciseDate
+                                    << "\n    strike:     " << strikes[k]
+                                    << "\n    calculated: " << calculated
+                                    << "\n    expected:   " << expected);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
 TEST_CASE("HestonModel_AnalyticPiecewiseTimeDependent", "[HestonModel]") {
     INFO("Testing analytic piecewise time dependent Heston prices...");
 
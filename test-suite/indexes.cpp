@@ -0,0 +1,61 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include "utilities.hpp"
+#include <ql/indexes/indexmanager.hpp>
+#include <algorithm>
+
+using namespace QuantLib;
+
+
+TEST_CASE("Indexes_MissingHistory", "[Indexes]") {
+
+    INFO("Testing that reading a missing index history doesn't store it...");
+
+    IndexHistoryCleaner cleaner;
+
+    IndexManager& manager = IndexManager::instance();
+    const std::string name = "Test Index";
+
+    const TimeSeries<Real>& missing = manager.getHistory(name);
+    if (!missing.empty())
+        FAIL_CHECK("non-empty history returned for missing index");
+    if (manager.hasHistory(name))
+        FAIL_CHECK("history stored after reading a missing index");
+    std::vector<std::string> names = manager.histories();
+    if (std::find(names.begin(), names.end(), "TEST INDEX") != names.end())
+        FAIL_CHECK("missing index listed among stored histories");
+
+    // observers registered before the history is stored are notified
+    Flag flag;
+    flag.registerWith(manager.notifier(name));
+    manager.getHistory(name);
+
+    Date d(15, March, 2021);
+    TimeSeries<Real> history;
+    history[d] = 0.01;
+    manager.setHistory(name, history);
+
+    if (!flag.isUp())
+        FAIL_CHECK("observer not notified of stored history");
+
+    Real fixing = manager.getHistory("TEST INDEX")[d];
+    if (fixing != 0.01)
+        FAIL_CHECK("wrong stored fixing:"
+                   << "\n    calculated: " << fixing
+                   << "\n    expected:   " << 0.01);
+}
@@ -21,9 +21,18 @@
 #include <ql/instruments/stock.hpp>
 #include <ql/instruments/compositeinstrument.hpp>
 #include <ql/instruments/europeanoption.hpp>
+#include <ql/instruments/portfoliovaluation.hpp>
+#include <ql/instruments/makevanillaswap.hpp>
+#include <ql/cashflows/couponpricer.hpp>
+#include <ql/indexes/ibor/euribor.hpp>
+#include <ql/pricingengines/swap/discountingswapengine.hpp>
 #include <ql/pricingengines/vanilla/analyticeuropeanengine.hpp>
 #include <ql/quotes/simplequote.hpp>
+#include <ql/termstructures/yield/flatforward.hpp>
 #include <ql/time/daycounters/actual360.hpp>
+#include <mutex>
+#include <set>
+#include <thread>
 
 using namespace QuantLib;
 
@@ -112,3 +121,141 @@ TEST_CASE("Instrument_CompositeWhenShiftingDates", "[Instrument]") {
     if (composite.NPV() == 0.0)
         FAIL("Composite didn't recalculate");
 }
+
+
+TEST_CASE("Instrument_PortfolioValuation", "[Instrument]") {
+
+    INFO("Testing multi-threaded valuation of a portfolio...");
+
+    SavedSettings backup;
+
+    Date today = Date::todaysDate();
+    DayCounter dc = Actual360();
+
+    shared_ptr<SimpleQuote> spot(new SimpleQuote(100.0));
+    shared_ptr<FlatForward> qTS(new FlatForward(today, 0.02, dc));
+    shared_ptr<FlatForward> rTS(new FlatForward(today, 0.05, dc));
+    shared_ptr<BlackVolTermStructure> volTS = flatVol(today, 0.2, dc);
+
+    shared_ptr<BlackScholesMertonProcess> process(
+        new BlackScholesMertonProcess(Handle<Quote>(spot),
+                                      Handle<YieldTermStructure>(qTS),
+                                      Handle<YieldTermStructure>(rTS),
+                                      Handle<BlackVolTermStructure>(volTS)));
+    shared_ptr<PricingEngine> engine(new AnalyticEuropeanEngine(process));
+
+    std::vector<shared_ptr<Instrument> > options, others;
+    for (Size i=0; i<500; ++i) {
+        shared_ptr<StrikedTypePayoff> payoff(
+            new PlainVanillaPayoff(i % 2 == 0 ? Option::Call : Option::Put,
+                                   60.0 + 0.2*i));
+        // some of the options are expired
+        shared_ptr<Exercise> exercise(
+                          new EuropeanExercise(today + Integer(i) - 10));
+        shared_ptr<Instrument> option(new EuropeanOption(payoff, exercise));
+        option->setPricingEngine(engine);
+        (i % 50 == 0 ? others : options).push_back(option);
+    }
+
+    PortfolioValuation portfolio(4, 16);
+    portfolio.addDependency(qTS);
+    portfolio.addDependency(rTS);
+    portfolio.add(options, [&process]() {
+        return shared_ptr<PricingEngine>(new AnalyticEuropeanEngine(process));
+    });
+    portfolio.add(others);
+
+    std::vector<Real> calculated = portfolio.NPV();
+
+    if (calculated.size() != options.size() + others.size())
+        FAIL("wrong number of results: " << calculated.size()
+             << " instead of " << options.size() + others.size());
+
+    for (Size i=0; i<calculated.size(); ++i) {
+        const shared_ptr<Instrument>& instrument =
+            i < options.size() ? options[i] : others[i-options.size()];
+        Real expected = instrument->NPV();
+        if (std::fabs(calculated[i] - expected) > 1.0e-12)
+            FAIL_CHECK("instrument " << i << ":"
+                       << std::setprecision(12)
+                       << "\n    calculated: " << calculated[i]
+                       << "\n    expected:   " << expected);
+    }
+}
+
+
+namespace {
+
+    // records the threads on which it is used
+    class ThreadRecordingPricer : public BlackIborCouponPricer {
+      public:
+        void initialize(const FloatingRateCoupon& coupon) {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                threads_.insert(std::this_thread::get_id());
+            }
+            BlackIborCouponPricer::initialize(coupon);
+        }
+        std::set<std::thread::id> threads() const {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return threads_;
+        }
+      private:
+        mutable std::mutex mutex_;
+        std::set<std::thread::id> threads_;
+    };
+
+}
+
+TEST_CASE("Instrument_PortfolioValuationWithSharedPricers", "[Instrument]") {
+
+    INFO("Testing multi-threaded valuation of swaps sharing "
+         "coupon pricers...");
+
+    SavedSettings backup;
+
+    Date today = Settings::instance().evaluationDate();
+    Handle<YieldTermStructure> curve(
+        std::make_shared<FlatForward>(today, 0.03, Actual360()));
+    const std::shared_ptr<IborIndex> index =
+        std::make_shared<Euribor6M>(curve);
+
+    const std::shared_ptr<ThreadRecordingPricer> sharedPricer =
+        std::make_shared<ThreadRecordingPricer>();
+
+    // half the swaps share a pricer; the others have their own
+    std::vector<shared_ptr<Instrument> > swaps;
+    for (Size i=0; i<200; ++i) {
+        std::shared_ptr<VanillaSwap> swap =
+            MakeVanillaSwap(Period(1 + i % 10, Years), index,
+                            0.02 + 0.0001*i);
+        if (i % 2 == 1)
+            setCouponPricer(swap->floatingLeg(), sharedPricer);
+        swaps.push_back(swap);
+    }
+
+    PortfolioValuation portfolio(4, 8);
+    portfolio.add(swaps, [&curve]() {
+        return shared_ptr<PricingEngine>(new DiscountingSwapEngine(curve));
+    });
+
+    std::vector<Real> calculated = portfolio.NPV();
+
+    std::set<std::thread::id> threads = sharedPricer->threads();
+    if (threads.size() != 1
+        || *threads.begin() != std::this_thread::get_id())
+        FAIL_CHECK("shared coupon pricer used on "
+                   << threads.size() << " thread(s), "
+                   << (threads.count(std::this_thread::get_id()) != 0 ?
+                       "including" : "excluding")
+                   << " the calling thread");
+
+    for (Size i=0; i<swaps.size(); ++i) {
+        Real expected = swaps[i]->NPV();
+        if (std::fabs(calculated[i] - expected) > 1.0e-10)
+            FAIL_CHECK("swap " << i << ":"
+                       << std::setprecision(12)
+                       << "\n    calculated: " << calculated[i]
+                       << "\n    expected:   " << expected);
+    }
+}
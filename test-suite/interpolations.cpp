@@ -34,6 +34,7 @@
 #include <ql/math/interpolations/kernelinterpolation.hpp>
 #include <ql/math/interpolations/kernelinterpolation2d.hpp>
 #include <ql/math/interpolations/lagrangeinterpolation.hpp>
+#include <ql/math/interpolations/loginterpolation.hpp>
 #include <ql/math/integrals/simpsonintegral.hpp>
 #include <ql/math/kernelfunctions.hpp>
 #include <ql/math/functional.hpp>
@@ -2132,3 +2133,50 @@ TEST_CASE("Interpolation_LagrangeInterpolationOnChebyshevPoints", "[Interpolatio
         }
     }
 }
+
+namespace {
+
+    template <class I>
+    void testPartialUpdate(const std::string& name) {
+        const Size n = 12;
+        std::vector<Real> x(n), y(n), z(n);
+        for (Size i=0; i<n; ++i) {
+            x[i] = 0.5*i + 0.1*i*i;
+            y[i] = z[i] = 1.0 + 0.3*std::sin(Real(i));
+        }
+
+        Interpolation partial = I().interpolate(x.begin(), x.end(),
+                                                y.begin());
+        for (Size from=0; from<n; ++from) {
+            // change the values from the given index on, as an
+            // iterative bootstrap does
+            for (Size i=from; i<n; ++i)
+                y[i] = z[i] = y[i] + 0.01*(i+1);
+            partial.updateFrom(from);
+            Interpolation full = I().interpolate(x.begin(), x.end(),
+                                                 z.begin());
+
+            for (Real t=x[0]; t<=x[n-1]; t+=0.05) {
+                Real calculated = partial(t), expected = full(t);
+                if (calculated != expected)
+                    FAIL_CHECK(name << " interpolation updated from "
+                               << io::ordinal(from+1) << " value:"
+                               << "\n    x:          " << t
+                               << "\n    calculated: " << calculated
+                               << "\n    expected:   " << expected);
+            }
+        }
+    }
+
+}
+
+TEST_CASE("Interpolation_PartialUpdate", "[Interpolation]") {
+    INFO("Testing update of local interpolations "
+         "from a given point...");
+
+    testPartialUpdate<Linear>("linear");
+    testPartialUpdate<LogLinear>("log-linear");
+    testPartialUpdate<BackwardFlat>("backward-flat");
+    testPartialUpdate<ForwardFlat>("forward-flat");
+    testPartialUpdate<Cubic>("cubic");
+}
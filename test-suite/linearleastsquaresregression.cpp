@@ -22,6 +22,7 @@
 #include <ql/math/functional.hpp>
 #include <ql/math/randomnumbers/rngtraits.hpp>
 #include <ql/math/linearleastsquaresregression.hpp>
+#include <ql/math/incrementallinearleastsquares.hpp>
 #include <functional>
 #include "circular_buffer.hpp"
 
@@ -239,3 +240,77 @@ TEST_CASE("LinearLeastSquaresRegression_1dLinearRegression", "[LinearLeastSquare
         }
     }    
 }
+
+TEST_CASE("LinearLeastSquaresRegression_IncrementalRegression", "[LinearLeastSquaresRegression]") {
+
+    INFO("Testing incremental linear least-squares regression...");
+
+    const Size nr=1000;
+    PseudoRandom::rng_type rng(PseudoRandom::urng_type(1234u));
+
+    std::vector<std::function<Real(Real)> > v;
+    v.emplace_back(constant(1.0));
+    v.emplace_back(identity);
+    v.emplace_back(square);
+    v.emplace_back([](Real x){return std::sin(x);});
+
+    // the last regressor is redundant
+    std::vector<std::function<Real(Real)> > w(v);
+    w.emplace_back([](Real x){return 2.0*x*x - 1.0;});
+
+    std::vector<Real> x(nr), y(nr);
+    for (Size i=0; i<nr; ++i) {
+        x[i] = 10.0*rng.next().value;
+        y[i] = 1.0 + 2.0*x[i] - 0.5*x[i]*x[i] + 3.0*std::sin(x[i])
+            + rng.next().value;
+    }
+
+    for (const auto& basis : {v, w}) {
+        const Size m = basis.size();
+        GeneralLinearLeastSquares expected(x, y, basis);
+
+        // accumulated in separate chunks and merged
+        std::vector<IncrementalLinearLeastSquares> chunks(
+            3, IncrementalLinearLeastSquares(m));
+        Array row(m);
+        for (Size i=0; i<nr; ++i) {
+            for (Size l=0; l<m; ++l)
+                row[l] = basis[l](x[i]);
+            chunks[i % 3].add(row, y[i]);
+        }
+        chunks[0].merge(chunks[1]);
+        chunks[0].merge(chunks[2]);
+        const IncrementalLinearLeastSquares& calculated = chunks[0];
+
+        if (calculated.size() != nr)
+            FAIL_CHECK("wrong number of observations"
+                       << "\n    calculated: " << calculated.size()
+                       << "\n    expected:   " << nr);
+
+        // coefficients are not unique for the redundant basis,
+        // but fitted values are
+        const Array a = calculated.coefficients();
+        Real rss = 0.0;
+        for (Size i=0; i<nr; ++i) {
+            Real fitted = 0.0, expectedFitted = 0.0;
+            for (Size l=0; l<m; ++l) {
+                fitted += a[l]*basis[l](x[i]);
+                expectedFitted += expected.coefficients()[l]*basis[l](x[i]);
+            }
+            rss += (y[i]-fitted)*(y[i]-fitted);
+            if (std::fabs(fitted - expectedFitted) > 1.0e-10)
+                FAIL_CHECK("Failed to reproduce fitted value at " << x[i]
+                           << " with " << m << " regressors"
+                           << QL_SCIENTIFIC
+                           << "\n    calculated: " << fitted
+                           << "\n    expected:   " << expectedFitted);
+        }
+        if (std::fabs(calculated.residualSumOfSquares() - rss) > 1.0e-10*rss)
+            FAIL_CHECK("Failed to reproduce residual sum of squares"
+                       << " with " << m << " regressors"
+                       << QL_SCIENTIFIC
+                       << "\n    calculated: "
+                       << calculated.residualSumOfSquares()
+                       << "\n    expected:   " << rss);
+    }
+}
@@ -29,6 +29,7 @@
 #include <ql/math/randomnumbers/randomizedlds.hpp>
 #include <ql/math/randomnumbers/randomsequencegenerator.hpp>
 #include <ql/math/randomnumbers/sobolrsg.hpp>
+#include <ql/math/randomnumbers/rngtraits.hpp>
 #include <ql/utilities/dataformatters.hpp>
 #include <ql/math/randomnumbers/latticerules.hpp>
 #include <ql/math/randomnumbers/latticersg.hpp>
@@ -1091,3 +1092,88 @@ TEST_CASE("LowDiscrepancy_SobolSkipping", "[LowDiscrepancy]") {
       }
     }
 }
+
+TEST_CASE("LowDiscrepancy_SobolBlocks", "[LowDiscrepancy]") {
+
+    INFO("Testing Sobol sequence blocks and substreams...");
+
+    unsigned long seed = 42;
+    Size dimensionality[] = { 1, 10, 100 };
+    SobolRsg::DirectionIntegers integers[] = { SobolRsg::Unit,
+                                               SobolRsg::Jaeckel,
+                                               SobolRsg::JoeKuoD7 };
+    Size first = 7, samples = 1000;
+
+    for (Size i=0; i<LENGTH(integers); i++) {
+      for (Size j=0; j<LENGTH(dimensionality); j++) {
+        Size d = dimensionality[j];
+
+        SobolRsg rsg1(d, seed, integers[i]);
+        SobolRsg rsg2(d, seed, integers[i]);
+        // a substream taken before drawing starts at the same point
+        SobolRsg rsg3 = rsg2.substream(first);
+        for (Size l=0; l<first; l++) {
+            rsg1.nextInt32Sequence();
+            rsg2.nextInt32Sequence();
+        }
+
+        std::vector<unsigned long> block(samples*d);
+        std::vector<unsigned long> block3(samples*d);
+        rsg2.nextInt32Sequences(samples, &block[0]);
+        rsg3.nextInt32Sequences(samples, &block3[0]);
+        for (Size m=0; m<samples; m++) {
+            std::vector<unsigned long> s1 = rsg1.nextInt32Sequence();
+            for (Size n=0; n<d; n++) {
+                if (s1[n] != block[m*d+n] || s1[n] != block3[m*d+n])
+                    FAIL_CHECK("Mismatch in block of draws:"
+                               << "\n  size:      " << d
+                               << "\n  integers:  " << integers[i]
+                               << "\n  draw:      " << first+m
+                               << "\n  at index:  " << n
+                               << "\n  expected:  " << s1[n]
+                               << "\n  found:     " << block[m*d+n]
+                               << "\n  substream: " << block3[m*d+n]);
+            }
+        }
+
+        // single draws continue after the block
+        const std::vector<Real>& s1 = rsg1.nextSequence().value;
+        std::vector<Real> s2(d);
+        rsg2.nextSequences(1, &s2[0]);
+        for (Size n=0; n<d; n++) {
+            if (s1[n] != s2[n])
+                FAIL_CHECK("Mismatch after block of draws:"
+                           << "\n  size:     " << d
+                           << "\n  integers: " << integers[i]
+                           << "\n  at index: " << n
+                           << "\n  expected: " << s1[n]
+                           << "\n  found:    " << s2[n]);
+        }
+      }
+    }
+
+    // contiguous blocks of Gaussian draws for different workers
+    typedef LowDiscrepancy::rsg_type rsg_type;
+    Size d = 10, workers = 4;
+    rsg_type serial = LowDiscrepancy::make_sequence_generator(d, seed);
+    for (Size k=0; k<workers; k++) {
+        rsg_type worker =
+            LowDiscrepancy::make_sequence_generator(d, seed, k*samples);
+        std::vector<Real> block(samples*d);
+        worker.nextSequences(samples, &block[0]);
+        for (Size m=0; m<samples; m++) {
+            const std::vector<Real>& s = serial.nextSequence().value;
+            for (Size n=0; n<d; n++) {
+                // the batch inverse cumulative normal might differ
+                // in the last bits between sample sizes
+                if (std::fabs(s[n] - block[m*d+n]) > 1.0e-12)
+                    FAIL_CHECK("Mismatch in Gaussian block of draws:"
+                               << "\n  worker:   " << k
+                               << "\n  draw:     " << m
+                               << "\n  at index: " << n
+                               << "\n  expected: " << s[n]
+                               << "\n  found:    " << block[m*d+n]);
+            }
+        }
+    }
+}
@@ -365,6 +365,42 @@ TEST_CASE("Matrices_Inverse", "[Matrices]") {
     }
 }
 
+TEST_CASE("Matrices_InverseWithNegativeRowMaxima", "[Matrices]") {
+
+    INFO("Testing LU inverse and determinant of rows "
+         "whose largest elements are negative...");
+
+    Real tol = 1.0e-12;
+
+    Matrix A(3, 3, 0.0);
+    A[0][0] = -2.0;
+    A[1][1] = -3.0;
+    A[2][0] = 0.5;   A[2][1] = -1.0;  A[2][2] = -4.0;
+
+    // A is lower triangular, so its inverse is known in closed form
+    Matrix expected(3, 3, 0.0);
+    expected[0][0] = -0.5;
+    expected[1][1] = -1.0/3.0;
+    expected[2][0] = -0.0625;  expected[2][1] = 1.0/12.0;
+    expected[2][2] = -0.25;
+
+    const Matrix invA = inverse(A);
+    for (Size i=0; i < 3; ++i) {
+        for (Size j=0; j < 3; ++j) {
+            if (!(std::fabs(invA[i][j] - expected[i][j]) <= tol))
+                FAIL_CHECK("inverse failed at (" << i << ", " << j << "):"
+                           << "\n    calculated: " << invA[i][j]
+                           << "\n    expected:   " << expected[i][j]);
+        }
+    }
+
+    const Real det = determinant(A);
+    if (!(std::fabs(det + 24.0) <= tol))
+        FAIL_CHECK("determinant failed:"
+                   << "\n    calculated: " << det
+                   << "\n    expected:   " << -24.0);
+}
+
 TEST_CASE("Matrices_Determinant", "[Matrices]") {
 
     INFO("Testing LU determinant calculation...");
@@ -600,3 +636,85 @@ TEST_CASE("Matrices_MoorePenroseInverse", "[Matrices]") {
     }
 
 }
+
+TEST_CASE("Matrices_Multiplication", "[Matrices]") {
+
+    INFO("Testing matrix products...");
+
+    // sizes are chosen so that the blocks used in the product
+    // don't divide them evenly
+    const Size rows = 150, inner = 300, columns = 270;
+
+    MersenneTwisterUniformRng rng(1234);
+    Matrix A(rows, inner), B(inner, columns);
+    for (Matrix::iterator i = A.begin(); i != A.end(); ++i)
+        *i = rng.next().value - 0.5;
+    for (Matrix::iterator i = B.begin(); i != B.end(); ++i)
+        *i = rng.next().value - 0.5;
+    Array x(inner), y(rows);
+    for (Size i=0; i<inner; ++i)
+        x[i] = rng.next().value;
+    for (Size i=0; i<rows; ++i)
+        y[i] = rng.next().value;
+
+    const Real tol = 1.0e-12;
+
+    Matrix C = A*B;
+    if (C.rows() != rows || C.columns() != columns)
+        FAIL("wrong size of product: "
+             << C.rows() << "x" << C.columns() << " instead of "
+             << rows << "x" << columns);
+    Real error = 0.0;
+    for (Size i=0; i<rows; ++i) {
+        for (Size j=0; j<columns; ++j) {
+            Real expected = 0.0;
+            for (Size k=0; k<inner; ++k)
+                expected += A[i][k]*B[k][j];
+            error = std::max(error, std::fabs(C[i][j]-expected));
+        }
+    }
+    if (error > tol)
+        FAIL_CHECK("matrix-matrix product failed:"
+                   << "\n    max error: " << error);
+
+    Array Ax = A*x;
+    Array yA = y*A;
+    Real errorAx = 0.0, erroryA = 0.0;
+    for (Size i=0; i<rows; ++i) {
+        Real expected = 0.0;
+        for (Size k=0; k<inner; ++k)
+            expected += A[i][k]*x[k];
+        errorAx = std::max(errorAx, std::fabs(Ax[i]-expected));
+    }
+    for (Size k=0; k<inner; ++k) {
+        Real expected = 0.0;
+        for (Size i=0; i<rows; ++i)
+            expected += y[i]*A[i][k];
+        erroryA = std::max(erroryA, std::fabs(yA[k]-expected));
+    }
+    if (errorAx > tol)
+        FAIL_CHECK("matrix-vector product failed:"
+                   << "\n    max error: " << errorAx);
+    if (erroryA > tol)
+        FAIL_CHECK("vector-matrix product failed:"
+                   << "\n    max error: " << erroryA);
+
+    Matrix At = transpose(A);
+    for (Size i=0; i<rows; ++i)
+        for (Size k=0; k<inner; ++k)
+            if (At[k][i] != A[i][k])
+                FAIL("transpose failed at (" << i << ", " << k << ")");
+
+    Matrix D = 2.0*(A*B) - C;
+    Matrix E = C - (A*B)/2.0;
+    Real errorD = 0.0, errorE = 0.0;
+    for (Size i=0; i<rows; ++i) {
+        for (Size j=0; j<columns; ++j) {
+            errorD = std::max(errorD, std::fabs(D[i][j]-C[i][j]));
+            errorE = std::max(errorE, std::fabs(E[i][j]-0.5*C[i][j]));
+        }
+    }
+    if (errorD > tol || errorE > tol)
+        FAIL_CHECK("algebra on temporary matrices failed:"
+                   << "\n    max errors: " << errorD << ", " << errorE);
+}
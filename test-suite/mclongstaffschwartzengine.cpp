@@ -25,10 +25,13 @@
 #include <ql/termstructures/volatility/equityfx/blackconstantvol.hpp>
 #include <ql/processes/stochasticprocessarray.hpp>
 #include <ql/methods/montecarlo/lsmbasissystem.hpp>
+#include <ql/methods/montecarlo/multipathgenerator.hpp>
+#include <ql/experimental/mcbasket/longstaffschwartzmultipathpricer.hpp>
 #include <ql/pricingengines/mclongstaffschwartzengine.hpp>
 #include <ql/pricingengines/vanilla/fdamericanengine.hpp>
 #include <ql/pricingengines/vanilla/mcamericanengine.hpp>
 #include <ql/time/calendars/nullcalendar.hpp>
+#include <ql/math/randomnumbers/rngtraits.hpp>
 
 using namespace QuantLib;
 
@@ -118,6 +121,37 @@ namespace {
         }
     };
 
+    // Bermudan max call paying a fixed coupon on each fixing date
+    class MaxCallWithCouponPayoff : public PathPayoff {
+      public:
+        MaxCallWithCouponPayoff(Real strike, Real coupon)
+        : strike_(strike), coupon_(coupon) {}
+
+        std::string name() const { return "MaxCallWithCoupon"; }
+        std::string description() const { return name(); }
+
+        void value(const Matrix& path,
+                   const std::vector<Handle<YieldTermStructure> >&,
+                   Array& payments,
+                   Array& exercises,
+                   std::vector<Array>& states) const {
+            for (Size i=0; i<path.columns(); ++i) {
+                payments[i] = coupon_;
+                if (i > 0) {
+                    states[i] = Array(path.column_begin(i),
+                                      path.column_end(i));
+                    exercises[i] = std::max(*std::max_element(
+                        states[i].begin(), states[i].end()) - strike_, 0.0);
+                }
+            }
+        }
+
+        Size basisSystemDimension() const { return 2; }
+
+      private:
+        Real strike_, coupon_;
+    };
+
 }
 
 
@@ -313,3 +347,133 @@ TEST_CASE("MCLongstaffSchwartzEngine_AmericanMaxOption", "[MCLongstaffSchwartzEn
         }
     }
 }
+
+TEST_CASE("MCLongstaffSchwartzEngine_LeanCalibration", "[MCLongstaffSchwartzEngine]") {
+
+    INFO("Testing Longstaff-Schwartz calibration on regression data...");
+
+    SavedSettings backup;
+
+    const Date today(15, May, 1998);
+    Settings::instance().evaluationDate() = today;
+    const DayCounter dayCounter = Actual365Fixed();
+
+    Handle<YieldTermStructure> riskFreeTS(
+        std::shared_ptr<YieldTermStructure>(
+            new FlatForward(today, 0.05, dayCounter)));
+    Handle<YieldTermStructure> dividendTS(
+        std::shared_ptr<YieldTermStructure>(
+            new FlatForward(today, 0.10, dayCounter)));
+    Handle<BlackVolTermStructure> volTS(
+        std::shared_ptr<BlackVolTermStructure>(
+            new BlackConstantVol(today, NullCalendar(), 0.20, dayCounter)));
+    Handle<Quote> underlying(
+        std::shared_ptr<Quote>(new SimpleQuote(100.0)));
+    std::shared_ptr<GeneralizedBlackScholesProcess> process(
+        new GeneralizedBlackScholesProcess(underlying, dividendTS,
+                                           riskFreeTS, volTS));
+
+    // the regressions are solved differently, so that the results
+    // might only differ by round-off unless exercise decisions flip
+    const Real tolerance = 1.0e-8;
+
+    // single-asset engine
+    VanillaOption americanOption(
+        std::make_shared<PlainVanillaPayoff>(Option::Put, 104.0),
+        std::make_shared<AmericanExercise>(today, Date(17, May, 1999)));
+
+    std::vector<Real> prices;
+    for (Size threads : {0, 1, 3}) {
+        americanOption.setPricingEngine(
+            MakeMCAmericanEngine<PseudoRandom>(process)
+            .withSteps(50)
+            .withAntitheticVariate()
+            .withSamples(4096)
+            .withSeed(42)
+            .withPolynomOrder(3)
+            .withLeanCalibration(threads));
+        prices.push_back(americanOption.NPV());
+    }
+    if (std::fabs(prices[1] - prices[0]) > tolerance*prices[0]
+        || prices[2] != prices[1])
+        FAIL_CHECK("lean calibration of American option failed:"
+                   << std::setprecision(12)
+                   << "\n    stored paths:         " << prices[0]
+                   << "\n    lean, single thread:  " << prices[1]
+                   << "\n    lean, three threads:  " << prices[2]);
+
+    // multi-asset engine
+    std::vector<std::shared_ptr<StochasticProcess1D> > processes(2, process);
+    Matrix correlation(2, 2, 0.0);
+    correlation[0][0] = correlation[1][1] = 1.0;
+    std::shared_ptr<StochasticProcessArray> processArray(
+        new StochasticProcessArray(processes, correlation));
+
+    VanillaOption americanMaxOption(
+        std::make_shared<PlainVanillaPayoff>(Option::Call, 100.0),
+        std::make_shared<AmericanExercise>(today, Date(16, May, 2001)));
+
+    prices.clear();
+    for (Size threads : {0, 1, 3}) {
+        std::shared_ptr<MCAmericanMaxEngine<PseudoRandom> > engine(
+            new MCAmericanMaxEngine<PseudoRandom>(processArray, 25,
+                                                  Null<Size>(), false,
+                                                  true, false, 4096,
+                                                  Null<Real>(), Null<Size>(),
+                                                  42, 1024));
+        // small shards so that they actually get distributed
+        engine->setLeanCalibration(threads, 100);
+        americanMaxOption.setPricingEngine(engine);
+        prices.push_back(americanMaxOption.NPV());
+    }
+    if (std::fabs(prices[1] - prices[0]) > tolerance*prices[0]
+        || prices[2] != prices[1])
+        FAIL_CHECK("lean calibration of American max option failed:"
+                   << std::setprecision(12)
+                   << "\n    stored paths:         " << prices[0]
+                   << "\n    lean, single thread:  " << prices[1]
+                   << "\n    lean, three threads:  " << prices[2]);
+
+    // path pricer for path-dependent payoffs
+    const std::vector<Time> fixingTimes = {0.25, 0.5, 0.75, 1.0};
+    const TimeGrid grid(fixingTimes.begin(), fixingTimes.end(), 20);
+    std::vector<Size> timePositions;
+    std::vector<Handle<YieldTermStructure> > forwardTermStructures;
+    Array discounts(fixingTimes.size());
+    for (Size i=0; i<fixingTimes.size(); ++i) {
+        timePositions.push_back(grid.index(fixingTimes[i]));
+        forwardTermStructures.push_back(riskFreeTS);
+        discounts[i] = riskFreeTS->discount(fixingTimes[i]);
+    }
+    std::shared_ptr<PathPayoff> pathPayoff =
+        std::make_shared<MaxCallWithCouponPayoff>(100.0, 0.5);
+
+    typedef MultiPathGenerator<PseudoRandom::rsg_type> generator_type;
+    prices.clear();
+    for (Size threads : {0, 1, 3}) {
+        LongstaffSchwartzMultiPathPricer pricer(
+            pathPayoff, timePositions, forwardTermStructures, discounts,
+            2, LsmBasisSystem::Monomial);
+        if (threads != 0)
+            pricer.setLeanCalibration(threads, 100);
+
+        generator_type generator(processArray, grid,
+                                 PseudoRandom::make_sequence_generator(
+                                     2*(grid.size()-1), 42));
+        for (Size j=0; j<2048; ++j)
+            pricer(generator.next().value);
+        pricer.calibrate();
+
+        Real sum = 0.0;
+        for (Size j=0; j<1024; ++j)
+            sum += pricer(generator.next().value);
+        prices.push_back(sum/1024);
+    }
+    if (std::fabs(prices[1] - prices[0]) > tolerance*prices[0]
+        || prices[2] != prices[1])
+        FAIL_CHECK("lean calibration of path-dependent payoff failed:"
+                   << std::setprecision(12)
+                   << "\n    stored paths:         " << prices[0]
+                   << "\n    lean, single thread:  " << prices[1]
+                   << "\n    lean, three threads:  " << prices[2]);
+}
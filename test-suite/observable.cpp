@@ -18,6 +18,7 @@
 */
 
 #include "utilities.hpp"
+#include <ql/patterns/lazyobject.hpp>
 #include <ql/patterns/observable.hpp>
 #include <ql/quotes/simplequote.hpp>
 
@@ -90,6 +91,247 @@ TEST_CASE("Observable_ObservableSettings", "[Observable]") {
 }
 
 
+namespace {
+
+    class ObserverDestroyer : public Observer {
+      public:
+        ObserverDestroyer(std::vector<std::unique_ptr<UpdateCounter> >& victims,
+                          std::unique_ptr<UpdateCounter>& newcomer,
+                          const std::shared_ptr<Observable>& observable)
+        : victims_(victims), newcomer_(newcomer), observable_(observable) {}
+        void update() {
+            for (Size i=1; i<victims_.size(); i+=2)
+                victims_[i].reset();
+            if (!newcomer_) {
+                newcomer_.reset(new UpdateCounter);
+                newcomer_->registerWith(observable_);
+            }
+        }
+      private:
+        std::vector<std::unique_ptr<UpdateCounter> >& victims_;
+        std::unique_ptr<UpdateCounter>& newcomer_;
+        std::shared_ptr<Observable> observable_;
+    };
+
+}
+
+TEST_CASE("Observable_ObserversChangingDuringNotification", "[Observable]") {
+
+    INFO("Testing observers registered and destroyed "
+         "during a notification...");
+
+    const std::shared_ptr<SimpleQuote> quote(new SimpleQuote(100.0));
+
+    std::vector<std::unique_ptr<UpdateCounter> > counters(40);
+    std::unique_ptr<UpdateCounter> newcomer;
+    ObserverDestroyer destroyer(counters, newcomer, quote);
+    destroyer.registerWith(quote);
+    for (Size i=0; i<counters.size(); ++i) {
+        counters[i].reset(new UpdateCounter);
+        counters[i]->registerWith(quote);
+    }
+    // registering twice has no effect
+    counters[0]->registerWith(quote);
+
+    quote->setValue(1.0);
+    if (!newcomer)
+        FAIL("observer not registered during notification");
+    if (newcomer->counter() != 0)
+        FAIL("observer registered during notification was notified");
+    for (Size i=0; i<counters.size(); i+=2) {
+        if (counters[i]->counter() != 1)
+            FAIL("observer " << i << " notified "
+                 << counters[i]->counter() << " times instead of once");
+    }
+
+    // destroy some of the observers outside of a notification
+    for (Size i=0; i<counters.size(); i+=4)
+        counters[i].reset();
+
+    quote->setValue(2.0);
+    if (newcomer->counter() != 1)
+        FAIL("registered observer notified "
+             << newcomer->counter() << " times instead of once");
+    for (Size i=2; i<counters.size(); i+=4) {
+        if (counters[i]->counter() != 2)
+            FAIL("observer " << i << " notified "
+                 << counters[i]->counter() << " times instead of twice");
+    }
+}
+
+
+TEST_CASE("Observable_NotificationFanOut", "[Observable]") {
+
+    INFO("Testing notification of a large number of observers...");
+
+    // also used as a benchmark of the time between a quote change
+    // and the invalidation of its dependent objects
+    const Size observers = 50000, ticks = 200;
+
+    const std::shared_ptr<SimpleQuote> quote(new SimpleQuote(100.0));
+    std::vector<std::unique_ptr<UpdateCounter> > counters(observers);
+    for (Size i=0; i<observers; ++i) {
+        counters[i].reset(new UpdateCounter);
+        counters[i]->registerWith(quote);
+    }
+
+    for (Size j=0; j<ticks; ++j)
+        quote->setValue(Real(j));
+
+    // unregister half of the observers in registration order
+    for (Size i=0; i<observers; i+=2)
+        counters[i]->unregisterWith(quote);
+    quote->setValue(-1.0);
+
+    for (Size i=0; i<observers; ++i) {
+        Size expected = (i % 2 == 0) ? ticks : ticks+1;
+        if (counters[i]->counter() != expected)
+            FAIL("observer " << i << " notified "
+                 << counters[i]->counter() << " times instead of "
+                 << expected);
+    }
+}
+
+
+#ifndef QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN
+
+namespace {
+
+    class DependentObject : public LazyObject {
+      public:
+        DependentObject(std::string name, std::vector<std::string>& log)
+        : name_(std::move(name)), log_(log), updates_(0) {}
+        void update() {
+            log_.push_back(name_);
+            ++updates_;
+            LazyObject::update();
+        }
+        void value() const { calculate(); }
+        Size updates() const { return updates_; }
+      private:
+        void performCalculations() const {}
+        std::string name_;
+        std::vector<std::string>& log_;
+        Size updates_;
+    };
+
+}
+
+TEST_CASE("Observable_UpdateTransaction", "[Observable]") {
+
+    INFO("Testing notifications after an update transaction...");
+
+    const std::shared_ptr<SimpleQuote> q1(new SimpleQuote(1.0));
+    const std::shared_ptr<SimpleQuote> q2(new SimpleQuote(2.0));
+
+    // c depends on b, which depends on a; all of them also depend
+    // directly on the quotes
+    std::vector<std::string> log;
+    const std::shared_ptr<DependentObject> a =
+        std::make_shared<DependentObject>("a", log);
+    const std::shared_ptr<DependentObject> b =
+        std::make_shared<DependentObject>("b", log);
+    const std::shared_ptr<DependentObject> c =
+        std::make_shared<DependentObject>("c", log);
+    c->registerWith(q2);
+    c->registerWith(b);
+    c->registerWith(a);
+    b->registerWith(q1);
+    b->registerWith(a);
+    a->registerWith(q1);
+    a->registerWith(q2);
+    c->value();
+
+    {
+        UpdateTransaction transaction;
+        {
+            // nested transactions have no effect
+            UpdateTransaction inner;
+            q1->setValue(10.0);
+        }
+        for (Size i=0; i<100; ++i) {
+            q1->setValue(Real(i));
+            q2->setValue(Real(i));
+        }
+        if (!log.empty())
+            FAIL("observers notified during the transaction");
+    }
+
+    if (!ObservableSettings::instance().updatesEnabled())
+        FAIL("updates not enabled after the transaction");
+
+    if (a->updates() != 1 || b->updates() != 1 || c->updates() != 1)
+        FAIL("observers not notified exactly once:"
+             << "\n    a: " << a->updates()
+             << "\n    b: " << b->updates()
+             << "\n    c: " << c->updates());
+
+    if (log.size() != 3 || log[0] != "a" || log[1] != "b" || log[2] != "c")
+        FAIL("observers not notified after the ones they depend upon");
+
+    // after the transaction, notifications are sent as usual
+    a->value();
+    b->value();
+    c->value();
+    q1->setValue(0.5);
+    if (a->updates() < 2 || b->updates() < 2 || c->updates() < 2)
+        FAIL("observers not notified after the transaction:"
+             << "\n    a: " << a->updates()
+             << "\n    b: " << b->updates()
+             << "\n    c: " << c->updates());
+}
+
+TEST_CASE("Observable_FrozenObjectInTransaction", "[Observable]") {
+
+    INFO("Testing that frozen objects don't forward notifications "
+         "after an update transaction...");
+
+    const std::shared_ptr<SimpleQuote> q(new SimpleQuote(1.0));
+
+    // d only depends on the quote through f
+    std::vector<std::string> log;
+    const std::shared_ptr<DependentObject> f =
+        std::make_shared<DependentObject>("f", log);
+    const std::shared_ptr<DependentObject> d =
+        std::make_shared<DependentObject>("d", log);
+    f->registerWith(q);
+    d->registerWith(f);
+    f->value();
+    d->value();
+
+    f->freeze();
+    {
+        UpdateTransaction transaction;
+        q->setValue(2.0);
+    }
+
+    if (f->updates() != 1)
+        FAIL_CHECK("frozen object not notified:"
+                   << "\n    calculated: " << f->updates()
+                   << "\n    expected:   1");
+    if (d->updates() != 0)
+        FAIL_CHECK("notification forwarded by frozen object:"
+                   << "\n    calculated: " << d->updates()
+                   << "\n    expected:   0");
+
+    // once unfrozen, f forwards notifications again
+    f->unfreeze();
+    f->value();
+    d->value();
+    const Size updates = d->updates();
+    {
+        UpdateTransaction transaction;
+        q->setValue(3.0);
+    }
+    if (d->updates() != updates+1)
+        FAIL_CHECK("notification not forwarded by unfrozen object:"
+                   << "\n    calculated: " << d->updates()
+                   << "\n    expected:   " << updates+1);
+}
+
+#endif
+
+
 #ifdef QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN
 
 #include <list>
@@ -21,6 +21,7 @@
 #include <ql/methods/montecarlo/mctraits.hpp>
 #include <ql/processes/blackscholesprocess.hpp>
 #include <ql/processes/geometricbrownianprocess.hpp>
+#include <ql/processes/hestonprocess.hpp>
 #include <ql/processes/ornsteinuhlenbeckprocess.hpp>
 #include <ql/processes/squarerootprocess.hpp>
 #include <ql/processes/stochasticprocessarray.hpp>
@@ -288,3 +289,116 @@ TEST_CASE("PathGenerator_MultiPathGenerator", "[PathGenerator]") {
     testMultiple(process, "square-root", result4, result4a);
 }
 
+
+
+TEST_CASE("PathGenerator_PathBlocks", "[PathGenerator]") {
+
+    INFO("Testing block path generation against single paths...");
+
+    SavedSettings backup;
+
+    Settings::instance().evaluationDate() = Date(26,April,2005);
+
+    Handle<Quote> x0(std::shared_ptr<Quote>(new SimpleQuote(100.0)));
+    Handle<YieldTermStructure> r(flatRate(0.05, Actual360()));
+    Handle<YieldTermStructure> q(flatRate(0.02, Actual360()));
+    Handle<BlackVolTermStructure> sigma(flatVol(0.20, Actual360()));
+
+    typedef PseudoRandom::rsg_type rsg_type;
+    BigNatural seed = 42;
+    TimeGrid grid(10.0, 12);
+    Size paths = 37;
+    Real tolerance = 1.0e-12;
+
+    std::shared_ptr<StochasticProcess1D> processes[] = {
+        std::shared_ptr<StochasticProcess1D>(
+                                 new BlackScholesMertonProcess(x0,q,r,sigma)),
+        std::shared_ptr<StochasticProcess1D>(
+                       new GeometricBrownianMotionProcess(100.0, 0.03, 0.20))
+    };
+
+    for (const auto& process : processes) {
+        for (bool brownianBridge : { false, true }) {
+            rsg_type rsg = PseudoRandom::make_sequence_generator(12, seed);
+            PathGenerator<rsg_type> generator(process, grid, rsg,
+                                              brownianBridge);
+            PathGenerator<rsg_type> blockGenerator(generator);
+
+            for (Size k=0; k<2; ++k) {
+                std::vector<Path> single, antithetic;
+                for (Size j=0; j<paths; ++j) {
+                    single.push_back(generator.next().value);
+                    antithetic.push_back(generator.antithetic().value);
+                }
+                for (Size n=0; n<2; ++n) {
+                    const PathBlock<Path>& block =
+                        n == 0 ? blockGenerator.nextBlock(paths)
+                               : blockGenerator.antitheticBlock();
+                    const std::vector<Path>& expected =
+                        n == 0 ? single : antithetic;
+                    for (Size j=0; j<paths; ++j) {
+                        for (Size i=0; i<grid.size(); ++i) {
+                            Real x = block.value(j,i);
+                            Real y = expected[j][i];
+                            if (std::fabs(x-y) > tolerance*std::fabs(y))
+                                FAIL_CHECK((n == 0 ? "" : "antithetic ")
+                                           << "path " << j
+                                           << " at point " << i
+                                           << (brownianBridge ?
+                                               " with" : " without")
+                                           << " brownian bridge:\n"
+                                           << std::setprecision(13)
+                                           << "    block:  " << x << "\n"
+                                           << "    single: " << y);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    HestonProcess::Discretization schemes[] = {
+        HestonProcess::PartialTruncation,
+        HestonProcess::FullTruncation,
+        HestonProcess::Reflection,
+        HestonProcess::QuadraticExponentialMartingale
+    };
+
+    for (auto scheme : schemes) {
+        std::shared_ptr<StochasticProcess> process(
+            new HestonProcess(r, q, x0, 0.04, 1.5, 0.04, 0.5, -0.7, scheme));
+        rsg_type rsg = PseudoRandom::make_sequence_generator(24, seed);
+        MultiPathGenerator<rsg_type> generator(process, grid, rsg, false);
+        MultiPathGenerator<rsg_type> blockGenerator(generator);
+
+        std::vector<MultiPath> single, antithetic;
+        for (Size j=0; j<paths; ++j) {
+            single.push_back(generator.next().value);
+            antithetic.push_back(generator.antithetic().value);
+        }
+        for (Size n=0; n<2; ++n) {
+            const PathBlock<MultiPath>& block =
+                n == 0 ? blockGenerator.nextBlock(paths)
+                       : blockGenerator.antitheticBlock();
+            const std::vector<MultiPath>& expected =
+                n == 0 ? single : antithetic;
+            for (Size j=0; j<paths; ++j) {
+                for (Size a=0; a<2; ++a) {
+                    for (Size i=0; i<grid.size(); ++i) {
+                        Real x = block.values(i,a)[j];
+                        Real y = expected[j][a][i];
+                        if (std::fabs(x-y) > tolerance*std::fabs(y))
+                            FAIL_CHECK("Heston scheme " << scheme << ", "
+                                       << (n == 0 ? "" : "antithetic ")
+                                       << "path " << j
+                                       << " (" << io::ordinal(a+1)
+                                       << " asset) at point " << i << ":\n"
+                                       << std::setprecision(13)
+                                       << "    block:  " << x << "\n"
+                                       << "    single: " << y);
+                    }
+                }
+            }
+        }
+    }
+}
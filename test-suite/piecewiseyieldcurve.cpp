@@ -22,6 +22,10 @@
 #include <ql/termstructures/yield/ratehelpers.hpp>
 #include <ql/termstructures/yield/bondhelpers.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
+#include <ql/termstructures/globalbootstrap.hpp>
+#include <ql/termstructures/multicurvebootstrap.hpp>
+#include <ql/experimental/risk/nodesensitivityanalysis.hpp>
+#include <ql/experimental/risk/sensitivityanalysis.hpp>
 #include <ql/time/calendars/target.hpp>
 #include <ql/time/calendars/japan.hpp>
 #include <ql/time/calendars/jointcalendar.hpp>
@@ -37,6 +41,7 @@
 #include <ql/indexes/indexmanager.hpp>
 #include <ql/instruments/forwardrateagreement.hpp>
 #include <ql/instruments/makevanillaswap.hpp>
+#include <ql/instruments/bonds/fixedratebond.hpp>
 #include <ql/math/interpolations/linearinterpolation.hpp>
 #include <ql/math/interpolations/loginterpolation.hpp>
 #include <ql/math/interpolations/backwardflatinterpolation.hpp>
@@ -1053,3 +1058,249 @@ TEST_CASE("PiecewiseYieldCurve_SwapRateHelperLastRelevantDate", "[PiecewiseYield
                                                    Actual365Fixed());
     CHECK_NOTHROW(curve.discount(1.0));
 }
+
+namespace {
+
+    std::vector<std::shared_ptr<RateHelper> > makeHelpers(
+                   CommonVars& vars,
+                   const Handle<YieldTermStructure>& discountingCurve =
+                                              Handle<YieldTermStructure>()) {
+        // each curve needs its own helpers; the quotes can be shared
+        std::shared_ptr<IborIndex> euribor6m(new Euribor6M);
+        std::vector<std::shared_ptr<RateHelper> > helpers;
+        for (Size i=0; i<vars.deposits; i++) {
+            Handle<Quote> r(vars.rates[i]);
+            helpers.push_back(std::shared_ptr<RateHelper>(new
+                DepositRateHelper(r, depositData[i].n*depositData[i].units,
+                                  euribor6m->fixingDays(), vars.calendar,
+                                  euribor6m->businessDayConvention(),
+                                  euribor6m->endOfMonth(),
+                                  euribor6m->dayCounter())));
+        }
+        for (Size i=0; i<vars.swaps; i++) {
+            Handle<Quote> r(vars.rates[i+vars.deposits]);
+            helpers.push_back(std::shared_ptr<RateHelper>(new
+                SwapRateHelper(r, swapData[i].n*swapData[i].units,
+                               vars.calendar,
+                               vars.fixedLegFrequency,
+                               vars.fixedLegConvention,
+                               vars.fixedLegDayCounter, euribor6m,
+                               Handle<Quote>(), 0*Days, discountingCurve)));
+        }
+        return helpers;
+    }
+
+    template <class T, class I>
+    std::shared_ptr<PiecewiseYieldCurve<T,I> > makeCurve(
+                   CommonVars& vars,
+                   const Handle<YieldTermStructure>& discountingCurve =
+                                              Handle<YieldTermStructure>()) {
+        return std::make_shared<PiecewiseYieldCurve<T,I> >(
+                    vars.settlement, makeHelpers(vars, discountingCurve),
+                    Actual360(), 1.0e-12);
+    }
+
+    void checkSameNodes(
+                  const std::vector<std::pair<Date, Real> >& calculated,
+                  const std::vector<std::pair<Date, Real> >& expected,
+                  const std::string& curve) {
+        REQUIRE(calculated.size() == expected.size());
+        for (Size i=0; i<calculated.size(); ++i) {
+            if (calculated[i] != expected[i])
+                FAIL_CHECK(io::ordinal(i+1) << " node of " << curve
+                           << " curve differs from serial bootstrap:"
+                           << "\n    calculated: " << calculated[i].first
+                           << ", " << calculated[i].second
+                           << "\n    expected:   " << expected[i].first
+                           << ", " << expected[i].second);
+        }
+    }
+
+}
+
+TEST_CASE("PiecewiseYieldCurve_MultiCurveBootstrap", "[PiecewiseYieldCurve]") {
+    INFO("Testing concurrent bootstrap of a multi-curve set...");
+
+    CommonVars vars;
+
+    std::shared_ptr<PiecewiseYieldCurve<Discount,LogLinear> > discount =
+        makeCurve<Discount,LogLinear>(vars);
+    std::shared_ptr<PiecewiseYieldCurve<ZeroYield,Linear> > zero =
+        makeCurve<ZeroYield,Linear>(vars);
+    std::shared_ptr<PiecewiseYieldCurve<ForwardRate,BackwardFlat> > forward =
+        makeCurve<ForwardRate,BackwardFlat>(
+                              vars, Handle<YieldTermStructure>(discount));
+
+    // same curves, bootstrapped one at a time
+    std::shared_ptr<PiecewiseYieldCurve<Discount,LogLinear> > discount0 =
+        makeCurve<Discount,LogLinear>(vars);
+    std::shared_ptr<PiecewiseYieldCurve<ZeroYield,Linear> > zero0 =
+        makeCurve<ZeroYield,Linear>(vars);
+    std::shared_ptr<PiecewiseYieldCurve<ForwardRate,BackwardFlat> >
+        forward0 = makeCurve<ForwardRate,BackwardFlat>(
+                              vars, Handle<YieldTermStructure>(discount0));
+
+    MultiCurveBootstrap curves(4);
+    curves.add(discount);
+    curves.add(zero);
+    curves.add(forward,
+               std::vector<std::shared_ptr<LazyObject> >(1, discount));
+
+    for (Size k=0; k<2; ++k) {
+        curves.calculate();
+        checkSameNodes(discount->nodes(), discount0->nodes(), "discount");
+        checkSameNodes(zero->nodes(), zero0->nodes(), "zero-rate");
+        checkSameNodes(forward->nodes(), forward0->nodes(), "forward-rate");
+
+        // the curves are bootstrapped again from their previous state
+        for (Size i=0; i<vars.rates.size(); ++i)
+            vars.rates[i]->setValue(vars.rates[i]->value() + 0.0005);
+    }
+
+    try {
+        curves.add(forward0,
+                   std::vector<std::shared_ptr<LazyObject> >(1, discount0));
+        FAIL_CHECK("dependency not in the set was accepted");
+    } catch (Error&) {}
+}
+
+namespace {
+
+    template <class T, class I>
+    void testGlobalBootstrap(CommonVars& vars, const std::string& curve) {
+
+        PiecewiseYieldCurve<T,I,GlobalBootstrap> global(
+                               vars.settlement, vars.instruments, Actual360());
+        PiecewiseYieldCurve<T,I> iterative(
+                               vars.settlement, vars.instruments, Actual360());
+
+        std::vector<std::pair<Date, Real> > calculated = global.nodes();
+        std::vector<std::pair<Date, Real> > expected = iterative.nodes();
+        REQUIRE(calculated.size() == expected.size());
+        for (Size i=0; i<calculated.size(); ++i) {
+            if (std::fabs(calculated[i].second-expected[i].second) > 1.0e-9)
+                FAIL_CHECK(io::ordinal(i+1) << " node of " << curve
+                           << " curve differs from iterative bootstrap:"
+                           << "\n    calculated: " << calculated[i].second
+                           << "\n    expected:   " << expected[i].second);
+        }
+
+        // the inverse of the Jacobian gives the change of the nodes
+        // for a change of the quotes
+        Matrix inverseJacobian = inverse(global.jacobian());
+        std::vector<Real> data = global.data();
+        Real bump = 1.0e-5;
+        for (Size j=0; j<vars.rates.size(); j+=5) {
+            vars.rates[j]->setValue(vars.rates[j]->value() + bump);
+            std::vector<Real> bumped = global.data();
+            vars.rates[j]->setValue(vars.rates[j]->value() - bump);
+            for (Size i=1; i<data.size(); ++i) {
+                Real change = (bumped[i]-data[i])/bump;
+                if (std::fabs(change-inverseJacobian[i-1][j]) > 1.0e-4)
+                    FAIL_CHECK("wrong sensitivity of " << io::ordinal(i+1)
+                               << " node of " << curve << " curve to "
+                               << io::ordinal(j+1) << " quote:"
+                               << "\n    jacobian:  "
+                               << inverseJacobian[i-1][j]
+                               << "\n    bumped:    " << change);
+            }
+        }
+    }
+
+}
+
+TEST_CASE("PiecewiseYieldCurve_GlobalBootstrap", "[PiecewiseYieldCurve]") {
+    INFO("Testing global bootstrap of piecewise yield curves...");
+
+    CommonVars vars;
+
+    testGlobalBootstrap<Discount,LogLinear>(vars, "discount");
+    testGlobalBootstrap<ZeroYield,Cubic>(vars, "zero-rate");
+    testGlobalBootstrap<ForwardRate,ConvexMonotone>(vars, "forward-rate");
+}
+
+namespace {
+
+    template <template <class> class B>
+    void testNodeBucketAnalysis(CommonVars& vars,
+                                const std::string& bootstrap) {
+
+        typedef PiecewiseYieldCurve<Discount,LogLinear,B> Curve;
+        std::shared_ptr<Curve> curve = std::make_shared<Curve>(
+                               vars.settlement, vars.instruments, Actual360());
+        Handle<YieldTermStructure> curveHandle(curve);
+
+        std::shared_ptr<IborIndex> index(new Euribor6M(curveHandle));
+        std::shared_ptr<PricingEngine> swapEngine =
+            std::make_shared<DiscountingSwapEngine>(
+                           curveHandle, std::nullopt, Date(), Date(), true);
+        Period tenors[] = { 2*Years, 7*Years, 12*Years, 25*Years };
+        Rate fixedRates[] = { 0.045, 0.052, 0.058, 0.061 };
+        std::vector<std::shared_ptr<Instrument> > instruments;
+        for (Size i=0; i<LENGTH(tenors); ++i) {
+            std::shared_ptr<VanillaSwap> swap =
+                MakeVanillaSwap(tenors[i], index, fixedRates[i])
+                .withPricingEngine(swapEngine)
+                .withNominal(1000000.0);
+            instruments.push_back(swap);
+        }
+        Schedule schedule(vars.settlement, vars.settlement + 9*Years,
+                          Period(Annual), vars.calendar, Unadjusted,
+                          Unadjusted, DateGeneration::Backward, false);
+        std::shared_ptr<Bond> bond = std::make_shared<FixedRateBond>(
+                                 vars.bondSettlementDays, 1000000.0, schedule,
+                                 std::vector<Rate>(1, 0.05),
+                                 vars.bondDayCounter, vars.bondConvention);
+        bond->setPricingEngine(std::make_shared<DiscountingBondEngine>(
+                                         curveHandle, std::nullopt, true));
+        instruments.push_back(bond);
+        std::vector<Real> quantities = { 1.0, -2.0, 0.5, 1.5, -1.0 };
+
+        std::vector<Handle<SimpleQuote> > quotes;
+        for (Size i=0; i<vars.rates.size(); ++i)
+            quotes.emplace_back(vars.rates[i]);
+
+        std::vector<std::pair<Date, Real> > nodes = curve->nodes();
+        Real npv = aggregateNPV(instruments, quantities);
+
+        std::vector<Real> calculated =
+            nodeBucketAnalysis(quotes, curve, instruments, quantities);
+
+        // the curve is left as it was
+        checkSameNodes(curve->nodes(), nodes, "discount");
+        if (npv != aggregateNPV(instruments, quantities))
+            FAIL_CHECK("portfolio value changed after sensitivity analysis:"
+                       << "\n    before: " << npv
+                       << "\n    after:  " << aggregateNPV(instruments,
+                                                          quantities));
+
+        std::vector<Real> expected =
+            bucketAnalysis(quotes, instruments, quantities, 1.0e-5).first;
+
+        REQUIRE(calculated.size() == expected.size());
+        // the errors of the finite-difference Jacobians spread the
+        // largest sensitivities over the others
+        Real largest = 0.0;
+        for (Size i=0; i<expected.size(); ++i)
+            largest = std::max(largest, std::fabs(expected[i]));
+        for (Size i=0; i<calculated.size(); ++i) {
+            Real tolerance = std::max(1.0e-5*std::fabs(expected[i]),
+                                      1.0e-7*largest);
+            if (std::fabs(calculated[i]-expected[i]) > tolerance)
+                FAIL_CHECK("wrong sensitivity to " << io::ordinal(i+1)
+                           << " quote with " << bootstrap << " bootstrap:"
+                           << "\n    calculated: " << calculated[i]
+                           << "\n    expected:   " << expected[i]);
+        }
+    }
+
+}
+
+TEST_CASE("PiecewiseYieldCurve_NodeBucketAnalysis", "[PiecewiseYieldCurve]") {
+    INFO("Testing bucket sensitivities through the curve nodes...");
+
+    CommonVars vars;
+
+    testNodeBucketAnalysis<IterativeBootstrap>(vars, "iterative");
+    testNodeBucketAnalysis<GlobalBootstrap>(vars, "global");
+}
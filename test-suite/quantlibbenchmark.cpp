@@ -221,6 +221,8 @@ int main() {
                               11244.95));
     bm.emplace_back(Benchmark("QuantoOption_ForwardGreeks", 90.98));
     bm.emplace_back(Benchmark("LowDiscrepancy_MersenneTwisterDiscrepancy", 951.98));
+    bm.emplace_back(Benchmark("Matrices_Multiplication", 97.92));
+    bm.emplace_back(Benchmark("Observable_NotificationFanOut", 10.05));
     bm.emplace_back(Benchmark("RiskStatistics_Results", 300.28));
     bm.emplace_back(Benchmark("ShortRateModel_Swaps", 454.73));
 
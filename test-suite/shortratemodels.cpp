@@ -23,6 +23,9 @@
 
 #include "utilities.hpp"
 #include <ql/models/shortrate/onefactormodels/hullwhite.hpp>
+#include <ql/models/shortrate/onefactormodels/blackkarasinski.hpp>
+#include <ql/termstructures/yield/flatforward.hpp>
+#include <ql/discretizedasset.hpp>
 #include <ql/models/shortrate/calibrationhelpers/swaptionhelper.hpp>
 #include <ql/pricingengines/swaption/jamshidianswaptionengine.hpp>
 #include <ql/pricingengines/swap/treeswapengine.hpp>
@@ -425,3 +428,56 @@ TEST_CASE("ShortRateModel_FuturesConvexityBias", "[ShortRateModel]") {
                     << "\n tolerance: " << tolerance);
     }
 }
+
+TEST_CASE("ShortRateModel_TreeRollback", "[ShortRateModel]") {
+    INFO("Testing consistency of rollback and state prices on trees...");
+
+    SavedSettings backup;
+
+    Date today = Settings::instance().evaluationDate();
+    Handle<YieldTermStructure> termStructure(
+        std::make_shared<FlatForward>(today, 0.04, Actual360()));
+
+    std::vector<std::shared_ptr<ShortRateModel> > models = {
+        std::make_shared<HullWhite>(termStructure, 0.05, 0.01),
+        std::make_shared<BlackKarasinski>(termStructure, 0.05, 0.2)
+    };
+
+    const Time maturity = 5.0;
+    const TimeGrid grid(maturity, 100);
+
+    for (const auto& model : models) {
+        std::shared_ptr<Lattice> lattice = model->tree(grid);
+
+        // rolling back a bond must give the same results as
+        // discounting its values with the state prices
+        for (Time t : {3.0, 1.0, 0.0}) {
+            DiscretizedDiscountBond bond;
+            bond.initialize(lattice, maturity);
+            bond.rollback(t);
+            Real rolledBack = lattice->presentValue(bond);
+
+            bond.initialize(lattice, maturity);
+            Real discounted = lattice->presentValue(bond);
+
+            if (std::fabs(rolledBack - discounted) > 1.0e-12)
+                FAIL_CHECK("rollback and state prices are inconsistent"
+                           << " rolling back to t = " << t << ":"
+                           << QL_SCIENTIFIC
+                           << "\n    rollback:     " << rolledBack
+                           << "\n    state prices: " << discounted);
+        }
+
+        // the tree is fitted to the term structure
+        DiscretizedDiscountBond bond;
+        bond.initialize(lattice, maturity);
+        bond.rollback(0.0);
+        Real calculated = bond.values()[0];
+        Real expected = termStructure->discount(maturity);
+        if (std::fabs(calculated - expected) > 1.0e-6)
+            FAIL_CHECK("failed to reproduce discount factor:"
+                       << QL_SCIENTIFIC
+                       << "\n    calculated: " << calculated
+                       << "\n    expected:   " << expected);
+    }
+}
@@ -123,6 +123,7 @@ TEST_CASE("Statistics_Statistics", "[Statistics]") {
     check<IncrementalStatistics>(
         std::string("IncrementalStatistics"));
     check<Statistics>(std::string("Statistics"));
+    check<TDigestRiskStatistics>(std::string("TDigestRiskStatistics"));
 }
 
 
@@ -243,6 +244,8 @@ TEST_CASE("Statistics_SequenceStatistics", "[Statistics]") {
     checkSequence<IncrementalStatistics>(
         std::string("IncrementalStatistics"),5);
     checkSequence<Statistics>(std::string("Statistics"),5);
+    checkSequence<TDigestRiskStatistics>(
+        std::string("TDigestRiskStatistics"),5);
 }
 
 
@@ -387,3 +390,113 @@ TEST_CASE("Statistics_IncrementalStatistics", "[Statistics]") {
                                  << tol);
 }
 
+
+TEST_CASE("Statistics_TDigestStatistics", "[Statistics]") {
+
+    INFO("Testing t-digest statistics...");
+
+    MersenneTwisterUniformRng mt(42), rng(43);
+    InverseCumulativeRng<MersenneTwisterUniformRng,InverseCumulativeNormal>
+        normal_gen(mt);
+
+    Statistics exact;
+    TDigestRiskStatistics stat;
+    std::vector<TDigestRiskStatistics> partial(4);
+
+    Size N = 200000;
+    for (Size i = 0; i < N; ++i) {
+        Real x = normal_gen.next().value;
+        Real w = 0.5 + rng.nextReal();
+        exact.add(x, w);
+        stat.add(x, w);
+        partial[i % 4].add(x, w);
+    }
+    TDigestRiskStatistics merged = partial[0];
+    for (Size k = 1; k < partial.size(); ++k)
+        merged.merge(partial[k]);
+
+    if (stat.centroids() > 1000)
+        FAIL_CHECK("too many centroids: " << stat.centroids());
+
+    TDigestRiskStatistics* stats[] = { &stat, &merged };
+    std::string names[] = { "single", "merged" };
+    Real percents[] = { 0.0001, 0.001, 0.01, 0.05, 0.25, 0.5,
+                        0.75, 0.95, 0.99, 0.999, 0.9999, 1.0 };
+
+    for (Size j = 0; j < LENGTH(stats); ++j) {
+        const TDigestRiskStatistics& s = *stats[j];
+
+        if (s.samples() != N)
+            FAIL_CHECK(names[j] << " digest: wrong number of samples"
+                       << "\n    calculated: " << s.samples()
+                       << "\n    expected:   " << N);
+        if (std::fabs(s.weightSum() - exact.weightSum()) > 1.0e-8)
+            FAIL_CHECK(names[j] << " digest: wrong sum of weights"
+                       << "\n    calculated: " << s.weightSum()
+                       << "\n    expected:   " << exact.weightSum());
+        // moments are accumulated exactly, up to rounding
+        Real calculatedMoments[] = { s.mean(), s.variance(),
+                                     s.skewness(), s.kurtosis(),
+                                     s.min(), s.max() };
+        Real expectedMoments[] = { exact.mean(), exact.variance(),
+                                   exact.skewness(), exact.kurtosis(),
+                                   exact.min(), exact.max() };
+        std::string moments[] = { "mean", "variance", "skewness",
+                                  "kurtosis", "minimum", "maximum" };
+        for (Size i = 0; i < LENGTH(moments); ++i) {
+            if (std::fabs(calculatedMoments[i] - expectedMoments[i]) >
+                1.0e-10*std::max(std::fabs(expectedMoments[i]), 1.0))
+                FAIL_CHECK(names[j] << " digest: wrong " << moments[i]
+                           << QL_SCIENTIFIC
+                           << "\n    calculated: " << calculatedMoments[i]
+                           << "\n    expected:   " << expectedMoments[i]);
+        }
+
+        for (Size i = 0; i < LENGTH(percents); ++i) {
+            Real p = percents[i];
+            Real tolerance = 1.0e-2;
+
+            Real expected = exact.percentile(p);
+            Real calculated = s.percentile(p);
+            std::pair<Real, Real> bounds = s.percentileBounds(p);
+            if (expected < bounds.first || expected > bounds.second)
+                FAIL_CHECK(names[j] << " digest: "
+                           << io::percent(p) << " percentile "
+                           << expected << " out of bounds ["
+                           << bounds.first << ", " << bounds.second << "]");
+            if (std::fabs(calculated - expected) > tolerance)
+                FAIL_CHECK(names[j] << " digest: wrong "
+                           << io::percent(p) << " percentile"
+                           << "\n    calculated: " << calculated
+                           << "\n    expected:   " << expected);
+
+            expected = exact.topPercentile(p);
+            calculated = s.topPercentile(p);
+            bounds = s.topPercentileBounds(p);
+            if (expected < bounds.first || expected > bounds.second)
+                FAIL_CHECK(names[j] << " digest: "
+                           << io::percent(p) << " top percentile "
+                           << expected << " out of bounds ["
+                           << bounds.first << ", " << bounds.second << "]");
+            if (std::fabs(calculated - expected) > tolerance)
+                FAIL_CHECK(names[j] << " digest: wrong "
+                           << io::percent(p) << " top percentile"
+                           << "\n    calculated: " << calculated
+                           << "\n    expected:   " << expected);
+        }
+
+        Real tolerance = 1.0e-2;
+        Real calculated = s.valueAtRisk(0.99);
+        Real expected = exact.valueAtRisk(0.99);
+        if (std::fabs(calculated - expected) > tolerance)
+            FAIL_CHECK(names[j] << " digest: wrong value-at-risk"
+                       << "\n    calculated: " << calculated
+                       << "\n    expected:   " << expected);
+        calculated = s.expectedShortfall(0.99);
+        expected = exact.expectedShortfall(0.99);
+        if (std::fabs(calculated - expected) > tolerance)
+            FAIL_CHECK(names[j] << " digest: wrong expected shortfall"
+                       << "\n    calculated: " << calculated
+                       << "\n    expected:   " << expected);
+    }
+}
@@ -223,6 +223,130 @@ TEST_CASE("SwaptionVolatilityCube_SabrVols", "[SwaptionVolatilityCube]") {
     vars.makeVolSpreadsTest(volCube, tolerance);
 }
 
+TEST_CASE("SwaptionVolatilityCube_SabrCalibrationSettings", "[SwaptionVolatilityCube]") {
+
+    INFO("Testing multi-threaded and warm-started sabr cube calibration...");
+
+    CommonVars vars;
+
+    std::vector<std::vector<Handle<Quote> > >
+        parametersGuess(vars.cube.tenors.options.size()*vars.cube.tenors.swaps.size());
+    for (Size i=0; i<vars.cube.tenors.options.size()*vars.cube.tenors.swaps.size(); i++) {
+        parametersGuess[i] = std::vector<Handle<Quote> >(4);
+        parametersGuess[i][0] =
+            Handle<Quote>(std::shared_ptr<Quote>(new SimpleQuote(0.2)));
+        parametersGuess[i][1] =
+            Handle<Quote>(std::shared_ptr<Quote>(new SimpleQuote(0.5)));
+        parametersGuess[i][2] =
+            Handle<Quote>(std::shared_ptr<Quote>(new SimpleQuote(0.4)));
+        parametersGuess[i][3] =
+            Handle<Quote>(std::shared_ptr<Quote>(new SimpleQuote(0.0)));
+    }
+    std::vector<bool> isParameterFixed(4, false);
+
+    std::vector<std::shared_ptr<SwaptionVolCube1> > volCubes;
+    for (Size i=0; i<3; ++i)
+        volCubes.emplace_back(std::make_shared<SwaptionVolCube1>(
+                                 vars.atmVolMatrix,
+                                 vars.cube.tenors.options,
+                                 vars.cube.tenors.swaps,
+                                 vars.cube.strikeSpreads,
+                                 vars.cube.volSpreadsHandle,
+                                 vars.swapIndexBase,
+                                 vars.shortSwapIndexBase,
+                                 vars.vegaWeighedSmileFit,
+                                 parametersGuess,
+                                 isParameterFixed,
+                                 false));
+    std::shared_ptr<SwaptionVolCube1> serial = volCubes[0];
+    std::shared_ptr<SwaptionVolCube1> threaded = volCubes[1];
+    std::shared_ptr<SwaptionVolCube1> incremental = volCubes[2];
+    threaded->setThreads(3);
+    incremental->setWarmStart(true);
+    incremental->setSkipUnchangedSmiles(true);
+
+    // each smile is fitted independently of the others
+    Matrix expected = serial->sparseSabrParameters();
+    Matrix calculated = threaded->sparseSabrParameters();
+    for (Size i=0; i<expected.rows(); ++i) {
+        for (Size j=0; j<expected.columns(); ++j) {
+            if (calculated[i][j] != expected[i][j])
+                FAIL_CHECK("multi-threaded sabr calibration differs "
+                           "from serial one:"
+                           << "\n    swap length: " << expected[i][0]
+                           << "\n    option time: " << expected[i][1]
+                           << "\n    layer:       " << j-2
+                           << std::setprecision(16)
+                           << "\n    serial:         " << expected[i][j]
+                           << "\n    multi-threaded: " << calculated[i][j]);
+        }
+    }
+
+    // the first calibration has nothing to start from
+    calculated = incremental->sparseSabrParameters();
+    for (Size i=0; i<expected.rows(); ++i) {
+        for (Size j=0; j<expected.columns(); ++j) {
+            if (calculated[i][j] != expected[i][j])
+                FAIL_CHECK("first incremental sabr calibration differs "
+                           "from cold one:"
+                           << "\n    swap length: " << expected[i][0]
+                           << "\n    option time: " << expected[i][1]
+                           << "\n    layer:       " << j-2
+                           << std::setprecision(16)
+                           << "\n    cold:        " << expected[i][j]
+                           << "\n    incremental: " << calculated[i][j]);
+        }
+    }
+
+    // move a single smile; the other ones are not fitted again and the
+    // moved one is fitted from the previous parameters
+    Size node = 4, strike = 1;
+    std::shared_ptr<SimpleQuote> volSpread =
+        std::dynamic_pointer_cast<SimpleQuote>(
+            vars.cube.volSpreadsHandle[node][strike].currentLink());
+    volSpread->setValue(volSpread->value() + 0.0010);
+
+    expected = serial->sparseSabrParameters();
+    calculated = incremental->sparseSabrParameters();
+    Size optionIndex = node / vars.cube.tenors.swaps.size();
+    Size swapIndex = node % vars.cube.tenors.swaps.size();
+    Size movedRow = swapIndex*vars.cube.tenors.options.size() + optionIndex;
+    for (Size i=0; i<expected.rows(); ++i) {
+        if (i == movedRow)
+            continue;
+        for (Size j=0; j<expected.columns(); ++j) {
+            if (calculated[i][j] != expected[i][j])
+                FAIL_CHECK("unchanged smile refitted by "
+                           "incremental sabr calibration:"
+                           << "\n    swap length: " << expected[i][0]
+                           << "\n    option time: " << expected[i][1]
+                           << "\n    layer:       " << j-2
+                           << std::setprecision(16)
+                           << "\n    cold:        " << expected[i][j]
+                           << "\n    incremental: " << calculated[i][j]);
+        }
+    }
+
+    Period optionTenor = vars.cube.tenors.options[optionIndex];
+    Period swapTenor = vars.cube.tenors.swaps[swapIndex];
+    Rate atmStrike = serial->atmStrike(optionTenor, swapTenor);
+    for (Size k=0; k<vars.cube.strikeSpreads.size(); ++k) {
+        Rate strike = atmStrike + vars.cube.strikeSpreads[k];
+        Volatility cold = serial->volatility(optionTenor, swapTenor,
+                                             strike, true);
+        Volatility warm = incremental->volatility(optionTenor, swapTenor,
+                                                  strike, true);
+        if (std::fabs(warm - cold) > 1.0e-4)
+            FAIL_CHECK("warm-started sabr calibration differs "
+                       "from cold one:"
+                       << "\n    option tenor: " << optionTenor
+                       << "\n    swap tenor:   " << swapTenor
+                       << "\n    strike:       " << io::rate(strike)
+                       << "\n    cold:         " << io::volatility(cold)
+                       << "\n    warm:         " << io::volatility(warm));
+    }
+}
+
 TEST_CASE("SwaptionVolatilityCube_SpreadedCube", "[SwaptionVolatilityCube]") {
 
     INFO("Testing spreaded swaption volatility cube...");